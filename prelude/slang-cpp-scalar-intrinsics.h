@@ -268,18 +268,174 @@ SLANG_FORCE_INLINE int64_t I64_max(int64_t a, int64_t b) { return a > b ? a : b;
 
 
 // ----------------------------- Interlocked ---------------------------------
-#ifdef _WIN32
+
+// The HLSL `Interlocked*` functions are implemented on top of a small set of atomic
+// primitives, for 32 and 64 bit unsigned values. Signed and float operations that can't be
+// expressed directly are implemented via the bit pattern with a compare-exchange loop.
+//
+// There is no way to express a memory barrier on the CPU target, so all of the primitives
+// are sequentially consistent.
+
+#if SLANG_VC
 #include <intrin.h>
+
+SLANG_FORCE_INLINE uint32_t _atomicCompareExchange(uint32_t* dest, uint32_t compareValue, uint32_t value) { return uint32_t(_InterlockedCompareExchange((long volatile*)dest, long(value), long(compareValue))); }
+SLANG_FORCE_INLINE uint64_t _atomicCompareExchange(uint64_t* dest, uint64_t compareValue, uint64_t value) { return uint64_t(_InterlockedCompareExchange64((__int64 volatile*)dest, __int64(value), __int64(compareValue))); }
+
+SLANG_FORCE_INLINE uint32_t _atomicExchange(uint32_t* dest, uint32_t value) { return uint32_t(_InterlockedExchange((long volatile*)dest, long(value))); }
+SLANG_FORCE_INLINE uint64_t _atomicExchange(uint64_t* dest, uint64_t value) { return uint64_t(_InterlockedExchange64((__int64 volatile*)dest, __int64(value))); }
+
+SLANG_FORCE_INLINE uint32_t _atomicAdd(uint32_t* dest, uint32_t value) { return uint32_t(_InterlockedExchangeAdd((long volatile*)dest, long(value))); }
+SLANG_FORCE_INLINE uint64_t _atomicAdd(uint64_t* dest, uint64_t value) { return uint64_t(_InterlockedExchangeAdd64((__int64 volatile*)dest, __int64(value))); }
+
+SLANG_FORCE_INLINE uint32_t _atomicAnd(uint32_t* dest, uint32_t value) { return uint32_t(_InterlockedAnd((long volatile*)dest, long(value))); }
+SLANG_FORCE_INLINE uint64_t _atomicAnd(uint64_t* dest, uint64_t value) { return uint64_t(_InterlockedAnd64((__int64 volatile*)dest, __int64(value))); }
+
+SLANG_FORCE_INLINE uint32_t _atomicOr(uint32_t* dest, uint32_t value) { return uint32_t(_InterlockedOr((long volatile*)dest, long(value))); }
+SLANG_FORCE_INLINE uint64_t _atomicOr(uint64_t* dest, uint64_t value) { return uint64_t(_InterlockedOr64((__int64 volatile*)dest, __int64(value))); }
+
+SLANG_FORCE_INLINE uint32_t _atomicXor(uint32_t* dest, uint32_t value) { return uint32_t(_InterlockedXor((long volatile*)dest, long(value))); }
+SLANG_FORCE_INLINE uint64_t _atomicXor(uint64_t* dest, uint64_t value) { return uint64_t(_InterlockedXor64((__int64 volatile*)dest, __int64(value))); }
+
+template <typename T>
+SLANG_FORCE_INLINE T _atomicLoad(T* src) { return *(T volatile*)src; }
+#else
+template <typename T>
+SLANG_FORCE_INLINE T _atomicCompareExchange(T* dest, T compareValue, T value)
+{
+    // On failure `compareValue` is updated to hold the current value, so in either case it holds
+    // the original value.
+    __atomic_compare_exchange_n(dest, &compareValue, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return compareValue;
+}
+
+template <typename T>
+SLANG_FORCE_INLINE T _atomicExchange(T* dest, T value) { return __atomic_exchange_n(dest, value, __ATOMIC_SEQ_CST); }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicAdd(T* dest, T value) { return __atomic_fetch_add(dest, value, __ATOMIC_SEQ_CST); }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicAnd(T* dest, T value) { return __atomic_fetch_and(dest, value, __ATOMIC_SEQ_CST); }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicOr(T* dest, T value) { return __atomic_fetch_or(dest, value, __ATOMIC_SEQ_CST); }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicXor(T* dest, T value) { return __atomic_fetch_xor(dest, value, __ATOMIC_SEQ_CST); }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicLoad(T* src) { return __atomic_load_n(src, __ATOMIC_RELAXED); }
 #endif
 
-void InterlockedAdd(uint32_t* dest, uint32_t value, uint32_t* oldValue)
+// Atomically replaces the value at `dest` with `replace(current, value)`, using a compare-exchange
+// loop on its bits stored as a `TBits`. Returns the original value.
+template <typename T, typename TBits, typename F>
+SLANG_FORCE_INLINE T _atomicUpdate(T* dest, T value, F replace)
 {
-#ifdef _WIN32
-    *oldValue = _InterlockedExchangeAdd((long*)dest, (long)value);
-#else
-    *oldValue = __sync_fetch_and_add(dest, value);
+    TBits* bitsDest = (TBits*)dest;
+    TBits oldBits = _atomicLoad(bitsDest);
+    for (;;)
+    {
+        const T oldValue = slang_bit_cast<T>(oldBits);
+        const T newValue = replace(oldValue, value);
+        const TBits newBits = slang_bit_cast<TBits>(newValue);
+        if (newBits == oldBits)
+        {
+            return oldValue;
+        }
+        const TBits prevBits = _atomicCompareExchange(bitsDest, oldBits, newBits);
+        if (prevBits == oldBits)
+        {
+            return oldValue;
+        }
+        oldBits = prevBits;
+    }
+}
+
+template <typename T>
+SLANG_FORCE_INLINE T _atomicMinOp(T a, T b) { return b < a ? b : a; }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicMaxOp(T a, T b) { return b > a ? b : a; }
+template <typename T>
+SLANG_FORCE_INLINE T _atomicAddOp(T a, T b) { return a + b; }
+
+// Defines the `Interlocked*` functions for an integral type `T` whose bits are stored as `TBits`.
+// Each function returns the original value as well as optionally writing it to `oldValue`.
+#define SLANG_PRELUDE_INTERLOCKED_INTEGER(T, TBits) \
+    SLANG_FORCE_INLINE T InterlockedAdd(T* dest, T value) { return T(_atomicAdd((TBits*)dest, TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedAdd(T* dest, T value, T* oldValue) { return *oldValue = InterlockedAdd(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedAnd(T* dest, T value) { return T(_atomicAnd((TBits*)dest, TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedAnd(T* dest, T value, T* oldValue) { return *oldValue = InterlockedAnd(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedOr(T* dest, T value) { return T(_atomicOr((TBits*)dest, TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedOr(T* dest, T value, T* oldValue) { return *oldValue = InterlockedOr(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedXor(T* dest, T value) { return T(_atomicXor((TBits*)dest, TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedXor(T* dest, T value, T* oldValue) { return *oldValue = InterlockedXor(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedMin(T* dest, T value) { return _atomicUpdate<T, TBits>(dest, value, _atomicMinOp<T>); } \
+    SLANG_FORCE_INLINE T InterlockedMin(T* dest, T value, T* oldValue) { return *oldValue = InterlockedMin(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedMax(T* dest, T value) { return _atomicUpdate<T, TBits>(dest, value, _atomicMaxOp<T>); } \
+    SLANG_FORCE_INLINE T InterlockedMax(T* dest, T value, T* oldValue) { return *oldValue = InterlockedMax(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedExchange(T* dest, T value) { return T(_atomicExchange((TBits*)dest, TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedExchange(T* dest, T value, T* oldValue) { return *oldValue = InterlockedExchange(dest, value); } \
+    SLANG_FORCE_INLINE T InterlockedCompareExchange(T* dest, T compareValue, T value) { return T(_atomicCompareExchange((TBits*)dest, TBits(compareValue), TBits(value))); } \
+    SLANG_FORCE_INLINE T InterlockedCompareExchange(T* dest, T compareValue, T value, T* oldValue) { return *oldValue = InterlockedCompareExchange(dest, compareValue, value); } \
+    SLANG_FORCE_INLINE void InterlockedCompareStore(T* dest, T compareValue, T value) { InterlockedCompareExchange(dest, compareValue, value); }
+
+SLANG_PRELUDE_INTERLOCKED_INTEGER(int32_t, uint32_t)
+SLANG_PRELUDE_INTERLOCKED_INTEGER(uint32_t, uint32_t)
+SLANG_PRELUDE_INTERLOCKED_INTEGER(int64_t, uint64_t)
+SLANG_PRELUDE_INTERLOCKED_INTEGER(uint64_t, uint64_t)
+
+#undef SLANG_PRELUDE_INTERLOCKED_INTEGER
+
+SLANG_FORCE_INLINE float InterlockedAdd(float* dest, float value) { return _atomicUpdate<float, uint32_t>(dest, value, _atomicAddOp<float>); }
+SLANG_FORCE_INLINE float InterlockedAdd(float* dest, float value, float* oldValue) { return *oldValue = InterlockedAdd(dest, value); }
+
+// ----------------------------- Derivatives ---------------------------------
+
+// Derivatives are differences between the values in the lanes of a 2x2 quad. When executing a quad (see QuadContext in
+// slang-cpp-types.h) the values are exchanged with the other lanes. Otherwise, such as when running a single thread,
+// there is nothing to take the difference with and derivatives are zero.
+//
+// As on most GPUs, `ddx` and `ddy` are the coarse derivatives.
+
+// Writes the value of `v` in each lane of the quad to `outValues`, and returns the current lane index.
+template <typename T>
+SLANG_FORCE_INLINE int _getQuadValues(T v, T outValues[4])
+{
+#if SLANG_PRELUDE_ENABLE_QUAD
+    if (QuadContext* quad = QuadContext::getCurrent())
+    {
+        quad->exchange(v, outValues);
+        return quad->currentLane;
+    }
 #endif
+    for (int i = 0; i < 4; ++i)
+    {
+        outValues[i] = v;
+    }
+    return 0;
 }
+
+#define SLANG_PRELUDE_DERIVATIVES(T, PREFIX) \
+    SLANG_FORCE_INLINE T PREFIX##_ddx_coarse(T v) { T values[4]; _getQuadValues(v, values); return values[1] - values[0]; } \
+    SLANG_FORCE_INLINE T PREFIX##_ddy_coarse(T v) { T values[4]; _getQuadValues(v, values); return values[2] - values[0]; } \
+    SLANG_FORCE_INLINE T PREFIX##_ddx_fine(T v) { T values[4]; const int lane = _getQuadValues(v, values); return values[lane | 1] - values[lane & 2]; } \
+    SLANG_FORCE_INLINE T PREFIX##_ddy_fine(T v) { T values[4]; const int lane = _getQuadValues(v, values); return values[lane | 2] - values[lane & 1]; } \
+    SLANG_FORCE_INLINE T PREFIX##_ddx(T v) { return PREFIX##_ddx_coarse(v); } \
+    SLANG_FORCE_INLINE T PREFIX##_ddy(T v) { return PREFIX##_ddy_coarse(v); } \
+    SLANG_FORCE_INLINE T PREFIX##_fwidth(T v) { T values[4]; _getQuadValues(v, values); return PREFIX##_abs(values[1] - values[0]) + PREFIX##_abs(values[2] - values[0]); }
+
+SLANG_PRELUDE_DERIVATIVES(float, F32)
+SLANG_PRELUDE_DERIVATIVES(double, F64)
+
+#undef SLANG_PRELUDE_DERIVATIVES
+
+// The SM6.0 quad intrinsics are generic over the type, so they are defined for any type here
+template <typename T>
+SLANG_FORCE_INLINE T QuadReadLaneAt(T sourceValue, uint32_t quadLaneID) { T values[4]; _getQuadValues(sourceValue, values); return values[quadLaneID & 3]; }
+template <typename T>
+SLANG_FORCE_INLINE T QuadReadAcrossX(T localValue) { T values[4]; const int lane = _getQuadValues(localValue, values); return values[lane ^ 1]; }
+template <typename T>
+SLANG_FORCE_INLINE T QuadReadAcrossY(T localValue) { T values[4]; const int lane = _getQuadValues(localValue, values); return values[lane ^ 2]; }
+template <typename T>
+SLANG_FORCE_INLINE T QuadReadAcrossDiagonal(T localValue) { T values[4]; const int lane = _getQuadValues(localValue, values); return values[lane ^ 3]; }
+
 #ifdef SLANG_PRELUDE_NAMESPACE
 } 
 #endif
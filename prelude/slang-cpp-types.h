@@ -13,6 +13,48 @@
 #    define SLANG_FORCE_INLINE inline
 #endif
 
+// Bounds checking of buffer and array accesses. When a checked mode is selected (with `-bounds-check-mode`)
+// generated code uses the `at` accessors for accesses that the compiler can't prove are in bounds.
+#define SLANG_PRELUDE_BOUND_CHECK_MODE_NONE     0
+#define SLANG_PRELUDE_BOUND_CHECK_MODE_CLAMP    1
+#define SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP     2
+
+#ifndef SLANG_PRELUDE_BOUND_CHECK_MODE
+#   define SLANG_PRELUDE_BOUND_CHECK_MODE SLANG_PRELUDE_BOUND_CHECK_MODE_NONE
+#endif
+
+// In trap mode, called with the source location of an out of bounds access. Can be replaced by defining 
+// before including this header. If it returns, the access is handled as in clamp mode.
+#if SLANG_PRELUDE_BOUND_CHECK_MODE == SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP && !defined(SLANG_PRELUDE_BOUND_CHECK_FAILED)
+#   include <stdio.h>
+#   include <stdlib.h>
+#   define SLANG_PRELUDE_BOUND_CHECK_FAILED(LOCATION, INDEX, COUNT) \
+        do { \
+            fprintf(stderr, "%s: index %llu is out of bounds (count %llu)\n", (LOCATION), (unsigned long long)(INDEX), (unsigned long long)(COUNT)); \
+            abort(); \
+        } while (0)
+#endif
+
+// Quad execution (see QuadContext) runs each lane of a quad on a fiber
+#if SLANG_PRELUDE_ENABLE_QUAD
+#   include <math.h>
+#   include <stdlib.h>
+#   if defined(_WIN32)
+#       ifndef WIN32_LEAN_AND_MEAN
+#           define WIN32_LEAN_AND_MEAN
+#       endif
+#       ifndef NOMINMAX
+#           define NOMINMAX
+#       endif
+#       include <windows.h>
+#   else
+#       if defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+#           define _XOPEN_SOURCE 600
+#       endif
+#       include <ucontext.h>
+#   endif
+#endif
+
 #ifdef SLANG_PRELUDE_NAMESPACE
 namespace SLANG_PRELUDE_NAMESPACE {
 #endif
@@ -22,11 +64,66 @@ struct TypeInfo
     size_t typeSize;
 };
 
+// ----------------------------- Bounds checking -----------------------------------------
+
+// A zeroed value, used for out of bounds accesses that have nothing to clamp to. It is zeroed on
+// every use, such that reads return 0 and writes are discarded.
+template <typename T>
+T& _getZeroedScratch()
+{
+    static thread_local T scratch;
+    scratch = T();
+    return scratch;
+}
+
+template <typename T>
+T& _getOutOfBoundsElement(T* data, size_t index, size_t count, const char* location)
+{
+#if SLANG_PRELUDE_BOUND_CHECK_MODE == SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP
+    SLANG_PRELUDE_BOUND_CHECK_FAILED(location, index, count);
+#else
+    (void)index;
+    (void)location;
+#endif
+    return count > 0 ? data[count - 1] : _getZeroedScratch<T>();
+}
+
+    /// Get the element at `index`, or if it is out of bounds handle as selected by SLANG_PRELUDE_BOUND_CHECK_MODE
+template <typename T>
+SLANG_FORCE_INLINE T& _getBoundCheckedElement(T* data, size_t index, size_t count, const char* location)
+{
+    return (index < count) ? data[index] : _getOutOfBoundsElement(data, index, count, location);
+}
+
+template <typename T>
+T* _getOutOfBoundsPtr(size_t offset, size_t sizeInBytes)
+{
+#if SLANG_PRELUDE_BOUND_CHECK_MODE == SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP
+    SLANG_PRELUDE_BOUND_CHECK_FAILED("ByteAddressBuffer", offset, sizeInBytes);
+#else
+    (void)offset;
+    (void)sizeInBytes;
+#endif
+    return &_getZeroedScratch<T>();
+}
+
+    /// Get a pointer to a T at the byte `offset` into `data`. If it is out of bounds (or misaligned) a zeroed 
+    /// value is used instead, as clamping a byte offset could produce a partial or misaligned value.
+template <typename T>
+SLANG_FORCE_INLINE T* _getBoundCheckedPtr(void* data, size_t offset, size_t sizeInBytes)
+{
+    return (offset <= sizeInBytes && sizeof(T) <= sizeInBytes - offset && (offset & (alignof(T) - 1)) == 0) ?
+        (T*)((char*)data + offset) : 
+        _getOutOfBoundsPtr<T>(offset, sizeInBytes);
+}
+
 template <typename T, size_t SIZE>
 struct FixedArray
 {
     const T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < SIZE); return m_data[index]; }
     T& operator[](size_t index) { SLANG_PRELUDE_ASSERT(index < SIZE); return m_data[index]; }
+    const T& at(size_t index, const char* location) const { return _getBoundCheckedElement(const_cast<T*>(m_data), index, SIZE, location); }
+    T& at(size_t index, const char* location) { return _getBoundCheckedElement(m_data, index, SIZE, location); }
 
     T m_data[SIZE];
 };
@@ -38,6 +135,8 @@ struct Array
 {
     const T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
     T& operator[](size_t index) { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
+    const T& at(size_t index, const char* location) const { return _getBoundCheckedElement(data, index, count, location); }
+    T& at(size_t index, const char* location) { return _getBoundCheckedElement(data, index, count, location); }
 
     T* data;
     size_t count;
@@ -127,6 +226,7 @@ template <typename T>
 struct RWStructuredBuffer
 {
     SLANG_FORCE_INLINE T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
+    SLANG_FORCE_INLINE T& at(size_t index, const char* location) const { return _getBoundCheckedElement(data, index, count, location); }
     const T& Load(size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }  
     void GetDimensions(uint32_t* outNumStructs, uint32_t* outStride) { *outNumStructs = uint32_t(count); *outStride = uint32_t(sizeof(T)); }
   
@@ -138,6 +238,7 @@ template <typename T>
 struct StructuredBuffer
 {
     SLANG_FORCE_INLINE const T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
+    SLANG_FORCE_INLINE const T& at(size_t index, const char* location) const { return _getBoundCheckedElement(data, index, count, location); }
     const T& Load(size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
     void GetDimensions(uint32_t* outNumStructs, uint32_t* outStride) { *outNumStructs = uint32_t(count); *outStride = uint32_t(sizeof(T)); }
     
@@ -150,6 +251,7 @@ template <typename T>
 struct RWBuffer
 {
     SLANG_FORCE_INLINE T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
+    SLANG_FORCE_INLINE T& at(size_t index, const char* location) const { return _getBoundCheckedElement(data, index, count, location); }
     const T& Load(size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
     void GetDimensions(uint32_t* outCount) { *outCount = uint32_t(count); }
     
@@ -161,6 +263,7 @@ template <typename T>
 struct Buffer
 {
     SLANG_FORCE_INLINE const T& operator[](size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
+    SLANG_FORCE_INLINE const T& at(size_t index, const char* location) const { return _getBoundCheckedElement(data, index, count, location); }
     const T& Load(size_t index) const { SLANG_PRELUDE_ASSERT(index < count); return data[index]; }
     void GetDimensions(uint32_t* outCount) { *outCount = uint32_t(count); }
     
@@ -169,37 +272,51 @@ struct Buffer
 };
 
 // Missing  Load(_In_  int  Location, _Out_ uint Status);
+//
+// With bounds checking enabled, an out of bounds (or misaligned) Load returns 0, as on D3D.
 struct ByteAddressBuffer
 {
     void GetDimensions(uint32_t* outDim) const { *outDim = uint32_t(sizeInBytes); }
     uint32_t Load(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 4 <= sizeInBytes && (index & 3) == 0); 
-        return data[index >> 2]; 
+        return *_getWordsAt<1>(index); 
     }
     uint2 Load2(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 8 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint2{data[dataIdx], data[dataIdx + 1]}; 
+        const uint32_t* words = _getWordsAt<2>(index); 
+        return uint2{words[0], words[1]}; 
     }
     uint3 Load3(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 12 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint3{data[dataIdx], data[dataIdx + 1], data[dataIdx + 2]}; 
+        const uint32_t* words = _getWordsAt<3>(index); 
+        return uint3{words[0], words[1], words[2]}; 
     }
     uint4 Load4(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 16 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint4{data[dataIdx], data[dataIdx + 1], data[dataIdx + 2], data[dataIdx + 3]}; 
+        const uint32_t* words = _getWordsAt<4>(index); 
+        return uint4{words[0], words[1], words[2], words[3]}; 
     }
     template<typename T>
     T Load(size_t offset) const
     {
+#if SLANG_PRELUDE_BOUND_CHECK_MODE
+        return *_getBoundCheckedPtr<T>((void*)data, offset, sizeInBytes);
+#else
         SLANG_PRELUDE_ASSERT(offset + sizeof(T) <= sizeInBytes && (offset & (alignof(T)-1)) == 0); 
         return *(T const*)((char*)data + offset);
+#endif
+    }
+
+        /// Get the WORD_COUNT words at the byte `index`
+    template <size_t WORD_COUNT>
+    const uint32_t* _getWordsAt(size_t index) const
+    {
+#if SLANG_PRELUDE_BOUND_CHECK_MODE
+        return _getBoundCheckedPtr<FixedArray<uint32_t, WORD_COUNT>>((void*)data, index, sizeInBytes)->m_data;
+#else
+        SLANG_PRELUDE_ASSERT(index + WORD_COUNT * 4 <= sizeInBytes && (index & 3) == 0); 
+        return data + (index >> 2);
+#endif
     }
     
     const uint32_t* data;
@@ -207,76 +324,92 @@ struct ByteAddressBuffer
 };
 
 // https://docs.microsoft.com/en-us/windows/win32/direct3dhlsl/sm5-object-rwbyteaddressbuffer
-// Missing support for Atomic operations 
+// Atomic operations are implemented by the `Interlocked*` functions, via _getPtrAt
 // Missing support for Load with status
+//
+// With bounds checking enabled, an out of bounds (or misaligned) Load returns 0 and Store is discarded, as on D3D.
 struct RWByteAddressBuffer
 {
     void GetDimensions(uint32_t* outDim) const { *outDim = uint32_t(sizeInBytes); }
     
     uint32_t Load(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 4 <= sizeInBytes && (index & 3) == 0); 
-        return data[index >> 2]; 
+        return *_getWordsAt<1>(index); 
     }
     uint2 Load2(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 8 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint2{data[dataIdx], data[dataIdx + 1]}; 
+        const uint32_t* words = _getWordsAt<2>(index); 
+        return uint2{words[0], words[1]}; 
     }
     uint3 Load3(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 12 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint3{data[dataIdx], data[dataIdx + 1], data[dataIdx + 2]}; 
+        const uint32_t* words = _getWordsAt<3>(index); 
+        return uint3{words[0], words[1], words[2]}; 
     }
     uint4 Load4(size_t index) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 16 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        return uint4{data[dataIdx], data[dataIdx + 1], data[dataIdx + 2], data[dataIdx + 3]}; 
+        const uint32_t* words = _getWordsAt<4>(index); 
+        return uint4{words[0], words[1], words[2], words[3]}; 
     }
     template<typename T>
     T Load(size_t offset) const
     {
-        SLANG_PRELUDE_ASSERT(offset + sizeof(T) <= sizeInBytes && (offset & (alignof(T)-1)) == 0); 
-        return *(T const*)((char*)data + offset);
+        return *_getPtrAt<T>(offset);
     }
 
     void Store(size_t index, uint32_t v) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 4 <= sizeInBytes && (index & 3) == 0); 
-        data[index >> 2] = v; 
+        *_getWordsAt<1>(index) = v; 
     }
     void Store2(size_t index, uint2 v) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 8 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        data[dataIdx + 0] = v.x;
-        data[dataIdx + 1] = v.y;
+        uint32_t* words = _getWordsAt<2>(index); 
+        words[0] = v.x;
+        words[1] = v.y;
     }
     void Store3(size_t index, uint3 v) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 12 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        data[dataIdx + 0] = v.x;
-        data[dataIdx + 1] = v.y;
-        data[dataIdx + 2] = v.z;
+        uint32_t* words = _getWordsAt<3>(index); 
+        words[0] = v.x;
+        words[1] = v.y;
+        words[2] = v.z;
     }
     void Store4(size_t index, uint4 v) const 
     { 
-        SLANG_PRELUDE_ASSERT(index + 16 <= sizeInBytes && (index & 3) == 0); 
-        const size_t dataIdx = index >> 2; 
-        data[dataIdx + 0] = v.x;
-        data[dataIdx + 1] = v.y;
-        data[dataIdx + 2] = v.z;
-        data[dataIdx + 3] = v.w;
+        uint32_t* words = _getWordsAt<4>(index); 
+        words[0] = v.x;
+        words[1] = v.y;
+        words[2] = v.z;
+        words[3] = v.w;
     }
     template<typename T>
     void Store(size_t offset, T const& value) const
     {
+        *_getPtrAt<T>(offset) = value;
+    }
+
+        /// Can be used in stdlib to gain access to the element of type T at offset.
+    template<typename T>
+    T* _getPtrAt(size_t offset) const
+    {
+#if SLANG_PRELUDE_BOUND_CHECK_MODE
+        return _getBoundCheckedPtr<T>(data, offset, sizeInBytes);
+#else
         SLANG_PRELUDE_ASSERT(offset + sizeof(T) <= sizeInBytes && (offset & (alignof(T)-1)) == 0); 
-        *(T*)((char*)data + offset) = value;
+        return (T*)((char*)data + offset);
+#endif
+    }
+
+        /// Get the WORD_COUNT words at the byte `index`
+    template <size_t WORD_COUNT>
+    uint32_t* _getWordsAt(size_t index) const
+    {
+#if SLANG_PRELUDE_BOUND_CHECK_MODE
+        return _getBoundCheckedPtr<FixedArray<uint32_t, WORD_COUNT>>(data, index, sizeInBytes)->m_data;
+#else
+        SLANG_PRELUDE_ASSERT(index + WORD_COUNT * 4 <= sizeInBytes && (index & 3) == 0); 
+        return data + (index >> 2);
+#endif
     }
 
     uint32_t* data;
@@ -441,6 +574,101 @@ struct TextureDimensions
 
 
 
+#if SLANG_PRELUDE_ENABLE_QUAD
+
+/* Derivatives (and so implicit level of detail texture sampling) need the values from the other threads in a 2x2 quad.
+When a kernel uses them the C++ emitter defines SLANG_PRELUDE_ENABLE_QUAD, and the `_Group` function runs the threads
+of each quad in lockstep via a QuadExecutor. Each lane of the quad runs on its own fiber, and when a lane needs the
+values from the other lanes it switches to the next lane until they have all provided their values.
+
+The lane index has the x offset within the quad in bit 0, and the y offset in bit 1. */
+struct QuadContext
+{
+    enum { kLaneCount = 4 };
+
+#if defined(_WIN32)
+    typedef void* Fiber;
+#else
+    typedef ucontext_t Fiber;
+#endif
+
+    struct Lane
+    {
+        Fiber fiber;
+        const void* value;          ///< The value being exchanged by the lane, or nullptr if the lane has finished
+        bool isDone;
+    };
+
+        /// Get the quad the current thread is executing, or nullptr if it isn't running a quad
+    static QuadContext*& getCurrent()
+    {
+        static thread_local QuadContext* s_current = nullptr;
+        return s_current;
+    }
+
+        /// Get `value` from each lane of the quad into `outValues`. Lanes that have finished have the value of the calling lane.
+    template <typename T>
+    void exchange(const T& value, T outValues[kLaneCount])
+    {
+        Lane& lane = lanes[currentLane];
+        lane.value = &value;
+        _sync();
+        for (int i = 0; i < kLaneCount; ++i)
+        {
+            const void* laneValue = lanes[i].value;
+            outValues[i] = laneValue ? *(const T*)laneValue : value;
+        }
+        // The values live on the stacks of the other lanes, so wait until all the lanes have read them
+        _sync();
+        lane.value = nullptr;
+    }
+
+        /// Wait until all of the lanes that haven't finished have reached the same point
+    void _sync()
+    {
+        if (++arrivedCount < liveCount)
+        {
+            _switchToLane(_getNextLiveLane());
+        }
+        else
+        {
+            arrivedCount = 0;
+        }
+    }
+
+    int _getNextLiveLane() const
+    {
+        for (int i = 1; i <= kLaneCount; ++i)
+        {
+            const int laneIndex = (currentLane + i) & (kLaneCount - 1);
+            if (!lanes[laneIndex].isDone)
+            {
+                return laneIndex;
+            }
+        }
+        return currentLane;
+    }
+
+    void _switchToLane(int laneIndex)
+    {
+        Lane& from = lanes[currentLane];
+        currentLane = laneIndex;
+#if defined(_WIN32)
+        (void)from;
+        SwitchToFiber(lanes[laneIndex].fiber);
+#else
+        swapcontext(&from.fiber, &lanes[laneIndex].fiber);
+#endif
+    }
+
+    Lane lanes[kLaneCount];
+    int currentLane;
+    int arrivedCount;                   ///< The number of lanes waiting in `_sync`
+    int liveCount;                      ///< The number of lanes that haven't finished
+};
+
+#endif // SLANG_PRELUDE_ENABLE_QUAD
+
 // Texture
 
 struct ITexture
@@ -451,6 +679,62 @@ struct ITexture
     virtual void SampleLevel(SamplerState samplerState, const float* loc, float level, void* outData, size_t dataSize) = 0;
 };
 
+// Implements `Sample`, which has an implicit level of detail. When executing a quad the level of detail is calculated
+// from the derivatives of the first `baseCoordCount` elements of `loc`, otherwise mip level 0 is sampled.
+SLANG_FORCE_INLINE void _sampleImplicitLevel(ITexture* texture, SamplerState samplerState, const float* loc, int baseCoordCount, bool isCube, void* outData, size_t dataSize)
+{
+#if SLANG_PRELUDE_ENABLE_QUAD
+    if (QuadContext* quad = QuadContext::getCurrent())
+    {
+        const TextureDimensions dims = texture->GetDimensions(0);
+        const float extents[3] = { float(dims.width), float(dims.height), float(dims.depth) };
+
+        // Calculate the location in texels of mip level 0. For a cube map that is the location on the face,
+        // which is the direction scaled by its major axis.
+        float scale = 1.0f;
+        if (isCube)
+        {
+            float majorAxis = 0.0f;
+            for (int i = 0; i < 3; ++i)
+            {
+                const float axis = loc[i] < 0.0f ? -loc[i] : loc[i];
+                majorAxis = axis > majorAxis ? axis : majorAxis;
+            }
+            scale = majorAxis > 0.0f ? 0.5f / majorAxis : 0.0f;
+        }
+        float3 texelLoc = {};
+        float* texelLocs = &texelLoc.x;
+        for (int i = 0; i < baseCoordCount; ++i)
+        {
+            texelLocs[i] = loc[i] * scale * extents[i];
+        }
+
+        float3 quadLocs[QuadContext::kLaneCount];
+        quad->exchange(texelLoc, quadLocs);
+
+        // Use the coarse derivatives, so all lanes sample the same level
+        float lengthX2 = 0.0f, lengthY2 = 0.0f;
+        for (int i = 0; i < baseCoordCount; ++i)
+        {
+            const float dx = (&quadLocs[1].x)[i] - (&quadLocs[0].x)[i];
+            const float dy = (&quadLocs[2].x)[i] - (&quadLocs[0].x)[i];
+            lengthX2 += dx * dx;
+            lengthY2 += dy * dy;
+        }
+        const float maxLength2 = lengthX2 > lengthY2 ? lengthX2 : lengthY2;
+
+        // log2(sqrt(x)) = 0.5 * log2(x)
+        const float level = 0.5f * ::log2f(maxLength2);
+        texture->SampleLevel(samplerState, loc, level, outData, dataSize);
+        return;
+    }
+#else
+    (void)baseCoordCount;
+    (void)isCube;
+#endif
+    texture->Sample(samplerState, loc, outData, dataSize);
+}
+
 template <typename T>
 struct Texture1D
 {
@@ -471,7 +755,7 @@ struct Texture1D
     }
     
     T Load(const int2& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
-    T Sample(SamplerState samplerState, float loc) const { T out; texture->Sample(samplerState, &loc, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, float loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc, 1, false, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, float loc, float level) { T out; texture->SampleLevel(samplerState, &loc, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -508,7 +792,7 @@ struct Texture2D
     }
     
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
-    T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float2& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 2, false, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -549,7 +833,7 @@ struct Texture3D
     }
     
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
-    T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float3& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 3, false, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -585,7 +869,7 @@ struct TextureCube
         *outNumberOfLevels = dims.numberOfLevels;
     }
     
-    T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float3& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 3, true, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -612,7 +896,7 @@ struct Texture1DArray
     }
     
     T Load(const int3& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
-    T Sample(SamplerState samplerState, const float2& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float2& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 1, false, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float2& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -654,7 +938,7 @@ struct Texture2DArray
     }
     
     T Load(const int4& loc) const { T out; texture->Load(&loc.x, &out, sizeof(out)); return out; }
-    T Sample(SamplerState samplerState, const float3& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float3& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 2, false, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float3& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -695,7 +979,7 @@ struct TextureCubeArray
         *outNumberOfLevels = dims.numberOfLevels;
     }
     
-    T Sample(SamplerState samplerState, const float4& loc) const { T out; texture->Sample(samplerState, &loc.x, &out, sizeof(out)); return out; }
+    T Sample(SamplerState samplerState, const float4& loc) const { T out; _sampleImplicitLevel(texture, samplerState, &loc.x, 3, true, &out, sizeof(out)); return out; }
     T SampleLevel(SamplerState samplerState, const float4& loc, float level) { T out; texture->SampleLevel(samplerState, &loc.x, level, &out, sizeof(out)); return out; }
     
     ITexture* texture;              
@@ -1032,6 +1316,240 @@ struct ComputeVaryingInput
 typedef void(*ComputeThreadFunc)(ComputeThreadVaryingInput* varyingInput, void* uniformEntryPointParams, void* uniformState);
 typedef void(*ComputeFunc)(ComputeVaryingInput* varyingInput, void* uniformEntryPointParams, void* uniformState);
 
+/* Describes a compute entry point held in a shared library. When multiple entry points (or multiple specializations
+of an entry point) are compiled into a single library, all of them can be enumerated through the exported function
+named slang_getComputeEntryPointTable, which has the signature GetComputeEntryPointTableFunc. */
+struct ComputeEntryPointInfo
+{
+    const char* name;                   ///< The exported name of the entry point
+    ComputeFunc func;                   ///< Executes a range of groups
+    ComputeFunc groupFunc;              ///< Executes a single group (at startGroupID)
+    ComputeThreadFunc threadFunc;       ///< Executes a single thread
+    uint32_t threadGroupSize[3];        ///< The [numthreads] of the entry point
+};
+
+typedef const ComputeEntryPointInfo*(*GetComputeEntryPointTableFunc)(int* outCount);
+
+#if SLANG_PRELUDE_ENABLE_QUAD
+
+#ifndef SLANG_PRELUDE_QUAD_STACK_SIZE
+#   define SLANG_PRELUDE_QUAD_STACK_SIZE (256 * 1024)
+#endif
+
+/* Holds the stacks the lanes of quads run on (on Windows the fibers, which own their stacks), so they are reused by
+each thread group rather than allocated for it. Executors running on different threads take stacks from the pool
+at the same time, so the slots are accessed atomically. */
+struct QuadStackPool
+{
+    enum { kSlotCount = 4 * QuadContext::kLaneCount };
+
+    typedef void* (*CreateFunc)();
+
+        /// Take a stack from the pool, creating one with `createFunc` if it's empty
+    void* take(CreateFunc createFunc)
+    {
+        for (int i = 0; i < kSlotCount; ++i)
+        {
+#if defined(_WIN32)
+            void* stack = InterlockedExchangePointer(&slots[i], nullptr);
+#else
+            void* stack = __atomic_exchange_n(&slots[i], nullptr, __ATOMIC_ACQ_REL);
+#endif
+            if (stack)
+            {
+                return stack;
+            }
+        }
+        return createFunc();
+    }
+
+        /// Give back a stack taken from the pool. If the pool is full it's destroyed.
+    void give(void* stack)
+    {
+        for (int i = 0; i < kSlotCount; ++i)
+        {
+#if defined(_WIN32)
+            if (InterlockedCompareExchangePointer(&slots[i], stack, nullptr) == nullptr)
+#else
+            void* expected = nullptr;
+            if (__atomic_compare_exchange_n(&slots[i], &expected, stack, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+#endif
+            {
+                return;
+            }
+        }
+        _destroy(stack);
+    }
+
+    ~QuadStackPool()
+    {
+        for (int i = 0; i < kSlotCount; ++i)
+        {
+            if (slots[i])
+            {
+                _destroy(slots[i]);
+            }
+        }
+    }
+
+    static void _destroy(void* stack)
+    {
+#if defined(_WIN32)
+        DeleteFiber(stack);
+#else
+        free(stack);
+#endif
+    }
+
+    void* volatile slots[kSlotCount];
+};
+
+// The pool is freed when the library holding the kernel is unloaded. It isn't thread_local, as a thread_local with
+// a destructor stops the library from being unloaded until the thread exits.
+static QuadStackPool g_quadStackPool;
+
+/* Runs the threads of a thread group a 2x2 quad at a time, with the lanes of each quad in lockstep (see QuadContext).
+A QuadExecutor is created for each thread group, and runs each of its quads in turn. */
+struct QuadExecutor : QuadContext
+{
+    typedef void(*ThreadFunc)(void* varyingInput, void* uniformEntryPointParams, void* uniformState);
+
+    QuadExecutor(ThreadFunc inFunc, void* inUniformEntryPointParams, void* inUniformState)
+        : func(inFunc)
+        , uniformEntryPointParams(inUniformEntryPointParams)
+        , uniformState(inUniformState)
+    {
+#if defined(_WIN32)
+        isConvertedThread = !IsThreadAFiber();
+        scheduler = isConvertedThread ? ConvertThreadToFiber(nullptr) : GetCurrentFiber();
+        for (int i = 0; i < kLaneCount; ++i)
+        {
+            lanes[i].fiber = g_quadStackPool.take(&_createStack);
+        }
+#else
+        for (int i = 0; i < kLaneCount; ++i)
+        {
+            stacks[i] = g_quadStackPool.take(&_createStack);
+        }
+#endif
+    }
+
+    ~QuadExecutor()
+    {
+        for (int i = 0; i < kLaneCount; ++i)
+        {
+#if defined(_WIN32)
+            g_quadStackPool.give(lanes[i].fiber);
+#else
+            g_quadStackPool.give(stacks[i]);
+#endif
+        }
+#if defined(_WIN32)
+        if (isConvertedThread)
+        {
+            ConvertFiberToThread();
+        }
+#endif
+    }
+
+    static void* _createStack()
+    {
+#if defined(_WIN32)
+        // The fibers outlive any one executor, so they find the executor via getCurrent
+        return CreateFiber(SLANG_PRELUDE_QUAD_STACK_SIZE, &_fiberEntry, nullptr);
+#else
+        return malloc(SLANG_PRELUDE_QUAD_STACK_SIZE);
+#endif
+    }
+
+        /// Run the quad whose top left thread is `quadInput`
+    void run(const ComputeThreadVaryingInput& quadInput)
+    {
+        input = quadInput;
+        arrivedCount = 0;
+        liveCount = kLaneCount;
+        for (int i = 0; i < kLaneCount; ++i)
+        {
+            Lane& lane = lanes[i];
+            lane.value = nullptr;
+            lane.isDone = false;
+#if !defined(_WIN32)
+            getcontext(&lane.fiber);
+            lane.fiber.uc_stack.ss_sp = stacks[i];
+            lane.fiber.uc_stack.ss_size = SLANG_PRELUDE_QUAD_STACK_SIZE;
+            lane.fiber.uc_link = &scheduler;
+            makecontext(&lane.fiber, &_contextEntry, 0);
+#endif
+        }
+
+        QuadContext*& current = getCurrent();
+        QuadContext* previous = current;
+        current = this;
+
+        currentLane = 0;
+        while (liveCount > 0)
+        {
+            // Returns when the lane at `currentLane` has finished
+#if defined(_WIN32)
+            SwitchToFiber(lanes[currentLane].fiber);
+#else
+            swapcontext(&scheduler, &lanes[currentLane].fiber);
+#endif
+            lanes[currentLane].isDone = true;
+            liveCount--;
+            // The lanes that are left may now all be waiting
+            if (arrivedCount >= liveCount)
+            {
+                arrivedCount = 0;
+            }
+            currentLane = _getNextLiveLane();
+        }
+
+        current = previous;
+    }
+
+    void _runLane()
+    {
+        ComputeThreadVaryingInput laneInput = input;
+        laneInput.groupThreadID.x += currentLane & 1;
+        laneInput.groupThreadID.y += currentLane >> 1;
+        func(&laneInput, uniformEntryPointParams, uniformState);
+    }
+
+#if defined(_WIN32)
+    static void WINAPI _fiberEntry(void* param)
+    {
+        (void)param;
+        for (;;)
+        {
+            // The fiber is reused by later executors on this thread, so the executor is looked up for each quad
+            QuadExecutor* executor = static_cast<QuadExecutor*>(getCurrent());
+            executor->_runLane();
+            SwitchToFiber(executor->scheduler);
+        }
+    }
+
+    void* scheduler;
+    bool isConvertedThread;
+#else
+    static void _contextEntry()
+    {
+        // When this returns the context continues with `scheduler`, via uc_link
+        static_cast<QuadExecutor*>(getCurrent())->_runLane();
+    }
+
+    ucontext_t scheduler;
+    void* stacks[kLaneCount];           ///< Taken from g_quadStackPool
+#endif
+
+    ThreadFunc func;
+    void* uniformEntryPointParams;
+    void* uniformState;
+    ComputeThreadVaryingInput input;
+};
+
+#endif // SLANG_PRELUDE_ENABLE_QUAD
+
 template<typename TResult, typename TInput>
 TResult slang_bit_cast(TInput val)
 {
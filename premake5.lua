@@ -753,6 +753,11 @@ tool "slang-test"
     includedirs { "." }
     links { "core", "compiler-core", "slang", "miniz", "lz4" }
     
+    -- Unit tests use std::thread
+    if not isTargetWindows then
+        links { "pthread" }
+    end
+    
     -- We want to set to the root of the project, but that doesn't seem to work with '.'. 
     -- So set a path that resolves to the same place.
     
@@ -1185,6 +1190,11 @@ standardProject("slang", "source/slang")
     flags { "FatalWarnings" }
     pic "On"
 
+    -- Emitting functions with -emit-threads uses std::thread
+    if not isTargetWindows then
+        links { "pthread" }
+    end
+
     -- The way that we currently configure things through `slang.h`,
     -- we need to set a preprocessor definitions to ensure that
     -- we declare the Slang API functions for *export* and not *import*.
@@ -560,6 +560,15 @@ extern "C"
         SLANG_PASS_THROUGH_COUNT_OF,
     };
 
+    /* Defines where temporary files used by file based downstream compilers (such as C/C++ compilers invoked 
+    via the command line) are staged. */
+    typedef int SlangDownstreamStagingIntegral;
+    enum SlangDownstreamStaging : SlangDownstreamStagingIntegral
+    {
+        SLANG_DOWNSTREAM_STAGING_DEFAULT,           ///< Use the temporary directory of the file system
+        SLANG_DOWNSTREAM_STAGING_MEMORY,            ///< Where supported hold temporary files in memory (such as tmpfs/memfd on linux), else falls back to default 
+    };
+
     /* Defines an archive type used to holds a 'file system' type structure. */
     typedef int SlangArchiveTypeIntegral;
     enum SlangArchiveType : SlangArchiveTypeIntegral
@@ -587,6 +596,11 @@ extern "C"
         /* Obfuscate shader names on release products */
         SLANG_COMPILE_FLAG_OBFUSCATE = 1 << 5,
 
+        /* Only check (and generate code for) the bodies of global functions that are reachable
+        from the entry points. Requires entry points to be specified explicitly, and errors in
+        the bodies of unreachable functions are not reported. */
+        SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING = 1 << 6,
+
         /* Deprecated flags: kept around to allow existing applications to
         compile. Note that the relevant features will still be left in
         their default state. */
@@ -830,6 +844,8 @@ extern "C"
 #define SLANG_E_INTERNAL_FAIL               SLANG_MAKE_CORE_ERROR(6)
     //! Could not complete because some underlying feature (hardware or software) was not available 
 #define SLANG_E_NOT_AVAILABLE               SLANG_MAKE_CORE_ERROR(7)
+    //! Could not complete in the time allowed 
+#define SLANG_E_TIME_OUT                    SLANG_MAKE_CORE_ERROR(8)
 
     /** A "Universally Unique Identifier" (UUID)
 
@@ -1546,6 +1562,11 @@ extern "C"
         SlangCompileRequest*    request,
         ISlangBlob**            outBlob);
 
+    /*! @see slang::ICompileRequest::getMemoryReport */
+    SLANG_API SlangResult spGetMemoryReport(
+        SlangCompileRequest*    request,
+        ISlangBlob**            outReport);
+
 
     /*! @see slang::ICompileRequest::getDependencyFileCount */
     SLANG_API int
@@ -3239,6 +3260,35 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(
             char const*     name) = 0;
+
+            /** Set where temporary files used by file based downstream compilers are staged.
+            @param staging The staging to use
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerStaging(
+            SlangDownstreamStaging staging) = 0;
+
+            /** Get where temporary files used by file based downstream compilers are staged. */
+        virtual SLANG_NO_THROW SlangDownstreamStaging SLANG_MCALL getDownstreamCompilerStaging() = 0;
+
+            /** Create a new global session that shares the standard library of this one.
+
+            The new session references the stdlib modules (their AST, IR and source) held by this
+            session instead of loading or compiling its own copy, so it is much cheaper to create and
+            takes little extra memory. Everything else, such as downstream compilers, preludes, names
+            created by compiling user code, and sessions created from it, is separate. Settings
+            (preludes, downstream compiler paths, the shared library loader etc) start as copies of
+            this session's.
+
+            This session must have a stdlib loaded. Once shared, neither this session nor any session
+            sharing with it can add to or reload the stdlib (`addBuiltins`, `compileStdLib`, `loadStdLib`).
+
+            NOTE! Sessions sharing a stdlib share reference counted objects, and so must not be used
+            concurrently from multiple threads.
+
+            @param outGlobalSession The new global session
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL createGlobalSessionSharingStdLib(
+            IGlobalSession** outGlobalSession) = 0;
     };
 
     #define SLANG_UUID_IGlobalSession IGlobalSession::getTypeGuid()
@@ -3796,6 +3846,18 @@ namespace slang
         virtual SLANG_NO_THROW void SLANG_MCALL setTargetLineDirectiveMode(
             SlangInt targetIndex,
             SlangLineDirectiveMode mode) = 0;
+
+            /** Get a report of the memory held by the compile request.
+
+            The report is human readable text, giving the number of bytes held by each
+            part of the compiler (AST, IR, source files, names, type layouts) for the
+            session, the linkage and each module, along with the peak amount of IR held
+            during back-end compilation.
+
+            @param outReport A pointer to receive a blob holding the report as a nul-terminated UTF-8 string.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryReport(
+            ISlangBlob** outReport) = 0;
     };
 
     #define SLANG_UUID_ICompileRequest ICompileRequest::getTypeGuid()
@@ -4020,6 +4082,13 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) = 0;
+
+            /** Get a report of the memory held by the session, and the global session it belongs to.
+
+            @see slang::ICompileRequest::getMemoryReport
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryReport(
+            ISlangBlob** outReport) = 0;
     };
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
@@ -4194,6 +4263,55 @@ namespace slang
     };
     #define SLANG_UUID_IComponentType IComponentType::getTypeGuid()
 
+        /** Whole-program access to the compiled code of a component type.
+
+        Obtained from an `IComponentType` via `queryInterface`. This is a separate
+        interface (rather than additional methods on `IComponentType`) so that the
+        layout of the `IComponentType`, `IEntryPoint` and `IModule` vtables is
+        unchanged.
+        */
+    struct IComponentType2 : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(0x9c2a7d1e, 0x51b3, 0x4f0c, { 0x8e, 0x27, 0x3a, 0x6d, 0xc4, 0x90, 0x1b, 0x5f })
+
+            /** Get the compiled code for all of the entry points in this component type, for the chosen `targetIndex`.
+
+            All of the entry points are output together, into a single blob. For C/C++ based targets
+            this means a single source file (or binary) holding all of the entry points, including
+            multiple specializations of the same entry point.
+
+            @param targetIndex      The index of the target to get code for.
+            @param outCode          The compiled code.
+            @param outDiagnostics   (Optional) Diagnostics produced during compilation.
+            @returns                A `SlangResult` to indicate success or failure.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
+            SlangInt                targetIndex,
+            IBlob**                 outCode,
+            IBlob**                 outDiagnostics = nullptr) = 0;
+
+            /** Get 'callable' functions for all of the entry points in this component type, accessible through a single ISlangSharedLibrary.
+
+            All the entry points are compiled together by a single invocation of the downstream
+            compiler, and loaded as a single library. Entry points with the same name (such as
+            different specializations of a single entry point) are given unique names by adding
+            a numeric suffix. The compute entry points held in the library can be enumerated
+            via the exported `slang_getComputeEntryPointTable` function (see the C++ prelude).
+
+            NOTE! Requires a compilation target of SLANG_HOST_CALLABLE.
+
+            @param targetIndex      The index of the target to get code for.
+            @param outSharedLibrary A pointer to a ISharedLibrary interface which functions can be queried on.
+            @param outDiagnostics   (Optional) Diagnostics produced during compilation.
+            @returns                A `SlangResult` to indicate success or failure.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            int                     targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics = 0) = 0;
+    };
+    #define SLANG_UUID_IComponentType2 IComponentType2::getTypeGuid()
+
     struct IEntryPoint : public IComponentType
     {
         SLANG_COM_INTERFACE(0x8f241361, 0xf5bd, 0x4ca0, { 0xa3, 0xac, 0x2, 0xf7, 0xfa, 0x24, 0x2, 0xb8 })
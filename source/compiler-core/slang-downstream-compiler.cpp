@@ -176,6 +176,16 @@ SlangResult DownstreamCompiler::disassemble(SlangCompileTarget sourceBlobTarget,
     return SLANG_E_NOT_AVAILABLE;
 }
 
+SlangResult DownstreamCompiler::validate(SlangCompileTarget blobTarget, const void* blob, size_t blobSize, ISlangBlob** outDiagnostics)
+{
+    SLANG_UNUSED(blobTarget);
+    SLANG_UNUSED(blob);
+    SLANG_UNUSED(blobSize);
+    SLANG_UNUSED(outDiagnostics);
+
+    return SLANG_E_NOT_AVAILABLE;
+}
+
 
 /* static */bool DownstreamCompiler::canCompile(SlangPassThrough compiler, SlangSourceLanguage sourceLanguage)
 {
@@ -355,6 +365,17 @@ SlangResult CommandLineDownstreamCompileResult::getHostCallableSharedLibrary(Com
         return SLANG_OK;
     }
 
+    if (m_memoryFile)
+    {
+        // Load directly from memory, so the library doesn't need to be mapped from the file system
+        RefPtr<MemorySharedLibrary> sharedLib;
+        SLANG_RETURN_ON_FAIL(MemorySharedLibrary::load(m_memoryFile, sharedLib));
+
+        m_hostCallableSharedLibrary = sharedLib;
+        outLibrary = m_hostCallableSharedLibrary;
+        return SLANG_OK;
+    }
+
     // Okay we want to load
     // Try loading the shared library
     SharedLibrary::Handle handle;
@@ -383,7 +404,7 @@ SlangResult CommandLineDownstreamCompileResult::getBinary(ComPtr<ISlangBlob>& ou
     try
     {
         // Read the contents of the binary
-        List<uint8_t> contents = File::readAllBytes(m_moduleFilePath);
+        List<uint8_t> contents = File::readAllBytes(m_memoryFile ? m_memoryFile->getPath() : m_moduleFilePath);
 
         m_binaryBlob = new ScopeRefObjectBlob(ListBlob::moveCreate(contents), m_temporaryFiles);
         outBlob = m_binaryBlob;
@@ -438,6 +459,9 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
 
     // Find all the files that will be produced
     RefPtr<TemporaryFileSet> productFileSet(new TemporaryFileSet);
+
+    // Contents written to the standard input of the compiler
+    String stdinContents;
     
     if (options.modulePath.getLength() == 0 || options.sourceContents.getLength() != 0)
     {
@@ -446,14 +470,39 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
         // If there is no module path, generate one.
         if (modulePath.getLength() == 0)
         {
-            SLANG_RETURN_ON_FAIL(File::generateTemporary(UnownedStringSlice::fromLiteral("slang-generated"), modulePath));
+            const auto prefix = UnownedStringSlice::fromLiteral("slang-generated");
+
+            String memoryDirectory;
+            if (options.stagingMode == StagingMode::Memory && 
+                SLANG_SUCCEEDED(File::getMemoryTemporaryDirectory(memoryDirectory)))
+            {
+                // If can't create in memory, we'll fall back to the default temporary directory 
+                if (SLANG_FAILED(File::generateTemporaryInDirectory(memoryDirectory, prefix, modulePath)))
+                {
+                    modulePath = String();
+                }
+            }
+
+            if (modulePath.getLength() == 0)
+            {
+                SLANG_RETURN_ON_FAIL(File::generateTemporary(prefix, modulePath));
+            }
             options.modulePath = modulePath;
+
+            // Generating the name creates the file, so make sure it's cleaned up
+            productFileSet->add(modulePath);
         }
 
         if (_isContentsInFile(options))
         {
             options.sourceFiles.add(options.sourceContentsPath);
         }
+        else if (canCompileSourceFromStdIn(options))
+        {
+            // Pipe the source to the compiler, avoiding writing (and later removing) a temporary file
+            stdinContents = options.sourceContents;
+            options.sourceFiles.add("-");
+        }
         else
         {
             String compileSourcePath = modulePath;
@@ -492,6 +541,17 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
         options.sourceContentsPath = String();
     }
 
+    // If staging in memory, have the compiler write a shared library directly into a memory file, from where it can
+    // be loaded (or read) without a copy. If a memory file isn't available, the library is written to the module path.
+    RefPtr<MemoryFile> memoryFile;
+    if (options.stagingMode == StagingMode::Memory &&
+        options.targetType == SLANG_SHARED_LIBRARY &&
+        options.moduleFilePathOverride.getLength() == 0 &&
+        SLANG_SUCCEEDED(MemoryFile::create("slang-generated", memoryFile)))
+    {
+        options.moduleFilePathOverride = memoryFile->getPath();
+    }
+
     // Append command line args to the end of cmdLine using the target specific function for the specified options
     SLANG_RETURN_ON_FAIL(calcArgs(options, cmdLine));
 
@@ -519,7 +579,7 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     }
 #endif
 
-    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, stdinContents, exeRes));
 
 #if 0
     {
@@ -531,7 +591,13 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     SLANG_RETURN_ON_FAIL(parseOutput(exeRes, diagnostics));
 
     
-    out = new CommandLineDownstreamCompileResult(diagnostics, moduleFilePath, productFileSet);
+    // If nothing was written to the memory file (for example because compilation failed), there is nothing to load from it
+    if (memoryFile && memoryFile->getSize() == 0)
+    {
+        memoryFile.setNull();
+    }
+
+    out = new CommandLineDownstreamCompileResult(diagnostics, moduleFilePath, productFileSet, memoryFile);
     
     return SLANG_OK;
 }
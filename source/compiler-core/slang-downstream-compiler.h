@@ -10,6 +10,7 @@
 #include "../core/slang-semantic-version.h"
 
 #include "../core/slang-io.h"
+#include "../core/slang-shared-library.h"
 
 #include "../../slang-com-ptr.h"
 
@@ -230,6 +231,12 @@ public:
         Precise,
     };
 
+    enum class StagingMode
+    {
+        Default,        ///< Temporary files (such as source and products) are placed in the temporary directory of the file system
+        Memory,         ///< Where supported temporary files are held in memory, else falls back to Default
+    };
+
     enum PipelineType
     {
         Unknown,
@@ -275,6 +282,7 @@ public:
         SlangSourceLanguage sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
         FloatingPointMode floatingPointMode = FloatingPointMode::Default;
         PipelineType pipelineType = PipelineType::Unknown;
+        StagingMode stagingMode = StagingMode::Default;
         SlangMatrixLayoutMode matrixLayout = SLANG_MATRIX_LAYOUT_MODE_UNKNOWN;
 
         Flags flags = Flag::EnableExceptionHandling;
@@ -285,6 +293,10 @@ public:
             /// If not set a module path will be internally generated internally on a command line based compiler
         String modulePath;                  
 
+            /// If set, the module file is written to this path, instead of the one derived from modulePath.
+            /// Used to have the compiler write its product directly into memory (see StagingMode::Memory).
+        String moduleFilePathOverride;
+
         List<Define> defines;
 
             /// The contents of the source to compile. This can be empty is sourceFiles is set.
@@ -348,6 +360,8 @@ public:
     virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) = 0;
         /// Some compilers have support converting a binary blob into disassembly. Output disassembly is held in the output blob
     virtual SlangResult disassemble(SlangCompileTarget sourceBlobTarget, const void* blob, size_t blobSize, ISlangBlob** out);
+        /// Some compilers can validate a binary blob. Returns SLANG_OK if it is valid, otherwise a failure with any problems found in outDiagnostics
+    virtual SlangResult validate(SlangCompileTarget blobTarget, const void* blob, size_t blobSize, ISlangBlob** outDiagnostics);
 
         /// True if underlying compiler uses file system to communicate source
     virtual bool isFileBased() = 0;
@@ -379,10 +393,11 @@ public:
     virtual SlangResult getHostCallableSharedLibrary(ComPtr<ISlangSharedLibrary>& outLibrary) SLANG_OVERRIDE;
     virtual SlangResult getBinary(ComPtr<ISlangBlob>& outBlob) SLANG_OVERRIDE;
 
-    CommandLineDownstreamCompileResult(const DownstreamDiagnostics& diagnostics, const String& moduleFilePath, TemporaryFileSet* temporaryFileSet) :
+    CommandLineDownstreamCompileResult(const DownstreamDiagnostics& diagnostics, const String& moduleFilePath, TemporaryFileSet* temporaryFileSet, MemoryFile* memoryFile = nullptr) :
         Super(diagnostics),
         m_moduleFilePath(moduleFilePath),
-        m_temporaryFiles(temporaryFileSet)
+        m_temporaryFiles(temporaryFileSet),
+        m_memoryFile(memoryFile)
     {
     }
     
@@ -390,6 +405,9 @@ public:
 
 protected:
 
+        /// If set, the module was written directly to this file held in memory, rather than to m_moduleFilePath
+    RefPtr<MemoryFile> m_memoryFile;
+
     String m_moduleFilePath;
     DownstreamCompiler::CompileOptions m_options;
     ComPtr<ISlangBlob> m_binaryBlob;
@@ -417,6 +435,9 @@ public:
 
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) = 0;
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) = 0;
+        /// True if the compiler can read the source contents from its standard input (specified as the source file "-"),
+        /// such that a temporary source file doesn't need to be written.
+    virtual bool canCompileSourceFromStdIn(const CompileOptions& options) { SLANG_UNUSED(options); return false; }
 
     CommandLineDownstreamCompiler(const Desc& desc, const String& exeName) :
         Super(desc)
@@ -484,6 +505,7 @@ struct DownstreamCompilerBaseUtil
     typedef DownstreamDiagnostics::Diagnostic Diagnostic;
 
     typedef DownstreamCompiler::FloatingPointMode FloatingPointMode;
+    typedef DownstreamCompiler::StagingMode StagingMode;
     typedef DownstreamCompiler::ProductFlag ProductFlag;
     typedef DownstreamCompiler::ProductFlags ProductFlags;
 };
@@ -484,6 +484,12 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         cmdLine.addArg("-v");
     }
 
+    if (options.stagingMode == StagingMode::Memory)
+    {
+        // Use pipes rather than temporary files between the stages of compilation
+        cmdLine.addArg("-pipe");
+    }
+
     switch (options.floatingPointMode)
     {
         case FloatingPointMode::Default: break;
@@ -502,7 +508,14 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
     }
 
     StringBuilder moduleFilePath;
-    calcModuleFilePath(options, moduleFilePath);
+    if (options.moduleFilePathOverride.getLength())
+    {
+        moduleFilePath << options.moduleFilePathOverride;
+    }
+    else
+    {
+        calcModuleFilePath(options, moduleFilePath);
+    }
 
     cmdLine.addArg("-o");
     cmdLine.addArg(moduleFilePath);
@@ -578,7 +591,20 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
     // Files to compile
     for (const auto& sourceFile : options.sourceFiles)
     {
-        cmdLine.addArg(sourceFile);
+        if (sourceFile == "-")
+        {
+            // Source is read from stdin, so the language can't be inferred from the extension
+            cmdLine.addArg("-x");
+            cmdLine.addArg((options.sourceLanguage == SLANG_SOURCE_LANGUAGE_C) ? "c" : "c++");
+            cmdLine.addArg(sourceFile);
+            // Subsequent inputs have their language inferred as usual
+            cmdLine.addArg("-x");
+            cmdLine.addArg("none");
+        }
+        else
+        {
+            cmdLine.addArg(sourceFile);
+        }
     }
 
     for (const auto& libPath : options.libraryPaths)
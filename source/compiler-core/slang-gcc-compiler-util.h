@@ -47,6 +47,7 @@ public:
     virtual SlangResult parseOutput(const ExecuteResult& exeResult, DownstreamDiagnostics& output) SLANG_OVERRIDE { return Util::parseOutput(exeResult, output); }
     virtual SlangResult calcModuleFilePath(const CompileOptions& options, StringBuilder& outPath) SLANG_OVERRIDE { return Util::calcModuleFilePath(options, outPath); }
     virtual SlangResult calcCompileProducts(const CompileOptions& options, ProductFlags flags,  List<String>& outPaths) SLANG_OVERRIDE { return Util::calcCompileProducts(options, flags, outPaths); }
+    virtual bool canCompileSourceFromStdIn(const CompileOptions& options) SLANG_OVERRIDE { SLANG_UNUSED(options); return true; }
 
     GCCDownstreamCompiler(const Desc& desc):Super(desc) {}
 };
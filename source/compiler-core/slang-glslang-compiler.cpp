@@ -42,6 +42,7 @@ public:
     // DownstreamCompiler
     virtual SlangResult compile(const CompileOptions& options, RefPtr<DownstreamCompileResult>& outResult) SLANG_OVERRIDE;
     virtual SlangResult disassemble(SlangCompileTarget sourceBlobTarget, const void* blob, size_t blobSize, ISlangBlob** out) SLANG_OVERRIDE;
+    virtual SlangResult validate(SlangCompileTarget blobTarget, const void* blob, size_t blobSize, ISlangBlob** outDiagnostics) SLANG_OVERRIDE;
     virtual bool isFileBased() SLANG_OVERRIDE { return false; }
 
         /// Must be called before use
@@ -248,6 +249,49 @@ SlangResult GlslangDownstreamCompiler::disassemble(SlangCompileTarget sourceBlob
     return SLANG_OK;
 }
 
+SlangResult GlslangDownstreamCompiler::validate(SlangCompileTarget blobTarget, const void* blob, size_t blobSize, ISlangBlob** outDiagnostics)
+{
+    if (blobTarget != SLANG_SPIRV)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder diagnostics;
+
+    auto diagnosticFunc = [](void const* data, size_t size, void* userData)
+    {
+        (*(StringBuilder*)userData).append((char const*)data, (char const*)data + size);
+    };
+
+    glslang_CompileRequest_1_1 request;
+    memset(&request, 0, sizeof(request));
+    request.sizeInBytes = sizeof(request);
+
+    request.action = GLSLANG_ACTION_VALIDATE_SPIRV;
+
+    request.inputBegin = blob;
+    request.inputEnd = (const char*)blob + blobSize;
+
+    request.diagnosticFunc = diagnosticFunc;
+    request.diagnosticUserData = &diagnostics;
+
+    if (SLANG_SUCCEEDED(_invoke(request)))
+    {
+        return SLANG_OK;
+    }
+
+    // Validation always reports why it failed, so a failure without diagnostics is from
+    // a version of the library that doesn't support validation
+    if (diagnostics.getLength() == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    ComPtr<ISlangBlob> diagnosticsBlob = StringUtil::createStringBlob(diagnostics);
+    *outDiagnostics = diagnosticsBlob.detach();
+    return SLANG_FAIL;
+}
+
 /* static */SlangResult GlslangDownstreamCompilerUtil::locateCompilers(const String& path, ISlangSharedLibraryLoader* loader, DownstreamCompilerSet* set)
 {
     ComPtr<ISlangSharedLibrary> library;
@@ -19,13 +19,65 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
+Name* RootNamePool::findName(String const& text) const
+{
+    if (auto name = names.TryGetValue(text))
+        return *name;
+    for (SharedNames* shared = sharedNames; shared; shared = shared->parent)
+    {
+        if (auto name = shared->names.TryGetValue(text))
+            return *name;
+    }
+    return nullptr;
+}
+
+static size_t _calcNamesMemoryUsed(const Dictionary<String, RefPtr<Name>>& names)
+{
+    size_t total = 0;
+    for (const auto& pair : names)
+    {
+        // The key and the name share the text
+        total += sizeof(pair) + sizeof(Name) + pair.Key.getLength() + 1;
+    }
+    return total;
+}
+
+size_t RootNamePool::calcTotalMemoryUsed(bool includeShared) const
+{
+    size_t total = _calcNamesMemoryUsed(names);
+    if (includeShared)
+    {
+        for (SharedNames* shared = sharedNames; shared; shared = shared->parent)
+        {
+            total += _calcNamesMemoryUsed(shared->names);
+        }
+    }
+    return total;
+}
+
+void RootNamePool::shareWith(RootNamePool& other)
+{
+    SLANG_ASSERT(other.names.Count() == 0 && other.sharedNames == nullptr);
+
+    if (names.Count())
+    {
+        RefPtr<SharedNames> shared = new SharedNames;
+        shared->names = _Move(names);
+        shared->parent = sharedNames;
+
+        names = Dictionary<String, RefPtr<Name> >();
+        sharedNames = shared;
+    }
+
+    other.sharedNames = sharedNames;
+}
+
 Name* NamePool::getName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
+    if (Name* name = rootPool->findName(text))
         return name;
 
-    name = new Name();
+    RefPtr<Name> name = new Name();
     name->text = text;
     rootPool->names.Add(text, name);
     return name;
@@ -33,10 +85,7 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
-    return nullptr;
+    return rootPool->findName(text);
 }
 
 } // namespace Slang
@@ -47,10 +47,37 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// A root pool can share the names it has created so far with other root pools
+// (see `shareWith`). Shared names are frozen: they are found by lookups on any of the
+// pools, but new names are only ever added to the pool that creates them.
+//
 struct RootNamePool
 {
+        /// A set of names that will no longer be added to, and so can be referenced by multiple pools
+    class SharedNames : public RefObject
+    {
+    public:
+        Dictionary<String, RefPtr<Name> > names;
+            /// Names frozen before these ones (or nullptr)
+        RefPtr<SharedNames> parent;
+    };
+
+        /// Find the name for `text` (shared or not). Returns nullptr if there isn't one.
+    Name* findName(String const& text) const;
+
+        /// Freeze all the names created so far and make them available to `other`.
+        /// `other` must not have any names yet.
+    void shareWith(RootNamePool& other);
+
+        /// Estimate of the memory used by the names in bytes.
+        /// Names shared with this pool (by it, or with it) are only included if `includeShared` is true.
+    size_t calcTotalMemoryUsed(bool includeShared) const;
+
     // The mapping from text strings to the corresponding name.
     Dictionary<String, RefPtr<Name> > names;
+
+    // Frozen names that may be shared with other root pools
+    RefPtr<SharedNames> sharedNames;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -652,6 +652,17 @@ SourceFile* SourceManager::findSourceFileByContent(const char* text) const
     return nullptr;
 }
 
+size_t SourceManager::calcTotalMemoryUsed() const
+{
+    size_t total = m_memoryArena.calcTotalMemoryUsed() + m_slicePool.calcTotalMemoryUsed();
+    for (auto sourceFile : m_sourceFiles)
+    {
+        total += sizeof(SourceFile) + sourceFile->getContentSize();
+    }
+    total += size_t(m_sourceViews.getCount()) * sizeof(SourceView);
+    return total;
+}
+
 void SourceManager::addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile)
 {
     SLANG_ASSERT(!findSourceFileRecursively(uniqueIdentity));
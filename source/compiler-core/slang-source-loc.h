@@ -449,6 +449,10 @@ struct SourceManager
         /// Get the source views
     const List<SourceView*>& getSourceViews() const { return m_sourceViews; }
 
+        /// Estimate of the memory used by this manager (not including any parents) in bytes.
+        /// Includes the contents of the source files.
+    size_t calcTotalMemoryUsed() const;
+
     SourceManager() :
         m_memoryArena(2048),
         m_slicePool(StringSlicePool::Style::Default)
@@ -92,6 +92,11 @@ namespace Slang
             return SLANG_FAIL;
         }
 
+        return generateTemporaryInDirectory(tempPath, inPrefix, outFileName);
+    }
+
+    /* static */SlangResult File::generateTemporaryInDirectory(const String& directory, const UnownedStringSlice& inPrefix, String& outFileName)
+    {
         const String prefix(inPrefix);
         String tempFileName;
 
@@ -101,7 +106,7 @@ namespace Slang
 
             // https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-gettempfilenamea
             //  Generates a temporary file name. 
-            DWORD ret = ::GetTempFileNameA(tempPath.getBuffer(), prefix.getBuffer(), 0, chars);
+            DWORD ret = ::GetTempFileNameA(directory.getBuffer(), prefix.getBuffer(), 0, chars);
 
             if (ret == 0)
             {
@@ -113,11 +118,39 @@ namespace Slang
         outFileName = tempFileName;
         return SLANG_OK;
     }
+
+    /* static */SlangResult File::getMemoryTemporaryDirectory(String& outPath)
+    {
+        SLANG_UNUSED(outPath);
+        // There is no standard memory backed file system on windows 
+        return SLANG_E_NOT_AVAILABLE;
+    }
 #else
     /* static */SlangResult File::generateTemporary(const UnownedStringSlice& inPrefix, Slang::String& outFileName)
+    {
+        return generateTemporaryInDirectory("/tmp", inPrefix, outFileName);
+    }
+
+    /* static */SlangResult File::getMemoryTemporaryDirectory(String& outPath)
+    {
+#if SLANG_LINUX_FAMILY
+        // /dev/shm is typically a tmpfs mount, that is writable by all users
+        const char path[] = "/dev/shm";
+        if (::access(path, W_OK | X_OK) == 0)
+        {
+            outPath = path;
+            return SLANG_OK;
+        }
+#else
+        SLANG_UNUSED(outPath);
+#endif
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    /* static */SlangResult File::generateTemporaryInDirectory(const String& directory, const UnownedStringSlice& inPrefix, String& outFileName)
     {
         StringBuilder builder;
-        builder << "/tmp/" << inPrefix << "-XXXXXX";
+        builder << directory << "/" << inPrefix << "-XXXXXX";
 
         List<char> buffer;
         buffer.setCount(builder.getLength() + 1);
@@ -742,7 +775,7 @@ namespace Slang
             return SLANG_E_BUFFER_TOO_SMALL;
         }
         // Zero terminate
-        outPath[resSize - 1] = 0;
+        outPath[resSize] = 0;
         return SLANG_OK;
 #   else        
         String text = Slang::File::readAllText("/proc/self/maps");
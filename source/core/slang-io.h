@@ -28,6 +28,12 @@ namespace Slang
         static SlangResult makeExecutable(const String& fileName);
 
         static SlangResult generateTemporary(const UnownedStringSlice& prefix, String& outFileName);
+            /// Generate a temporary file in the specified directory
+        static SlangResult generateTemporaryInDirectory(const String& directory, const UnownedStringSlice& prefix, String& outFileName);
+
+            /// Get a directory for temporary files whose contents are held in memory (such as a tmpfs mount on linux).
+            /// Returns SLANG_E_NOT_AVAILABLE if there is no such directory on the platform.
+        static SlangResult getMemoryTemporaryDirectory(String& outPath);
     };
 
     class Path
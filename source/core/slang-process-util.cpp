@@ -0,0 +1,211 @@
+// slang-process-util.cpp
+#include "slang-process-util.h"
+
+#include "../../slang-com-helper.h"
+
+namespace Slang {
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ProcessUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
+{
+    return execute(commandLine, String(), outExecuteResult);
+}
+
+/* static */SlangResult ProcessUtil::createProcess(const CommandLine& commandLine, const String& stdinContents, RefPtr<Process>& outProcess)
+{
+    return createProcess(commandLine, stdinContents, 0, outProcess);
+}
+
+/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, const String& stdinContents, ExecuteResult& outExecuteResult)
+{
+    outExecuteResult.init();
+
+    RefPtr<Process> process;
+    SLANG_RETURN_ON_FAIL(createProcess(commandLine, stdinContents, process));
+
+    Process* processes[] = { process };
+    while (!process->isTerminated())
+    {
+        SLANG_RETURN_ON_FAIL(waitForAny(processes, 1, -1));
+    }
+
+    outExecuteResult = process->getResult();
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ProcessQueue !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */Index ProcessQueue::getDefaultMaxRunningCount()
+{
+    return ProcessUtil::getProcessorCount();
+}
+
+ProcessQueue::Handle ProcessQueue::add(const CommandLine& commandLine, const String& stdinContents, CompletedFunc completedFunc, void* userData)
+{
+    Job job;
+    job.commandLine = commandLine;
+    job.stdinContents = stdinContents;
+    job.completedFunc = completedFunc;
+    job.userData = userData;
+
+    const Handle handle = m_jobs.getCount();
+    m_jobs.add(job);
+    m_pendingCount++;
+    return handle;
+}
+
+void ProcessQueue::_complete(Handle handle, SlangResult res)
+{
+    Job& job = m_jobs[handle];
+    SLANG_ASSERT(job.state != State::Completed);
+
+    job.state = State::Completed;
+    job.result = res;
+    if (job.process)
+    {
+        job.exeResult = job.process->getResult();
+        job.process.setNull();
+    }
+    // Not needed anymore
+    job.stdinContents = String();
+    job.commandLine.reset();
+
+    m_pendingCount--;
+
+    if (job.completedFunc)
+    {
+        m_completedToNotify.add(handle);
+    }
+}
+
+void ProcessQueue::_notifyCompleted()
+{
+    // The callbacks are only invoked once the results of all of the jobs that have completed are
+    // stored, so a callback that uses the queue sees consistent state. A callback may re-enter the
+    // queue (adding to m_completedToNotify), so it is consumed one handle at a time.
+    while (m_completedToNotify.getCount() > 0)
+    {
+        const Handle handle = m_completedToNotify[0];
+        m_completedToNotify.removeAt(0);
+
+        // Copy what is needed, as the callback may add jobs (invalidating job)
+        const Job& job = m_jobs[handle];
+        const CompletedFunc completedFunc = job.completedFunc;
+        void* userData = job.userData;
+        const SlangResult res = job.result;
+        const ExecuteResult exeResult = job.exeResult;
+
+        completedFunc(handle, res, exeResult, userData);
+    }
+}
+
+void ProcessQueue::_startQueued()
+{
+    while (m_running.getCount() < m_maxRunningCount && m_nextQueuedIndex < m_jobs.getCount())
+    {
+        const Handle handle = m_nextQueuedIndex++;
+
+        RefPtr<Process> process;
+        {
+            const Job& job = m_jobs[handle];
+            SlangResult res = ProcessUtil::createProcess(job.commandLine, job.stdinContents, process);
+            if (SLANG_FAILED(res))
+            {
+                _complete(handle, res);
+                continue;
+            }
+        }
+
+        Job& job = m_jobs[handle];
+        job.process = process;
+        job.state = State::Running;
+        m_running.add(handle);
+    }
+}
+
+SlangResult ProcessQueue::update(Int timeOutInMs)
+{
+    _startQueued();
+
+    if (m_running.getCount() == 0)
+    {
+        _notifyCompleted();
+        return SLANG_OK;
+    }
+
+    List<Process*> processes;
+    for (auto handle : m_running)
+    {
+        processes.add(m_jobs[handle].process);
+    }
+
+    const SlangResult waitRes = ProcessUtil::waitForAny(processes.getBuffer(), processes.getCount(), timeOutInMs);
+    if (waitRes == SLANG_E_TIME_OUT)
+    {
+        _notifyCompleted();
+        return SLANG_OK;
+    }
+
+    // Work out which have completed. If the wait failed, we can't make progress on any of the running processes,
+    // so they are killed and completed with the failure.
+    for (Index i = 0; i < m_running.getCount(); ++i)
+    {
+        const Handle handle = m_running[i];
+        Process* process = m_jobs[handle].process;
+
+        SlangResult res = SLANG_OK;
+        if (!process->isTerminated())
+        {
+            if (SLANG_SUCCEEDED(waitRes))
+            {
+                continue;
+            }
+            process->kill();
+            res = waitRes;
+        }
+
+        m_running.removeAt(i);
+        --i;
+        _complete(handle, res);
+    }
+
+    // Start anything that can be started with the slots that are now free
+    _startQueued();
+
+    _notifyCompleted();
+    return waitRes;
+}
+
+SlangResult ProcessQueue::wait(Handle handle)
+{
+    while (!isCompleted(handle))
+    {
+        SLANG_RETURN_ON_FAIL(update(-1));
+    }
+    return m_jobs[handle].result;
+}
+
+SlangResult ProcessQueue::waitAll()
+{
+    SlangResult res = SLANG_OK;
+    while (m_pendingCount > 0)
+    {
+        const SlangResult updateRes = update(-1);
+        res = SLANG_FAILED(res) ? res : updateRes;
+    }
+    return res;
+}
+
+SlangResult ProcessQueue::getResult(Handle handle, ExecuteResult& outExecuteResult) const
+{
+    const Job& job = m_jobs[handle];
+    if (job.state != State::Completed)
+    {
+        return SLANG_E_PENDING;
+    }
+    outExecuteResult = job.exeResult;
+    return job.result;
+}
+
+} // namespace Slang
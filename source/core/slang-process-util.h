@@ -4,6 +4,7 @@
 
 #include "slang-string.h"
 #include "slang-list.h"
+#include "slang-smart-pointer.h"
 
 #include "slang-string-escape-util.h"
 
@@ -61,6 +62,44 @@ struct ExecuteResult
     Slang::String standardError;
 };
 
+/* A process started via ProcessUtil::createProcess. The process runs asynchronously - progress (writing to its
+standard input, and reading its output) is made by calling ProcessUtil::waitForAny or ProcessUtil::waitForOutput.
+Once the process has terminated the result is available via getResult. */
+class Process : public RefObject
+{
+public:
+    typedef uint32_t Flags;
+    struct Flag
+    {
+        enum Enum : Flags
+        {
+            KeepStdInOpen = 0x1,        ///< Standard input stays open after the initial contents are written, so more can be written with writeStdIn
+        };
+    };
+
+        /// True when the process has terminated and all of its output has been read
+    bool isTerminated() const { return m_isTerminated; }
+        /// The result of execution. The output is appended to as it is read, the result code is only valid once terminated.
+    const ExecuteResult& getResult() const { return m_result; }
+
+        /// Kill the process if it is still running, and wait for it to exit. Output that hasn't
+        /// been read is discarded. The process is terminated afterwards.
+    virtual void kill() = 0;
+
+        /// Add contents to be written to the standard input of the process. Only valid if the process was created
+        /// with Flag::KeepStdInOpen, and closeStdIn hasn't been called. The contents are written as the process reads them.
+    virtual void writeStdIn(const String& contents) = 0;
+        /// Close standard input once everything added has been written, such that the process sees the end of input.
+    virtual void closeStdIn() = 0;
+
+        /// Ctor
+    Process() { m_result.init(); }
+
+protected:
+    bool m_isTerminated = false;
+    ExecuteResult m_result;
+};
+
 struct ProcessUtil
 {
         /// The quoting style used for the command line on this target. Currently just uses Space,
@@ -75,12 +114,109 @@ struct ProcessUtil
 
         /// Execute the command line 
     static SlangResult execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult);
+        /// Execute the command line, with stdinContents written to the standard input of the process
+    static SlangResult execute(const CommandLine& commandLine, const String& stdinContents, ExecuteResult& outExecuteResult);
+
+        /// Start executing the command line without waiting for it to complete. 
+        /// stdinContents is streamed to the standard input of the process as it runs, after which its standard input is closed.
+    static SlangResult createProcess(const CommandLine& commandLine, const String& stdinContents, RefPtr<Process>& outProcess);
+        /// Start executing the command line without waiting for it to complete. If flags contains Process::Flag::KeepStdInOpen,
+        /// standard input stays open after stdinContents has been written, and is closed with Process::closeStdIn.
+    static SlangResult createProcess(const CommandLine& commandLine, const String& stdinContents, Process::Flags flags, RefPtr<Process>& outProcess);
+
+        /// Make progress on the processes, returning when at least one of them has terminated, or timeOutInMs has elapsed.
+        /// A timeOutInMs of -1 means wait without a time out. Returns SLANG_E_TIME_OUT if no process terminated in time.
+        /// Processes that have already terminated are ignored.
+    static SlangResult waitForAny(Process*const* processes, Index processesCount, Int timeOutInMs);
+        /// Same as waitForAny, but also returns when at least one of the processes has produced more standard output. 
+    static SlangResult waitForOutput(Process*const* processes, Index processesCount, Int timeOutInMs);
+
+        /// Get the number of processors available to run processes. Always returns at least 1.
+    static Index getProcessorCount();
 
     static uint64_t getClockFrequency();
 
     static uint64_t getClockTick();
 };
 
+/* Executes command lines concurrently. Commands are added to the queue, and are started in the order they were added,
+with at most 'maxRunningCount' running at any one time. The queue only makes progress (starting processes, streaming
+standard input, reading output) within calls to update or one of the wait functions.
+
+When a command completes, its result can be accessed via getResult, and the optional callback is invoked (from
+within the call that made progress, once the results of all of the commands that completed have been stored). */
+class ProcessQueue
+{
+public:
+    typedef Index Handle;
+
+        /// Called when a command has completed. res is the result of launching/running, and exeResult the result
+        /// of execution (only meaningful if res succeeded).
+    typedef void (*CompletedFunc)(Handle handle, SlangResult res, const ExecuteResult& exeResult, void* userData);
+
+        /// Add a command line to the queue. Returns a handle that can be used to wait for and get the result.
+    Handle add(const CommandLine& commandLine, const String& stdinContents = String(), CompletedFunc completedFunc = nullptr, void* userData = nullptr);
+
+        /// Start queued commands where there is capacity, and make progress on running ones. Waits at most timeOutInMs
+        /// for a command to complete (-1 waits until at least one does, if any are running).
+    SlangResult update(Int timeOutInMs = 0);
+
+        /// Wait for the command identified by handle to complete. Other commands continue to make progress.
+    SlangResult wait(Handle handle);
+        /// Wait until all commands added have completed.
+    SlangResult waitAll();
+
+        /// True if the command has completed
+    bool isCompleted(Handle handle) const { return m_jobs[handle].state == State::Completed; }
+        /// Get the result of a completed command. Returns the result of launching the process.
+    SlangResult getResult(Handle handle, ExecuteResult& outExecuteResult) const;
+
+        /// The total number of commands that have been added and not yet completed
+    Index getPendingCount() const { return m_pendingCount; }
+
+        /// Set the maximum amount of processes that can run simultaneously. Must be at least 1.
+    void setMaxRunningCount(Index count) { SLANG_ASSERT(count > 0); m_maxRunningCount = count; }
+    Index getMaxRunningCount() const { return m_maxRunningCount; }
+
+        /// Get a default for the maximum running count (typically the number of processors)
+    static Index getDefaultMaxRunningCount();
+
+        /// Ctor
+    ProcessQueue() : m_maxRunningCount(getDefaultMaxRunningCount()) {}
+
+protected:
+    enum class State : uint8_t
+    {
+        Queued,
+        Running,
+        Completed,
+    };
+
+    struct Job
+    {
+        State state = State::Queued;
+        CommandLine commandLine;
+        String stdinContents;
+        CompletedFunc completedFunc = nullptr;
+        void* userData = nullptr;
+
+        RefPtr<Process> process;
+        SlangResult result = SLANG_OK;
+        ExecuteResult exeResult;
+    };
+
+    void _complete(Handle handle, SlangResult res);
+    void _startQueued();
+    void _notifyCompleted();
+
+    Index m_maxRunningCount;
+    Index m_pendingCount = 0;
+    Index m_nextQueuedIndex = 0;            ///< All jobs before this index have been started
+    List<Handle> m_running;                 ///< Handles of jobs that are running
+    List<Handle> m_completedToNotify;       ///< Handles of completed jobs whose callback hasn't been invoked
+    List<Job> m_jobs;
+};
+
 // -----------------------------------------------------------------------
 SLANG_INLINE void CommandLine::addPrefixPathArg(const char* prefix, const String& path, const char* pathPostfix)
 {
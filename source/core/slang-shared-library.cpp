@@ -16,6 +16,9 @@
 #ifndef WIN32
 #    include <unistd.h>
 #endif
+#if defined(__linux__)
+#   include <sys/syscall.h>
+#endif
 
 namespace Slang
 {
@@ -62,6 +65,80 @@ SlangResult DefaultSharedLibraryLoader::loadPlatformSharedLibrary(const char* pa
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! MemoryFile !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+/* static */SlangResult MemoryFile::create(const char* name, RefPtr<MemoryFile>& outFile)
+{
+#if defined(__linux__) && defined(SYS_memfd_create)
+    // MFD_CLOEXEC, such that the file isn't inherited by child processes. Other processes
+    // can still open it via the path, which identifies it by this process and descriptor.
+    const unsigned int flags = 1;
+    const int fd = int(syscall(SYS_memfd_create, name, flags));
+    if (fd < 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder path;
+    path << "/proc/" << int(getpid()) << "/fd/" << fd;
+
+    outFile = new MemoryFile(fd, path);
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(name);
+    SLANG_UNUSED(outFile);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+size_t MemoryFile::getSize() const
+{
+#ifndef WIN32
+    struct stat fileStat;
+    if (fstat(m_fileDescriptor, &fileStat) == 0)
+    {
+        return size_t(fileStat.st_size);
+    }
+#endif
+    return 0;
+}
+
+MemoryFile::~MemoryFile()
+{
+#ifndef WIN32
+    if (m_fileDescriptor >= 0)
+    {
+        close(m_fileDescriptor);
+    }
+#endif
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! MemorySharedLibrary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+/* static */SlangResult MemorySharedLibrary::load(MemoryFile* file, RefPtr<MemorySharedLibrary>& outLibrary)
+{
+    if (file->getSize() == 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    SharedLibrary::Handle handle;
+    SLANG_RETURN_ON_FAIL(SharedLibrary::loadWithPlatformPath(file->getPath().getBuffer(), handle));
+
+    outLibrary = new MemorySharedLibrary(handle, file);
+    return SLANG_OK;
+}
+
+MemorySharedLibrary::~MemorySharedLibrary()
+{
+    if (m_sharedLibraryHandle)
+    {
+        // Must unload before the file backing it is closed
+        SharedLibrary::unload(m_sharedLibraryHandle);
+        m_sharedLibraryHandle = nullptr;
+    }
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!! DefaultSharedLibrary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 
 TemporarySharedLibrary::~TemporarySharedLibrary()
@@ -98,6 +98,55 @@ protected:
     String m_path;
 };
 
+/* A file held in memory, that can be written to (and read from) through a path, including by other processes.
+Only supported on some platforms (currently linux, via memfd). */
+class MemoryFile : public RefObject
+{
+public:
+        /// Create an empty memory file. Returns SLANG_E_NOT_AVAILABLE if not supported on this platform.
+    static SlangResult create(const char* name, RefPtr<MemoryFile>& outFile);
+
+        /// Get a path that can be used to open the file, from this or another process.
+    const String& getPath() const { return m_path; }
+        /// Get the current size of the file's contents in bytes
+    size_t getSize() const;
+
+    virtual ~MemoryFile();
+
+protected:
+    MemoryFile(int fileDescriptor, const String& path):
+        m_fileDescriptor(fileDescriptor),
+        m_path(path)
+    {
+    }
+
+    int m_fileDescriptor;
+    String m_path;
+};
+
+/* A shared library loaded from a MemoryFile, such that the library doesn't need to be accessible on the file system. */
+class MemorySharedLibrary : public DefaultSharedLibrary
+{
+public:
+    typedef DefaultSharedLibrary Super;
+
+        /// Load the shared library that has been written to file.
+    static SlangResult load(MemoryFile* file, RefPtr<MemorySharedLibrary>& outLibrary);
+
+    virtual ~MemorySharedLibrary();
+
+protected:
+    MemorySharedLibrary(const SharedLibrary::Handle sharedLibraryHandle, MemoryFile* file):
+        Super(sharedLibraryHandle),
+        m_file(file)
+    {
+    }
+
+        /// Backs the library. Must be held open whilst the library is loaded, as the library is identified by a path
+        /// containing the file descriptor.
+    RefPtr<MemoryFile> m_file;
+};
+
 class SharedLibraryUtils
 {
 public:
@@ -115,11 +115,6 @@ public:
     CppStringEscapeHandler() : Super('"') {}
 };
 
-static char _getHexChar(int v)
-{
-    return (v <= 9) ? char(v + '0') : char(v - 10 + 'A');
-}
-
 static int _getHexDigit(char c)
 {
     if (c >= '0' && c <= '9')
@@ -173,6 +168,7 @@ static char _getCppUnescapedChar(char c)
         case '\'':      return '\'';
         case '\"':      return '"';
         case '\\':      return '\\';
+        case '?':       return '?';
         default:        return 0;
     }
 }
@@ -245,12 +241,14 @@ SlangResult CppStringEscapeHandler::appendEscaped(const UnownedStringSlice& slic
                 out.append(start, cur);
             }
 
-            char buf[5] = "\\0x0";
+            // Output as a 3 digit octal escape. Unlike a hex escape, an octal escape is at most 3 digits
+            // so it can't consume characters that follow.
+            const int value = int((unsigned char)c);
 
-            buf[3] = _getHexChar((int(c) >> 4) & 0xf);
-            buf[4] = _getHexChar(c & 0xf);
-
-            out.append(buf, buf + 4);
+            out.appendChar('\\');
+            out.appendChar(char('0' + ((value >> 6) & 7)));
+            out.appendChar(char('0' + ((value >> 3) & 7)));
+            out.appendChar(char('0' + (value & 7)));
 
             start = cur + 1;
         }
@@ -269,101 +267,96 @@ SlangResult CppStringEscapeHandler::appendUnescaped(const UnownedStringSlice& sl
     const char* cur = start;
     const char*const end = slice.end();
 
-    for (; cur < end; ++cur)
+    while (cur < end)
     {
         const char c = *cur;
 
-        if (c == '\\')
+        if (c != '\\')
         {
-            // Flush
-            if (start < end)
-            {
-                out.append(start, end);
-            }
-
-            /// Next 
             cur++;
+            continue;
+        }
 
-            if (cur >= end)
-            {
-                return SLANG_FAIL;
-            }
+        // Flush
+        if (start < cur)
+        {
+            out.append(start, cur);
+        }
 
-            // Need to handle various escape sequence cases
-            switch (*cur)
+        /// Next 
+        cur++;
+
+        if (cur >= end)
+        {
+            return SLANG_FAIL;
+        }
+
+        // Need to handle various escape sequence cases
+        switch (*cur)
+        {
+            case '\'':
+            case '\"':
+            case '\\':
+            case '?':
+            case 'a':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+            case 'v':
             {
-                case '\'':
-                case '\"':
-                case '\\':
-                case '?':
-                case 'a':
-                case 'b':
-                case 'f':
-                case 'n':
-                case 'r':
-                case 't':
-                case 'v':
+                const char unescapedChar = _getCppUnescapedChar(*cur);
+                if (unescapedChar == 0)
                 {
-                    const char unescapedChar = _getCppUnescapedChar(*cur);
-                    if (unescapedChar == 0)
-                    {
-                        // Don't know how to unescape that char
-                        return SLANG_FAIL;
-                    }
-                    out.appendChar(unescapedChar);
-
-                    start = cur + 1;
-                    break;
+                    // Don't know how to unescape that char
+                    return SLANG_FAIL;
                 }
-                case '0': case '1': case '2': case '3': case '4':
-                case '5': case '6': case '7':
-                {
-                    // octal escape: up to 3 characters
-                    ++cur;
-                    int value = 0;
-
-                    const char* octEnd = cur + 3;
-                    octEnd = (octEnd > end) ? end : octEnd;
+                out.appendChar(unescapedChar);
+                cur++;
+                break;
+            }
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7':
+            {
+                // octal escape: up to 3 characters
+                int value = 0;
 
-                    for (; cur < octEnd; ++cur)
-                    {
-                        const char d = *cur;
-                        if (d >= '0' && d <= '7')
-                        {
-                            value = (value << 3) | (d - '0');
-                        }
-                    }
-                    out.appendChar(char(value));
+                const char* octEnd = cur + 3;
+                octEnd = (octEnd > end) ? end : octEnd;
 
-                    start = cur;
-                    break;
+                for (; cur < octEnd && *cur >= '0' && *cur <= '7'; ++cur)
+                {
+                    value = (value << 3) | (*cur - '0');
                 }
-                case 'x':
+                out.appendChar(char(value));
+                break;
+            }
+            case 'x':
+            {
+                uint32_t value = 0;
+                for (++cur; cur < end && CharUtil::isHexDigit(*cur); ++cur)
                 {
-                    uint32_t value = 0;
-                    for (++cur; cur < end && CharUtil::isHexDigit(*cur); ++cur)
-                    {
-                        value = value << 4 | _getHexDigit(*cur);
-                    }
-
-                    // It's arguable what is appropriate. We only decode/encode 4, which the current spec has,
-                    // but 6 are possible, so lets go large.
-                    const Index maxUtf8EncodeCount = 6;
+                    value = value << 4 | _getHexDigit(*cur);
+                }
 
-                    char* chars = out.prepareForAppend(maxUtf8EncodeCount);
+                // It's arguable what is appropriate. We only decode/encode 4, which the current spec has,
+                // but 6 are possible, so lets go large.
+                const Index maxUtf8EncodeCount = 6;
 
-                    int numChars = EncodeUnicodePointToUTF8(chars, int(value));
-                    out.appendInPlace(chars, numChars);
+                char* chars = out.prepareForAppend(maxUtf8EncodeCount);
 
-                    start = cur;
-                    break;
-                }
-                default:
-                {
-                    return SLANG_FAIL;
-                }
+                int numChars = EncodeUnicodePointToUTF8(chars, int(value));
+                out.appendInPlace(chars, numChars);
+                break;
+            }
+            default:
+            {
+                return SLANG_FAIL;
             }
         }
+
+        start = cur;
     }
 
     if (start < end)
@@ -0,0 +1,136 @@
+#include "slang-string-rope.h"
+
+#include "slang-math.h"
+
+#include "../../slang-com-helper.h"
+
+namespace Slang {
+
+/* static */const Index StringRope::kChunkSize;
+
+void StringRope::append(const char* chars, Index count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    m_length += count;
+
+    // Fill up the last chunk first
+    if (m_tailSpace > 0)
+    {
+        const Index tailCount = Math::Min(count, m_tailSpace);
+        m_chunks.getLast().append(chars, chars + tailCount);
+        m_tailSpace -= tailCount;
+
+        chars += tailCount;
+        count -= tailCount;
+        if (count == 0)
+        {
+            return;
+        }
+    }
+
+    // Anything larger than a chunk gets a chunk of its own
+    const Index capacity = Math::Max(count, kChunkSize);
+
+    StringBuilder chunk(capacity);
+    chunk.append(chars, chars + count);
+    m_chunks.add(chunk);
+
+    m_tailSpace = capacity - count;
+}
+
+void StringRope::appendChunk(const String& string)
+{
+    const Index length = string.getLength();
+    if (length == 0)
+    {
+        return;
+    }
+
+    m_chunks.add(string);
+    m_length += length;
+    m_tailSpace = 0;
+}
+
+void StringRope::appendRope(const ThisType& rope)
+{
+    if (rope.m_length == 0)
+    {
+        return;
+    }
+
+    // Copy the chunk list in case rope is this
+    List<String> chunks(rope.m_chunks);
+    m_chunks.addRange(chunks);
+    m_length += rope.m_length;
+    m_tailSpace = 0;
+}
+
+void StringRope::prependRope(const ThisType& rope)
+{
+    if (rope.m_length == 0)
+    {
+        return;
+    }
+
+    // If rope is this, the tail would end up in the middle
+    if (&rope == this)
+    {
+        appendRope(rope);
+        return;
+    }
+
+    m_chunks.insertRange(0, rope.m_chunks);
+    m_length += rope.m_length;
+}
+
+void StringRope::clear()
+{
+    // Release the chunks, as List::clear would keep them alive
+    m_chunks.clearAndDeallocate();
+    m_length = 0;
+    m_tailSpace = 0;
+}
+
+String StringRope::flatten()
+{
+    switch (m_chunks.getCount())
+    {
+        case 0:     return String();
+        case 1:     return m_chunks[0];
+        default:    break;
+    }
+
+    StringBuilder buf(m_length);
+    for (const auto& chunk : m_chunks)
+    {
+        buf.append(chunk);
+    }
+
+    m_chunks.clearAndDeallocate();
+    m_chunks.add(buf);
+    m_tailSpace = 0;
+
+    return m_chunks[0];
+}
+
+SlangResult StringRope::writeTo(ISlangWriter* writer) const
+{
+    for (const auto& chunk : m_chunks)
+    {
+        SLANG_RETURN_ON_FAIL(writer->write(chunk.getBuffer(), size_t(chunk.getLength())));
+    }
+    return SLANG_OK;
+}
+
+void StringRope::swapWith(ThisType& rhs)
+{
+    m_chunks.swapWith(rhs.m_chunks);
+    Swap(m_length, rhs.m_length);
+    Swap(m_tailSpace, rhs.m_tailSpace);
+}
+
+} // namespace Slang
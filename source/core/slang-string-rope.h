@@ -0,0 +1,68 @@
+#ifndef SLANG_CORE_STRING_ROPE_H
+#define SLANG_CORE_STRING_ROPE_H
+
+#include "slang-string.h"
+#include "slang-list.h"
+
+namespace Slang {
+
+/* A string that is held as a sequence of chunks.
+
+Appending text never moves text that has already been appended, so building up a large
+string (such as generated source) doesn't require a realloc and copy every time the
+buffer fills up, as happens with a StringBuilder. Ropes can also be joined, and written
+out to a writer or file, without copying the text they hold.
+
+Chunks are Strings, so they are reference counted and can be shared with other Strings
+and ropes without copying. */
+class StringRope
+{
+public:
+    typedef StringRope ThisType;
+
+        /// The capacity of chunks allocated to hold appended text
+    static const Index kChunkSize = 64 * 1024;
+
+        /// Append the text
+    void append(const char* chars, Index count);
+    void append(const UnownedStringSlice& slice) { append(slice.begin(), slice.getLength()); }
+
+        /// Append the string as a chunk, sharing (rather than copying) its contents
+    void appendChunk(const String& string);
+
+        /// Append the contents of rope. The chunks are shared and not copied.
+    void appendRope(const ThisType& rope);
+        /// Prepend the contents of rope. The chunks are shared and not copied.
+    void prependRope(const ThisType& rope);
+
+        /// Get the total length in bytes
+    Index getLength() const { return m_length; }
+
+        /// Get the chunks that make up the rope, in order
+    const List<String>& getChunks() const { return m_chunks; }
+
+        /// Clear the contents
+    void clear();
+
+        /// Returns the contents as a single String.
+        /// If the rope is held in more than one chunk, they are replaced with a single chunk
+        /// holding all of the text, such that the copy is only ever made once.
+    String flatten();
+
+        /// Write the contents to the writer, chunk by chunk
+    SlangResult writeTo(ISlangWriter* writer) const;
+
+        /// Swap contents with rhs
+    void swapWith(ThisType& rhs);
+
+protected:
+    List<String> m_chunks;
+    Index m_length = 0;
+        /// The number of bytes that can be appended to the last chunk in place.
+        /// Is 0 if the last chunk is not owned by this rope (so may be shared).
+    Index m_tailSpace = 0;
+};
+
+} // namespace Slang
+
+#endif
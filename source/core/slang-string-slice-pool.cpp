@@ -14,6 +14,13 @@ StringSlicePool::StringSlicePool(Style style) :
     clear();
 }
 
+size_t StringSlicePool::calcTotalMemoryUsed() const
+{
+    return m_arena.calcTotalMemoryUsed() +
+        size_t(m_slices.getCapacity()) * sizeof(UnownedStringSlice) +
+        size_t(m_map.Count()) * (sizeof(UnownedStringSlice) + sizeof(Handle));
+}
+
 void StringSlicePool::clear()
 {
     m_map.Clear();
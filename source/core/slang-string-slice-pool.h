@@ -94,6 +94,9 @@ public:
         /// Get the index of the first added handle
     Index getFirstAddedIndex() const { return m_style == Style::Default ? kDefaultHandlesCount : 0; }
 
+        /// Estimate of the total amount of memory used by the pool in bytes
+    size_t calcTotalMemoryUsed() const;
+
         /// Ctor
     explicit StringSlicePool(Style style);
 
@@ -6,12 +6,17 @@
 #include "../slang-string-escape-util.h"
 #include "../slang-memory-arena.h"
 
+#include "../../../slang-com-helper.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 
 //#include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -54,17 +59,228 @@ namespace Slang {
     return cmd.ToString();
 }
 
-/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
+namespace { // anonymous
+
+class UnixProcess : public Process
+{
+public:
+    enum StreamIndex
+    {
+        StdOut,
+        StdErr,
+        StdIn,
+        CountOf,
+    };
+
+        /// Returns true if still has pipes open
+    bool hasOpenStreams() const { return m_fds[StdOut] >= 0 || m_fds[StdErr] >= 0 || m_fds[StdIn] >= 0; }
+        /// Returns true if there are stdin contents that haven't been written yet
+    bool hasPendingStdIn() const { return m_stdinOffset < m_stdinContents.getLength(); }
+
+        /// Close the stream
+    void closeStream(StreamIndex index)
+    {
+        if (m_fds[index] >= 0)
+        {
+            close(m_fds[index]);
+            m_fds[index] = -1;
+        }
+    }
+
+        /// Read from the stream (which has data or is closed). Returns the amount of bytes read.
+    Index readStream(StreamIndex index);
+        /// Write remaining stdin contents
+    void flushStdIn();
+        /// Checks if process has exited, and if so sets the result. 
+    SlangResult checkExited(bool wait);
+
+        /// Once all streams are closed and the process has exited, it's terminated
+    void updateTerminated() { m_isTerminated = m_hasExited && !hasOpenStreams(); }
+
+    virtual void kill() SLANG_OVERRIDE;
+    virtual void writeStdIn(const String& contents) SLANG_OVERRIDE;
+    virtual void closeStdIn() SLANG_OVERRIDE;
+
+    ~UnixProcess()
+    {
+        for (Index i = 0; i < CountOf; ++i)
+        {
+            closeStream(StreamIndex(i));
+        }
+        if (!m_hasExited && m_pid > 0)
+        {
+            // Don't leave a zombie
+            int childStatus;
+            waitpid(m_pid, &childStatus, 0);
+        }
+    }
+
+    pid_t m_pid = -1;
+    int m_fds[CountOf] = { -1, -1, -1 };
+
+    bool m_hasExited = false;
+
+    String m_stdinContents;
+    Index m_stdinOffset = 0;
+        /// If set stdin is closed once all of the contents have been written
+    bool m_closeStdInWhenWritten = true;
+};
+
+Index UnixProcess::readStream(StreamIndex index)
+{
+    enum { kBufferSize = 4096 };
+    char buffer[kBufferSize];
+
+    const auto count = read(m_fds[index], buffer, kBufferSize);
+    if (count <= 0)
+    {
+        // If interrupted we can just try again later
+        if (count < 0 && (errno == EINTR || errno == EAGAIN))
+        {
+            return 0;
+        }
+        // end-of-file
+        closeStream(index);
+        return 0;
+    }
+
+    String& dst = (index == StdOut) ? m_result.standardOutput : m_result.standardError;
+    dst.append(buffer, buffer + count);
+    return Index(count);
+}
+
+void UnixProcess::flushStdIn()
+{
+    const Index remaining = m_stdinContents.getLength() - m_stdinOffset;
+    if (remaining > 0)
+    {
+#ifdef MSG_NOSIGNAL
+        const int flags = MSG_NOSIGNAL;
+#else
+        const int flags = 0;
+#endif
+        const auto count = send(m_fds[StdIn], m_stdinContents.getBuffer() + m_stdinOffset, size_t(remaining), flags);
+        if (count < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                return;
+            }
+            // The process isn't reading its input (perhaps it has exited), so nothing more can be written.
+            m_stdinOffset = m_stdinContents.getLength();
+            m_closeStdInWhenWritten = true;
+        }
+        else
+        {
+            m_stdinOffset += Index(count);
+        }
+    }
+
+    if (m_stdinOffset >= m_stdinContents.getLength())
+    {
+        m_stdinContents = String();
+        m_stdinOffset = 0;
+
+        if (m_closeStdInWhenWritten)
+        {
+            // Closing signals end of input
+            closeStream(StdIn);
+        }
+    }
+}
+
+void UnixProcess::writeStdIn(const String& contents)
+{
+    // If the process has stopped reading its input, there is nowhere for the contents to go
+    if (m_fds[StdIn] < 0 || m_closeStdInWhenWritten)
+    {
+        return;
+    }
+    m_stdinContents.append(contents);
+}
+
+void UnixProcess::closeStdIn()
+{
+    m_closeStdInWhenWritten = true;
+    if (!hasPendingStdIn())
+    {
+        closeStream(StdIn);
+    }
+}
+
+SlangResult UnixProcess::checkExited(bool wait)
+{
+    if (m_hasExited)
+    {
+        return SLANG_OK;
+    }
+
+    int childStatus = 0;
+    pid_t terminatedProcessID;
+    do 
+    {
+        terminatedProcessID = waitpid(m_pid, &childStatus, wait ? 0 : WNOHANG);
+    }
+    while (terminatedProcessID == -1 && errno == EINTR);
+
+    if (terminatedProcessID == -1)
+    {
+        fprintf(stderr, "error: `waitpid` failed\n");
+        return SLANG_FAIL;
+    }
+
+    if (terminatedProcessID == m_pid)
+    {
+        if (WIFEXITED(childStatus))
+        {
+            m_result.resultCode = (int)(int8_t)WEXITSTATUS(childStatus);
+        }
+        else
+        {
+            m_result.resultCode = 1;
+        }
+        m_hasExited = true;
+    }
+    return SLANG_OK;
+}
+
+void UnixProcess::kill()
+{
+    if (!m_hasExited && m_pid > 0)
+    {
+        ::kill(m_pid, SIGKILL);
+        if (SLANG_FAILED(checkExited(true)))
+        {
+            // Can't reap it, but it's gone as far as we are concerned
+            m_hasExited = true;
+        }
+    }
+    for (Index i = 0; i < CountOf; ++i)
+    {
+        closeStream(StreamIndex(i));
+    }
+    updateTerminated();
+}
+
+static void _setCloseOnExec(int fd)
+{
+    // Make sure the handles held by the parent are not inherited by other children launched whilst
+    // this process is running (otherwise for example the stdin of this process may not be closed
+    // until they exit).
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+} // anonymous
+
+/* static */SlangResult ProcessUtil::createProcess(const CommandLine& commandLine, const String& stdinContents, Process::Flags flags, RefPtr<Process>& outProcess)
 {
-    outExecuteResult.init();
-    
     List<char const*> argPtrs;
 
     // Add the command
     argPtrs.add(commandLine.m_executable.getBuffer());
 
     // Add all the args - they don't need any explicit escaping 
-    for (auto arg : commandLine.m_args)
+    for (const auto& arg : commandLine.m_args)
     {
         // All args for this target must be unescaped (as they are in CommandLine)
         argPtrs.add(arg.getBuffer());
@@ -75,6 +291,9 @@ namespace Slang {
 
     int stdoutPipe[2];
     int stderrPipe[2];
+    // We use a socket pair for stdin, as it allows writing without SIGPIPE if the process exits
+    // without reading all of its input
+    int stdinPipe[2];
 
     if (pipe(stdoutPipe) == -1)
     {
@@ -84,13 +303,37 @@ namespace Slang {
 
     if (pipe(stderrPipe) == -1)
     {
+        close(stdoutPipe[0]);
+        close(stdoutPipe[1]);
         fprintf(stderr, "error: `pipe` failed\n");
         return SLANG_FAIL;
     }
 
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, stdinPipe) == -1)
+    {
+        close(stdoutPipe[0]);
+        close(stdoutPipe[1]);
+        close(stderrPipe[0]);
+        close(stderrPipe[1]);
+        fprintf(stderr, "error: `socketpair` failed\n");
+        return SLANG_FAIL;
+    }
+
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    {
+        int value = 1;
+        setsockopt(stdinPipe[0], SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+    }
+#endif
+
     pid_t childProcessID = fork();
     if (childProcessID == -1)
     {
+        for (int* fds : { stdoutPipe, stderrPipe, stdinPipe })
+        {
+            close(fds[0]);
+            close(fds[1]);
+        }
         fprintf(stderr, "error: `fork` failed\n");
         return SLANG_FAIL;
     }
@@ -101,6 +344,7 @@ namespace Slang {
 
         dup2(stdoutPipe[1], STDOUT_FILENO);
         dup2(stderrPipe[1], STDERR_FILENO);
+        dup2(stdinPipe[1], STDIN_FILENO);
 
         close(stdoutPipe[0]);
         close(stdoutPipe[1]);
@@ -108,127 +352,206 @@ namespace Slang {
         close(stderrPipe[0]);
         close(stderrPipe[1]);
 
+        close(stdinPipe[0]);
+        close(stdinPipe[1]);
+
         execvp(argPtrs[0], (char* const*)&argPtrs[0]);
 
         // If we get here, then `exec` failed
         fprintf(stderr, "error: `exec` failed\n");
-        return SLANG_FAIL;
+        _exit(1);
+    }
+
+    // We are the parent process
+
+    close(stdoutPipe[1]);
+    close(stderrPipe[1]);
+    close(stdinPipe[1]);
+
+    RefPtr<UnixProcess> process = new UnixProcess;
+    process->m_pid = childProcessID;
+    process->m_fds[UnixProcess::StdOut] = stdoutPipe[0];
+    process->m_fds[UnixProcess::StdErr] = stderrPipe[0];
+    process->m_fds[UnixProcess::StdIn] = stdinPipe[0];
+
+    for (auto fd : process->m_fds)
+    {
+        _setCloseOnExec(fd);
     }
-    else
+    // Writing to stdin must not block, as we write as the process consumes 
+    fcntl(stdinPipe[0], F_SETFL, fcntl(stdinPipe[0], F_GETFL) | O_NONBLOCK);
+
+    process->m_stdinContents = stdinContents;
+    process->m_closeStdInWhenWritten = (flags & Process::Flag::KeepStdInOpen) == 0;
+    if (stdinContents.getLength() == 0 && process->m_closeStdInWhenWritten)
     {
-        // We are the parent process
+        // Nothing to write, so just close such that the process sees end of input
+        process->closeStream(UnixProcess::StdIn);
+    }
 
-        close(stdoutPipe[1]);
-        close(stderrPipe[1]);
+    outProcess = process;
+    return SLANG_OK;
+}
+
+static SlangResult _wait(Process*const* processes, Index processesCount, Int timeOutInMs, bool returnOnOutput)
+{
+    // While waiting on streams we have a limit on how long we wait, as there may be processes that have closed
+    // all their streams but not exited. 
+    const int exitPollTimeOutInMs = 10;
 
-        int stdoutFD = stdoutPipe[0];
-        int stderrFD = stderrPipe[0];
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    const uint64_t timeOutTicks = (timeOutInMs < 0) ? 0 : (uint64_t(timeOutInMs) * ProcessUtil::getClockFrequency()) / 1000;
 
-        pollfd pollInfos[2];
-        nfds_t pollInfoCount = 2;
+    List<pollfd> pollInfos;
+    List<UnixProcess*> pollProcesses;
 
-        pollInfos[0].fd = stdoutFD;
-        pollInfos[0].events = POLLIN;
-        pollInfos[0].revents = 0;
-        pollInfos[1].fd = stderrFD;
-        pollInfos[1].events = POLLIN;
-        pollInfos[1].revents = 0;
+    bool isFirst = true;
+    for (;;)
+    {
+        bool hasTerminated = false;
+        bool hasExitPending = false;
+        bool hasRunning = false;
+
+        pollInfos.clear();
+        pollProcesses.clear();
 
-        int remainingCount = 2;
-        int iterations = 0;
-        while (remainingCount)
+        for (Index i = 0; i < processesCount; ++i)
         {
-            // Safeguard against infinite loop:
-            iterations++;
-            if (iterations > 10000)
+            UnixProcess* process = static_cast<UnixProcess*>(processes[i]);
+            if (process->isTerminated())
             {
-                fprintf(stderr, "poll(): %d iterations\n", iterations);
-                return SLANG_FAIL;
+                continue;
             }
-
-            // Set a timeout of twenty seconds;
-            // we really shouldn't wait too long...
-            int pollTimeout = 20000;
-            int pollResult = poll(pollInfos, pollInfoCount, pollTimeout);
-            if (pollResult <= 0)
+            
+            const bool hasOpenOutput = process->m_fds[UnixProcess::StdOut] >= 0 || process->m_fds[UnixProcess::StdErr] >= 0;
+            if (!hasOpenOutput && !process->hasPendingStdIn())
             {
-                // If there was a signal that got in
-                // the way, then retry...
-                if (pollResult == -1 && errno == EINTR)
-                    continue;
-
-                // timeout or error...
-                fprintf(stderr, "error: `poll` failed or timed out\n");
-                return SLANG_FAIL;
+                // If only one process we can just block. We can't if stdin is open, as more may be written to it.
+                SLANG_RETURN_ON_FAIL(process->checkExited(processesCount == 1 && !process->hasOpenStreams()));
+                if (process->m_hasExited)
+                {
+                    // Nothing can be written to a process that has exited
+                    process->closeStream(UnixProcess::StdIn);
+                }
+                process->updateTerminated();
+                
+                hasTerminated = hasTerminated || process->isTerminated();
+                hasExitPending = hasExitPending || !process->isTerminated();
+                continue;
             }
 
-            enum { kBufferSize = 1024 };
-            char buffer[kBufferSize];
+            hasRunning = true;
 
-            if (pollInfos[0].revents)
+            for (Index j = 0; j < UnixProcess::CountOf; ++j)
             {
-                auto count = read(stdoutFD, buffer, kBufferSize);
-                if (count <= 0)
+                const int fd = process->m_fds[j];
+                // Only wait to write to stdin if there is something to write
+                if (fd >= 0 && (j != UnixProcess::StdIn || process->hasPendingStdIn()))
                 {
-                    // end-of-file
-                    close(stdoutFD);
-                    pollInfos[0].fd = -1;
-                    remainingCount--;
-                }
+                    pollfd info;
+                    info.fd = fd;
+                    info.events = (j == UnixProcess::StdIn) ? POLLOUT : POLLIN;
+                    info.revents = 0;
 
-                outExecuteResult.standardOutput.append(buffer, buffer + count);
+                    pollInfos.add(info);
+                    pollProcesses.add(process);
+                }
             }
+        }
 
-            if (pollInfos[1].revents)
+        if (hasTerminated)
+        {
+            return SLANG_OK;
+        }
+        if (!hasRunning && !hasExitPending)
+        {
+            // There is nothing to wait on
+            return SLANG_OK;
+        }
+
+        // Work out how long we can wait
+        int pollTimeOut = -1;
+        if (timeOutInMs >= 0)
+        {
+            const uint64_t elapsedTicks = ProcessUtil::getClockTick() - startTick;
+            if (elapsedTicks >= timeOutTicks)
             {
-                auto count = read(stderrFD, buffer, kBufferSize);
-                if (count <= 0)
+                // We always make at least one attempt at progress
+                if (!isFirst)
                 {
-                    // end-of-file
-                    close(stderrFD);
-                    pollInfos[1].fd = -1;
-                    remainingCount--;
+                    return SLANG_E_TIME_OUT;
                 }
-
-                outExecuteResult.standardError.append(buffer, buffer + count);
+                pollTimeOut = 0;
+            }
+            else
+            {
+                pollTimeOut = int(((timeOutTicks - elapsedTicks) * 1000) / ProcessUtil::getClockFrequency());
             }
         }
+        isFirst = false;
 
-        int childStatus = 0;
-        iterations = 0;
-        for (;;)
+        if (hasExitPending && (pollTimeOut < 0 || pollTimeOut > exitPollTimeOutInMs))
         {
-            // Safeguard against infinite loop:
-            iterations++;
-            if (iterations > 10000)
+            pollTimeOut = exitPollTimeOutInMs;
+        }
+
+        const int pollResult = poll(pollInfos.getBuffer(), nfds_t(pollInfos.getCount()), pollTimeOut);
+        if (pollResult < 0)
+        {
+            // If there was a signal that got in the way, then retry...
+            if (errno == EINTR)
             {
-                fprintf(stderr, "waitpid(): %d iterations\n", iterations);
-                return SLANG_FAIL;
+                continue;
             }
+            fprintf(stderr, "error: `poll` failed\n");
+            return SLANG_FAIL;
+        }
 
-            pid_t terminatedProcessID = waitpid(childProcessID, &childStatus, 0);
-            if (terminatedProcessID == -1)
+        bool hasOutput = false;
+        for (Index i = 0; i < pollInfos.getCount(); ++i)
+        {
+            const auto& info = pollInfos[i];
+            if (info.revents == 0)
             {
-                fprintf(stderr, "error: `waitpid` failed\n");
-                return SLANG_FAIL;
+                continue;
             }
 
-            if (terminatedProcessID == childProcessID)
+            UnixProcess* process = pollProcesses[i];
+            if (info.fd == process->m_fds[UnixProcess::StdIn])
             {
-                if (WIFEXITED(childStatus))
-                {
-                    outExecuteResult.resultCode = (int)(int8_t)WEXITSTATUS(childStatus);
-                }
-                else
-                {
-                    outExecuteResult.resultCode = 1;
-                }
-                return SLANG_OK;
+                process->flushStdIn();
             }
+            else if (info.fd == process->m_fds[UnixProcess::StdOut])
+            {
+                hasOutput = (process->readStream(UnixProcess::StdOut) > 0) || hasOutput;
+            }
+            else
+            {
+                process->readStream(UnixProcess::StdErr);
+            }
+        }
+
+        if (hasOutput && returnOnOutput)
+        {
+            return SLANG_OK;
         }
     }
+}
+
+/* static */SlangResult ProcessUtil::waitForAny(Process*const* processes, Index processesCount, Int timeOutInMs)
+{
+    return _wait(processes, processesCount, timeOutInMs, false);
+}
 
-    return SLANG_FAIL;
+/* static */SlangResult ProcessUtil::waitForOutput(Process*const* processes, Index processesCount, Int timeOutInMs)
+{
+    return _wait(processes, processesCount, timeOutInMs, true);
+}
+
+/* static */Index ProcessUtil::getProcessorCount()
+{
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? Index(count) : 1;
 }
 
 /* static */uint64_t ProcessUtil::getClockFrequency()
@@ -4,6 +4,8 @@
 #include "../slang-string.h"
 #include "../slang-string-escape-util.h"
 
+#include "../../../slang-com-helper.h"
+
 #ifdef _WIN32
 // Include Windows header in a way that minimized namespace pollution.
 // TODO: We could try to avoid including this at all, but it would
@@ -26,7 +28,9 @@ namespace { // anonymous
 struct ThreadInfo
 {
     HANDLE	file;
-    String	output;
+    CRITICAL_SECTION* lock;         ///< Guards output
+    HANDLE outputEvent;             ///< Set when output is added
+    String	output;                 ///< Output read that the process hasn't taken yet
 };
 
 // Has behavior very similar to unique_ptr - assignment is a move.
@@ -82,8 +86,6 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
     static const int kChunkSize = 1024;
     char buffer[kChunkSize];
 
-    StringBuilder outputBuilder;
-
     // We need to re-write the output to deal with line
     // endings, so we check for paired '\r' and '\n'
     // characters, which may span chunks.
@@ -138,14 +140,16 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
         }
         bytesRead = (DWORD)(writeCursor - buffer);
 
-        // Note: Current "core" implementation gives no way to know
-        // the length of the buffer, so we ultimately have
-        // to just assume null termination...
-        outputBuilder.Append(buffer, bytesRead);
+        if (bytesRead)
+        {
+            // Make the output available whilst the process is running
+            EnterCriticalSection(info->lock);
+            info->output.append(buffer, buffer + bytesRead);
+            SetEvent(info->outputEvent);
+            LeaveCriticalSection(info->lock);
+        }
     }
 
-    info->output = outputBuilder.ProduceString();
-
     return 0;
 }
 
@@ -176,17 +180,229 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
 
 #define SLANG_RETURN_FAIL_ON_FALSE(x) if (!(x)) return SLANG_FAIL;
 
-/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
+namespace { // anonymous
+
+struct WriterThreadInfo
+{
+    HANDLE file;
+    CRITICAL_SECTION* lock;         ///< Guards contents and isClosed
+    HANDLE event;                   ///< Set when contents are added or isClosed is set
+    String contents;                ///< Contents that haven't been written yet
+    bool isClosed;                  ///< If set the file is closed once contents are written
+};
+
+class WinProcess : public Process
+{
+public:
+        /// Checks if the process has completed. If it has, waits for the output to be read, and sets the result.
+    SlangResult checkTerminated();
+        /// Move output read by the reader threads into the result. Returns true if there was any standard output.
+    bool updateOutput();
+
+    virtual void kill() SLANG_OVERRIDE;
+    virtual void writeStdIn(const String& contents) SLANG_OVERRIDE;
+    virtual void closeStdIn() SLANG_OVERRIDE;
+
+    WinProcess()
+    {
+        InitializeCriticalSection(&m_lock);
+    }
+
+    ~WinProcess()
+    {
+        // Make sure the writer thread doesn't wait for more input
+        closeStdIn();
+
+        // The threads reference members, so we must wait for them to complete
+        for (HANDLE thread : { HANDLE(m_stdOutThread), HANDLE(m_stdErrThread), HANDLE(m_stdInThread) })
+        {
+            if (thread)
+            {
+                WaitForSingleObject(thread, INFINITE);
+            }
+        }
+        DeleteCriticalSection(&m_lock);
+    }
+
+        /// Guards the members shared with the threads
+    CRITICAL_SECTION m_lock;
+        /// Set when the reader threads have output
+    WinHandle m_outputEvent;
+        /// Set when there is more for the writer thread to do
+    WinHandle m_stdInEvent;
+
+    WinHandle m_process;
+
+    WinHandle m_stdOutThread;
+    WinHandle m_stdErrThread;
+    WinHandle m_stdInThread;
+
+    ThreadInfo m_stdOutThreadInfo;
+    ThreadInfo m_stdErrThreadInfo;
+    WriterThreadInfo m_stdInThreadInfo;
+
+    WinHandle m_stdOutRead;
+    WinHandle m_stdErrRead;
+};
+
+SlangResult WinProcess::checkTerminated()
+{
+    if (m_isTerminated || WaitForSingleObject(m_process, 0) != WAIT_OBJECT_0)
+    {
+        return SLANG_OK;
+    }
+
+    // get exit code for process
+    // https://docs.microsoft.com/en-us/windows/desktop/api/processthreadsapi/nf-processthreadsapi-getexitcodeprocess
+
+    DWORD childExitCode = 0;
+    if (!GetExitCodeProcess(m_process, &childExitCode))
+    {
+        return SLANG_FAIL;
+    }
+
+    // wait for the reader threads
+    WaitForSingleObject(m_stdOutThread, INFINITE);
+    WaitForSingleObject(m_stdErrThread, INFINITE);
+
+    updateOutput();
+    m_result.resultCode = childExitCode;
+
+    // Nothing more can be written to a process that has exited
+    closeStdIn();
+
+    m_isTerminated = true;
+    return SLANG_OK;
+}
+
+bool WinProcess::updateOutput()
+{
+    EnterCriticalSection(&m_lock);
+    ResetEvent(m_outputEvent);
+
+    const bool hasOutput = m_stdOutThreadInfo.output.getLength() > 0;
+
+    m_result.standardOutput.append(m_stdOutThreadInfo.output);
+    m_result.standardError.append(m_stdErrThreadInfo.output);
+    m_stdOutThreadInfo.output = String();
+    m_stdErrThreadInfo.output = String();
+
+    LeaveCriticalSection(&m_lock);
+    return hasOutput;
+}
+
+void WinProcess::writeStdIn(const String& contents)
+{
+    if (!m_stdInThread)
+    {
+        return;
+    }
+
+    EnterCriticalSection(&m_lock);
+    // Once closed (for example because the process has exited) there is nowhere for the contents to go
+    if (!m_stdInThreadInfo.isClosed)
+    {
+        // Copy the characters, so the string isn't shared with the writer thread 
+        m_stdInThreadInfo.contents.append(contents.begin(), contents.end());
+        SetEvent(m_stdInEvent);
+    }
+    LeaveCriticalSection(&m_lock);
+}
+
+void WinProcess::closeStdIn()
+{
+    if (!m_stdInThread)
+    {
+        return;
+    }
+
+    EnterCriticalSection(&m_lock);
+    m_stdInThreadInfo.isClosed = true;
+    SetEvent(m_stdInEvent);
+    LeaveCriticalSection(&m_lock);
+}
+
+void WinProcess::kill()
+{
+    if (m_isTerminated)
+    {
+        return;
+    }
+
+    // The reader and writer threads complete once the process has exited, as its ends of the pipes are closed
+    TerminateProcess(m_process, 1);
+    WaitForSingleObject(m_process, INFINITE);
+
+    if (SLANG_FAILED(checkTerminated()))
+    {
+        m_isTerminated = true;
+    }
+}
+
+} // anonymous
+
+static DWORD WINAPI _writerThreadProc(LPVOID threadParam)
 {
-    outExecuteResult.init();
+    WriterThreadInfo* info = (WriterThreadInfo*)threadParam;
+
+    for (;;)
+    {
+        // Take the contents to write, such that more can be added whilst writing
+        EnterCriticalSection(info->lock);
+        String contents = info->contents;
+        info->contents = String();
+        const bool isClosed = info->isClosed;
+        LeaveCriticalSection(info->lock);
+
+        if (contents.getLength() == 0)
+        {
+            if (isClosed)
+            {
+                break;
+            }
+            WaitForSingleObject(info->event, INFINITE);
+            continue;
+        }
+
+        const char* cur = contents.getBuffer();
+        const char* end = cur + contents.getLength();
+
+        bool isBroken = false;
+        while (cur < end)
+        {
+            const DWORD chunkSize = DWORD(((end - cur) > 0x10000) ? 0x10000 : (end - cur));
+            DWORD bytesWritten = 0;
+            if (!WriteFile(info->file, cur, chunkSize, &bytesWritten, nullptr))
+            {
+                // The process isn't reading its input (perhaps it has exited).
+                isBroken = true;
+                break;
+            }
+            cur += bytesWritten;
+        }
 
+        if (isBroken)
+        {
+            break;
+        }
+    }
+
+    // Closing signals end of input
+    CloseHandle(info->file);
+    info->file = nullptr;
+    return 0;
+}
+
+
+/* static */SlangResult ProcessUtil::createProcess(const CommandLine& commandLine, const String& stdinContents, Process::Flags flags, RefPtr<Process>& outProcess)
+{
     SECURITY_ATTRIBUTES securityAttributes;
     securityAttributes.nLength = sizeof(securityAttributes);
     securityAttributes.lpSecurityDescriptor = nullptr;
     securityAttributes.bInheritHandle = true;
 
-    WinHandle childStdOutRead;
-    WinHandle childStdErrRead;
+    RefPtr<WinProcess> process = new WinProcess;
+
     WinHandle childStdInWrite;
     
     // Now we can actually get around to starting a process
@@ -211,13 +427,12 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
             HANDLE currentProcess = GetCurrentProcess();
 
             // create a non-inheritable duplicate of the stdout reader        
-            SLANG_RETURN_FAIL_ON_FALSE(DuplicateHandle(currentProcess, childStdOutReadTmp, currentProcess, childStdOutRead.writeRef(), 0, FALSE, DUPLICATE_SAME_ACCESS));
+            SLANG_RETURN_FAIL_ON_FALSE(DuplicateHandle(currentProcess, childStdOutReadTmp, currentProcess, process->m_stdOutRead.writeRef(), 0, FALSE, DUPLICATE_SAME_ACCESS));
             // create a non-inheritable duplicate of the stderr reader
-            SLANG_RETURN_FAIL_ON_FALSE(DuplicateHandle(currentProcess, childStdErrReadTmp, currentProcess, childStdErrRead.writeRef(), 0, FALSE, DUPLICATE_SAME_ACCESS));
+            SLANG_RETURN_FAIL_ON_FALSE(DuplicateHandle(currentProcess, childStdErrReadTmp, currentProcess, process->m_stdErrRead.writeRef(), 0, FALSE, DUPLICATE_SAME_ACCESS));
             // create a non-inheritable duplicate of the stdin writer
             SLANG_RETURN_FAIL_ON_FALSE(DuplicateHandle(currentProcess, childStdInWriteTmp, currentProcess, childStdInWrite.writeRef(), 0, FALSE, DUPLICATE_SAME_ACCESS));
         }
-
         
         // TODO: switch to proper wide-character versions of these...
         STARTUPINFOW startupInfo;
@@ -270,43 +485,132 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
         CloseHandle(processInfo.hThread);
     }
 
+    process->m_process = processInfo.hProcess;
+
+    // A manual reset event, that is reset when the output is taken
+    process->m_outputEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    SLANG_RETURN_FAIL_ON_FALSE(process->m_outputEvent);
+
+    for (ThreadInfo* info : { &process->m_stdOutThreadInfo, &process->m_stdErrThreadInfo })
+    {
+        info->lock = &process->m_lock;
+        info->outputEvent = process->m_outputEvent;
+    }
+
     // Create a thread to read from the child's stdout.
-    ThreadInfo stdOutThreadInfo;
-    stdOutThreadInfo.file = childStdOutRead;
-    WinHandle stdOutThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&stdOutThreadInfo, 0, nullptr);
+    process->m_stdOutThreadInfo.file = process->m_stdOutRead;
+    process->m_stdOutThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&process->m_stdOutThreadInfo, 0, nullptr);
 
     // Create a thread to read from the child's stderr.
-    ThreadInfo stdErrThreadInfo;
-    stdErrThreadInfo.file = childStdErrRead;
-    WinHandle stdErrThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&stdErrThreadInfo, 0, nullptr);
+    process->m_stdErrThreadInfo.file = process->m_stdErrRead;
+    process->m_stdErrThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&process->m_stdErrThreadInfo, 0, nullptr);
 
-    // wait for the process to exit
-    // TODO: set a timeout as a safety measure...
-    WaitForSingleObject(processInfo.hProcess, INFINITE);
+    // If there is any input (or may be later), create a thread to write it to the child's stdin, else just closing
+    // the handle means the child will see the end of input.
+    const bool keepStdInOpen = (flags & Process::Flag::KeepStdInOpen) != 0;
+    if (stdinContents.getLength() || keepStdInOpen)
+    {
+        process->m_stdInEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        SLANG_RETURN_FAIL_ON_FALSE(process->m_stdInEvent);
+
+        // The thread takes ownership of the handle
+        auto& info = process->m_stdInThreadInfo;
+        info.file = childStdInWrite.detach();
+        info.lock = &process->m_lock;
+        info.event = process->m_stdInEvent;
+        info.contents = stdinContents;
+        info.isClosed = !keepStdInOpen;
+        process->m_stdInThread = CreateThread(nullptr, 0, &_writerThreadProc, (LPVOID)&info, 0, nullptr);
+    }
 
-    // get exit code for process
-    // https://docs.microsoft.com/en-us/windows/desktop/api/processthreadsapi/nf-processthreadsapi-getexitcodeprocess
+    outProcess = process;
+    return SLANG_OK;
+}
 
-    DWORD childExitCode = 0;
-    if (!GetExitCodeProcess(processInfo.hProcess, &childExitCode))
+static SlangResult _wait(Process*const* processes, Index processesCount, Int timeOutInMs, bool returnOnOutput)
+{
+    List<HANDLE> handles;
+    List<WinProcess*> waitProcesses;
+
+    // Output read whilst the process is running is taken when waiting, so waitForAny needs to
+    // wake up on output too, to stop it accumulating in the threads.
+    const Index handlesPerProcess = 2;
+
+    for (Index i = 0; i < processesCount; ++i)
     {
-        // TODO(JS): Do we want to close here? It seems plausible because just because reading the exit code failed, doesn't mean the handle is closed
-        CloseHandle(processInfo.hProcess);
+        WinProcess* process = static_cast<WinProcess*>(processes[i]);
+        if (!process->isTerminated())
+        {
+            handles.add(process->m_process);
+            handles.add(process->m_outputEvent);
+            waitProcesses.add(process);
+        }
+    }
 
-        return SLANG_FAIL;
+    if (handles.getCount() == 0)
+    {
+        return SLANG_OK;
     }
 
-    // wait for the reader threads
-    WaitForSingleObject(stdOutThread, INFINITE);
-    WaitForSingleObject(stdErrThread, INFINITE);
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    const uint64_t timeOutTicks = (timeOutInMs < 0) ? 0 : (uint64_t(timeOutInMs) * ProcessUtil::getClockFrequency()) / 1000;
+
+    // We can only wait on a limited amount of handles. If there are more we will just wait on the first ones.
+    const Index maxWaitCount = (MAXIMUM_WAIT_OBJECTS / handlesPerProcess) * handlesPerProcess;
+    const DWORD waitCount = DWORD((handles.getCount() > maxWaitCount) ? maxWaitCount : handles.getCount());
 
-    CloseHandle(processInfo.hProcess);
+    for (;;)
+    {
+        DWORD waitTimeOut = INFINITE;
+        if (timeOutInMs >= 0)
+        {
+            const uint64_t elapsedTicks = ProcessUtil::getClockTick() - startTick;
+            waitTimeOut = (elapsedTicks >= timeOutTicks) ? 0 : DWORD(((timeOutTicks - elapsedTicks) * 1000) / ProcessUtil::getClockFrequency());
+        }
 
-    outExecuteResult.standardOutput = stdOutThreadInfo.output;
-    outExecuteResult.standardError = stdErrThreadInfo.output;
-    outExecuteResult.resultCode = childExitCode;
+        const DWORD waitResult = WaitForMultipleObjects(waitCount, handles.getBuffer(), FALSE, waitTimeOut);
 
-    return SLANG_OK;
+        if (waitResult == WAIT_TIMEOUT)
+        {
+            return SLANG_E_TIME_OUT;
+        }
+        if (waitResult == WAIT_FAILED)
+        {
+            return SLANG_FAIL;
+        }
+
+        // More than one may have output or terminated, so check them all
+        bool hasOutput = false;
+        bool hasTerminated = false;
+        for (auto process : waitProcesses)
+        {
+            hasOutput = process->updateOutput() || hasOutput;
+            SLANG_RETURN_ON_FAIL(process->checkTerminated());
+            hasTerminated = hasTerminated || process->isTerminated();
+        }
+
+        if (hasTerminated || (hasOutput && returnOnOutput))
+        {
+            return SLANG_OK;
+        }
+    }
+}
+
+/* static */SlangResult ProcessUtil::waitForAny(Process*const* processes, Index processesCount, Int timeOutInMs)
+{
+    return _wait(processes, processesCount, timeOutInMs, false);
+}
+
+/* static */SlangResult ProcessUtil::waitForOutput(Process*const* processes, Index processesCount, Int timeOutInMs)
+{
+    return _wait(processes, processesCount, timeOutInMs, true);
+}
+
+/* static */Index ProcessUtil::getProcessorCount()
+{
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return (systemInfo.dwNumberOfProcessors > 0) ? Index(systemInfo.dwNumberOfProcessors) : 1;
 }
 
 static uint64_t _getClockFrequency()
@@ -473,6 +473,51 @@ static int glslang_dissassembleSPIRV(const glslang_CompileRequest_1_1& request)
     return 0;
 }
 
+static int glslang_validateSPIRV(const glslang_CompileRequest_1_1& request)
+{
+    typedef unsigned int SPIRVWord;
+
+    SPIRVWord const* spirvBegin = (SPIRVWord const*)request.inputBegin;
+    SPIRVWord const* spirvEnd   = (SPIRVWord const*)request.inputEnd;
+
+    // Validate for the version of Vulkan that accepts the version of SPIR-V in the header
+    const SPIRVWord version = (spirvEnd - spirvBegin > 1) ? spirvBegin[1] : 0;
+    spv_target_env targetEnv = SPV_ENV_VULKAN_1_1;
+    if (version >= 0x10500)
+    {
+        targetEnv = SPV_ENV_UNIVERSAL_1_5;
+    }
+    else if (version >= 0x10400)
+    {
+        targetEnv = SPV_ENV_VULKAN_1_1_SPIRV_1_4;
+    }
+
+    std::string log;
+    spvtools::SpirvTools tools(targetEnv);
+    tools.SetMessageConsumer(
+        [&](spv_message_level_t level, const char* source, const spv_position_t& position, const char* message) {
+        SLANG_UNUSED(source);
+        log += (level == SPV_MSG_WARNING || level == SPV_MSG_INFO || level == SPV_MSG_DEBUG) ? "warning: " : "error: ";
+        log += std::to_string(position.index) + ": ";
+        log += message ? message : "";
+        log += "\n";
+    });
+
+    if (tools.Validate(spirvBegin, size_t(spirvEnd - spirvBegin)))
+    {
+        return 0;
+    }
+
+    // Something is always reported on failure, so that it can be told apart from
+    // a library that doesn't support validation
+    if (log.empty())
+    {
+        log = "error: invalid SPIR-V\n";
+    }
+    dumpDiagnostics(request, log);
+    return 1;
+}
+
 // We need a per process initialization
 class ProcessInitializer
 {
@@ -525,6 +570,10 @@ static int _compile(const glslang_CompileRequest_1_1& request)
         case GLSLANG_ACTION_DISSASSEMBLE_SPIRV:
             result = glslang_dissassembleSPIRV(request);
             break;
+
+        case GLSLANG_ACTION_VALIDATE_SPIRV:
+            result = glslang_validateSPIRV(request);
+            break;
     }
 
     return result;
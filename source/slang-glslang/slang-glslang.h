@@ -10,6 +10,9 @@ enum
 {
     GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV,
     GLSLANG_ACTION_DISSASSEMBLE_SPIRV,
+        /// Validate the SPIR-V input for Vulkan. Problems found are written to the diagnostic function,
+        /// and the result is non-zero if there are any.
+    GLSLANG_ACTION_VALIDATE_SPIRV,
 };
 
 struct glsl_SPIRVVersion
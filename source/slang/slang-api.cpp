@@ -447,6 +447,14 @@ SLANG_API SlangResult spGetDiagnosticOutputBlob(
     return request->getDiagnosticOutputBlob(outBlob);
 }
 
+SLANG_API SlangResult spGetMemoryReport(
+    slang::ICompileRequest*    request,
+    ISlangBlob**            outReport)
+{
+    SLANG_ASSERT(request);
+    return request->getMemoryReport(outReport);
+}
+
 // New-fangled compilation API
 
 SLANG_API int spAddTranslationUnit(
@@ -48,6 +48,44 @@ void SharedASTBuilder::init(Session* session)
     }
 }
 
+void SharedASTBuilder::initSharing(Session* session, SharedASTBuilder* source)
+{
+    m_namePool = session->getNamePool();
+    m_session = session;
+    m_sharedFrom = source;
+
+    {
+        RefPtr<ASTBuilder> astBuilder(new ASTBuilder);
+        astBuilder->m_sharedASTBuilder = this;
+        m_astBuilder = astBuilder.detach();
+    }
+
+    // Make sure the lazily created types exist on the source, so that they
+    // are shared too, rather than being created again from the stdlib decls.
+    source->getStringType();
+    source->getEnumTypeType();
+    source->getDynamicType();
+
+    m_errorType = source->m_errorType;
+    m_initializerListType = source->m_initializerListType;
+    m_overloadedType = source->m_overloadedType;
+
+    m_stringType = source->m_stringType;
+    m_enumTypeType = source->m_enumTypeType;
+    m_dynamicType = source->m_dynamicType;
+
+    ::memcpy(m_builtinTypes, source->m_builtinTypes, sizeof(m_builtinTypes));
+
+    m_magicDecls = source->m_magicDecls;
+
+    // The names are shared between the name pools, so the maps can just be copied
+    m_sliceToTypeMap = source->m_sliceToTypeMap;
+    m_nameToTypeMap = source->m_nameToTypeMap;
+
+    // Continue numbering builders from where the source is
+    m_id = source->m_id;
+}
+
 const ReflectClassInfo* SharedASTBuilder::findClassInfo(const UnownedStringSlice& slice)
 {
     const ReflectClassInfo* typeInfo;
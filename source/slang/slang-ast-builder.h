@@ -43,6 +43,12 @@ public:
         /// Must be called before used
     void init(Session* session);
 
+        /// Alternative to `init`, for a `session` that shares the stdlib of `source`'s session.
+        ///
+        /// The builtin and magic types/decls of `source` are referenced (not copied), and
+        /// `source` is kept alive for as long as this builder is.
+    void initSharing(Session* session, SharedASTBuilder* source);
+
     SharedASTBuilder();
 
     ~SharedASTBuilder();
@@ -79,6 +85,9 @@ protected:
     ASTBuilder* m_astBuilder = nullptr;
     Session* m_session = nullptr;
 
+    // If set, the builder the shared types and decls are taken from
+    RefPtr<SharedASTBuilder> m_sharedFrom;
+
     Index m_id = 1;
 };
 
@@ -926,6 +926,14 @@ class RequiresNVAPIAttribute : public Attribute
     SLANG_AST_CLASS(RequiresNVAPIAttribute)
 };
 
+    /// A `[__requiresQuad]` attribute indicates that the declaration being modified
+    /// needs the values from the other threads of a 2x2 quad (such as derivatives), so
+    /// needs quad execution on targets (such as CPU) that don't run threads in lockstep.
+class RequiresQuadAttribute : public Attribute
+{
+    SLANG_AST_CLASS(RequiresQuadAttribute)
+};
+
     /// Indicates that the modified declaration is one of the "magic" declarations
     /// that NVAPI uses to communicate extended operations. When NVAPI is being included
     /// via the prelude for downstream compilation, declarations with this modifier
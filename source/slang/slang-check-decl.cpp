@@ -672,6 +672,17 @@ namespace Slang
     // Note that this may lead to us recursively invoking checking,
     // so this may not be the best way to handle things.
     void SemanticsVisitor::ensureDecl(Decl* decl, DeclCheckState state)
+    {
+        // Any reference to a function whose body checking is deferred means the
+        // body will need to be checked (even if the function is already checked
+        // far enough for this reference).
+        //
+        getShared()->noteReferenced(decl);
+
+        ensureDeclWithoutReference(decl, state);
+    }
+
+    void SemanticsVisitor::ensureDeclWithoutReference(Decl* decl, DeclCheckState state)
     {
         // If the `decl` has already been checked up to or beyond `state`
         // then there is nothing for us to do.
@@ -772,8 +783,13 @@ namespace Slang
         Decl*                       decl,
         DeclCheckState              state)
     {
+        // The body of a function is only checked as part of pushing it to `Checked`,
+        // so a function whose body checking is deferred stays where it is.
+        if (state == DeclCheckState::Checked && visitor->getShared()->shouldDeferBody(decl))
+            return;
+
         // Ensure `decl` itself first.
-        visitor->ensureDecl(decl, state);
+        visitor->ensureDeclWithoutReference(decl, state);
 
         // If `decl` is a container, then we want to ensure its children.
         if(auto containerDecl = as<ContainerDecl>(decl))
@@ -1347,11 +1363,58 @@ namespace Slang
             _ensureAllDeclsRec(this, moduleDecl, s);
         }
 
+        // If checking function bodies is deferred, the loop above skipped the
+        // bodies of any functions that weren't referenced when they were reached.
+        // We now check the bodies of all the functions that have been referenced.
+        // Doing so can reference more functions, which are added to the end of the
+        // list, so we keep going until no more are added.
+        //
+        {
+            const auto& referencedFunctions = getShared()->m_referencedFunctions;
+            for (Index i = 0; i < referencedFunctions.getCount(); ++i)
+            {
+                _ensureAllDeclsRec(this, referencedFunctions[i], DeclCheckState::Checked);
+            }
+        }
+
         // Once we have completed the above loop, all declarations not
         // nested in function bodies should be in `DeclState::Checked`.
         // Furthermore, because a fully checked function will have checked
         // its body, this also means that all function bodies and the
         // declarations they contain should be fully checked.
+        //
+        // The exception is when checking function bodies is deferred, where
+        // functions that are never referenced are left unchecked.
+    }
+
+    Decl* SharedSemanticsContext::getDeferrableFunction(Decl* decl)
+    {
+        Decl* outerDecl = decl;
+        FuncDecl* funcDecl = nullptr;
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            funcDecl = as<FuncDecl>(genericDecl->inner);
+        }
+        else
+        {
+            funcDecl = as<FuncDecl>(decl);
+            if (funcDecl && as<GenericDecl>(decl->parentDecl))
+            {
+                outerDecl = decl->parentDecl;
+            }
+        }
+
+        // Only functions at the global scope of the module being checked are deferred. Functions
+        // nested in types may be needed to satisfy interface requirements, and other modules
+        // have all their functions checked.
+        if (!funcDecl || !m_module || outerDecl->parentDecl != m_module->getModuleDecl())
+            return nullptr;
+
+        // Entry points are where checking starts from
+        if (funcDecl->hasModifier<EntryPointAttribute>())
+            return nullptr;
+
+        return outerDecl;
     }
 
     bool SemanticsVisitor::doesSignatureMatchRequirement(
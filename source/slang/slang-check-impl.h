@@ -223,6 +223,15 @@ namespace Slang
         List<ModuleDecl*> importedModulesList;
         HashSet<ModuleDecl*> importedModulesSet;
 
+            /// If set, checking the bodies of global functions (other than entry points)
+            /// in `m_module` is deferred until they are referenced.
+        bool m_deferFunctionBodies = false;
+
+            /// The deferrable functions that have been referenced, in the order they were
+            /// first referenced (only tracked if `m_deferFunctionBodies` is set)
+        List<Decl*> m_referencedFunctions;
+        HashSet<Decl*> m_referencedFunctionSet;
+
     public:
         SharedSemanticsContext(
             Linkage*        linkage,
@@ -248,6 +257,28 @@ namespace Slang
             return m_module;
         }
 
+            /// If `decl` is (or is the inner declaration of) a global function whose body can be
+            /// checked lazily, returns that function (or the generic holding it). Else returns nullptr.
+        Decl* getDeferrableFunction(Decl* decl);
+
+            /// Note that `decl` is referenced, and so (if deferrable) its body will need to be checked
+        void noteReferenced(Decl* decl)
+        {
+            if (!m_deferFunctionBodies)
+                return;
+            if (auto funcDecl = getDeferrableFunction(decl))
+            {
+                if (m_referencedFunctionSet.Add(funcDecl))
+                    m_referencedFunctions.add(funcDecl);
+            }
+        }
+
+            /// True if checking the body of `decl` should be deferred, as it hasn't been referenced (yet)
+        bool shouldDeferBody(Decl* decl)
+        {
+            return m_deferFunctionBodies && getDeferrableFunction(decl) == decl && !m_referencedFunctionSet.Contains(decl);
+        }
+
             /// Get the list of extension declarations that appear to apply to `decl` in this context
         List<ExtensionDecl*> const& getCandidateExtensionsForTypeDecl(AggTypeDecl* decl);
 
@@ -457,6 +488,11 @@ namespace Slang
             ///
         void ensureDecl(Decl* decl, DeclCheckState state);
 
+            /// As `ensureDecl`, but without treating `decl` as being referenced (which matters
+            /// when checking of function bodies is deferred). Used to check all the declarations
+            /// of a module.
+        void ensureDeclWithoutReference(Decl* decl, DeclCheckState state);
+
             /// Helper routine allowing `ensureDecl` to be called on a `DeclRef`
         void ensureDecl(DeclRefBase const& declRef, DeclCheckState state)
         {
@@ -172,6 +172,32 @@ namespace Slang
             translationUnit->getModule(),
             translationUnit->compileRequest->getSink());
 
+        auto compileRequest = translationUnit->compileRequest;
+
+        // Checking of function bodies can only be deferred when we know where to start
+        // from, so it requires the entry points to be specified explicitly.
+        if ((compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING) &&
+            compileRequest->getEntryPointReqCount())
+        {
+            sharedSemanticsContext.m_deferFunctionBodies = true;
+
+            // Functions named by entry point requests are referenced from the outset
+            auto moduleDecl = translationUnit->getModuleDecl();
+            for (auto entryPointReq : compileRequest->getEntryPointReqs())
+            {
+                if (entryPointReq->getTranslationUnit() != translationUnit)
+                    continue;
+
+                for (auto memberDecl : moduleDecl->members)
+                {
+                    if (memberDecl->getName() == entryPointReq->getName())
+                    {
+                        sharedSemanticsContext.noteReferenced(memberDecl);
+                    }
+                }
+            }
+        }
+
         SemanticsDeclVisitorBase visitor(&sharedSemanticsContext);
 
         // Apply the visitor to do the main semantic
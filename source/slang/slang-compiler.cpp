@@ -98,7 +98,8 @@ namespace Slang
                 }
                 case ResultFormat::Text:
                 {
-                    blob = StringUtil::createStringBlob(outputString);
+                    // If the text is in more than one chunk, this is the only time it's copied
+                    blob = StringUtil::createStringBlob(outputText.flatten());
                     break;
                 }
                 case ResultFormat::Binary:
@@ -543,9 +544,9 @@ namespace Slang
         CodeGenTarget           target,
         EndToEndCompileRequest* endToEndReq,
         ExtensionTracker*       extensionTracker, 
-        String&                 outSource)
+        StringRope&             outSource)
     {
-        outSource = String();
+        outSource.clear();
 
         if(isPassThroughEnabled(endToEndReq))
         {
@@ -588,7 +589,7 @@ namespace Slang
                     }
                 }
 
-                outSource = codeBuilder.ProduceString();
+                outSource.appendChunk(codeBuilder.ProduceString());
             }
             return SLANG_OK;
         }
@@ -611,7 +612,7 @@ namespace Slang
         CodeGenTarget           target,
         EndToEndCompileRequest* endToEndReq,
         ExtensionTracker*       extensionTracker,
-        String&                 outSource)
+        StringRope&             outSource)
     {
         List<Int> entryPointIndices;
         entryPointIndices.add(entryPointIndex);
@@ -1053,7 +1054,10 @@ namespace Slang
                 // If it's not file based we can set an appropriate path name, and it doesn't matter if it doesn't
                 // exist on the file system
                 options.sourceContentsPath = calcSourcePathForEntryPoints(endToEndReq, entryPointIndices);
-                SLANG_RETURN_ON_FAIL(emitEntryPointsSource(slangRequest, entryPointIndices, targetReq, sourceTarget, endToEndReq, extensionTracker, options.sourceContents));
+
+                StringRope source;
+                SLANG_RETURN_ON_FAIL(emitEntryPointsSource(slangRequest, entryPointIndices, targetReq, sourceTarget, endToEndReq, extensionTracker, source));
+                options.sourceContents = source.flatten();
             }
             else
             {
@@ -1069,7 +1073,10 @@ namespace Slang
         }
         else
         {
-            SLANG_RETURN_ON_FAIL(emitEntryPointsSource(slangRequest, entryPointIndices, targetReq, sourceTarget, endToEndReq, extensionTracker, options.sourceContents));
+            // Downstream compilers need the source in a single buffer
+            StringRope source;
+            SLANG_RETURN_ON_FAIL(emitEntryPointsSource(slangRequest, entryPointIndices, targetReq, sourceTarget, endToEndReq, extensionTracker, source));
+            options.sourceContents = source.flatten();
             maybeDumpIntermediate(slangRequest, options.sourceContents.getBuffer(), sourceTarget);
         }
 
@@ -1211,6 +1218,13 @@ namespace Slang
                 default: SLANG_ASSERT(!"Unhandled floating point mode");
             }
 
+            switch (session->getDownstreamCompilerStaging())
+            {
+                case SLANG_DOWNSTREAM_STAGING_DEFAULT:  options.stagingMode = DownstreamCompiler::StagingMode::Default; break;
+                case SLANG_DOWNSTREAM_STAGING_MEMORY:   options.stagingMode = DownstreamCompiler::StagingMode::Memory; break;
+                default: SLANG_ASSERT(!"Unhandled downstream staging");
+            }
+
             {
                 // We need to look at the stage of the entry point(s) we are
                 // being asked to compile, since this will determine the
@@ -1519,7 +1533,7 @@ namespace Slang
             {
                 RefPtr<ExtensionTracker> extensionTracker = _newExtensionTracker(target);
 
-                String code;
+                StringRope code;
                 if (SLANG_FAILED(emitEntryPointsSource(compileRequest,
                     entryPointIndices,
                     targetReq,
@@ -1531,7 +1545,11 @@ namespace Slang
                     return result;
                 }
 
-                maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
+                if (compileRequest->shouldDumpIntermediates)
+                {
+                    const String text = code.flatten();
+                    maybeDumpIntermediate(compileRequest, text.getBuffer(), text.getLength(), target);
+                }
                 result = CompileResult(code);
             }
             break;
@@ -1628,6 +1646,29 @@ namespace Slang
         fclose(file);
     }
 
+    static void writeOutputFile(
+        BackEndCompileRequest*  compileRequest,
+        String const&           path,
+        StringRope const&       text)
+    {
+        FILE* file = fopen(path.getBuffer(), "w");
+        if (!file)
+        {
+            compileRequest->getSink()->diagnose(
+                SourceLoc(),
+                Diagnostics::cannotWriteOutputFile,
+                path);
+            return;
+        }
+
+        // Write the text a chunk at a time, so it never has to be made contiguous
+        for (const auto& chunk : text.getChunks())
+        {
+            writeOutputFile(compileRequest, file, path, chunk.getBuffer(), size_t(chunk.getLength()));
+        }
+        fclose(file);
+    }
+
     static void writeCompileResultToFile(
         BackEndCompileRequest* compileRequest,
         String const& outputPath,
@@ -1637,12 +1678,9 @@ namespace Slang
         {
         case ResultFormat::Text:
             {
-                auto text = result.outputString;
                 writeOutputFile(compileRequest,
                     outputPath,
-                    text.begin(),
-                    text.end() - text.begin(),
-                    OutputFileKind::Text);
+                    result.outputText);
             }
             break;
 
@@ -1686,6 +1724,13 @@ namespace Slang
         writer->write(text.getBuffer(), text.getLength());
     }
 
+    static void writeOutputToConsole(
+        ISlangWriter*       writer,
+        StringRope const&   text)
+    {
+        text.writeTo(writer);
+    }
+
     static void writeCompileRequestToStandardOutput(
         EndToEndCompileRequest* compileRequest,
         TargetRequest* targetReq,
@@ -1697,7 +1742,7 @@ namespace Slang
         switch (result.format)
         {
         case ResultFormat::Text:
-            writeOutputToConsole(writer, result.outputString);
+            writeOutputToConsole(writer, result.outputText);
             break;
 
         case ResultFormat::Binary:
@@ -5,6 +5,7 @@
 #include "../core/slang-shared-library.h"
 #include "../core/slang-archive-file-system.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-string-rope.h"
 
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-name.h"
@@ -143,16 +144,19 @@ namespace Slang
     {
     public:
         CompileResult() = default;
-        explicit CompileResult(String const& str) : format(ResultFormat::Text), outputString(str) {}
+        explicit CompileResult(String const& str) : format(ResultFormat::Text) { outputText.appendChunk(str); }
+        explicit CompileResult(StringRope const& text) : format(ResultFormat::Text) { outputText.appendRope(text); }
         explicit CompileResult(ISlangBlob* inBlob) : format(ResultFormat::Binary), blob(inBlob) {}
         explicit CompileResult(DownstreamCompileResult* inDownstreamResult): format(ResultFormat::Binary), downstreamResult(inDownstreamResult) {}
-        explicit CompileResult(const UnownedStringSlice& slice ) : format(ResultFormat::Text), outputString(slice) {}
+        explicit CompileResult(const UnownedStringSlice& slice ) : format(ResultFormat::Text) { outputText.append(slice); }
 
         SlangResult getBlob(ComPtr<ISlangBlob>& outBlob) const;
         SlangResult getSharedLibrary(ComPtr<ISlangSharedLibrary>& outSharedLibrary);
 
         ResultFormat format = ResultFormat::None;
-        String outputString;                    ///< Only set if result type is ResultFormat::Text
+            /// Only set if result type is ResultFormat::Text. The text is held in chunks, and is
+            /// only made contiguous if a blob is requested.
+        mutable StringRope outputText;
 
         mutable ComPtr<ISlangBlob> blob;
 
@@ -265,7 +269,7 @@ namespace Slang
         /// Base class for "component types" that represent the pieces a final
         /// shader program gets linked together from.
         ///
-    class ComponentType : public RefObject, public slang::IComponentType
+    class ComponentType : public RefObject, public slang::IComponentType, public slang::IComponentType2
     {
     public:
         //
@@ -302,6 +306,19 @@ namespace Slang
             ISlangSharedLibrary**   outSharedLibrary,
             slang::IBlob**          outDiagnostics) SLANG_OVERRIDE;
 
+        //
+        // slang::IComponentType2 interface
+        //
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCode(
+            SlangInt        targetIndex,
+            slang::IBlob**  outCode,
+            slang::IBlob**  outDiagnostics) SLANG_OVERRIDE;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getTargetHostCallable(
+            int                     targetIndex,
+            ISlangSharedLibrary**   outSharedLibrary,
+            slang::IBlob**          outDiagnostics) SLANG_OVERRIDE;
+
             /// Get the linkage (aka "session" in the public API) for this component type.
         Linkage* getLinkage() { return m_linkage; }
 
@@ -1146,6 +1163,14 @@ namespace Slang
         Precise = SLANG_FLOATING_POINT_MODE_PRECISE,
     };
 
+        /// How the C/C++ targets handle buffer and array accesses that might be out of bounds
+    enum class BoundsCheckMode
+    {
+        Default,    ///< Only checked by asserts in the prelude, which are typically disabled in release builds
+        Clamp,      ///< The index is clamped to the last element
+        Trap,       ///< A failure (with the source location of the access) is reported, which by default aborts
+    };
+
     enum class WriterChannel : SlangWriterChannel
     {
         Diagnostic = SLANG_WRITER_CHANNEL_DIAGNOSTIC,
@@ -1314,6 +1339,8 @@ namespace Slang
             uint32_t*              outId) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryReport(
+            ISlangBlob** outReport) override;
 
         void addTarget(
             slang::TargetDesc const& desc);
@@ -1352,6 +1379,18 @@ namespace Slang
 
         bool m_obfuscateCode = false;
 
+            /// If true the linked IR is compacted at every point it can be, rather than only when
+            /// dead instructions hold enough of its memory. Used to test compaction.
+        bool m_shouldAlwaysCompactIR = false;
+
+            /// If true small functions are inlined for the CPU and CUDA targets below `-O2`,
+            /// where they otherwise aren't.
+        bool m_shouldInlineFunctions = false;
+
+            /// If > 0 the function definitions of HLSL and GLSL output are emitted independently of each other,
+            /// on this many threads. The output doesn't depend on the number of threads.
+        Index m_emitThreadCount = 0;
+
         // Determine whether to output heterogeneity-related code
         bool m_heterogeneous = false;
 
@@ -1398,6 +1437,13 @@ namespace Slang
         // The resulting specialized IR module for each entry point request
         List<RefPtr<IRModule>> compiledModules;
 
+            /// Record that back-end compilation was holding `bytes` of IR, keeping track of the peak
+        void noteBackEndIRMemoryUsed(size_t bytes) { m_peakBackEndIRMemoryUsed = Math::Max(m_peakBackEndIRMemoryUsed, bytes); }
+            /// The most IR memory held by a single back-end compilation so far
+        size_t getPeakBackEndIRMemoryUsed() const { return m_peakBackEndIRMemoryUsed; }
+
+        size_t m_peakBackEndIRMemoryUsed = 0;
+
         /// File system implementation to use when loading files from disk.
         ///
         /// If this member is `null`, a default implementation that tries
@@ -1453,6 +1499,11 @@ namespace Slang
             /// Load a module of the given name.
         Module* loadModule(String const& name);
 
+            /// Find the module imported as `name`, loading (parsing and checking) it if needed.
+            ///
+            /// Imports are loaded depth first, one at a time, on the calling thread. They aren't
+            /// loaded concurrently, because parsing and checking share the linkage's name pool,
+            /// source manager and AST builder, and the diagnostic sink, none of which are thread safe.
         RefPtr<Module> findOrImportModule(
             Name*               name,
             SourceLoc const&    loc,
@@ -1488,6 +1539,8 @@ namespace Slang
 
         OptimizationLevel optimizationLevel = OptimizationLevel::Default;
 
+        BoundsCheckMode boundsCheckMode = BoundsCheckMode::Default;
+
         SerialCompressionType serialCompressionType = SerialCompressionType::VariableByteLite;
 
         bool m_requireCacheFileSystem = false;
@@ -1895,6 +1948,9 @@ namespace Slang
             /// Should SPIR-V be generated directly from Slang IR rather than via translation to GLSL?
         bool shouldEmitSPIRVDirectly = false;
 
+            /// Should SPIR-V that is generated directly be validated (with the SPIR-V tools in slang-glslang)?
+        bool shouldValidateSPIRV = false;
+
 
         // If true will disable generics/existential value specialization pass.
         bool disableSpecialization = false;
@@ -1990,6 +2046,7 @@ namespace Slang
         virtual SLANG_NO_THROW void SLANG_MCALL setTargetLineDirectiveMode(
             SlangInt targetIndex,
             SlangLineDirectiveMode mode) SLANG_OVERRIDE;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryReport(ISlangBlob** outReport) SLANG_OVERRIDE;
 
         EndToEndCompileRequest(
             Session* session);
@@ -2028,6 +2085,9 @@ namespace Slang
             /// If set, if a compilation failure occurs will attempt to save off a dump repro with a unique name
         bool m_dumpReproOnError = false;
 
+            /// If set, a report of the memory held by the compiler is written to the std error channel after compilation
+        bool m_reportMemory = false;
+
             /// A blob holding the diagnostic output
         ComPtr<ISlangBlob> m_diagnosticOutputBlob;
 
@@ -2181,7 +2241,7 @@ namespace Slang
         CodeGenTarget           target,
         EndToEndCompileRequest* endToEndReq,
         ExtensionTracker*       extensionTracker,
-        String&                 outSource);
+        StringRope&             outSource);
 
     SlangResult emitEntryPointSource(
         BackEndCompileRequest*  compileRequest,
@@ -2190,7 +2250,7 @@ namespace Slang
         CodeGenTarget           target,
         EndToEndCompileRequest* endToEndReq,
         ExtensionTracker*       extensionTracker,
-        String&                 outSource);
+        StringRope&             outSource);
 
     //
 
@@ -2256,9 +2316,17 @@ namespace Slang
 
         SLANG_NO_THROW SlangCapabilityID SLANG_MCALL findCapability(char const* name) override;
 
+        SLANG_NO_THROW void SLANG_MCALL setDownstreamCompilerStaging(SlangDownstreamStaging staging) override { m_downstreamStaging = staging; }
+        SLANG_NO_THROW SlangDownstreamStaging SLANG_MCALL getDownstreamCompilerStaging() override { return m_downstreamStaging; }
+        SLANG_NO_THROW SlangResult SLANG_MCALL createGlobalSessionSharingStdLib(slang::IGlobalSession** outGlobalSession) override;
+
             /// Get the default compiler for a language
         DownstreamCompiler* getDefaultDownstreamCompiler(SourceLanguage sourceLanguage);
 
+            /// If set, the session the stdlib is shared from. Held so everything referenced
+            /// from it outlives this session, so must be destroyed last (ie declared first).
+        RefPtr<Session> m_stdLibSession;
+
         Scope* baseLanguageScope = nullptr;
         Scope* coreLanguageScope = nullptr;
         Scope* hlslLanguageScope = nullptr;
@@ -2319,6 +2387,11 @@ namespace Slang
         Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
         void init();
+            /// Alternative to `init`, that shares the stdlib of `source`.
+        void initSharingStdLib(Session* source);
+
+            /// True if the stdlib is shared with another session, so must not be modified
+        bool isStdLibShared() const { return m_isStdLibShared; }
 
         void addBuiltinSource(
             Scope*                  scope,
@@ -2346,6 +2419,9 @@ namespace Slang
         String m_downstreamCompilerPaths[int(PassThroughMode::CountOf)];         ///< Paths for each pass through
         String m_languagePreludes[int(SourceLanguage::CountOf)];                  ///< Prelude for each source language
         PassThroughMode m_defaultDownstreamCompilers[int(SourceLanguage::CountOf)];
+        SlangDownstreamStaging m_downstreamStaging = SLANG_DOWNSTREAM_STAGING_DEFAULT;  ///< Where file based downstream compilers stage temporary files
+
+        bool m_isStdLibShared = false;                                              ///< Set once the stdlib is shared between sessions
     };
 
 
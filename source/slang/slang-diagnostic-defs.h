@@ -76,6 +76,7 @@ DIAGNOSTIC(    19, Error, unknownSourceLanguage, "unknown source language '$0'")
 DIAGNOSTIC(    20, Error, entryPointsNeedToBeAssociatedWithTranslationUnits, "when using multiple source files, entry points must be specified after their corresponding source file(s)")
 DIAGNOSTIC(    22, Error, unknownDownstreamCompiler, "unknown downstream compiler '$0'")
 
+DIAGNOSTIC(    23, Error, unknownBoundsCheckMode, "unknown bounds check mode '$0'")
 DIAGNOSTIC(    24, Error, unknownLineDirectiveMode, "unknown '#line' directive mode '$0'")
 DIAGNOSTIC(    25, Error, unknownFloatingPointMode, "unknown floating-point mode '$0'")
 DIAGNOSTIC(    26, Error, unknownOptimiziationLevel, "unknown optimization level '$0'")
@@ -119,6 +120,10 @@ DIAGNOSTIC(    87, Error, unableToSetDefaultDownstreamCompiler, "unable to set d
 
 DIAGNOSTIC(    88, Error, unknownArchiveType, "archive type '%0' is unknown")
 
+DIAGNOSTIC(    89, Error, unknownDownstreamStaging, "downstream staging '$0' is unknown")
+
+DIAGNOSTIC(    90, Error, invalidEmitThreadCount, "emit thread count '$0' is not a valid number of threads")
+
 //
 // 001xx - Downstream Compilers
 //
@@ -551,6 +556,15 @@ DIAGNOSTIC(52002, Error, passThroughCompilerNotFound, "Could not find a suitable
 DIAGNOSTIC(52004, Error, unableToWriteFile, "Unable to write file '$0'")
 DIAGNOSTIC(52005, Error, unableToReadFile, "Unable to read file '$0'")
 
+// 523xx - Emitting SPIR-V directly
+
+DIAGNOSTIC(52300, Error, spirvBoolInBuffer, "buffer '$0' holds a 'bool', which can't be stored in a buffer when emitting SPIR-V directly. Use an integer type instead")
+DIAGNOSTIC(52301, Error, spirvTypeWithMoreThanOneBufferLayout, "buffer '$0' holds a type that another buffer lays out differently (such as a constant buffer and a structured buffer holding the same structure), which isn't supported when emitting SPIR-V directly")
+DIAGNOSTIC(52302, Error, spirvDynamicIndexOfArrayValue, "indexing an array value (rather than a variable) with an index that isn't constant isn't supported when emitting SPIR-V directly")
+DIAGNOSTIC(52303, Error, spirvPushConstantBufferUnsupported, "push constant buffer '$0' isn't supported when emitting SPIR-V directly")
+DIAGNOSTIC(52304, Error, spirvGlobalVariableInitializerUnsupported, "global variable '$0' has an initializer, which isn't supported when emitting SPIR-V directly")
+DIAGNOSTIC(52305, Error, spirvValidationFailed, "the SPIR-V emitted directly failed validation:\n$0")
+
 //
 // 8xxxx - Issues specific to a particular library/technology/platform/etc.
 //
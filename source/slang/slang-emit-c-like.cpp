@@ -31,6 +31,10 @@
 
 #include <assert.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace Slang {
 
 struct CLikeSourceEmitter::ComputeEmitActionsContext
@@ -100,6 +104,7 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
     m_compileRequest = desc.compileRequest;
     m_entryPointStage = desc.entryPointStage;
     m_effectiveProfile = desc.effectiveProfile;
+    m_emitThreadCount = desc.emitThreadCount;
 }
 
 SlangResult CLikeSourceEmitter::init()
@@ -397,12 +402,12 @@ void CLikeSourceEmitter::emitStringLiteral(String const& value)
             m_writer->emit(buffer);
             break;
 
-        case '\"': m_writer->emit("\\\"");
-        case '\'': m_writer->emit("\\\'");
-        case '\\': m_writer->emit("\\\\");
-        case '\n': m_writer->emit("\\n");
-        case '\r': m_writer->emit("\\r");
-        case '\t': m_writer->emit("\\t");
+        case '\"': m_writer->emit("\\\""); break;
+        case '\'': m_writer->emit("\\\'"); break;
+        case '\\': m_writer->emit("\\\\"); break;
+        case '\n': m_writer->emit("\\n"); break;
+        case '\r': m_writer->emit("\\r"); break;
+        case '\t': m_writer->emit("\\t"); break;
         }
     }
     m_writer->emit("\"");
@@ -689,14 +694,15 @@ String CLikeSourceEmitter::_generateUniqueName(const UnownedStringSlice& name)
     return sb.ProduceString();
 }
 
-String CLikeSourceEmitter::generateName(IRInst* inst)
+bool CLikeSourceEmitter::_tryGenerateFixedName(IRInst* inst, String& outName)
 {
     // If the instruction names something
     // that should be emitted as a target intrinsic,
     // then use that name instead.
     if(auto intrinsicDecoration = findBestTargetIntrinsicDecoration(inst))
     {
-        return String(intrinsicDecoration->getDefinition());
+        outName = String(intrinsicDecoration->getDefinition());
+        return true;
     }
 
     // If the instruction reprsents one of the "magic" declarations
@@ -708,7 +714,8 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
     //
     if(auto nvapiDecor = inst->findDecoration<IRNVAPIMagicDecoration>())
     {
-        return String(nvapiDecor->getName());
+        outName = String(nvapiDecor->getName());
+        return true;
     }
 
     auto entryPointDecor = inst->findDecoration<IREntryPointDecoration>();
@@ -724,10 +731,23 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
             // use the appropriate options for glslang to
             // make it support a non-`main` name.
             //
-            return "main";
+            outName = "main";
+            return true;
         }
 
-        return generateEntryPointNameImpl(entryPointDecor);
+        outName = generateEntryPointNameImpl(entryPointDecor);
+        return true;
+    }
+
+    return false;
+}
+
+String CLikeSourceEmitter::generateName(IRInst* inst)
+{
+    String fixedName;
+    if (_tryGenerateFixedName(inst, fixedName))
+    {
+        return fixedName;
     }
 
     // If we have a name hint on the instruction, then we will try to use that
@@ -758,7 +778,23 @@ String CLikeSourceEmitter::getName(IRInst* inst)
     String name;
     if(!m_mapInstToName.TryGetValue(inst, name))
     {
-        name = generateName(inst);
+        if (m_moduleEmitter)
+        {
+            // Names that are made unique have to come from the module emitter. They are copied,
+            // as the reference count of the module emitter's string can't be changed from this thread.
+            if (auto moduleName = m_moduleEmitter->m_mapInstToName.TryGetValue(inst))
+            {
+                name = String(moduleName->getUnownedSlice());
+            }
+            else if (!_tryGenerateFixedName(inst, name))
+            {
+                m_isIncomplete = true;
+            }
+        }
+        else
+        {
+            name = generateName(inst);
+        }
         m_mapInstToName.Add(inst, name);
     }
     return name;
@@ -1295,7 +1331,20 @@ void CLikeSourceEmitter::emitInstResultDecl(IRInst* inst)
 
 IRTargetSpecificDecoration* CLikeSourceEmitter::findBestTargetDecoration(IRInst* inInst)
 {
-    return Slang::findBestTargetDecoration(inInst, getTargetCaps());
+    // The same instructions (notably the intrinsic functions, which can have a decoration
+    // for every target) are looked up over and over during emission, and each lookup builds
+    // and compares capability sets for all of the decorations, so the result is cached.
+    IRTargetSpecificDecoration* decoration = nullptr;
+    if (m_moduleEmitter && m_moduleEmitter->m_mapInstToBestTargetDecoration.TryGetValue(inInst, decoration))
+    {
+        return decoration;
+    }
+    if (!m_mapInstToBestTargetDecoration.TryGetValue(inInst, decoration))
+    {
+        decoration = Slang::findBestTargetDecoration(inInst, getTargetCaps());
+        m_mapInstToBestTargetDecoration.Add(inInst, decoration);
+    }
+    return decoration;
 }
 
 IRTargetIntrinsicDecoration* CLikeSourceEmitter::findBestTargetIntrinsicDecoration(IRInst* inInst)
@@ -2635,6 +2684,16 @@ void CLikeSourceEmitter::emitPhiVarDecls(IRFunc* func)
 
 void CLikeSourceEmitter::emitFunctionBody(IRGlobalValueWithCode* code)
 {
+    // The region tree may have been computed ahead of time, so that the function
+    // can be emitted independently. The module emitter owns the tree.
+    //
+    CLikeSourceEmitter* moduleEmitter = m_moduleEmitter ? m_moduleEmitter : this;
+    if (auto precomputedRegionTree = moduleEmitter->m_regionTrees.TryGetValue(code))
+    {
+        emitRegionTree(precomputedRegionTree->Ptr());
+        return;
+    }
+
     // Compute a structured region tree that can represent
     // the control flow of our function.
     //
@@ -2962,11 +3021,18 @@ void CLikeSourceEmitter::emitInterpolationModifiers(IRInst* varInst, IRType* val
 
 UInt CLikeSourceEmitter::getRayPayloadLocation(IRInst* inst)
 {
-    auto& map = m_mapIRValueToRayPayloadLocation;
+    auto& map = m_moduleEmitter ? m_moduleEmitter->m_mapIRValueToRayPayloadLocation : m_mapIRValueToRayPayloadLocation;
     UInt value = 0;
     if(map.TryGetValue(inst, value))
         return value;
 
+    // Locations are allocated in order, so only the module emitter can allocate them
+    if (m_moduleEmitter)
+    {
+        m_isIncomplete = true;
+        return 0;
+    }
+
     value = map.Count();
     map.Add(inst, value);
     return value;
@@ -2974,11 +3040,18 @@ UInt CLikeSourceEmitter::getRayPayloadLocation(IRInst* inst)
 
 UInt CLikeSourceEmitter::getCallablePayloadLocation(IRInst* inst)
 {
-    auto& map = m_mapIRValueToCallablePayloadLocation;
+    auto& map = m_moduleEmitter ? m_moduleEmitter->m_mapIRValueToCallablePayloadLocation : m_mapIRValueToCallablePayloadLocation;
     UInt value = 0;
     if(map.TryGetValue(inst, value))
         return value;
 
+    // Locations are allocated in order, so only the module emitter can allocate them
+    if (m_moduleEmitter)
+    {
+        m_isIncomplete = true;
+        return 0;
+    }
+
     value = map.Count();
     map.Add(inst, value);
     return value;
@@ -3430,6 +3503,11 @@ void CLikeSourceEmitter::computeEmitActions(IRModule* module, List<EmitAction>&
 
 void CLikeSourceEmitter::executeEmitActions(List<EmitAction> const& actions)
 {
+    if (m_emitThreadCount > 0 && executeEmitActionsWithFunctionEmitters(actions))
+    {
+        return;
+    }
+
     for(auto action : actions)
     {
         switch(action.level)
@@ -3445,6 +3523,210 @@ void CLikeSourceEmitter::executeEmitActions(List<EmitAction> const& actions)
     }
 }
 
+bool CLikeSourceEmitter::executeEmitActionsWithFunctionEmitters(List<EmitAction> const& actions)
+{
+    // A function definition that is emitted independently, by an emitter and writer of its own
+    struct FunctionEmit : public RefObject
+    {
+        FunctionEmit(IRFunc* inFunc, LineDirectiveMode lineDirectiveMode):
+            func(inFunc),
+            writer(nullptr, lineDirectiveMode)
+        {}
+
+        IRFunc* func;
+        SourceWriter writer;
+        RefPtr<CLikeSourceEmitter> emitter;
+            /// The emitted text. Only valid if succeeded is set.
+        String content;
+        bool succeeded = false;
+    };
+
+    Desc desc;
+    desc.compileRequest = m_compileRequest;
+    desc.target = m_target;
+    desc.entryPointStage = m_entryPointStage;
+    desc.effectiveProfile = m_effectiveProfile;
+    desc.targetCaps = m_targetCaps;
+
+    List<RefPtr<FunctionEmit>> functionEmits;
+    Dictionary<IRInst*, FunctionEmit*> mapFuncToFunctionEmit;
+    for (const auto& action : actions)
+    {
+        auto func = as<IRFunc>(action.inst);
+        if (action.level != EmitAction::Level::Definition || !func || !isDefinition(func) || isTargetIntrinsic(func))
+        {
+            continue;
+        }
+
+        RefPtr<FunctionEmit> functionEmit = new FunctionEmit(func, m_writer->getLineDirectiveMode());
+        desc.sourceWriter = &functionEmit->writer;
+        functionEmit->emitter = createFunctionEmitterImpl(desc);
+        if (!functionEmit->emitter)
+        {
+            // The target doesn't support it
+            return false;
+        }
+        functionEmit->emitter->m_moduleEmitter = this;
+        functionEmit->emitter->m_irModule = m_irModule;
+        functionEmit->emitter->init();
+
+        functionEmits.add(functionEmit);
+        mapFuncToFunctionEmit.Add(func, functionEmit);
+    }
+
+    if (functionEmits.getCount() == 0)
+    {
+        return false;
+    }
+
+    // Everything that modifies the IR, or depends on the order things are emitted in,
+    // has to be done ahead of time, and in order.
+    //
+    // Computing region trees fixes value scoping, which changes the IR, so comes first.
+    for (auto functionEmit : functionEmits)
+    {
+        RefPtr<RegionTree> regionTree = generateRegionTreeForFunc(functionEmit->func, getSink());
+        fixValueScoping(regionTree);
+        m_regionTrees.Add(functionEmit->func, regionTree);
+    }
+
+    // Generate the names of the global declarations, including the field keys of structs
+    // (which have no actions of their own)...
+    for (const auto& action : actions)
+    {
+        auto inst = action.inst;
+        if (auto structType = as<IRStructType>(inst))
+        {
+            getName(structType);
+            for (auto field : structType->getFields())
+            {
+                getName(field->getKey());
+            }
+        }
+        else if (!shouldFoldInstIntoUseSites(inst))
+        {
+            getName(inst);
+        }
+    }
+
+    // ...then the names and payload locations of the instructions in each function, and resolve
+    // the source locations each function's writer will need.
+    for (auto functionEmit : functionEmits)
+    {
+        auto func = functionEmit->func;
+        m_writer->addResolvedSourceLocation(func->sourceLoc, functionEmit->writer);
+
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                m_writer->addResolvedSourceLocation(inst->sourceLoc, functionEmit->writer);
+
+                if (shouldFoldInstIntoUseSites(inst))
+                {
+                    continue;
+                }
+                getName(inst);
+
+                if (inst->findDecoration<IRVulkanRayPayloadDecoration>())
+                {
+                    getRayPayloadLocation(inst);
+                }
+                if (inst->findDecoration<IRVulkanCallablePayloadDecoration>())
+                {
+                    getCallablePayloadLocation(inst);
+                }
+            }
+        }
+    }
+
+    // Emit the functions. A function that can't be emitted independently (because it needs something
+    // that wasn't prepared above, or produces a diagnostic or internal error) is emitted again in order
+    // below, which reproduces any diagnostics.
+    const Index functionCount = functionEmits.getCount();
+    std::atomic<Index> nextFunctionIndex(0);
+
+    auto emitFunctions = [&]()
+    {
+        SourceManager sourceManager;
+        sourceManager.initialize(nullptr, nullptr);
+
+        for (Index i = nextFunctionIndex++; i < functionCount; i = nextFunctionIndex++)
+        {
+            FunctionEmit* functionEmit = functionEmits[i];
+            CLikeSourceEmitter* emitter = functionEmit->emitter;
+
+            DiagnosticSink sink(&sourceManager, nullptr);
+            emitter->m_sink = &sink;
+            try
+            {
+                emitter->emitGlobalInst(functionEmit->func);
+            }
+            catch (...)
+            {
+                emitter->m_isIncomplete = true;
+            }
+            emitter->m_sink = nullptr;
+
+            if (!emitter->m_isIncomplete &&
+                !functionEmit->writer.hasUnresolvedSourceLocation() &&
+                sink.outputBuffer.getLength() == 0)
+            {
+                // Copy so that only the emitted text is held until it's used
+                StringRope content;
+                functionEmit->writer.takeContent(content);
+                functionEmit->content = String(content.flatten().getUnownedSlice());
+                functionEmit->succeeded = true;
+            }
+        }
+    };
+
+    const Index threadCount = Math::Min(m_emitThreadCount, functionCount);
+    if (threadCount <= 1)
+    {
+        emitFunctions();
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (Index i = 0; i < threadCount; ++i)
+        {
+            threads.push_back(std::thread(emitFunctions));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    for (const auto& action : actions)
+    {
+        FunctionEmit* functionEmit = nullptr;
+        if (action.level == EmitAction::Level::Definition &&
+            mapFuncToFunctionEmit.TryGetValue(action.inst, functionEmit) &&
+            functionEmit->succeeded)
+        {
+            m_writer->appendContent(functionEmit->content.getUnownedSlice());
+            addFunctionEmitterRequirementsImpl(functionEmit->emitter);
+            continue;
+        }
+
+        switch (action.level)
+        {
+        case EmitAction::Level::ForwardDeclaration:
+            emitFuncDecl(cast<IRFunc>(action.inst));
+            break;
+
+        case EmitAction::Level::Definition:
+            emitGlobalInst(action.inst);
+            break;
+        }
+    }
+
+    m_regionTrees.Clear();
+    return true;
+}
+
 void CLikeSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
 {
     // The IR will usually come in an order that respects
@@ -39,6 +39,13 @@ public:
             /// The associated extension tracker
         ExtensionTracker* extensionTracker = nullptr;
 
+            /// How buffer and array accesses are bounds checked (only used by the C/C++ targets)
+        BoundsCheckMode boundsCheckMode = BoundsCheckMode::Default;
+
+            /// If > 0 function definitions are emitted independently, by this many threads
+            /// (only used by targets that implement createFunctionEmitterImpl)
+        Index emitThreadCount = 0;
+
         SourceWriter* sourceWriter = nullptr;
     };
 
@@ -194,7 +201,7 @@ public:
     SourceWriter* getSourceWriter() const { return m_writer; }
 
         /// Get the diagnostic sink
-    DiagnosticSink* getSink() { return m_compileRequest->getSink();}
+    DiagnosticSink* getSink() { return m_sink ? m_sink : m_compileRequest->getSink(); }
 
         /// Get the code gen target
     CodeGenTarget getTarget() { return m_target; }
@@ -379,7 +386,12 @@ public:
 
     void executeEmitActions(List<EmitAction> const& actions);
     void emitModule(IRModule* module, DiagnosticSink* sink)
-        { m_irModule = module; emitModuleImpl(module, sink); }
+        { m_irModule = module; m_mapInstToBestTargetDecoration.Clear(); emitModuleImpl(module, sink); }
+
+        /// Emit the definitions of the functions in actions on m_emitThreadCount threads, then execute the
+        /// actions, using the function definitions that were emitted successfully. Returns false if the target
+        /// doesn't support emitting functions independently.
+    bool executeEmitActionsWithFunctionEmitters(List<EmitAction> const& actions);
 
         /// Emit any preprocessor directives that should come *before* the prelude code
         ///
@@ -453,6 +465,12 @@ public:
     virtual bool tryEmitGlobalParamImpl(IRGlobalParam* varDecl, IRType* varType) { SLANG_UNUSED(varDecl); SLANG_UNUSED(varType); return false; }
     virtual bool tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOuterPrec) { SLANG_UNUSED(inst); SLANG_UNUSED(inOuterPrec); return false; }
 
+        /// Create an emitter for emitting function definitions independently of this emitter (and of each other),
+        /// or nullptr if that isn't supported. The emitter must track requirements (such as extensions) itself.
+    virtual RefPtr<CLikeSourceEmitter> createFunctionEmitterImpl(const Desc& desc) { SLANG_UNUSED(desc); return nullptr; }
+        /// Add the requirements tracked by functionEmitter (created by createFunctionEmitterImpl) to this emitter
+    virtual void addFunctionEmitterRequirementsImpl(CLikeSourceEmitter* functionEmitter) { SLANG_UNUSED(functionEmitter); }
+
         /// Inspect the capabilities required by `inst` (according to its decorations),
         /// and ensure that those capabilities have been detected and stored in the
         /// target-specific extension tracker.
@@ -471,6 +489,8 @@ public:
     void _emitCallArgList(IRCall* call);
 
     String _generateUniqueName(const UnownedStringSlice& slice);
+        /// Generate the name of inst if it doesn't depend on other names (such as an intrinsic or entry point name)
+    bool _tryGenerateFixedName(IRInst* inst, String& outName);
 
         // Sort witnessTable entries according to the order defined in the witnessed interface type.
     List<IRWitnessTableEntry*> getSortedWitnessTableEntries(IRWitnessTable* witnessTable);
@@ -518,8 +538,27 @@ public:
     // to use for it when emitting code.
     Dictionary<IRInst*, String> m_mapInstToName;
 
+    // Map an IR instruction to its best target specific decoration for the target
+    // (or nullptr if it has none). Only valid for the module being emitted.
+    Dictionary<IRInst*, IRTargetSpecificDecoration*> m_mapInstToBestTargetDecoration;
+
     Dictionary<IRInst*, UInt> m_mapIRValueToRayPayloadLocation;
     Dictionary<IRInst*, UInt> m_mapIRValueToCallablePayloadLocation;
+
+        /// The number of threads to emit function definitions on (0 emits everything in order)
+    Index m_emitThreadCount = 0;
+
+        /// Region trees computed (and scoping fixed) ahead of emitting function bodies
+    Dictionary<IRGlobalValueWithCode*, RefPtr<RegionTree>> m_regionTrees;
+
+    // When emitting a function independently, the emitter for the module. Its names, payload locations
+    // and region trees are read (but never modified) so many function emitters can run at the same time.
+    CLikeSourceEmitter* m_moduleEmitter = nullptr;
+        /// Set if a function emitter needed something the module emitter doesn't have, so its output is incomplete
+    bool m_isIncomplete = false;
+
+        /// If set, diagnostics are reported here rather than to the compile request
+    DiagnosticSink* m_sink = nullptr;
 };
 
 }
@@ -1617,6 +1617,7 @@ CPPSourceEmitter::CPPSourceEmitter(const Desc& desc):
     m_intrinsicSet(&m_typeSet, m_opLookup)
 {
     m_semanticUsedFlags = 0;
+    m_boundsCheckMode = desc.boundsCheckMode;
     //m_semanticUsedFlags = SemanticUsedFlag::GroupID | SemanticUsedFlag::GroupThreadID | SemanticUsedFlag::DispatchThreadID;
 }
 
@@ -2108,14 +2109,23 @@ void CPPSourceEmitter::emitIntrinsicCallExprImpl(
             auto elementType = resourceType ? resourceType->getOperand(0) : nullptr;
             bool isRef = ptrType && ptrType->getValueType() == elementType;
 
-            auto emitSubscript = [this, &args](EmitOpInfo _outerPrec)
+            const bool isBoundsChecked = _isBoundsCheckedAccess(inst, args[0].get()->getDataType());
+
+            auto emitSubscript = [this, &args, inst, isBoundsChecked](EmitOpInfo _outerPrec)
             {
                 auto prec = getInfo(EmitOp::Postfix);
                 bool needCloseSubscript = maybeEmitParens(_outerPrec, prec);
                 emitOperand(args[0].get(), leftSide(_outerPrec, prec));
-                m_writer->emit("[");
-                emitOperand(args[1].get(), getInfo(EmitOp::General));
-                m_writer->emit("]");
+                if (isBoundsChecked)
+                {
+                    _emitBoundsCheckedIndex(inst, args[1].get());
+                }
+                else
+                {
+                    m_writer->emit("[");
+                    emitOperand(args[1].get(), getInfo(EmitOp::General));
+                    m_writer->emit("]");
+                }
                 maybeCloseParens(needCloseSubscript);
             };
 
@@ -2166,6 +2176,96 @@ void CPPSourceEmitter::emitLoopControlDecorationImpl(IRLoopControlDecoration* de
     }
 }
 
+void CPPSourceEmitter::handleRequiredCapabilitiesImpl(IRInst* inst)
+{
+    if (inst->findDecoration<IRRequiresQuadDecoration>())
+    {
+        m_requiresQuad = true;
+    }
+}
+
+void CPPSourceEmitter::emitPreludeDirectivesImpl()
+{
+    if (m_requiresQuad && m_target == CodeGenTarget::CPPSource)
+    {
+        // Enables quad execution in the prelude (see `QuadContext` in slang-cpp-types.h)
+        m_writer->emit("#define SLANG_PRELUDE_ENABLE_QUAD 1\n");
+    }
+
+    if (m_target == CodeGenTarget::CPPSource)
+    {
+        // Selects how the `at` accessors in the prelude handle an out of bounds index
+        switch (m_boundsCheckMode)
+        {
+            case BoundsCheckMode::Clamp:
+                m_writer->emit("#define SLANG_PRELUDE_BOUND_CHECK_MODE SLANG_PRELUDE_BOUND_CHECK_MODE_CLAMP\n");
+                break;
+            case BoundsCheckMode::Trap:
+                m_writer->emit("#define SLANG_PRELUDE_BOUND_CHECK_MODE SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP\n");
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/* static */bool CPPSourceEmitter::_hasBoundsCheckedAccessor(IRType* type)
+{
+    switch (type->getOp())
+    {
+        case kIROp_ArrayType:
+        case kIROp_UnsizedArrayType:
+        case kIROp_HLSLStructuredBufferType:
+        case kIROp_HLSLRWStructuredBufferType:
+            return true;
+        default:
+            break;
+    }
+
+    // Typed buffers (`Buffer` and `RWBuffer`)
+    if (auto textureType = as<IRTextureTypeBase>(type))
+    {
+        const auto access = textureType->getAccess();
+        return textureType->GetBaseShape() == TextureFlavor::Shape::ShapeBuffer &&
+            !textureType->isArray() && !textureType->isMultisample() &&
+            (access == SLANG_RESOURCE_ACCESS_READ || access == SLANG_RESOURCE_ACCESS_READ_WRITE);
+    }
+    return false;
+}
+
+bool CPPSourceEmitter::_isBoundsCheckedAccess(IRInst* inst, IRType* baseType)
+{
+    return m_boundsCheckMode != BoundsCheckMode::Default &&
+        m_target == CodeGenTarget::CPPSource &&
+        !inst->findDecoration<IRInBoundsDecoration>() &&
+        _hasBoundsCheckedAccessor(baseType);
+}
+
+void CPPSourceEmitter::_emitBoundsCheckedIndex(IRInst* inst, IRInst* index)
+{
+    // The source location is passed as a string, such that a failure can be reported
+    // even if the code is compiled without #line directives. Instructions created by
+    // passes may not have a location, in which case the closest parent's is used.
+    SourceLoc sourceLoc;
+    for (IRInst* cur = inst; cur && !sourceLoc.isValid(); cur = cur->getParent())
+    {
+        sourceLoc = cur->sourceLoc;
+    }
+
+    StringBuilder location;
+    const HumaneSourceLoc humaneLoc = getSourceManager()->getHumaneLoc(sourceLoc);
+    if (humaneLoc.line > 0)
+    {
+        location << humaneLoc.pathInfo.foundPath << "(" << humaneLoc.line << ")";
+    }
+
+    m_writer->emit(".at(");
+    emitOperand(index, getInfo(EmitOp::General));
+    m_writer->emit(", ");
+    emitStringLiteral(location);
+    m_writer->emit(")");
+}
+
 const UnownedStringSlice* CPPSourceEmitter::getVectorElementNames(BaseType baseType, Index elemCount)
 {
     SLANG_UNUSED(baseType);
@@ -2263,6 +2363,47 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOut
             // try doing automatically
             return _tryEmitInstExprAsIntrinsic(inst, inOuterPrec);
         }
+        case kIROp_getElement:
+        case kIROp_getElementPtr:
+        {
+            IRInst* base = inst->getOperand(0);
+            IRType* baseType = base->getDataType();
+            if (inst->getOp() == kIROp_getElementPtr)
+            {
+                auto ptrType = as<IRPtrTypeBase>(baseType);
+                baseType = ptrType ? ptrType->getValueType() : nullptr;
+            }
+            if (!baseType || !_isBoundsCheckedAccess(inst, baseType))
+            {
+                return _tryEmitInstExprAsIntrinsic(inst, inOuterPrec);
+            }
+
+            // Use the checked `at` accessor of `FixedArray` or `Array`
+            auto outerPrec = inOuterPrec;
+            bool needClose = false;
+            if (inst->getOp() == kIROp_getElementPtr)
+            {
+                const auto prefixPrec = getInfo(EmitOp::Prefix);
+                needClose = maybeEmitParens(outerPrec, prefixPrec);
+                m_writer->emit("&");
+                outerPrec = rightSide(outerPrec, prefixPrec);
+            }
+
+            const auto postfixPrec = getInfo(EmitOp::Postfix);
+            const bool needClosePostfix = maybeEmitParens(outerPrec, postfixPrec);
+            if (inst->getOp() == kIROp_getElementPtr)
+            {
+                emitDereferenceOperand(base, leftSide(outerPrec, postfixPrec));
+            }
+            else
+            {
+                emitOperand(base, leftSide(outerPrec, postfixPrec));
+            }
+            _emitBoundsCheckedIndex(inst, inst->getOperand(1));
+            maybeCloseParens(needClosePostfix);
+            maybeCloseParens(needClose);
+            return true;
+        }
         case kIROp_lookup_interface_method:
         {
             emitInstExpr(inst->getOperand(0), inOuterPrec);
@@ -2540,6 +2681,44 @@ void CPPSourceEmitter::_emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroup
     }
 }
 
+void CPPSourceEmitter::_emitEntryPointGroupQuads(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
+{
+    StringBuilder builder;
+    builder << "QuadExecutor quadExecutor(_" << funcName << ", entryPointParams, globalParams);\n";
+    m_writer->emit(builder);
+
+    // Open the loops, in the order z, y, x. The x and y loops step over the top left thread of each quad.
+    Index loopCount = 0;
+    for (int i = kThreadGroupAxisCount - 1; i >= 0; --i)
+    {
+        const Int step = (i < 2) ? 2 : 1;
+        if (sizeAlongAxis[i] <= step)
+        {
+            continue;
+        }
+
+        builder.Clear();
+        const char elem[2] = { s_xyzwNames[i], 0 };
+        builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << sizeAlongAxis[i] << "; " << elem << " += " << step << ")\n{\n";
+        m_writer->emit(builder);
+        m_writer->indent();
+
+        builder.Clear();
+        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        m_writer->emit(builder);
+        loopCount++;
+    }
+
+    m_writer->emit("quadExecutor.run(threadInput);\n");
+
+    // Close all the loops
+    for (Index i = 0; i < loopCount; ++i)
+    {
+        m_writer->dedent();
+        m_writer->emit("}\n");
+    }
+}
+
 void CPPSourceEmitter::_emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName)
 {
     List<AxisWithSize> axes;
@@ -2601,6 +2780,91 @@ void CPPSourceEmitter::_emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupA
     m_writer->emit("};\n");
 }
 
+void CPPSourceEmitter::_emitComputeEntryPointTable(IRModule* module)
+{
+    // When a module holds multiple entry points (for example from a whole program compile of many entry points,
+    // or many specializations of the same entry point) it is useful to be able to enumerate them all from the
+    // compiled binary, without having to look up each function by name.
+    //
+    // We output the entries in the order the entry points appear in the module, which is the order they were
+    // linked in.
+    List<IRFunc*> entryPoints;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->isDefinition())
+            continue;
+
+        auto entryPointDecor = func->findDecoration<IREntryPointDecoration>();
+        if (entryPointDecor && entryPointDecor->getProfile().getStage() == Stage::Compute)
+        {
+            entryPoints.add(func);
+        }
+    }
+
+    if (entryPoints.getCount() == 0)
+    {
+        return;
+    }
+
+    m_writer->emit("static const ComputeEntryPointInfo _slang_computeEntryPointTable[] =\n{\n");
+    m_writer->indent();
+    for (auto func : entryPoints)
+    {
+        Int groupThreadSize[kThreadGroupAxisCount];
+        getComputeThreadGroupSize(func, groupThreadSize);
+
+        const String funcName = getName(func);
+
+        StringBuilder builder;
+        builder << "{ \"" << funcName << "\", " << funcName << ", " << funcName << "_Group, " << funcName << "_Thread, { ";
+        for (Index i = 0; i < kThreadGroupAxisCount; ++i)
+        {
+            if (i > 0)
+            {
+                builder << ", ";
+            }
+            builder << groupThreadSize[i];
+        }
+        builder << " } },\n";
+
+        m_writer->emit(builder);
+    }
+    m_writer->dedent();
+    m_writer->emit("};\n\n");
+
+    m_writer->emit("SLANG_PRELUDE_EXPORT\n");
+    m_writer->emit("const ComputeEntryPointInfo* slang_getComputeEntryPointTable(int* outCount)\n{\n");
+    m_writer->indent();
+    m_writer->emit("*outCount = ");
+    m_writer->emit(entryPoints.getCount());
+    m_writer->emit(";\n");
+    m_writer->emit("return _slang_computeEntryPointTable;\n");
+    m_writer->dedent();
+    m_writer->emit("}\n");
+}
+
+String CPPSourceEmitter::generateEntryPointNameImpl(IREntryPointDecoration* entryPointDecor)
+{
+    // Multiple entry points with the same name can be output into the same module - for example when
+    // multiple specializations of a single entry point are compiled together. Exported symbols must be
+    // unique, so all but the first use of a name are given a numeric suffix.
+    String name = Super::generateEntryPointNameImpl(entryPointDecor);
+
+    Index& countRef = m_entryPointNameCounts.GetOrAddValue(name, 0);
+    const Index count = countRef;
+    countRef = count + 1;
+
+    if (count == 0)
+    {
+        return name;
+    }
+
+    StringBuilder builder;
+    builder << name << "_" << count;
+    return builder.ProduceString();
+}
+
 void CPPSourceEmitter::_emitForwardDeclarations(const List<EmitAction>& actions)
 {
     // Emit forward declarations. Don't emit variables that need to be grouped or function definitions (which will ref those types)
@@ -2819,7 +3083,16 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
                     m_writer->emit("ComputeThreadVaryingInput threadInput = {};\n");
                     m_writer->emit("threadInput.groupID = varyingInput->startGroupID;\n");
 
-                    _emitEntryPointGroup(groupThreadSize, funcName);
+                    // Quads are formed from 2x2 threads in the x and y axes, so that is only possible if both sizes are even.
+                    // If not, the group runs a thread at a time, and derivatives are zero.
+                    if (m_requiresQuad && (groupThreadSize[0] & 1) == 0 && (groupThreadSize[1] & 1) == 0)
+                    {
+                        _emitEntryPointGroupQuads(groupThreadSize, funcName);
+                    }
+                    else
+                    {
+                        _emitEntryPointGroup(groupThreadSize, funcName);
+                    }
                     _emitEntryPointDefinitionEnd(func);
                 }
 
@@ -2836,6 +3109,8 @@ void CPPSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sink)
             }
         }
     }
+
+    _emitComputeEntryPointTable(module);
 }
 
 } // namespace Slang
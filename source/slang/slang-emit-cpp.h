@@ -74,6 +74,9 @@ protected:
     virtual void emitIntrinsicCallExprImpl(IRCall* inst, IRTargetIntrinsicDecoration* targetIntrinsic, EmitOpInfo const& inOuterPrec) SLANG_OVERRIDE;
 
     virtual void emitLoopControlDecorationImpl(IRLoopControlDecoration* decl) SLANG_OVERRIDE;
+    virtual void handleRequiredCapabilitiesImpl(IRInst* inst) SLANG_OVERRIDE;
+    virtual void emitPreludeDirectivesImpl() SLANG_OVERRIDE;
+    virtual String generateEntryPointNameImpl(IREntryPointDecoration* entryPointDecor) SLANG_OVERRIDE;
 
     virtual const UnownedStringSlice* getVectorElementNames(BaseType elemType, Index elemCount);
     
@@ -86,6 +89,13 @@ protected:
 
     void _maybeEmitSpecializedOperationDefinition(const HLSLIntrinsic* specOp);
 
+        /// True if values of `type` have an `at` accessor in the prelude, that checks the index
+    static bool _hasBoundsCheckedAccessor(IRType* type);
+        /// True if the access `inst` into a value of `baseType` should be emitted with a bounds check
+    bool _isBoundsCheckedAccess(IRInst* inst, IRType* baseType);
+        /// Emits `.at(index, location)` for the access `inst`
+    void _emitBoundsCheckedIndex(IRInst* inst, IRInst* index);
+
     void _emitForwardDeclarations(const List<EmitAction>& actions);
 
     void _emitAryDefinition(const HLSLIntrinsic* specOp);
@@ -119,8 +129,13 @@ protected:
     void _emitEntryPointDefinitionStart(IRFunc* func, const String& funcName, const UnownedStringSlice& varyingTypeName);
     void _emitEntryPointDefinitionEnd(IRFunc* func);
     void _emitEntryPointGroup(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
+        /// Emit running the group a 2x2 quad at a time, with the threads of each quad in lockstep
+    void _emitEntryPointGroupQuads(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
     void _emitEntryPointGroupRange(const Int sizeAlongAxis[kThreadGroupAxisCount], const String& funcName);
 
+        /// Emit a table describing all of the compute entry points in the module, and an exported function to access it
+    void _emitComputeEntryPointTable(IRModule* module);
+
     void _emitInitAxisValues(const Int sizeAlongAxis[kThreadGroupAxisCount], const UnownedStringSlice& mulName, const UnownedStringSlice& addName);
 
     bool _tryEmitInstExprAsIntrinsic(IRInst* inst, const EmitOpInfo& inOuterPrec);
@@ -149,6 +164,15 @@ protected:
 
     SemanticUsedFlags m_semanticUsedFlags;
 
+        // True if the code uses operations (such as derivatives) that need the threads of a quad to run in lockstep
+    bool m_requiresQuad = false;
+
+        // How buffer and array accesses that aren't proven to be in bounds are checked
+    BoundsCheckMode m_boundsCheckMode = BoundsCheckMode::Default;
+
+        // Counts the uses of each entry point name, such that exported entry point names can be made unique
+    Dictionary<String, Index> m_entryPointNameCounts;
+
     // Witness tables pending for emitting their definitions.
     // They must be emitted last, after the entire `Context` class so those member functions defined
     // in `Context` may be referenced.
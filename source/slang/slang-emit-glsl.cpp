@@ -1637,6 +1637,20 @@ bool GLSLSourceEmitter::tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOu
     return false;
 }
 
+RefPtr<CLikeSourceEmitter> GLSLSourceEmitter::createFunctionEmitterImpl(const Desc& desc)
+{
+    // The function emitter tracks its requirements itself, so they can be added when its output is used
+    Desc functionDesc(desc);
+    RefPtr<GLSLExtensionTracker> extensionTracker = new GLSLExtensionTracker;
+    functionDesc.extensionTracker = extensionTracker;
+    return new GLSLSourceEmitter(functionDesc);
+}
+
+void GLSLSourceEmitter::addFunctionEmitterRequirementsImpl(CLikeSourceEmitter* functionEmitter)
+{
+    m_glslExtensionTracker->addRequirements(*static_cast<GLSLSourceEmitter*>(functionEmitter)->m_glslExtensionTracker);
+}
+
 void GLSLSourceEmitter::handleRequiredCapabilitiesImpl(IRInst* inst)
 {
     // Does this function declare any requirements on GLSL version or
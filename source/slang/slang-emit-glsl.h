@@ -40,6 +40,9 @@ protected:
 
     virtual void handleRequiredCapabilitiesImpl(IRInst* inst) SLANG_OVERRIDE;
 
+    virtual RefPtr<CLikeSourceEmitter> createFunctionEmitterImpl(const Desc& desc) SLANG_OVERRIDE;
+    virtual void addFunctionEmitterRequirementsImpl(CLikeSourceEmitter* functionEmitter) SLANG_OVERRIDE;
+
     virtual bool tryEmitGlobalParamImpl(IRGlobalParam* varDecl, IRType* varType) SLANG_OVERRIDE;
     virtual bool tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOuterPrec) SLANG_OVERRIDE;
 
@@ -1055,6 +1055,14 @@ void HLSLSourceEmitter::handleRequiredCapabilitiesImpl(IRInst* inst)
     }
 }
 
+void HLSLSourceEmitter::addFunctionEmitterRequirementsImpl(CLikeSourceEmitter* functionEmitter)
+{
+    if (static_cast<HLSLSourceEmitter*>(functionEmitter)->m_extensionTracker->m_requiresNVAPI)
+    {
+        m_extensionTracker->m_requiresNVAPI = true;
+    }
+}
+
 void HLSLSourceEmitter::emitPreludeDirectivesImpl()
 {
     if( m_extensionTracker->m_requiresNVAPI )
@@ -49,6 +49,9 @@ protected:
 
 
     virtual void handleRequiredCapabilitiesImpl(IRInst* inst) SLANG_OVERRIDE;
+
+    virtual RefPtr<CLikeSourceEmitter> createFunctionEmitterImpl(const Desc& desc) SLANG_OVERRIDE { return new HLSLSourceEmitter(desc); }
+    virtual void addFunctionEmitterRequirementsImpl(CLikeSourceEmitter* functionEmitter) SLANG_OVERRIDE;
     virtual void emitPreludeDirectivesImpl() SLANG_OVERRIDE;
 
     virtual void emitGlobalInstImpl(IRInst* inst) SLANG_OVERRIDE;
@@ -29,11 +29,83 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::takeContent(StringRope& outContent)
+{
+    outContent.clear();
+    outContent.swapWith(m_content);
+}
+
+void SourceWriter::appendContent(const UnownedStringSlice& content)
+{
+    if (content.getLength() == 0)
+    {
+        return;
+    }
+
+    m_content.append(content);
+
+    // Where the content leaves the output is unknown, so any pending change of location is dropped
+    m_loc = HumaneSourceLoc();
+    m_nextSourceLoc = SourceLoc();
+    m_nextHumaneSourceLocation = HumaneSourceLoc();
+    m_needToUpdateSourceLocation = false;
+    m_isAtStartOfLine = (content[content.getLength() - 1] == '\n');
+}
+
+void SourceWriter::addResolvedSourceLocation(const SourceLoc& sourceLocation, SourceWriter& ioWriter)
+{
+    if (!sourceLocation.isValid() || ioWriter.m_resolvedSourceLocs.ContainsKey(sourceLocation.getRaw()))
+    {
+        return;
+    }
+
+    const HumaneSourceLoc humaneLoc = getSourceManager()->getHumaneLoc(sourceLocation);
+
+    // Only the found path is used, and it is copied so its reference count isn't shared
+    HumaneSourceLoc resolvedLoc;
+    resolvedLoc.pathInfo.type = humaneLoc.pathInfo.type;
+    resolvedLoc.pathInfo.foundPath = String(humaneLoc.pathInfo.foundPath.getUnownedSlice());
+    resolvedLoc.line = humaneLoc.line;
+    resolvedLoc.column = humaneLoc.column;
+
+    ioWriter.m_resolvedSourceLocs.Add(sourceLocation.getRaw(), resolvedLoc);
+
+    // GLSL paths are output as IDs, which have to be the same in both writers
+    if (humaneLoc.line > 0 && getLineDirectiveMode() == LineDirectiveMode::GLSL)
+    {
+        const String& path = humaneLoc.pathInfo.foundPath;
+        int id = 0;
+        if (!m_mapGLSLSourcePathToID.TryGetValue(path, id))
+        {
+            id = m_glslSourceIDCount++;
+            m_mapGLSLSourcePathToID.Add(path, id);
+        }
+        if (!ioWriter.m_mapGLSLSourcePathToID.ContainsKey(resolvedLoc.pathInfo.foundPath))
+        {
+            ioWriter.m_mapGLSLSourcePathToID.Add(resolvedLoc.pathInfo.foundPath, id);
+        }
+    }
+}
+
+HumaneSourceLoc SourceWriter::_getHumaneLoc(const SourceLoc& sourceLocation)
+{
+    if (m_sourceManager)
+    {
+        return m_sourceManager->getHumaneLoc(sourceLocation);
+    }
+    if (auto resolvedLoc = m_resolvedSourceLocs.TryGetValue(sourceLocation.getRaw()))
+    {
+        return *resolvedLoc;
+    }
+    m_hasUnresolvedSourceLocation = true;
+    return HumaneSourceLoc();
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
-    m_builder.Append(textBegin, len);
+    m_content.append(textBegin, Index(len));
 }
 
 void SourceWriter::emitRawText(char const* text)
@@ -292,7 +364,7 @@ void SourceWriter::advanceToSourceLocation(const SourceLoc& sourceLocation)
     }
 
     // Workout the humane source location.
-    const HumaneSourceLoc humaneSourceLoc = getSourceManager()->getHumaneLoc(sourceLocation);
+    const HumaneSourceLoc humaneSourceLoc = _getHumaneLoc(sourceLocation);
 
     // If the location is valid, mark need to update, and the new location
     if (humaneSourceLoc.line > 0)
@@ -3,6 +3,7 @@
 #define SLANG_EMIT_SOURCE_WRITER_H
 
 #include "../core/slang-basic.h"
+#include "../core/slang-string-rope.h"
 
 #include "slang-compiler.h"
 
@@ -61,11 +62,23 @@ public:
     void advanceToSourceLocationIfValid(const SourceLoc& sourceLocation);
 
         /// Get the content as a string
-    String getContent() { return m_builder.ProduceString(); }
+    String getContent() { return m_content.flatten(); }
         /// Clear the content
-    void clearContent() { m_builder.Clear(); }
+    void clearContent() { m_content.clear(); }
         /// Get the content as a string and clear the internal representation
     String getContentAndClear();
+        /// Move the content into outContent (without copying it), leaving the writer empty
+    void takeContent(StringRope& outContent);
+        /// Append text that was written by another writer (typically on another thread).
+        /// Line tracking restarts, so the next `#line` directive is output with its path.
+    void appendContent(const UnownedStringSlice& content);
+
+        /// Look up sourceLocation with this writer's source manager, and record the result in ioWriter,
+        /// so that ioWriter can advance to the location without a source manager. Nothing held by ioWriter
+        /// is shared with this writer, so ioWriter can then be used on another thread.
+    void addResolvedSourceLocation(const SourceLoc& sourceLocation, SourceWriter& ioWriter);
+        /// True if the writer (which has no source manager) was advanced to a location that wasn't resolved
+    bool hasUnresolvedSourceLocation() const { return m_hasUnresolvedSourceLocation; }
 
         /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
@@ -90,12 +103,13 @@ protected:
         // Doesn't update state of source-location tracking.
     void _emitLineDirective(const HumaneSourceLoc& sourceLocation);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
-    StringBuilder m_builder;
+        // Get the humane location from the source manager, or if there isn't one the resolved locations
+    HumaneSourceLoc _getHumaneLoc(const SourceLoc& sourceLocation);
+
+    // The code we've built so far. It is held in chunks, so that no copies/reallocs are
+    // needed as it grows, and it's only sewn together into one buffer if it's required.
+    // A downside is that it isn't so simple to debug by looking at the current contents.
+    StringRope m_content;
 
     // Current source position for tracking purposes...
     HumaneSourceLoc m_loc;
@@ -116,6 +130,10 @@ protected:
 
     SourceManager* m_sourceManager = nullptr;
 
+    // Locations resolved by another writer, used if there is no source manager
+    Dictionary<SourceLoc::RawValue, HumaneSourceLoc> m_resolvedSourceLocs;
+    bool m_hasUnresolvedSourceLocation = false;
+
     // For GLSL output, we can't emit traditional `#line` directives
     // with a file path in them, so we maintain a map that associates
     // each path with a unique integer, and then we output those
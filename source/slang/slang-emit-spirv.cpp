@@ -6,7 +6,9 @@
 #include "slang-ir-insts.h"
 
 #include "spirv/unified1/spirv.h"
+#include "spirv/unified1/GLSL.std.450.h"
 
+#include "../core/slang-char-util.h"
 #include "../core/slang-memory-arena.h"
 
 namespace Slang
@@ -72,6 +74,18 @@ typedef uint32_t SpvWord;
 // the enumeration of the ordering in Section 2.4 and use it to
 // define a list of *logical sections* that make up a SPIR-V module.
 
+// Section 2.4 lists type declarations, constants and global variables
+// together:
+//
+// > All type declarations (OpTypeXXX instructions), all constant instructions,
+// > and all global variable declarations
+//
+// These can refer to each other in any combination (e.g., an array
+// type refers to a constant for its element count), with the only
+// rule being that definitions come before uses. We emit the operands
+// of an instruction before the instruction itself, so putting all
+// of them in the single `Types` section gives a valid order.
+
     /// Logical sections of a SPIR-V module.
 enum class SpvLogicalSectionID
 {
@@ -85,8 +99,6 @@ enum class SpvLogicalSectionID
     DebugNames,
     Annotations,
     Types,
-    Constants,
-    GlobalVariables,
     FunctionDeclarations,
     FunctionDefinitions,
 
@@ -564,10 +576,29 @@ struct SPIRVEmitContext
         // We first ensure that the `src` instruction has been emitted,
         // and then handle it as for any other <id> operand.
         //
-        SpvInst* spvSrc = ensureInst(src);
+        SpvInst* spvSrc = getValue(src);
         emitOperand(getID(spvSrc));
     }
 
+        /// Get the SPIR-V instruction that holds the value of `irInst` in the current function
+    SpvInst* getValue(IRInst* irInst)
+    {
+        // Varying inputs are global parameters in the IR that are used
+        // directly as values, while in SPIR-V they are `Input` variables
+        // that need to be loaded. Each function loads the inputs it uses
+        // once, at the start of its entry block.
+        //
+        if( m_funcState )
+        {
+            SpvInst* spvInst = nullptr;
+            if( m_funcState->loadedInputs.TryGetValue(irInst, spvInst) )
+            {
+                return spvInst;
+            }
+        }
+        return ensureInst(irInst);
+    }
+
     // Some instructions take a string as a literal operand,
     // which requires us to follow the SPIR-V rules to
     // encode the string into multiple operand words.
@@ -751,16 +782,27 @@ struct SPIRVEmitContext
     // which do not directly relate to any instruction in the
     // Slang IR.
 
+        /// Capabilities that have been declared so far
+    HashSet<SpvWord> m_capabilities;
+
+        /// Declare that the module requires `capability`, if it hasn't been already
+    void requireCapability(SpvCapability capability)
+    {
+        if( m_capabilities.Add(SpvWord(capability)) )
+        {
+            emitInst(getSection(SpvLogicalSectionID::Capabilities), nullptr, SpvOpCapability, capability);
+        }
+    }
+
         /// Emit the mandatory "front-matter" instructions that
         /// the SPIR-V module must include to make it usable.
     void emitFrontMatter()
     {
-        // TODO: We should ideally add SPIR-V capabilities to
-        // the module as we emit instructions that require them.
-        // For now we will always emit the `Shader` capability,
-        // since every Vulkan shader module will use it.
+        // Every Vulkan shader module uses the `Shader` capability.
+        // Other capabilities are added as we emit instructions
+        // that require them.
         //
-        emitInst(getSection(SpvLogicalSectionID::Capabilities), nullptr, SpvOpCapability, SpvCapabilityShader);
+        requireCapability(SpvCapabilityShader);
 
         // [2.4: Logical Layout of a Module]
         //
@@ -788,13 +830,23 @@ struct SPIRVEmitContext
         ///
     SpvInst* emitGlobalInst(IRInst* inst)
     {
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All type declarations (OpTypeXXX instructions), all constant instructions,
+        // > and all global variable declarations (all OpVariable instructions whose
+        // > Storage Class is not Function)
+        //
+        // These may be freely interleaved, so all of them go into the one section.
+        //
+        auto section = getSection(SpvLogicalSectionID::Types);
+
         switch( inst->getOp() )
         {
         // [3.32.6: Type-Declaration Instructions]
         //
 
 #define CASE(IROP, SPVOP) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SPVOP, kResultID)
+        case IROP: return emitInst(section, inst, SPVOP, kResultID)
 
         // > OpTypeVoid
         CASE(kIROp_VoidType, SpvOpTypeVoid);
@@ -807,8 +859,12 @@ struct SPIRVEmitContext
         // > OpTypeInt
 
 #define CASE(IROP, BITS, SIGNED) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeInt, kResultID, BITS, SIGNED)
+        case IROP: return emitIntType(inst, BITS, SIGNED)
 
+        CASE(kIROp_Int8Type,    8,  1);
+        CASE(kIROp_UInt8Type,   8,  0);
+        CASE(kIROp_Int16Type,   16, 1);
+        CASE(kIROp_UInt16Type,  16, 0);
         CASE(kIROp_IntType,     32, 1);
         CASE(kIROp_UIntType,    32, 0);
         CASE(kIROp_Int64Type,   64, 1);
@@ -819,7 +875,7 @@ struct SPIRVEmitContext
         // > OpTypeFloat
 
 #define CASE(IROP, BITS) \
-        case IROP: return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeFloat, kResultID, BITS)
+        case IROP: return emitFloatType(inst, BITS)
 
         CASE(kIROp_HalfType,    16);
         CASE(kIROp_FloatType,   32);
@@ -827,15 +883,79 @@ struct SPIRVEmitContext
 
 #undef CASE
 
-        // > OpTypeVector
+        case kIROp_VectorType:
+            {
+                // > OpTypeVector
+                auto vectorType = cast<IRVectorType>(inst);
+                return emitInst(section, inst, SpvOpTypeVector, kResultID,
+                    vectorType->getElementType(),
+                    SpvWord(getIntVal(vectorType->getElementCount())));
+            }
+
         // > OpTypeMatrix
         // > OpTypeImage
         // > OpTypeSampler
-        // > OpTypeArray
-        // > OpTypeRuntimeArray
-        // > OpTypeStruct
+
+        case kIROp_ArrayType:
+            {
+                // > OpTypeArray
+                //
+                // Unlike a vector, the length of an array is the <id>
+                // of a constant, just as in the Slang IR.
+                //
+                auto arrayType = cast<IRArrayType>(inst);
+                return emitInst(section, inst, SpvOpTypeArray, kResultID,
+                    arrayType->getElementType(),
+                    arrayType->getElementCount());
+            }
+
+        case kIROp_UnsizedArrayType:
+            // > OpTypeRuntimeArray
+            return emitInst(section, inst, SpvOpTypeRuntimeArray, kResultID, cast<IRUnsizedArrayType>(inst)->getElementType());
+
+        case kIROp_StructType:
+            // > OpTypeStruct
+            return emitStructType(cast<IRStructType>(inst));
+
         // > OpTypeOpaque
-        // > OpTypePointer
+
+        case kIROp_PtrType:
+        case kIROp_RefType:
+        case kIROp_OutType:
+        case kIROp_InOutType:
+            {
+                // > OpTypePointer
+                //
+                // A SPIR-V pointer type includes the storage class of
+                // what it points to, while a Slang IR pointer type does not.
+                // The storage class of a pointer-typed *value* depends on
+                // where it came from (see `getStorageClassForAddress()`),
+                // so the only place we reference an IR pointer type directly
+                // is for the parameters of a function, which can only point
+                // to function-local variables.
+                //
+                auto spvPointerType = ensurePointerType(SpvStorageClassFunction, cast<IRPtrTypeBase>(inst)->getValueType());
+                registerInst(inst, spvPointerType);
+                return spvPointerType;
+            }
+
+        case kIROp_RateQualifiedType:
+            {
+                // Rates don't have a SPIR-V representation, so a rate-qualified
+                // type is the same as the type it qualifies.
+                //
+                auto spvType = ensureInst(cast<IRRateQualifiedType>(inst)->getValueType());
+                registerInst(inst, spvType);
+                return spvType;
+            }
+
+        case kIROp_HLSLStructuredBufferType:
+        case kIROp_HLSLRWStructuredBufferType:
+        case kIROp_HLSLRasterizerOrderedStructuredBufferType:
+            return emitStructuredBufferType(cast<IRHLSLStructuredBufferTypeBase>(inst));
+
+        case kIROp_ConstantBufferType:
+            return emitConstantBufferType(cast<IRConstantBufferType>(inst));
 
         case kIROp_FuncType:
             // > OpTypeFunction
@@ -844,10 +964,75 @@ struct SPIRVEmitContext
             // with the result-type operand coming first,
             // followed by operand sfor all the parameter types.
             //
-            return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeFunction, kResultID, OperandsOf(inst));
+            return emitInst(section, inst, SpvOpTypeFunction, kResultID, OperandsOf(inst));
 
         // > OpTypeForwardPointer
 
+        // [3.32.7. Constant-Creation Instructions]
+
+        case kIROp_BoolLit:
+            // > OpConstantTrue
+            // > OpConstantFalse
+            return emitInst(section, inst,
+                cast<IRBoolLit>(inst)->getValue() ? SpvOpConstantTrue : SpvOpConstantFalse,
+                inst->getDataType(),
+                kResultID);
+
+        case kIROp_IntLit:
+            {
+                // > OpConstant
+                //
+                // > Types 32 bits wide or smaller take one word. Larger types take
+                // > multiple words, with low-order words appearing first.
+                //
+                const IRIntegerValue value = cast<IRIntLit>(inst)->getValue();
+                if( _getScalarSize(inst->getDataType()) > 4 )
+                {
+                    return emitInst(section, inst, SpvOpConstant, inst->getDataType(), kResultID,
+                        SpvWord(UInt64(value)),
+                        SpvWord(UInt64(value) >> 32));
+                }
+                return emitInst(section, inst, SpvOpConstant, inst->getDataType(), kResultID, SpvWord(value));
+            }
+
+        case kIROp_FloatLit:
+            {
+                // > OpConstant
+                const IRFloatingPointValue value = cast<IRConstant>(inst)->value.floatVal;
+                switch( _getScalarSize(inst->getDataType()) )
+                {
+                case 2:
+                    return emitInst(section, inst, SpvOpConstant, inst->getDataType(), kResultID, SpvWord(FloatToHalf(float(value))));
+                case 4:
+                    {
+                        const float floatValue = float(value);
+                        SpvWord word;
+                        memcpy(&word, &floatValue, sizeof(word));
+                        return emitInst(section, inst, SpvOpConstant, inst->getDataType(), kResultID, word);
+                    }
+                default:
+                    {
+                        SpvWord words[2];
+                        memcpy(words, &value, sizeof(words));
+                        return emitInst(section, inst, SpvOpConstant, inst->getDataType(), kResultID, words[0], words[1]);
+                    }
+                }
+            }
+
+        case kIROp_DefaultConstruct:
+            // > OpConstantNull
+            return emitInst(section, inst, SpvOpConstantNull, inst->getDataType(), kResultID);
+
+        // [3.32.8. Memory Instructions]
+        //
+        // > OpVariable
+        //
+        case kIROp_GlobalParam:
+            return emitGlobalParam(cast<IRGlobalParam>(inst));
+
+        case kIROp_GlobalVar:
+            return emitGlobalVar(cast<IRGlobalVar>(inst));
+
         case kIROp_Func:
             // [3.32.6: Function Instructions]
             //
@@ -866,214 +1051,2044 @@ struct SPIRVEmitContext
         }
     }
 
-        /// Emit the given `irFunc` to SPIR-V
-    SpvInst* emitFunc(IRFunc* irFunc)
+        /// Emit an `OpTypeInt` for `inst`, requiring any capability the width needs
+    SpvInst* emitIntType(IRInst* inst, SpvWord bitCount, SpvWord isSigned)
     {
-        // [2.4: Logical Layout of a Module]
-        //
-        // > All function declarations ("declarations" are functions
-        // > without a body; there is no forward declaration to a
-        // > function with a body).
-        // > ...
-        // > All function definitions (functions with a body).
-        //
-        // We need to treat functions differently based
-        // on whether they have a body or not, since these
-        // are encoded differently (and to different sections).
-        //
-        if( isDefinition(irFunc) )
-        {
-            return emitFuncDefinition(irFunc);
-        }
-        else
+        switch( bitCount )
         {
-            return emitFuncDeclaration(irFunc);
+        case 8:     requireCapability(SpvCapabilityInt8); break;
+        case 16:    requireCapability(SpvCapabilityInt16); break;
+        case 64:    requireCapability(SpvCapabilityInt64); break;
+        default:    break;
         }
+        return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeInt, kResultID, bitCount, isSigned);
     }
 
-        /// Emit a declaration for the given `irFunc`
-    SpvInst* emitFuncDeclaration(IRFunc* irFunc)
+        /// Emit an `OpTypeFloat` for `inst`, requiring any capability the width needs
+    SpvInst* emitFloatType(IRInst* inst, SpvWord bitCount)
     {
-        // For now we aren't handling function declarations;
-        // we expect to deal only with fully linked modules.
-        //
-        SLANG_UNUSED(irFunc);
-        SLANG_UNEXPECTED("function declaration in SPIR-V emit");
-        UNREACHABLE_RETURN(nullptr);
+        switch( bitCount )
+        {
+        case 16:    requireCapability(SpvCapabilityFloat16); break;
+        case 64:    requireCapability(SpvCapabilityFloat64); break;
+        default:    break;
+        }
+        return emitInst(getSection(SpvLogicalSectionID::Types), inst, SpvOpTypeFloat, kResultID, bitCount);
     }
 
-        /// Emit a SPIR-V function definition for the Slang IR function `irFunc`.
-    SpvInst* emitFuncDefinition(IRFunc* irFunc)
+        /// Emit an `OpTypeStruct` for `structType`, along with the names of its members
+    SpvInst* emitStructType(IRStructType* structType)
     {
-        // [2.4: Logical Layout of a Module]
-        //
-        // > All function definitions (functions with a body).
-        //
-        auto section = getSection(SpvLogicalSectionID::FunctionDefinitions);
-        //
-        // > A function definition is as follows.
-        // > * Function definition, using OpFunction.
-        // > * Function parameter declarations, using OpFunctionParameter.
-        // > * Block
-        // > * Block
-        // > * ...
-        // > * Function end, using OpFunctionEnd.
-        //
-
-        // [3.24. Function Control]
-        //
-        // TODO: We should eventually support emitting the "function control"
-        // mask to include inline and other hint bits based on decorations
-        // set on `irFunc`.
-        //
-        SpvFunctionControlMask spvFunctionControl = SpvFunctionControlMaskNone;
-
-        // [3.32.9. Function Instructions]
-        //
-        // > OpFunction
-        //
-        // Note that the type <id> of a SPIR-V function uses the
-        // *result* type of the function, while the actual function
-        // type is given as a later operand. Slan IR instead uses
-        // the type of a function instruction store, you know, its *type*.
-        //
-        SpvInst* spvFunc = emitInst(section, irFunc, SpvOpFunction,
-            irFunc->getDataType()->getResultType(),
-            kResultID,
-            spvFunctionControl,
-            irFunc->getDataType());
-
-        // > OpFunctionParameter
-        //
-        // Unlike Slang, where parameters always belong to blocks,
-        // the parameters of a SPIR-V function must appear as direct
-        // children of the function instruction, and before any basic blocks.
+        // Fields in SPIR-V are identified by their index, rather than
+        // by a key as in the Slang IR, so the only place the keys
+        // show up is in the names of the members.
         //
-        for( auto irParam : irFunc->getParams() )
+        SpvInst* spvStructType = nullptr;
         {
-            emitInst(spvFunc, irParam, SpvOpFunctionParameter,
-                irParam->getFullType(),
-                kResultID);
+            InstConstructScope scopeInst(this, SpvOpTypeStruct, structType);
+            spvStructType = scopeInst;
+            emitOperand(kResultID);
+            for( auto field : structType->getFields() )
+            {
+                emitOperand(field->getFieldType());
+            }
+            getSection(SpvLogicalSectionID::Types)->addInst(spvStructType);
         }
 
-        // [3.32.17. Control-Flow Instructions]
-        //
-        // > OpLabel
-        //
-        // A Slang `IRBlock` corresponds to a SPIR-V `OpLabel`:
-        // each represents a basic block in the control flow
-        // graph of a parent function.
+        const SpvWord structID = getID(spvStructType);
+
+        // [3.32.2. Debug Instructions]
         //
-        // We will allocate SPIR-V instructions to represent
-        // all of the blocks in a function before we emit
-        // body instructions into any of them. We do this
-        // because it is possible for one block to make
-        // forward reference to another (wheras that is
-        // not possible for ordinary instructions within
-        // the blocks in the Slang IR)
+        // > OpMemberName
         //
-        for( auto irBlock : irFunc->getBlocks() )
+        SpvWord memberIndex = 0;
+        for( auto field : structType->getFields() )
         {
-            emitInst(spvFunc, irBlock, SpvOpLabel, kResultID);
+            if( auto nameHint = field->getKey()->findDecoration<IRNameHintDecoration>() )
+            {
+                emitInst(getSection(SpvLogicalSectionID::DebugNames), nullptr, SpvOpMemberName, structID, memberIndex, nameHint->getName());
+            }
+            memberIndex++;
         }
 
-        // Once all the basic blocks have had instructions allocated
-        // for them, we go through and fill them in with their bodies.
+        emitDecorations(structType, structID);
+        return spvStructType;
+    }
+
+    // Buffers in the Slang IR are opaque types, while in SPIR-V
+    // they are variables of a structure type decorated as a `Block`,
+    // and the contents of the buffer are the members of the structure.
+    //
+    // We use the same structure the GLSL emitter declares for each
+    // kind of buffer, so that the code we emit for accessing the
+    // buffers (which often comes from GLSL intrinsic definitions
+    // such as `$0._data[$1]`) is the same for both targets.
+
+        /// Emit the block type for a structured buffer, which is equivalent to the GLSL
+        ///
+        ///     buffer { T _data[]; }
+        ///
+    SpvInst* emitStructuredBufferType(IRHLSLStructuredBufferTypeBase* bufferType)
+    {
+        auto section = getSection(SpvLogicalSectionID::Types);
+        auto annotations = getSection(SpvLogicalSectionID::Annotations);
+
+        // The stride of the array, and the layout of the element type, are
+        // decorated when a parameter of the buffer type is emitted.
         //
-        for( auto irBlock : irFunc->getBlocks() )
-        {
-            // Note: because we already created the block above,
-            // we can be sure that it will have been registred.
-            //
-            SpvInst* spvBlock = nullptr;
-            m_mapIRInstToSpvInst.TryGetValue(irBlock, spvBlock);
-            SLANG_ASSERT(spvBlock);
+        SpvInst* spvArrayType = emitInst(section, nullptr, SpvOpTypeRuntimeArray, kResultID, bufferType->getElementType());
+        m_runtimeArrayTypes.Add(bufferType, spvArrayType);
 
-            // [3.32.17. Control-Flow Instructions]
-            //
-            // > OpPhi
-            //
-            // TODO: We eventually need to emit `OpPhi` instructions corresponding
-            // to the parameters of any non-entry block, with operands representing
-            // the values passed along incoming edges from the predecessor blocks.
+        SpvInst* spvBlockType = emitInst(section, bufferType, SpvOpTypeStruct, kResultID, spvArrayType);
+        const SpvWord blockID = getID(spvBlockType);
 
-            for( auto irInst : irBlock->getOrdinaryInsts() )
-            {
-                // Any instructions local to the block will be emitted as children
-                // of the block.
-                //
-                emitLocalInst(spvBlock, irInst);
-            }
+        emitInst(annotations, nullptr, SpvOpDecorate, blockID, SpvDecorationBlock);
+        emitInst(annotations, nullptr, SpvOpMemberDecorate, blockID, SpvWord(0), SpvDecorationOffset, SpvWord(0));
+        if( bufferType->getOp() == kIROp_HLSLStructuredBufferType )
+        {
+            emitInst(annotations, nullptr, SpvOpMemberDecorate, blockID, SpvWord(0), SpvDecorationNonWritable);
         }
 
-        // [3.32.9. Function Instructions]
-        //
-        // > OpFunctionEnd
-        //
-        // In the SPIR-V encoding a function is logically the parent of any
-        // instructions up to a matching `OpFunctionEnd`. In our intermediate
-        // structure we will make the `OpFunctionEnd` be the last child of
-        // the `OpFunction`.
-        //
-        emitInst(spvFunc, nullptr, SpvOpFunctionEnd);
+        emitInst(getSection(SpvLogicalSectionID::DebugNames), nullptr, SpvOpMemberName, blockID, SpvWord(0), UnownedStringSlice::fromLiteral("_data"));
+        return spvBlockType;
+    }
 
-        // We will emit any decorations pertinent to the function to the
-        // appropriate section of the module.
-        //
-        emitDecorations(irFunc, getID(spvFunc));
+        /// Emit the block type for a constant buffer, which holds the element type as its only member
+    SpvInst* emitConstantBufferType(IRConstantBufferType* bufferType)
+    {
+        auto annotations = getSection(SpvLogicalSectionID::Annotations);
 
-        return spvFunc;
+        SpvInst* spvBlockType = emitInst(getSection(SpvLogicalSectionID::Types), bufferType, SpvOpTypeStruct, kResultID, bufferType->getElementType());
+        const SpvWord blockID = getID(spvBlockType);
+
+        emitInst(annotations, nullptr, SpvOpDecorate, blockID, SpvDecorationBlock);
+        emitInst(annotations, nullptr, SpvOpMemberDecorate, blockID, SpvWord(0), SpvDecorationOffset, SpvWord(0));
+        return spvBlockType;
     }
 
-    // The instructions that appear inside the basic blocks of
-    // functions are what we will call "local" instructions.
+    // [2.16.2. Validation Rules for Shader Capabilities]
     //
-    // When emititng blobal instructions, we usually have to
-    // pick the right logical section to emit them into, while
-    // for local instructions they will usually emit into
-    // a known parent (the basic block that contains them).
+    // > Composite objects in the StorageBuffer, PhysicalStorageBuffer, Uniform,
+    // > and PushConstant Storage Classes must be explicitly laid out.
+    //
+    // That means decorating the members of every structure with their
+    // `Offset`, and every array with its `ArrayStride`. These come from
+    // the layout computed for the buffer parameter (following the rules
+    // for its kind of buffer), which the IR holds as the type layout of
+    // the parameter.
+    //
+    // A type can only have one set of decorations, so we track the
+    // offsets or stride each type was decorated with, and report an
+    // error if a type would need different ones, such as a structure
+    // used in both a constant buffer and a structured buffer.
 
-        /// Emit an instruction that is local to the body of the given `parent`.
-    SpvInst* emitLocalInst(SpvInstParent* parent, IRInst* inst)
+        /// The offsets (for a structure) or stride (for an array) each type was decorated with
+    Dictionary<IRInst*, List<IRIntegerValue>> m_explicitLayouts;
+
+        /// The runtime array types holding the contents of structured buffers, by buffer type
+    Dictionary<IRInst*, SpvInst*> m_runtimeArrayTypes;
+
+        /// Decorate `spvType` (the SPIR-V type for `type`) with `layout`, returning false if it already has a different layout
+    bool _emitExplicitLayoutDecorations(IRInst* type, SpvInst* spvType, const List<IRIntegerValue>& layout)
     {
-        switch( inst->getOp() )
+        if( auto existingLayout = m_explicitLayouts.TryGetValue(type) )
         {
-        default:
-            SLANG_UNIMPLEMENTED_X("unhandled instruction opcode");
-            break;
+            return *existingLayout == layout;
+        }
+        m_explicitLayouts.Add(type, layout);
 
-        // [3.32.17. Control-Flow Instructions]
-        //
-        // > OpReturn
-        case kIROp_ReturnVoid: return emitInst(parent, inst, SpvOpReturn);
+        auto annotations = getSection(SpvLogicalSectionID::Annotations);
+        if( spvType->opcode == SpvOpTypeStruct )
+        {
+            for( Index i = 0; i < layout.getCount(); ++i )
+            {
+                emitInst(annotations, nullptr, SpvOpMemberDecorate, getID(spvType), SpvWord(i), SpvDecorationOffset, SpvWord(layout[i]));
+            }
+        }
+        else
+        {
+            emitInst(annotations, nullptr, SpvOpDecorate, getID(spvType), SpvDecorationArrayStride, SpvWord(layout[0]));
         }
+        return true;
     }
 
-    // Both "local" and "global" instructions can have decorations.
-    // When we decide to emit an instruction, we typically also want
-    // to emit any decoratons that were attached to it that have
-    // a SPIR-V equivalent.
-
-        /// Emit appropriate SPIR-V decorations for the given IR `irInst`.
-        ///
-        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
-        /// and should correspond to `irInst`.
+        /// Decorate `type` (and the types it is made of) with the explicit layout given by `typeLayout`.
         ///
-    void emitDecorations(IRInst* irInst, SpvWord dstID)
+        /// `param` is the buffer parameter that holds the type, which errors are reported for.
+    void emitExplicitLayout(IRGlobalParam* param, IRType* type, IRTypeLayout* typeLayout)
     {
-        for( auto decoration : irInst->getDecorations() )
+        if( auto vectorType = as<IRVectorType>(type) )
         {
-            emitDecoration(dstID, decoration);
+            type = vectorType->getElementType();
+        }
+        if( as<IRBoolType>(type) )
+        {
+            // There is no bool type that can be stored in a buffer
+            m_sink->diagnose(param, Diagnostics::spirvBoolInBuffer, _getName(param));
+            return;
+        }
+        if( as<IRBasicType>(type) )
+        {
+            return;
         }
-    }
 
-        /// Emit an appropriate SPIR-V decoration for the given IR `decoration`, if necessary and possible.
-        ///
-        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
-        /// and should correspond to the parent of `decoration` in the Slang IR.
-        ///
-    void emitDecoration(SpvWord dstID, IRDecoration* decoration)
-    {
+        List<IRIntegerValue> layout;
+        if( auto arrayType = as<IRArrayType>(type) )
+        {
+            auto arrayTypeLayout = as<IRArrayTypeLayout>(typeLayout);
+            SLANG_ASSERT(arrayTypeLayout);
+
+            emitExplicitLayout(param, arrayType->getElementType(), arrayTypeLayout->getElementTypeLayout());
+            layout.add(arrayTypeLayout->getUniformStride());
+        }
+        else if( auto structType = as<IRStructType>(type) )
+        {
+            auto structTypeLayout = as<IRStructTypeLayout>(typeLayout);
+            SLANG_ASSERT(structTypeLayout);
+
+            // The layout identifies fields by their key
+            for( auto field : structType->getFields() )
+            {
+                IRVarLayout* fieldLayout = nullptr;
+                for( auto fieldLayoutAttr : structTypeLayout->getFieldLayoutAttrs() )
+                {
+                    if( fieldLayoutAttr->getFieldKey() == field->getKey() )
+                    {
+                        fieldLayout = fieldLayoutAttr->getLayout();
+                        break;
+                    }
+                }
+                SLANG_ASSERT(fieldLayout);
+
+                emitExplicitLayout(param, field->getFieldType(), fieldLayout->getTypeLayout());
+
+                auto offsetAttr = fieldLayout->findOffsetAttr(LayoutResourceKind::Uniform);
+                layout.add(offsetAttr ? IRIntegerValue(offsetAttr->getOffset()) : 0);
+            }
+        }
+        else
+        {
+            SLANG_UNIMPLEMENTED_X("type in buffer in SPIR-V emit");
+        }
+
+        if( !_emitExplicitLayoutDecorations(type, ensureInst(type), layout) )
+        {
+            m_sink->diagnose(param, Diagnostics::spirvTypeWithMoreThanOneBufferLayout, _getName(param));
+        }
+    }
+
+        /// Decorate the contents of the buffer held by `param` with their explicit layout
+    void emitBufferLayout(IRGlobalParam* param, IRType* bufferType)
+    {
+        auto layoutDecor = param->findDecoration<IRLayoutDecoration>();
+        auto varLayout = layoutDecor ? as<IRVarLayout>(layoutDecor->getLayout()) : nullptr;
+        if( !varLayout )
+        {
+            SLANG_UNEXPECTED("buffer parameter without layout in SPIR-V emit");
+        }
+        auto typeLayout = varLayout->getTypeLayout();
+
+        if( auto structuredBufferType = as<IRHLSLStructuredBufferTypeBase>(bufferType) )
+        {
+            auto structuredBufferTypeLayout = as<IRStructuredBufferTypeLayout>(typeLayout);
+            SLANG_ASSERT(structuredBufferTypeLayout);
+
+            emitExplicitLayout(param, structuredBufferType->getElementType(), structuredBufferTypeLayout->getElementTypeLayout());
+
+            List<IRIntegerValue> layout;
+            layout.add(structuredBufferTypeLayout->getElementStride());
+            if( !_emitExplicitLayoutDecorations(structuredBufferType, m_runtimeArrayTypes[structuredBufferType], layout) )
+            {
+                m_sink->diagnose(param, Diagnostics::spirvTypeWithMoreThanOneBufferLayout, _getName(param));
+            }
+        }
+        else if( auto constantBufferType = as<IRConstantBufferType>(bufferType) )
+        {
+            auto parameterGroupTypeLayout = as<IRParameterGroupTypeLayout>(typeLayout);
+            SLANG_ASSERT(parameterGroupTypeLayout);
+
+            emitExplicitLayout(param, constantBufferType->getElementType(), parameterGroupTypeLayout->getElementVarLayout()->getTypeLayout());
+        }
+    }
+
+        /// Get the name of `inst` to use in diagnostics
+    static String _getName(IRInst* inst)
+    {
+        if( auto nameHint = inst->findDecoration<IRNameHintDecoration>() )
+        {
+            return nameHint->getName();
+        }
+        return "(unnamed)";
+    }
+
+    // Pointer types in SPIR-V are parameterized on a storage class,
+    // which isn't part of the IR type, so we can't simply map IR
+    // pointer types to SPIR-V ones. Instead we look up pointer types
+    // by the storage class and the <id> of the type pointed to.
+
+        /// Map from (storage class, value type <id>) to the SPIR-V pointer type
+    Dictionary<UInt64, SpvInst*> m_pointerTypes;
+
+        /// Get the SPIR-V type for a pointer to `valueType` in `storageClass`
+    SpvInst* ensurePointerType(SpvStorageClass storageClass, IRType* valueType)
+    {
+        SpvInst* spvValueType = ensureInst(valueType);
+
+        const UInt64 key = (UInt64(storageClass) << 32) | getID(spvValueType);
+        SpvInst* spvPointerType = nullptr;
+        if( !m_pointerTypes.TryGetValue(key, spvPointerType) )
+        {
+            spvPointerType = emitInst(getSection(SpvLogicalSectionID::Types), nullptr, SpvOpTypePointer, kResultID, storageClass, spvValueType);
+            m_pointerTypes.Add(key, spvPointerType);
+        }
+        return spvPointerType;
+    }
+
+        /// Get the storage class that a global shader parameter is declared in
+    SpvStorageClass getGlobalParamStorageClass(IRGlobalParam* param)
+    {
+        // By the time we emit SPIR-V, the GLSL legalization pass has turned
+        // entry point varying parameters into global parameters. Inputs are
+        // held directly, and outputs are held as `Out<T>` (or `InOut<T>`).
+        //
+        auto type = param->getDataType();
+        if( as<IROutTypeBase>(type) )
+        {
+            return SpvStorageClassOutput;
+        }
+        if( as<IRHLSLStructuredBufferTypeBase>(type) )
+        {
+            return SpvStorageClassStorageBuffer;
+        }
+        if( as<IRConstantBufferType>(type) )
+        {
+            // Push constant buffers are reported as unsupported when the parameter is emitted
+            return SpvStorageClassUniform;
+        }
+        if( as<IRResourceTypeBase>(type) || as<IRSamplerStateTypeBase>(type) || as<IRUntypedBufferResourceType>(type) || as<IRParameterGroupType>(type) )
+        {
+            SLANG_UNIMPLEMENTED_X("shader parameter type in SPIR-V emit");
+        }
+        return SpvStorageClassInput;
+    }
+
+        /// Get the storage class of the memory that `address` points to
+    SpvStorageClass getStorageClassForAddress(IRInst* address)
+    {
+        for(;;)
+        {
+            switch( address->getOp() )
+            {
+            case kIROp_GlobalParam:
+                return getGlobalParamStorageClass(cast<IRGlobalParam>(address));
+
+            case kIROp_GlobalVar:
+                return as<IRGroupSharedRate>(address->getRate()) ? SpvStorageClassWorkgroup : SpvStorageClassPrivate;
+
+            case kIROp_FieldAddress:
+            case kIROp_getElementPtr:
+                address = address->getOperand(0);
+                break;
+
+            case kIROp_Call:
+                // The only calls that produce an address are accessors
+                // into the buffer passed as the first argument.
+                address = cast<IRCall>(address)->getArg(0);
+                break;
+
+            default:
+                // Local variables, and parameters of pointer type
+                return SpvStorageClassFunction;
+            }
+        }
+    }
+
+        /// Get the SPIR-V type of the result of `inst`, taking the storage class into account if it is an address
+    SpvInst* getResultType(IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        if( auto ptrType = as<IRPtrTypeBase>(type) )
+        {
+            return ensurePointerType(getStorageClassForAddress(inst), ptrType->getValueType());
+        }
+        return ensureInst(type);
+    }
+
+    // Variables that are part of the interface of an entry point
+    // (varying inputs and outputs, and from SPIR-V 1.4 all global
+    // variables) need to be listed by the `OpEntryPoint`.
+
+        /// Global variables to list in the interface of entry points
+    List<SpvInst*> m_interfaceVars;
+        /// Set if the `FragDepth` builtin is written, which needs an execution mode
+    bool m_usesFragDepth = false;
+
+    void _addToInterface(SpvInst* spvVar, SpvStorageClass storageClass)
+    {
+        if( storageClass == SpvStorageClassInput || storageClass == SpvStorageClassOutput || SpvVersion >= 0x10400 )
+        {
+            m_interfaceVars.add(spvVar);
+        }
+    }
+
+        /// Emit an `OpVariable` for a global shader parameter
+    SpvInst* emitGlobalParam(IRGlobalParam* param)
+    {
+        auto storageClass = getGlobalParamStorageClass(param);
+
+        IRType* valueType = param->getDataType();
+        if( auto outType = as<IROutTypeBase>(valueType) )
+        {
+            valueType = outType->getValueType();
+        }
+
+        SpvInst* spvVar = emitInst(getSection(SpvLogicalSectionID::Types), param, SpvOpVariable,
+            ensurePointerType(storageClass, valueType),
+            kResultID,
+            storageClass);
+        const SpvWord varID = getID(spvVar);
+
+        emitDecorations(param, varID);
+        emitGlobalParamLayoutDecorations(param, varID, storageClass);
+        _addToInterface(spvVar, storageClass);
+
+        if( storageClass == SpvStorageClassUniform || storageClass == SpvStorageClassStorageBuffer )
+        {
+            if( _isPushConstantBuffer(param) )
+            {
+                m_sink->diagnose(param, Diagnostics::spirvPushConstantBufferUnsupported, _getName(param));
+            }
+            emitBufferLayout(param, valueType);
+        }
+        return spvVar;
+    }
+
+        /// Returns true if `param` is a push constant buffer, rather than an ordinary constant buffer
+    static bool _isPushConstantBuffer(IRGlobalParam* param)
+    {
+        // Push constants would need a block type (and layout) of their own, and no binding
+        auto layoutDecor = param->findDecoration<IRLayoutDecoration>();
+        auto varLayout = layoutDecor ? as<IRVarLayout>(layoutDecor->getLayout()) : nullptr;
+        return varLayout && varLayout->findOffsetAttr(LayoutResourceKind::PushConstantBuffer);
+    }
+
+        /// Emit an `OpVariable` for a global variable
+    SpvInst* emitGlobalVar(IRGlobalVar* globalVar)
+    {
+        // An initializer would need to be run at the start of the entry point
+        if( globalVar->getFirstBlock() )
+        {
+            m_sink->diagnose(globalVar, Diagnostics::spirvGlobalVariableInitializerUnsupported, _getName(globalVar));
+        }
+
+        auto storageClass = getStorageClassForAddress(globalVar);
+        SpvInst* spvVar = emitInst(getSection(SpvLogicalSectionID::Types), globalVar, SpvOpVariable,
+            ensurePointerType(storageClass, globalVar->getDataType()->getValueType()),
+            kResultID,
+            storageClass);
+
+        emitDecorations(globalVar, getID(spvVar));
+        _addToInterface(spvVar, storageClass);
+        return spvVar;
+    }
+
+        /// Emit the decorations that bind a global parameter to its location, binding or builtin
+    void emitGlobalParamLayoutDecorations(IRGlobalParam* param, SpvWord varID, SpvStorageClass storageClass)
+    {
+        auto annotations = getSection(SpvLogicalSectionID::Annotations);
+
+        // The GLSL legalization pass marks parameters for system values
+        // as imports of the corresponding GLSL builtin variables.
+        //
+        if( auto importDecor = param->findDecoration<IRImportDecoration>() )
+        {
+            auto builtIn = mapGLSLBuiltInToSPIRV(importDecor->getMangledName());
+            emitInst(annotations, nullptr, SpvOpDecorate, varID, SpvDecorationBuiltIn, builtIn);
+            if( builtIn == SpvBuiltInFragDepth )
+            {
+                m_usesFragDepth = true;
+            }
+            return;
+        }
+
+        auto layoutDecor = param->findDecoration<IRLayoutDecoration>();
+        if( !layoutDecor )
+            return;
+        auto varLayout = as<IRVarLayout>(layoutDecor->getLayout());
+        if( !varLayout )
+            return;
+
+        switch( storageClass )
+        {
+        case SpvStorageClassInput:
+        case SpvStorageClassOutput:
+            {
+                auto kind = storageClass == SpvStorageClassInput ? LayoutResourceKind::VaryingInput : LayoutResourceKind::VaryingOutput;
+                if( auto offsetAttr = varLayout->findOffsetAttr(kind) )
+                {
+                    emitInst(annotations, nullptr, SpvOpDecorate, varID, SpvDecorationLocation, SpvWord(offsetAttr->getOffset()));
+
+                    // A fragment output with a nonzero space is the second input of dual-source blending
+                    if( auto index = offsetAttr->getSpace() )
+                    {
+                        emitInst(annotations, nullptr, SpvOpDecorate, varID, SpvDecorationIndex, SpvWord(index));
+                    }
+                }
+            }
+            break;
+
+        default:
+            if( auto offsetAttr = varLayout->findOffsetAttr(LayoutResourceKind::DescriptorTableSlot) )
+            {
+                UInt space = offsetAttr->getSpace();
+                if( auto spaceAttr = varLayout->findOffsetAttr(LayoutResourceKind::RegisterSpace) )
+                {
+                    space += spaceAttr->getOffset();
+                }
+                emitInst(annotations, nullptr, SpvOpDecorate, varID, SpvDecorationDescriptorSet, SpvWord(space));
+                emitInst(annotations, nullptr, SpvOpDecorate, varID, SpvDecorationBinding, SpvWord(offsetAttr->getOffset()));
+            }
+            break;
+        }
+    }
+
+        /// Map the name of a GLSL builtin variable to the SPIR-V `BuiltIn` decoration
+    SpvBuiltIn mapGLSLBuiltInToSPIRV(UnownedStringSlice const& name)
+    {
+        // [3.21. BuiltIn]
+        //
+        // Some of the builtins need capabilities beyond `Shader`.
+        //
+        static const struct
+        {
+            char const*     name;
+            SpvBuiltIn      builtIn;
+            SpvCapability   capability;
+        } kBuiltIns[] =
+        {
+            { "gl_Position",                SpvBuiltInPosition,             SpvCapabilityShader },
+            { "gl_PointSize",               SpvBuiltInPointSize,            SpvCapabilityShader },
+            { "gl_ClipDistance",            SpvBuiltInClipDistance,         SpvCapabilityClipDistance },
+            { "gl_CullDistance",            SpvBuiltInCullDistance,         SpvCapabilityCullDistance },
+            { "gl_VertexIndex",             SpvBuiltInVertexIndex,          SpvCapabilityShader },
+            { "gl_InstanceIndex",           SpvBuiltInInstanceIndex,        SpvCapabilityShader },
+            { "gl_PrimitiveID",             SpvBuiltInPrimitiveId,          SpvCapabilityGeometry },
+            { "gl_InvocationID",            SpvBuiltInInvocationId,         SpvCapabilityGeometry },
+            { "gl_Layer",                   SpvBuiltInLayer,                SpvCapabilityGeometry },
+            { "gl_ViewportIndex",           SpvBuiltInViewportIndex,        SpvCapabilityMultiViewport },
+            { "gl_TessCoord",               SpvBuiltInTessCoord,            SpvCapabilityTessellation },
+            { "gl_FragCoord",               SpvBuiltInFragCoord,            SpvCapabilityShader },
+            { "gl_FrontFacing",             SpvBuiltInFrontFacing,          SpvCapabilityShader },
+            { "gl_SampleID",                SpvBuiltInSampleId,             SpvCapabilitySampleRateShading },
+            { "gl_SampleMaskIn",            SpvBuiltInSampleMask,           SpvCapabilityShader },
+            { "gl_SampleMask",              SpvBuiltInSampleMask,           SpvCapabilityShader },
+            { "gl_FragDepth",               SpvBuiltInFragDepth,            SpvCapabilityShader },
+            { "gl_NumWorkGroups",           SpvBuiltInNumWorkgroups,        SpvCapabilityShader },
+            { "gl_WorkGroupID",             SpvBuiltInWorkgroupId,          SpvCapabilityShader },
+            { "gl_LocalInvocationID",       SpvBuiltInLocalInvocationId,    SpvCapabilityShader },
+            { "gl_GlobalInvocationID",      SpvBuiltInGlobalInvocationId,   SpvCapabilityShader },
+            { "gl_LocalInvocationIndex",    SpvBuiltInLocalInvocationIndex, SpvCapabilityShader },
+        };
+
+        for( auto const& entry : kBuiltIns )
+        {
+            if( name == entry.name )
+            {
+                requireCapability(entry.capability);
+                return entry.builtIn;
+            }
+        }
+
+        SLANG_UNIMPLEMENTED_X("builtin variable in SPIR-V emit");
+        UNREACHABLE_RETURN(SpvBuiltInMax);
+    }
+
+        /// Emit the given `irFunc` to SPIR-V
+    SpvInst* emitFunc(IRFunc* irFunc)
+    {
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All function declarations ("declarations" are functions
+        // > without a body; there is no forward declaration to a
+        // > function with a body).
+        // > ...
+        // > All function definitions (functions with a body).
+        //
+        // We need to treat functions differently based
+        // on whether they have a body or not, since these
+        // are encoded differently (and to different sections).
+        //
+        if( isDefinition(irFunc) )
+        {
+            return emitFuncDefinition(irFunc);
+        }
+        else
+        {
+            return emitFuncDeclaration(irFunc);
+        }
+    }
+
+        /// Emit a declaration for the given `irFunc`
+    SpvInst* emitFuncDeclaration(IRFunc* irFunc)
+    {
+        // For now we aren't handling function declarations;
+        // we expect to deal only with fully linked modules.
+        //
+        SLANG_UNUSED(irFunc);
+        SLANG_UNEXPECTED("function declaration in SPIR-V emit");
+        UNREACHABLE_RETURN(nullptr);
+    }
+
+    // The Slang IR and SPIR-V differ in how they represent the
+    // control flow inside a function body:
+    //
+    // * Values flowing into a block are parameters of the block in
+    //   the Slang IR, with arguments passed by the branches to it.
+    //   In SPIR-V they are `OpPhi` instructions at the start of the
+    //   block, which list a value for every predecessor.
+    //
+    // * SPIR-V requires *structured* control flow, where the header
+    //   of each loop and selection names its merge block (and loops their
+    //   continue target) with an `OpLoopMerge` or `OpSelectionMerge`.
+    //   The Slang IR records the same information in its `loop`,
+    //   `ifElse` and `switch` terminators.
+    //
+    // * A loop header can't also be the continue target of its loop,
+    //   while in the Slang IR the continue block of a loop without any
+    //   "continue" code (e.g., a `while` loop) is the header itself.
+    //   We synthesize a continue block for such loops, which just
+    //   branches back to the header.
+    //
+    // * The header of a loop in SPIR-V holds the `OpLoopMerge`, so it
+    //   can't also be the header of a selection (as the first block of
+    //   a loop body often is in the Slang IR). We split each loop header
+    //   so that the body of the IR block goes in a block of its own.
+    //
+    // Because phis need the values for all the predecessors (which
+    // may be emitted after the block), we emit a placeholder for each
+    // phi up front, and fill in the operands once the whole function
+    // has been emitted.
+
+        /// An edge into a block with phis
+    struct PhiIncoming
+    {
+        SpvInst*                fromLabel = nullptr;        ///< The block the edge comes from
+        IRUnconditionalBranch*  branch = nullptr;           ///< The branch whose arguments are the values, if any
+        Index                   fromPhiBlockIndex = -1;     ///< Otherwise the values are the phis of this block
+    };
+
+        /// A block with phis, corresponding to the parameters of an IR block
+    struct PhiBlock
+    {
+        IRBlock*                paramsBlock = nullptr;      ///< The IR block whose parameters the phis are for
+        List<SpvInst*>          phis;
+        List<PhiIncoming>       incoming;
+    };
+
+        /// A loop in the function being emitted
+    struct LoopInfo
+    {
+        IRLoop*                 loop = nullptr;
+        SpvInst*                bodyLabel = nullptr;        ///< The block holding the body of the header block
+        SpvInst*                continueLabel = nullptr;    ///< A synthesized continue target, if needed
+        Index                   continuePhiBlockIndex = -1; ///< Phis of the synthesized continue target, if any
+    };
+
+        /// State for the function being emitted
+    struct FuncState
+    {
+        Dictionary<IRInst*, SpvInst*>   loadedInputs;       ///< Loads of the varying inputs used by the function
+        Dictionary<IRBlock*, LoopInfo>  loops;              ///< Loops in the function, keyed by their header
+        List<IRBlock*>                  loopHeaders;        ///< Loop headers, in order
+        Dictionary<IRBlock*, Index>     phiBlockIndices;    ///< Index into phiBlocks for IR blocks with parameters
+        List<PhiBlock>                  phiBlocks;
+    };
+
+        /// The function currently being emitted, if any
+    FuncState* m_funcState = nullptr;
+
+        /// Add a block of placeholder phis to `label`, for the parameters of `paramsBlock`
+    Index _addPhiBlock(SpvInst* label, IRBlock* paramsBlock, bool registerParams)
+    {
+        PhiBlock phiBlock;
+        phiBlock.paramsBlock = paramsBlock;
+        for( auto irParam : paramsBlock->getParams() )
+        {
+            InstConstructScope scopeInst(this, SpvOpPhi, registerParams ? irParam : nullptr);
+            SpvInst* spvPhi = scopeInst;
+            getID(spvPhi);
+            label->addInst(spvPhi);
+            phiBlock.phis.add(spvPhi);
+        }
+
+        const Index index = m_funcState->phiBlocks.getCount();
+        m_funcState->phiBlocks.add(phiBlock);
+        return index;
+    }
+
+        /// Fill in the operands of the placeholder phis of `phiBlock`
+    void _fillPhis(PhiBlock const& phiBlock)
+    {
+        Index paramIndex = 0;
+        for( auto irParam : phiBlock.paramsBlock->getParams() )
+        {
+            SpvInst* spvPhi = phiBlock.phis[paramIndex];
+
+            // A block that is never branched to can still have parameters
+            // (e.g., the continue block of a loop that always exits), and
+            // an `OpPhi` needs at least one operand, so we use an undefined
+            // value instead.
+            //
+            // > OpPhi
+            // > ...
+            // > There must be exactly one Parent i for each parent block of the current block
+            //
+            const SpvOp opcode = phiBlock.incoming.getCount() ? SpvOpPhi : SpvOpUndef;
+
+            SpvInst* filled = nullptr;
+            {
+                InstConstructScope scopeInst(this, opcode);
+                filled = scopeInst;
+                emitOperand(irParam->getDataType());
+                emitOperand(getID(spvPhi));
+                for( auto const& incoming : phiBlock.incoming )
+                {
+                    if( incoming.branch )
+                    {
+                        emitOperand(incoming.branch->getArg(paramIndex));
+                    }
+                    else
+                    {
+                        emitOperand(m_funcState->phiBlocks[incoming.fromPhiBlockIndex].phis[paramIndex]);
+                    }
+                    emitOperand(incoming.fromLabel);
+                }
+            }
+
+            // The placeholder is already in place (and referenced by <id> by
+            // the instructions that use it), so we take over the operands.
+            //
+            spvPhi->opcode = filled->opcode;
+            spvPhi->operandWords = filled->operandWords;
+            spvPhi->operandWordsCount = filled->operandWordsCount;
+
+            paramIndex++;
+        }
+    }
+
+        /// Emit a SPIR-V function definition for the Slang IR function `irFunc`.
+    SpvInst* emitFuncDefinition(IRFunc* irFunc)
+    {
+        // [2.4: Logical Layout of a Module]
+        //
+        // > All function definitions (functions with a body).
+        //
+        auto section = getSection(SpvLogicalSectionID::FunctionDefinitions);
+        //
+        // > A function definition is as follows.
+        // > * Function definition, using OpFunction.
+        // > * Function parameter declarations, using OpFunctionParameter.
+        // > * Block
+        // > * Block
+        // > * ...
+        // > * Function end, using OpFunctionEnd.
+        //
+
+        // [3.24. Function Control]
+        //
+        // TODO: We should eventually support emitting the "function control"
+        // mask to include inline and other hint bits based on decorations
+        // set on `irFunc`.
+        //
+        SpvFunctionControlMask spvFunctionControl = SpvFunctionControlMaskNone;
+
+        // [3.32.9. Function Instructions]
+        //
+        // > OpFunction
+        //
+        // Note that the type <id> of a SPIR-V function uses the
+        // *result* type of the function, while the actual function
+        // type is given as a later operand. Slan IR instead uses
+        // the type of a function instruction store, you know, its *type*.
+        //
+        SpvInst* spvFunc = emitInst(section, irFunc, SpvOpFunction,
+            irFunc->getDataType()->getResultType(),
+            kResultID,
+            spvFunctionControl,
+            irFunc->getDataType());
+
+        // > OpFunctionParameter
+        //
+        // Unlike Slang, where parameters always belong to blocks,
+        // the parameters of a SPIR-V function must appear as direct
+        // children of the function instruction, and before any basic blocks.
+        //
+        for( auto irParam : irFunc->getParams() )
+        {
+            emitInst(spvFunc, irParam, SpvOpFunctionParameter,
+                irParam->getFullType(),
+                kResultID);
+        }
+
+        // Emitting the body can lead to other functions being emitted
+        // (when they are called), so the state for this function is
+        // kept on the stack.
+        //
+        FuncState funcState;
+        FuncState* prevFuncState = m_funcState;
+        m_funcState = &funcState;
+
+        for( auto irBlock : irFunc->getBlocks() )
+        {
+            // Note: `IRLoop` doesn't have its own opcode test, so `as<IRLoop>`
+            // would match any unconditional branch.
+            auto terminator = irBlock->getTerminator();
+            if( terminator && terminator->getOp() == kIROp_loop )
+            {
+                auto irLoop = static_cast<IRLoop*>(terminator);
+                LoopInfo loopInfo;
+                loopInfo.loop = irLoop;
+                funcState.loops.Add(irLoop->getTargetBlock(), loopInfo);
+                funcState.loopHeaders.add(irLoop->getTargetBlock());
+            }
+        }
+
+        // [3.32.17. Control-Flow Instructions]
+        //
+        // > OpLabel
+        //
+        // A Slang `IRBlock` corresponds to a SPIR-V `OpLabel`:
+        // each represents a basic block in the control flow
+        // graph of a parent function.
+        //
+        // We will allocate SPIR-V instructions to represent
+        // all of the blocks in a function before we emit
+        // body instructions into any of them. We do this
+        // because it is possible for one block to make
+        // forward reference to another (wheras that is
+        // not possible for ordinary instructions within
+        // the blocks in the Slang IR)
+        //
+        // The same goes for the phis for block parameters, which can
+        // be used by blocks that come before any branch to the block.
+        //
+        for( auto irBlock : irFunc->getBlocks() )
+        {
+            SpvInst* spvBlock = emitInst(spvFunc, irBlock, SpvOpLabel, kResultID);
+
+            // > OpPhi
+            //
+            // The parameters of the entry block are the function parameters,
+            // which were handled above.
+            //
+            if( irBlock != irFunc->getFirstBlock() && irBlock->getFirstParam() )
+            {
+                funcState.phiBlockIndices.Add(irBlock, _addPhiBlock(spvBlock, irBlock, true));
+            }
+
+            if( auto loopInfo = funcState.loops.TryGetValue(irBlock) )
+            {
+                loopInfo->bodyLabel = emitInst(spvFunc, nullptr, SpvOpLabel, kResultID);
+            }
+        }
+
+        // The synthesized continue targets go after all the other blocks,
+        // which keeps them after the blocks of the loop body that branch
+        // to them.
+        //
+        for( auto header : funcState.loopHeaders )
+        {
+            auto loopInfo = funcState.loops.TryGetValue(header);
+            if( loopInfo->loop->getContinueBlock() != header )
+                continue;
+
+            loopInfo->continueLabel = emitInst(spvFunc, nullptr, SpvOpLabel, kResultID);
+            if( header->getFirstParam() )
+            {
+                loopInfo->continuePhiBlockIndex = _addPhiBlock(loopInfo->continueLabel, header, false);
+            }
+        }
+
+        // > All OpVariable instructions in a function must be the first
+        // > instructions in the first block.
+        //
+        SpvInst* spvEntryBlock = nullptr;
+        m_mapIRInstToSpvInst.TryGetValue(irFunc->getFirstBlock(), spvEntryBlock);
+        SLANG_ASSERT(spvEntryBlock);
+
+        for( auto irBlock : irFunc->getBlocks() )
+        {
+            for( auto irInst : irBlock->getOrdinaryInsts() )
+            {
+                if( irInst->getOp() != kIROp_Var )
+                    continue;
+
+                SpvInst* spvVar = emitInst(spvEntryBlock, irInst, SpvOpVariable,
+                    getResultType(irInst),
+                    kResultID,
+                    SpvStorageClassFunction);
+                emitDecorations(irInst, getID(spvVar));
+            }
+        }
+
+        // Load each varying input the function uses, once, at the start of the function
+        for( auto irBlock : irFunc->getBlocks() )
+        {
+            for( auto irInst : irBlock->getOrdinaryInsts() )
+            {
+                const UInt operandCount = irInst->getOperandCount();
+                for( UInt ii = 0; ii < operandCount; ++ii )
+                {
+                    auto param = as<IRGlobalParam>(irInst->getOperand(ii));
+                    if( !param || funcState.loadedInputs.ContainsKey(param) )
+                        continue;
+                    if( getGlobalParamStorageClass(param) != SpvStorageClassInput )
+                        continue;
+
+                    SpvInst* spvLoad = emitInst(spvEntryBlock, nullptr, SpvOpLoad,
+                        param->getDataType(),
+                        kResultID,
+                        ensureInst(param));
+                    funcState.loadedInputs.Add(param, spvLoad);
+                }
+            }
+        }
+
+        // Once all the basic blocks have had instructions allocated
+        // for them, we go through and fill them in with their bodies.
+        //
+        for( auto irBlock : irFunc->getBlocks() )
+        {
+            // Note: because we already created the block above,
+            // we can be sure that it will have been registred.
+            //
+            SpvInst* spvBlock = nullptr;
+            m_mapIRInstToSpvInst.TryGetValue(irBlock, spvBlock);
+            SLANG_ASSERT(spvBlock);
+
+            if( auto loopInfo = funcState.loops.TryGetValue(irBlock) )
+            {
+                emitLoopHeader(spvBlock, *loopInfo);
+                spvBlock = loopInfo->bodyLabel;
+            }
+
+            for( auto irInst : irBlock->getOrdinaryInsts() )
+            {
+                // Variables were emitted at the start of the function
+                if( irInst->getOp() == kIROp_Var )
+                    continue;
+
+                // Any instructions local to the block will be emitted as children
+                // of the block.
+                //
+                emitLocalInst(spvBlock, irInst);
+            }
+        }
+
+        for( auto header : funcState.loopHeaders )
+        {
+            auto loopInfo = funcState.loops.TryGetValue(header);
+            if( !loopInfo->continueLabel )
+                continue;
+
+            SpvInst* spvHeader = nullptr;
+            m_mapIRInstToSpvInst.TryGetValue(header, spvHeader);
+
+            Index headerPhiBlockIndex = -1;
+            if( funcState.phiBlockIndices.TryGetValue(header, headerPhiBlockIndex) )
+            {
+                PhiIncoming incoming;
+                incoming.fromLabel = loopInfo->continueLabel;
+                incoming.fromPhiBlockIndex = loopInfo->continuePhiBlockIndex;
+                funcState.phiBlocks[headerPhiBlockIndex].incoming.add(incoming);
+            }
+            emitInst(loopInfo->continueLabel, nullptr, SpvOpBranch, spvHeader);
+        }
+
+        for( auto const& phiBlock : funcState.phiBlocks )
+        {
+            _fillPhis(phiBlock);
+        }
+
+        m_funcState = prevFuncState;
+
+        // [3.32.9. Function Instructions]
+        //
+        // > OpFunctionEnd
+        //
+        // In the SPIR-V encoding a function is logically the parent of any
+        // instructions up to a matching `OpFunctionEnd`. In our intermediate
+        // structure we will make the `OpFunctionEnd` be the last child of
+        // the `OpFunction`.
+        //
+        emitInst(spvFunc, nullptr, SpvOpFunctionEnd);
+
+        // We will emit any decorations pertinent to the function to the
+        // appropriate section of the module.
+        //
+        emitDecorations(irFunc, getID(spvFunc));
+
+        return spvFunc;
+    }
+
+        /// Emit the merge instruction for a loop into its header, followed by a branch to the body
+    void emitLoopHeader(SpvInst* spvHeader, LoopInfo const& loopInfo)
+    {
+        auto irLoop = loopInfo.loop;
+
+        // [3.23. Loop Control]
+        SpvWord loopControl = SpvLoopControlMaskNone;
+        if( auto loopControlDecor = irLoop->findDecoration<IRLoopControlDecoration>() )
+        {
+            switch( loopControlDecor->getMode() )
+            {
+            case kIRLoopControl_Unroll: loopControl = SpvLoopControlUnrollMask; break;
+            case kIRLoopControl_Loop:   loopControl = SpvLoopControlDontUnrollMask; break;
+            default: break;
+            }
+        }
+
+        // > OpLoopMerge
+        SpvInst* spvContinue = loopInfo.continueLabel ? loopInfo.continueLabel : ensureInst(irLoop->getContinueBlock());
+        emitInst(spvHeader, nullptr, SpvOpLoopMerge, irLoop->getBreakBlock(), spvContinue, loopControl);
+        emitInst(spvHeader, nullptr, SpvOpBranch, loopInfo.bodyLabel);
+    }
+
+        /// Emit an unconditional branch, recording the values it passes to the phis of its target
+    SpvInst* emitBranch(SpvInstParent* parent, IRUnconditionalBranch* branch)
+    {
+        auto targetBlock = branch->getTargetBlock();
+        SpvInst* spvTarget = ensureInst(targetBlock);
+
+        Index phiBlockIndex = -1;
+        m_funcState->phiBlockIndices.TryGetValue(targetBlock, phiBlockIndex);
+
+        // A branch back to the header of a loop (as opposed to the `loop`
+        // instruction that enters it) goes via the synthesized continue
+        // target, if there is one.
+        //
+        if( branch->getOp() != kIROp_loop )
+        {
+            auto loopInfo = m_funcState->loops.TryGetValue(targetBlock);
+            if( loopInfo && loopInfo->continueLabel )
+            {
+                spvTarget = loopInfo->continueLabel;
+                phiBlockIndex = loopInfo->continuePhiBlockIndex;
+            }
+        }
+
+        if( phiBlockIndex >= 0 )
+        {
+            PhiIncoming incoming;
+            incoming.fromLabel = (SpvInst*) parent;
+            incoming.branch = branch;
+            m_funcState->phiBlocks[phiBlockIndex].incoming.add(incoming);
+        }
+
+        // > OpBranch
+        return emitInst(parent, branch, SpvOpBranch, spvTarget);
+    }
+
+    // The instructions that appear inside the basic blocks of
+    // functions are what we will call "local" instructions.
+    //
+    // When emititng blobal instructions, we usually have to
+    // pick the right logical section to emit them into, while
+    // for local instructions they will usually emit into
+    // a known parent (the basic block that contains them).
+
+        /// Emit an instruction that is local to the body of the given `parent`.
+    SpvInst* emitLocalInst(SpvInstParent* parent, IRInst* inst)
+    {
+        switch( inst->getOp() )
+        {
+        default:
+            SLANG_UNIMPLEMENTED_X("unhandled instruction opcode");
+            break;
+
+        // [3.32.8. Memory Instructions]
+
+        case kIROp_Load:
+            // > OpLoad
+            return emitInst(parent, inst, SpvOpLoad, getResultType(inst), kResultID, getAddress(parent, inst->getOperand(0)));
+
+        case kIROp_Store:
+            // > OpStore
+            return emitInst(parent, inst, SpvOpStore, getAddress(parent, inst->getOperand(0)), inst->getOperand(1));
+
+        case kIROp_FieldAddress:
+            {
+                // > OpAccessChain
+                auto fieldAddress = cast<IRFieldAddress>(inst);
+                auto base = fieldAddress->getBase();
+                auto structType = as<IRStructType>(_getValueTypeOfAddress(base));
+                SLANG_ASSERT(structType);
+                return emitInst(parent, inst, SpvOpAccessChain, getResultType(inst), kResultID,
+                    getAddress(parent, base),
+                    _getIntConstant(_getFieldIndex(structType, fieldAddress->getField())));
+            }
+
+        case kIROp_getElementPtr:
+            {
+                // > OpAccessChain
+                auto elementPtr = cast<IRGetElementPtr>(inst);
+                return emitInst(parent, inst, SpvOpAccessChain, getResultType(inst), kResultID,
+                    getAddress(parent, elementPtr->getBase()),
+                    elementPtr->getIndex());
+            }
+
+        case kIROp_SwizzledStore:
+            return emitSwizzledStore(parent, cast<IRSwizzledStore>(inst));
+
+        // [3.32.12. Composite Instructions]
+
+        case kIROp_FieldExtract:
+            {
+                // > OpCompositeExtract
+                auto fieldExtract = cast<IRFieldExtract>(inst);
+                auto base = fieldExtract->getBase();
+                auto structType = as<IRStructType>(base->getDataType());
+                SLANG_ASSERT(structType);
+                return emitInst(parent, inst, SpvOpCompositeExtract, getResultType(inst), kResultID,
+                    base,
+                    SpvWord(_getFieldIndex(structType, fieldExtract->getField())));
+            }
+
+        case kIROp_getElement:
+            {
+                auto getElement = cast<IRGetElement>(inst);
+                auto base = getElement->getBase();
+                auto index = getElement->getIndex();
+                if( auto indexLit = as<IRIntLit>(index) )
+                {
+                    // > OpCompositeExtract
+                    return emitInst(parent, inst, SpvOpCompositeExtract, getResultType(inst), kResultID, base, SpvWord(indexLit->getValue()));
+                }
+                if( as<IRVectorType>(base->getDataType()) )
+                {
+                    // > OpVectorExtractDynamic
+                    return emitInst(parent, inst, SpvOpVectorExtractDynamic, getResultType(inst), kResultID, base, index);
+                }
+                // An array value would need to be copied to a variable to index it
+                m_sink->diagnose(inst, Diagnostics::spirvDynamicIndexOfArrayValue);
+                return emitInst(parent, inst, SpvOpUndef, getResultType(inst), kResultID);
+            }
+
+        case kIROp_swizzle:
+            return emitSwizzle(parent, cast<IRSwizzle>(inst));
+
+        case kIROp_swizzleSet:
+            return emitSwizzleSet(parent, cast<IRSwizzleSet>(inst));
+
+        case kIROp_makeVector:
+        case kIROp_makeArray:
+        case kIROp_makeStruct:
+            // > OpCompositeConstruct
+            return emitInst(parent, inst, SpvOpCompositeConstruct, getResultType(inst), kResultID, OperandsOf(inst));
+
+        case kIROp_Construct:
+            return emitConstruct(parent, inst);
+
+        // [3.32.13. Arithmetic Instructions]
+        // [3.32.14. Bit Instructions]
+        // [3.32.15. Relational and Logical Instructions]
+        //
+        // Slang IR arithmetic instructions apply to all types, while
+        // SPIR-V has distinct opcodes for floating-point, signed and
+        // unsigned integer, and boolean operands.
+
+#define CASE(IROP, FLOAT_OP, SIGNED_OP, UNSIGNED_OP, BOOL_OP) \
+        case IROP: return emitArithmetic(parent, inst, SpvOp##FLOAT_OP, SpvOp##SIGNED_OP, SpvOp##UNSIGNED_OP, SpvOp##BOOL_OP)
+
+        CASE(kIROp_Add,     FAdd,                   IAdd,                   IAdd,                   Nop);
+        CASE(kIROp_Sub,     FSub,                   ISub,                   ISub,                   Nop);
+        CASE(kIROp_Mul,     FMul,                   IMul,                   IMul,                   Nop);
+        CASE(kIROp_Div,     FDiv,                   SDiv,                   UDiv,                   Nop);
+        CASE(kIROp_IRem,    Nop,                    SRem,                   UMod,                   Nop);
+        CASE(kIROp_FRem,    FRem,                   Nop,                    Nop,                    Nop);
+        CASE(kIROp_Neg,     FNegate,                SNegate,                SNegate,                Nop);
+        CASE(kIROp_Lsh,     Nop,                    ShiftLeftLogical,       ShiftLeftLogical,       Nop);
+        CASE(kIROp_Rsh,     Nop,                    ShiftRightArithmetic,   ShiftRightLogical,      Nop);
+        CASE(kIROp_BitAnd,  Nop,                    BitwiseAnd,             BitwiseAnd,             LogicalAnd);
+        CASE(kIROp_BitOr,   Nop,                    BitwiseOr,              BitwiseOr,              LogicalOr);
+        CASE(kIROp_BitXor,  Nop,                    BitwiseXor,             BitwiseXor,             LogicalNotEqual);
+        CASE(kIROp_BitNot,  Nop,                    Not,                    Not,                    LogicalNot);
+        CASE(kIROp_And,     Nop,                    Nop,                    Nop,                    LogicalAnd);
+        CASE(kIROp_Or,      Nop,                    Nop,                    Nop,                    LogicalOr);
+        CASE(kIROp_Not,     Nop,                    Nop,                    Nop,                    LogicalNot);
+        CASE(kIROp_Eql,     FOrdEqual,              IEqual,                 IEqual,                 LogicalEqual);
+        CASE(kIROp_Neq,     FUnordNotEqual,         INotEqual,              INotEqual,              LogicalNotEqual);
+        CASE(kIROp_Less,    FOrdLessThan,           SLessThan,              ULessThan,              Nop);
+        CASE(kIROp_Leq,     FOrdLessThanEqual,      SLessThanEqual,         ULessThanEqual,         Nop);
+        CASE(kIROp_Greater, FOrdGreaterThan,        SGreaterThan,           UGreaterThan,           Nop);
+        CASE(kIROp_Geq,     FOrdGreaterThanEqual,   SGreaterThanEqual,      UGreaterThanEqual,      Nop);
+
+#undef CASE
+
+        case kIROp_Dot:
+            // > OpDot
+            return emitInst(parent, inst, SpvOpDot, getResultType(inst), kResultID, OperandsOf(inst));
+
+        case kIROp_Select:
+            {
+                // > OpSelect
+                //
+                // > Before version 1.4, Result Type must be a pointer, scalar, or vector.
+                // > ... Condition must be a scalar or vector of Boolean type.
+                // > It must have the same number of components as Result Type
+                //
+                auto condition = inst->getOperand(0);
+                SpvInst* spvCondition = getValue(condition);
+                auto vectorType = as<IRVectorType>(inst->getDataType());
+                if( vectorType && !as<IRVectorType>(condition->getDataType()) )
+                {
+                    spvCondition = _emitSplat(parent, nullptr,
+                        m_builder.getVectorType(condition->getDataType(), vectorType->getElementCount()),
+                        spvCondition);
+                }
+                return emitInst(parent, inst, SpvOpSelect, getResultType(inst), kResultID,
+                    spvCondition,
+                    inst->getOperand(1),
+                    inst->getOperand(2));
+            }
+
+        case kIROp_BitCast:
+            // > OpBitcast
+            return emitInst(parent, inst, SpvOpBitcast, getResultType(inst), kResultID, inst->getOperand(0));
+
+        case kIROp_undefined:
+            // > OpUndef
+            return emitInst(parent, inst, SpvOpUndef, getResultType(inst), kResultID);
+
+        case kIROp_Call:
+            return emitCall(parent, cast<IRCall>(inst));
+
+        case kIROp_Specialize:
+            // Specializations of the generic intrinsics in the stdlib are only
+            // used as callees, and are resolved when the call is emitted.
+            return nullptr;
+
+        // [3.32.20. Barrier Instructions]
+        //
+        // > OpControlBarrier
+        //
+        case kIROp_GroupMemoryBarrierWithGroupSync:
+            return emitInst(parent, inst, SpvOpControlBarrier,
+                _getUIntConstant(SpvScopeWorkgroup),
+                _getUIntConstant(SpvScopeWorkgroup),
+                _getUIntConstant(SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsWorkgroupMemoryMask));
+
+        // [3.32.17. Control-Flow Instructions]
+
+        case kIROp_ReturnVoid:
+            // > OpReturn
+            return emitInst(parent, inst, SpvOpReturn);
+
+        case kIROp_ReturnVal:
+            // > OpReturnValue
+            return emitInst(parent, inst, SpvOpReturnValue, cast<IRReturnVal>(inst)->getVal());
+
+        case kIROp_unconditionalBranch:
+        case kIROp_loop:
+            // The merge instruction for a loop goes in the loop header,
+            // and entering the loop is a simple branch.
+            return emitBranch(parent, cast<IRUnconditionalBranch>(inst));
+
+        case kIROp_ifElse:
+            {
+                // > OpSelectionMerge
+                // > OpBranchConditional
+                auto ifElse = cast<IRIfElse>(inst);
+                emitInst(parent, nullptr, SpvOpSelectionMerge, ifElse->getAfterBlock(), SpvSelectionControlMaskNone);
+                return emitInst(parent, inst, SpvOpBranchConditional,
+                    ifElse->getCondition(),
+                    ifElse->getTrueBlock(),
+                    ifElse->getFalseBlock());
+            }
+
+        case kIROp_conditionalBranch:
+            {
+                // > OpBranchConditional
+                //
+                // A conditional branch that isn't an `if` is the test of a loop,
+                // which is structured by the merge instruction of the loop.
+                //
+                auto branch = cast<IRConditionalBranch>(inst);
+                return emitInst(parent, inst, SpvOpBranchConditional,
+                    branch->getCondition(),
+                    branch->getTrueBlock(),
+                    branch->getFalseBlock());
+            }
+
+        case kIROp_Switch:
+            {
+                // > OpSelectionMerge
+                // > OpSwitch
+                auto switchInst = cast<IRSwitch>(inst);
+                emitInst(parent, nullptr, SpvOpSelectionMerge, switchInst->getBreakLabel(), SpvSelectionControlMaskNone);
+
+                InstConstructScope scopeInst(this, SpvOpSwitch, inst);
+                SpvInst* spvSwitch = scopeInst;
+                emitOperand(switchInst->getCondition());
+                emitOperand(switchInst->getDefaultLabel());
+                const UInt caseCount = switchInst->getCaseCount();
+                for( UInt ii = 0; ii < caseCount; ++ii )
+                {
+                    // Case values are literals in SPIR-V
+                    emitOperand(SpvWord(getIntVal(switchInst->getCaseValue(ii))));
+                    emitOperand(switchInst->getCaseLabel(ii));
+                }
+                parent->addInst(spvSwitch);
+                return spvSwitch;
+            }
+
+        case kIROp_discard:
+            // > OpKill
+            return emitInst(parent, inst, SpvOpKill);
+
+        case kIROp_MissingReturn:
+        case kIROp_Unreachable:
+            // > OpUnreachable
+            return emitInst(parent, inst, SpvOpUnreachable);
+        }
+        UNREACHABLE_RETURN(nullptr);
+    }
+
+        /// Get the type that `address` points to
+    IRType* _getValueTypeOfAddress(IRInst* address)
+    {
+        auto type = address->getDataType();
+        if( auto ptrType = as<IRPtrTypeBase>(type) )
+        {
+            return ptrType->getValueType();
+        }
+        if( auto bufferType = as<IRConstantBufferType>(type) )
+        {
+            return bufferType->getElementType();
+        }
+        return nullptr;
+    }
+
+        /// Get a pointer that can be used to access the memory `address` refers to
+    SpvInst* getAddress(SpvInstParent* parent, IRInst* address)
+    {
+        // A constant buffer in the IR is used as a pointer to its contents,
+        // while in SPIR-V the contents are the only member of the block.
+        //
+        if( auto bufferType = as<IRConstantBufferType>(address->getDataType()) )
+        {
+            return emitInst(parent, nullptr, SpvOpAccessChain,
+                ensurePointerType(getStorageClassForAddress(address), bufferType->getElementType()),
+                kResultID,
+                address,
+                _getIntConstant(0));
+        }
+        return getValue(address);
+    }
+
+        /// Get the index of the field of `structType` with the given `key`
+    IRIntegerValue _getFieldIndex(IRStructType* structType, IRInst* key)
+    {
+        IRIntegerValue index = 0;
+        for( auto field : structType->getFields() )
+        {
+            if( field->getKey() == key )
+            {
+                return index;
+            }
+            index++;
+        }
+        SLANG_UNEXPECTED("field not found in struct type");
+        UNREACHABLE_RETURN(0);
+    }
+
+        /// Get an `int` constant for use as an <id> operand
+    IRInst* _getIntConstant(IRIntegerValue value)
+    {
+        return m_builder.getIntValue(m_builder.getIntType(), value);
+    }
+        /// Get a `uint` constant for use as an <id> operand
+    IRInst* _getUIntConstant(IRIntegerValue value)
+    {
+        return m_builder.getIntValue(m_builder.getUIntType(), value);
+    }
+
+        /// Get the size in bytes of a scalar type, or the elements of a vector type
+    static int _getScalarSize(IRType* type)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
+        {
+            type = vectorType->getElementType();
+        }
+        auto basicType = as<IRBasicType>(type);
+        return basicType ? BaseTypeInfo::getInfo(basicType->getBaseType()).sizeInBytes : 0;
+    }
+
+    enum class ScalarKind
+    {
+        Other,
+        Bool,
+        Signed,
+        Unsigned,
+        Float,
+    };
+
+        /// Classify a scalar type, or the element type of a vector type
+    static ScalarKind _getScalarKind(IRType* type)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
+        {
+            type = vectorType->getElementType();
+        }
+        auto basicType = as<IRBasicType>(type);
+        if( !basicType )
+        {
+            return ScalarKind::Other;
+        }
+        if( basicType->getBaseType() == BaseType::Bool )
+        {
+            return ScalarKind::Bool;
+        }
+        auto const& info = BaseTypeInfo::getInfo(basicType->getBaseType());
+        if( info.flags & BaseTypeInfo::Flag::FloatingPoint )
+        {
+            return ScalarKind::Float;
+        }
+        return (info.flags & BaseTypeInfo::Flag::Signed) ? ScalarKind::Signed : ScalarKind::Unsigned;
+    }
+
+        /// Emit an arithmetic instruction, picking the opcode from the kind of its first operand.
+        /// The opcode for a kind is `SpvOpNop` if the kind isn't supported.
+    SpvInst* emitArithmetic(SpvInstParent* parent, IRInst* inst, SpvOp floatOp, SpvOp signedOp, SpvOp unsignedOp, SpvOp boolOp)
+    {
+        SpvOp opcode = SpvOpNop;
+        switch( _getScalarKind(inst->getOperand(0)->getDataType()) )
+        {
+        case ScalarKind::Float:     opcode = floatOp; break;
+        case ScalarKind::Signed:    opcode = signedOp; break;
+        case ScalarKind::Unsigned:  opcode = unsignedOp; break;
+        case ScalarKind::Bool:      opcode = boolOp; break;
+        default:                    break;
+        }
+        if( opcode == SpvOpNop )
+        {
+            SLANG_UNIMPLEMENTED_X("arithmetic operand type in SPIR-V emit");
+        }
+        return emitInst(parent, inst, opcode, getResultType(inst), kResultID, OperandsOf(inst));
+    }
+
+        /// Emit a vector of `vectorType` with every element set to `scalar`
+    SpvInst* _emitSplat(SpvInstParent* parent, IRInst* irInst, IRVectorType* vectorType, SpvInst* scalar)
+    {
+        // > OpCompositeConstruct
+        InstConstructScope scopeInst(this, SpvOpCompositeConstruct, irInst);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(vectorType);
+        emitOperand(kResultID);
+        const auto elementCount = getIntVal(vectorType->getElementCount());
+        for( IRIntegerValue ii = 0; ii < elementCount; ++ii )
+        {
+            emitOperand(scalar);
+        }
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+        /// Get a constant of `type` (a scalar or vector type) with all elements set to `value`
+    SpvInst* _getConstant(IRType* type, IRIntegerValue value)
+    {
+        if( auto vectorType = as<IRVectorType>(type) )
+        {
+            // > OpConstantComposite
+            SpvInst* spvElement = _getConstant(vectorType->getElementType(), value);
+            SpvInst* spvConstant = _emitSplat(getSection(SpvLogicalSectionID::Types), nullptr, vectorType, spvElement);
+            spvConstant->opcode = SpvOpConstantComposite;
+            return spvConstant;
+        }
+        if( _getScalarKind(type) == ScalarKind::Float )
+        {
+            return ensureInst(m_builder.getFloatValue(type, IRFloatingPointValue(value)));
+        }
+        return ensureInst(m_builder.getIntValue(type, value));
+    }
+
+        /// Emit a `construct`, which is either a conversion or builds a composite from its operands
+    SpvInst* emitConstruct(SpvInstParent* parent, IRInst* inst)
+    {
+        auto type = inst->getDataType();
+        if( inst->getOperandCount() == 1 )
+        {
+            auto arg = inst->getOperand(0);
+            auto argType = arg->getDataType();
+            if( _getScalarKind(type) != ScalarKind::Other && _getScalarKind(argType) != ScalarKind::Other )
+            {
+                // Constructing a vector from a scalar converts the scalar, then
+                // replicates it
+                //
+                auto vectorType = as<IRVectorType>(type);
+                if( vectorType && !as<IRVectorType>(argType) )
+                {
+                    SpvInst* spvElement = emitConversion(parent, nullptr, vectorType->getElementType(), argType, getValue(arg));
+                    return _emitSplat(parent, inst, vectorType, spvElement);
+                }
+                return emitConversion(parent, inst, type, argType, getValue(arg));
+            }
+        }
+
+        // > OpCompositeConstruct
+        return emitInst(parent, inst, SpvOpCompositeConstruct, getResultType(inst), kResultID, OperandsOf(inst));
+    }
+
+        /// Emit a conversion of `value` from `fromType` to `toType`, which are scalar types,
+        /// or vector types with the same number of elements.
+        ///
+        /// If `irInst` is non-null, it is registered as corresponding to the result.
+        ///
+    SpvInst* emitConversion(SpvInstParent* parent, IRInst* irInst, IRType* toType, IRType* fromType, SpvInst* value)
+    {
+        // [3.32.11. Conversion Instructions]
+        //
+        const auto fromKind = _getScalarKind(fromType);
+        const auto toKind = _getScalarKind(toType);
+        const auto fromSize = _getScalarSize(fromType);
+        const auto toSize = _getScalarSize(toType);
+
+        if( fromKind == toKind && fromSize == toSize )
+        {
+            // Nothing to convert (the types may only differ by a rate)
+            if( irInst )
+            {
+                registerInst(irInst, value);
+            }
+            return value;
+        }
+
+        if( toKind == ScalarKind::Bool )
+        {
+            // A conversion to bool is a comparison with zero
+            //
+            // > OpFUnordNotEqual
+            // > OpINotEqual
+            //
+            return emitInst(parent, irInst, fromKind == ScalarKind::Float ? SpvOpFUnordNotEqual : SpvOpINotEqual,
+                toType, kResultID,
+                value,
+                _getConstant(fromType, 0));
+        }
+        if( fromKind == ScalarKind::Bool )
+        {
+            // > OpSelect
+            return emitInst(parent, irInst, SpvOpSelect, toType, kResultID,
+                value,
+                _getConstant(toType, 1),
+                _getConstant(toType, 0));
+        }
+
+        SpvOp opcode = SpvOpNop;
+        if( fromKind == ScalarKind::Float )
+        {
+            // > OpFConvert
+            // > OpConvertFToS
+            // > OpConvertFToU
+            opcode = toKind == ScalarKind::Float ? SpvOpFConvert :
+                toKind == ScalarKind::Signed ? SpvOpConvertFToS : SpvOpConvertFToU;
+        }
+        else if( toKind == ScalarKind::Float )
+        {
+            // > OpConvertSToF
+            // > OpConvertUToF
+            opcode = fromKind == ScalarKind::Signed ? SpvOpConvertSToF : SpvOpConvertUToF;
+        }
+        else if( fromSize == toSize )
+        {
+            // Only the signedness differs
+            //
+            // > OpBitcast
+            opcode = SpvOpBitcast;
+        }
+        else if( fromKind == ScalarKind::Signed )
+        {
+            // > OpSConvert
+            //
+            // > Convert signed width. This is either a truncate or a sign extend.
+            opcode = SpvOpSConvert;
+        }
+        else if( toKind == ScalarKind::Unsigned )
+        {
+            // > OpUConvert
+            opcode = SpvOpUConvert;
+        }
+        else
+        {
+            // > OpUConvert
+            // > ... Result Type must be a scalar or vector of integer type, whose Signedness operand is 0.
+            //
+            // so a zero extension to a signed type goes via the unsigned type of the same width.
+            //
+            IRType* unsignedType = m_builder.getBasicType(_getUnsignedBaseType(toType));
+            if( auto vectorType = as<IRVectorType>(toType) )
+            {
+                unsignedType = m_builder.getVectorType(unsignedType, vectorType->getElementCount());
+            }
+            SpvInst* spvExtended = emitInst(parent, nullptr, SpvOpUConvert, unsignedType, kResultID, value);
+            return emitInst(parent, irInst, SpvOpBitcast, toType, kResultID, spvExtended);
+        }
+        return emitInst(parent, irInst, opcode, toType, kResultID, value);
+    }
+
+        /// Get the unsigned integer base type with the same size as the (scalar or vector element) type
+    static BaseType _getUnsignedBaseType(IRType* type)
+    {
+        switch( _getScalarSize(type) )
+        {
+        case 1:     return BaseType::UInt8;
+        case 2:     return BaseType::UInt16;
+        case 8:     return BaseType::UInt64;
+        default:    return BaseType::UInt;
+        }
+    }
+
+        /// Emit a `swizzle`
+    SpvInst* emitSwizzle(SpvInstParent* parent, IRSwizzle* swizzle)
+    {
+        auto base = swizzle->getBase();
+        const UInt elementCount = swizzle->getElementCount();
+
+        if( !as<IRVectorType>(base->getDataType()) )
+        {
+            // Swizzling a scalar replicates it
+            if( elementCount == 1 )
+            {
+                SpvInst* spvBase = getValue(base);
+                registerInst(swizzle, spvBase);
+                return spvBase;
+            }
+            return _emitSplat(parent, swizzle, cast<IRVectorType>(swizzle->getDataType()), getValue(base));
+        }
+
+        if( elementCount == 1 )
+        {
+            // > OpCompositeExtract
+            return emitInst(parent, swizzle, SpvOpCompositeExtract, getResultType(swizzle), kResultID,
+                base,
+                SpvWord(getIntVal(swizzle->getElementIndex(0))));
+        }
+
+        // > OpVectorShuffle
+        InstConstructScope scopeInst(this, SpvOpVectorShuffle, swizzle);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(getResultType(swizzle));
+        emitOperand(kResultID);
+        emitOperand(base);
+        emitOperand(base);
+        for( UInt ii = 0; ii < elementCount; ++ii )
+        {
+            emitOperand(SpvWord(getIntVal(swizzle->getElementIndex(ii))));
+        }
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+        /// Emit a `swizzleSet`, which produces a copy of a vector with some of the elements replaced
+    SpvInst* emitSwizzleSet(SpvInstParent* parent, IRSwizzleSet* swizzleSet)
+    {
+        auto base = swizzleSet->getBase();
+        auto source = swizzleSet->getSource();
+        auto vectorType = as<IRVectorType>(base->getDataType());
+        SLANG_ASSERT(vectorType);
+
+        const UInt elementCount = swizzleSet->getElementCount();
+        if( !as<IRVectorType>(source->getDataType()) )
+        {
+            // > OpCompositeInsert
+            SLANG_ASSERT(elementCount == 1);
+            return emitInst(parent, swizzleSet, SpvOpCompositeInsert, getResultType(swizzleSet), kResultID,
+                source,
+                base,
+                SpvWord(getIntVal(swizzleSet->getElementIndex(0))));
+        }
+
+        // > OpVectorShuffle
+        //
+        // The components of the result are picked from the concatenation of
+        // the base and source vectors.
+        //
+        const IRIntegerValue baseCount = getIntVal(vectorType->getElementCount());
+        List<SpvWord> components;
+        for( IRIntegerValue ii = 0; ii < baseCount; ++ii )
+        {
+            components.add(SpvWord(ii));
+        }
+        for( UInt ii = 0; ii < elementCount; ++ii )
+        {
+            components[Index(getIntVal(swizzleSet->getElementIndex(ii)))] = SpvWord(baseCount + ii);
+        }
+
+        InstConstructScope scopeInst(this, SpvOpVectorShuffle, swizzleSet);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(getResultType(swizzleSet));
+        emitOperand(kResultID);
+        emitOperand(base);
+        emitOperand(source);
+        for( auto component : components )
+        {
+            emitOperand(component);
+        }
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+        /// Emit a `swizzledStore`, as a store to each of the elements written
+    SpvInst* emitSwizzledStore(SpvInstParent* parent, IRSwizzledStore* swizzledStore)
+    {
+        auto dest = swizzledStore->getDest();
+        auto source = swizzledStore->getSource();
+        auto vectorType = as<IRVectorType>(_getValueTypeOfAddress(dest));
+        SLANG_ASSERT(vectorType);
+
+        SpvInst* spvElementPtrType = ensurePointerType(getStorageClassForAddress(dest), vectorType->getElementType());
+        const bool isSourceVector = as<IRVectorType>(source->getDataType()) != nullptr;
+
+        SpvInst* spvStore = nullptr;
+        const UInt elementCount = swizzledStore->getElementCount();
+        for( UInt ii = 0; ii < elementCount; ++ii )
+        {
+            // > OpAccessChain
+            SpvInst* spvElementPtr = emitInst(parent, nullptr, SpvOpAccessChain, spvElementPtrType, kResultID,
+                getAddress(parent, dest),
+                _getIntConstant(getIntVal(swizzledStore->getElementIndex(ii))));
+
+            SpvInst* spvValue = isSourceVector ?
+                emitInst(parent, nullptr, SpvOpCompositeExtract, vectorType->getElementType(), kResultID, source, SpvWord(ii)) :
+                getValue(source);
+
+            // > OpStore
+            spvStore = emitInst(parent, nullptr, SpvOpStore, spvElementPtr, spvValue);
+        }
+        return spvStore;
+    }
+
+        /// Emit a call
+    SpvInst* emitCall(SpvInstParent* parent, IRCall* call)
+    {
+        // A function that has an intrinsic definition for GLSL is called as an intrinsic,
+        // even if it has a body (which is used for other targets).
+        //
+        auto callee = getResolvedInstForDecorations(call->getCallee());
+        auto func = as<IRFunc>(callee);
+        if( func && !as<IRTargetIntrinsicDecoration>(findBestTargetDecoration(callee, CapabilityAtom::GLSL)) )
+        {
+            if( func->getFirstBlock() )
+            {
+                // [3.32.9. Function Instructions]
+                //
+                // > OpFunctionCall
+                //
+                InstConstructScope scopeInst(this, SpvOpFunctionCall, call);
+                SpvInst* spvInst = scopeInst;
+                emitOperand(getResultType(call));
+                emitOperand(kResultID);
+                emitOperand(func);
+                const UInt argCount = call->getArgCount();
+                for( UInt ii = 0; ii < argCount; ++ii )
+                {
+                    emitOperand(call->getArg(ii));
+                }
+                parent->addInst(spvInst);
+                return spvInst;
+            }
+        }
+        return emitIntrinsicCall(parent, call, callee);
+    }
+
+    // Calls to functions without a body are calls to intrinsics of the
+    // target. The stdlib defines these with the GLSL code to emit, which
+    // we map to the equivalent SPIR-V instructions where we can.
+    //
+    // For now we handle the definitions that are a plain GLSL function name
+    // (or a call to one, passing all the arguments in order), and accesses
+    // to the elements of structured buffers.
+
+        /// How a GLSL function maps to the GLSL.std.450 extended instructions, by the type of its first argument
+    struct GLSLStd450Info
+    {
+        char const*     name;
+        Index           argCount;       ///< Number of arguments, or -1 for any
+        GLSLstd450      floatOp;
+        GLSLstd450      signedOp;
+        GLSLstd450      unsignedOp;
+    };
+
+    static GLSLStd450Info const* _findGLSLStd450Info(UnownedStringSlice const& name, Index argCount)
+    {
+        static const GLSLStd450Info kInfos[] =
+        {
+            { "abs",            1,  GLSLstd450FAbs,         GLSLstd450SAbs,     GLSLstd450Bad },
+            { "sign",           1,  GLSLstd450FSign,        GLSLstd450SSign,    GLSLstd450Bad },
+            { "min",            2,  GLSLstd450FMin,         GLSLstd450SMin,     GLSLstd450UMin },
+            { "max",            2,  GLSLstd450FMax,         GLSLstd450SMax,     GLSLstd450UMax },
+            { "clamp",          3,  GLSLstd450FClamp,       GLSLstd450SClamp,   GLSLstd450UClamp },
+            { "mix",            3,  GLSLstd450FMix,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "step",           2,  GLSLstd450Step,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "smoothstep",     3,  GLSLstd450SmoothStep,   GLSLstd450Bad,      GLSLstd450Bad },
+            { "fma",            3,  GLSLstd450Fma,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "round",          1,  GLSLstd450Round,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "roundEven",      1,  GLSLstd450RoundEven,    GLSLstd450Bad,      GLSLstd450Bad },
+            { "trunc",          1,  GLSLstd450Trunc,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "floor",          1,  GLSLstd450Floor,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "ceil",           1,  GLSLstd450Ceil,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "fract",          1,  GLSLstd450Fract,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "radians",        1,  GLSLstd450Radians,      GLSLstd450Bad,      GLSLstd450Bad },
+            { "degrees",        1,  GLSLstd450Degrees,      GLSLstd450Bad,      GLSLstd450Bad },
+            { "sin",            1,  GLSLstd450Sin,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "cos",            1,  GLSLstd450Cos,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "tan",            1,  GLSLstd450Tan,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "asin",           1,  GLSLstd450Asin,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "acos",           1,  GLSLstd450Acos,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "atan",           1,  GLSLstd450Atan,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "atan",           2,  GLSLstd450Atan2,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "sinh",           1,  GLSLstd450Sinh,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "cosh",           1,  GLSLstd450Cosh,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "tanh",           1,  GLSLstd450Tanh,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "pow",            2,  GLSLstd450Pow,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "exp",            1,  GLSLstd450Exp,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "log",            1,  GLSLstd450Log,          GLSLstd450Bad,      GLSLstd450Bad },
+            { "exp2",           1,  GLSLstd450Exp2,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "log2",           1,  GLSLstd450Log2,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "sqrt",           1,  GLSLstd450Sqrt,         GLSLstd450Bad,      GLSLstd450Bad },
+            { "inversesqrt",    1,  GLSLstd450InverseSqrt,  GLSLstd450Bad,      GLSLstd450Bad },
+            { "length",         1,  GLSLstd450Length,       GLSLstd450Bad,      GLSLstd450Bad },
+            { "distance",       2,  GLSLstd450Distance,     GLSLstd450Bad,      GLSLstd450Bad },
+            { "cross",          2,  GLSLstd450Cross,        GLSLstd450Bad,      GLSLstd450Bad },
+            { "normalize",      1,  GLSLstd450Normalize,    GLSLstd450Bad,      GLSLstd450Bad },
+            { "faceforward",    3,  GLSLstd450FaceForward,  GLSLstd450Bad,      GLSLstd450Bad },
+            { "reflect",        2,  GLSLstd450Reflect,      GLSLstd450Bad,      GLSLstd450Bad },
+            { "refract",        3,  GLSLstd450Refract,      GLSLstd450Bad,      GLSLstd450Bad },
+            { "findLSB",        1,  GLSLstd450Bad,          GLSLstd450FindILsb, GLSLstd450FindILsb },
+            { "findMSB",        1,  GLSLstd450Bad,          GLSLstd450FindSMsb, GLSLstd450FindUMsb },
+        };
+
+        for( auto const& info : kInfos )
+        {
+            if( name == info.name && (info.argCount < 0 || info.argCount == argCount) )
+            {
+                return &info;
+            }
+        }
+        return nullptr;
+    }
+
+        /// If `definition` is the name of a function, or a call to a function that
+        /// passes all `argCount` arguments in order (`f($0, $1)`), returns the name.
+        ///
+        /// Otherwise returns an empty slice.
+    static UnownedStringSlice _getGLSLFunctionName(UnownedStringSlice const& definition, UInt argCount)
+    {
+        char const* cursor = definition.begin();
+        char const* end = definition.end();
+
+        char const* nameEnd = cursor;
+        while( nameEnd < end && (CharUtil::isAlpha(*nameEnd) || CharUtil::isDigit(*nameEnd) || *nameEnd == '_') )
+        {
+            nameEnd++;
+        }
+        if( nameEnd == cursor || CharUtil::isDigit(*cursor) )
+        {
+            return UnownedStringSlice();
+        }
+        UnownedStringSlice name(cursor, nameEnd);
+        if( nameEnd == end )
+        {
+            return name;
+        }
+
+        // Check the arguments are `($0, $1, ...)`, ignoring whitespace
+        StringBuilder expected;
+        expected << "(";
+        for( UInt ii = 0; ii < argCount; ++ii )
+        {
+            if( ii )
+            {
+                expected << ",";
+            }
+            expected << "$" << ii;
+        }
+        expected << ")";
+
+        StringBuilder args;
+        for( cursor = nameEnd; cursor < end; ++cursor )
+        {
+            if( !CharUtil::isWhitespace(*cursor) )
+            {
+                args.appendChar(*cursor);
+            }
+        }
+        return args == expected ? name : UnownedStringSlice();
+    }
+
+        /// The GLSL.std.450 extended instruction set, imported on first use
+    SpvInst* m_glslStd450 = nullptr;
+
+    SpvInst* getGLSLStd450()
+    {
+        if( !m_glslStd450 )
+        {
+            // > OpExtInstImport
+            m_glslStd450 = emitInst(getSection(SpvLogicalSectionID::ExtIntInstImports), nullptr, SpvOpExtInstImport,
+                kResultID,
+                UnownedStringSlice::fromLiteral("GLSL.std.450"));
+        }
+        return m_glslStd450;
+    }
+
+        /// Emit a call to a function without a body, using its definition for GLSL
+    SpvInst* emitIntrinsicCall(SpvInstParent* parent, IRCall* call, IRInst* callee)
+    {
+        UnownedStringSlice definition;
+        if( auto targetIntrinsic = as<IRTargetIntrinsicDecoration>(findBestTargetDecoration(callee, CapabilityAtom::GLSL)) )
+        {
+            definition = targetIntrinsic->getDefinition();
+        }
+        else if( auto nameHint = callee->findDecoration<IRNameHintDecoration>() )
+        {
+            definition = nameHint->getName();
+        }
+
+        const UInt argCount = call->getArgCount();
+
+        // The element of a structured buffer is an element of the
+        // `_data` array that is the only member of its block.
+        //
+        if( definition == "$0._data[$1]" && argCount == 2 )
+        {
+            auto buffer = call->getArg(0);
+            auto bufferType = as<IRHLSLStructuredBufferTypeBase>(buffer->getDataType());
+            SLANG_ASSERT(bufferType);
+
+            // > OpAccessChain
+            SpvInst* spvElementPtr = emitInst(parent, nullptr, SpvOpAccessChain,
+                ensurePointerType(getStorageClassForAddress(buffer), bufferType->getElementType()),
+                kResultID,
+                buffer,
+                _getIntConstant(0),
+                call->getArg(1));
+
+            // A read-only buffer returns the element by value
+            if( !as<IRPtrTypeBase>(call->getDataType()) )
+            {
+                return emitInst(parent, call, SpvOpLoad, getResultType(call), kResultID, spvElementPtr);
+            }
+            registerInst(call, spvElementPtr);
+            return spvElementPtr;
+        }
+
+        auto name = _getGLSLFunctionName(definition, argCount);
+        if( name.getLength() == 0 || argCount == 0 )
+        {
+            SLANG_UNIMPLEMENTED_X("intrinsic function in SPIR-V emit");
+        }
+
+        auto firstArgType = call->getArg(0)->getDataType();
+        const auto kind = _getScalarKind(firstArgType);
+
+        // Some functions map to core instructions rather than extended ones
+
+        // [3.32.13. Arithmetic Instructions]
+        if( name == "dot" && kind == ScalarKind::Float )
+        {
+            // > OpDot
+            //
+            // OpDot only applies to vectors, while the GLSL function also takes scalars
+            return emitInst(parent, call, as<IRVectorType>(firstArgType) ? SpvOpDot : SpvOpFMul,
+                getResultType(call), kResultID, call->getArg(0), call->getArg(1));
+        }
+
+        // [3.32.11. Conversion Instructions]
+        if( name == "floatBitsToInt" || name == "floatBitsToUint" || name == "intBitsToFloat" || name == "uintBitsToFloat" )
+        {
+            // > OpBitcast
+            return emitInst(parent, call, SpvOpBitcast, getResultType(call), kResultID, call->getArg(0));
+        }
+
+        // [3.32.14. Bit Instructions]
+        if( name == "bitCount" )
+        {
+            // > OpBitCount
+            return emitInst(parent, call, SpvOpBitCount, getResultType(call), kResultID, call->getArg(0));
+        }
+        if( name == "bitfieldReverse" )
+        {
+            // > OpBitReverse
+            return emitInst(parent, call, SpvOpBitReverse, getResultType(call), kResultID, call->getArg(0));
+        }
+
+        // [3.32.15. Relational and Logical Instructions]
+        if( name == "isnan" || name == "isinf" )
+        {
+            // > OpIsNan
+            // > OpIsInf
+            return emitInst(parent, call, name == "isnan" ? SpvOpIsNan : SpvOpIsInf, getResultType(call), kResultID, call->getArg(0));
+        }
+
+        GLSLstd450 extOp = GLSLstd450Bad;
+        if( auto info = _findGLSLStd450Info(name, Index(argCount)) )
+        {
+            switch( kind )
+            {
+            case ScalarKind::Float:     extOp = info->floatOp; break;
+            case ScalarKind::Signed:    extOp = info->signedOp; break;
+            case ScalarKind::Unsigned:  extOp = info->unsignedOp; break;
+            default:                    break;
+            }
+        }
+        if( extOp == GLSLstd450Bad )
+        {
+            SLANG_UNIMPLEMENTED_X("intrinsic function in SPIR-V emit");
+        }
+
+        // [3.32.10. Extension Instructions]
+        //
+        // > OpExtInst
+        //
+        InstConstructScope scopeInst(this, SpvOpExtInst, call);
+        SpvInst* spvInst = scopeInst;
+        emitOperand(getResultType(call));
+        emitOperand(kResultID);
+        emitOperand(getGLSLStd450());
+        emitOperand(SpvWord(extOp));
+        for( UInt ii = 0; ii < argCount; ++ii )
+        {
+            emitOperand(call->getArg(ii));
+        }
+        parent->addInst(spvInst);
+        return spvInst;
+    }
+
+    // Both "local" and "global" instructions can have decorations.
+    // When we decide to emit an instruction, we typically also want
+    // to emit any decoratons that were attached to it that have
+    // a SPIR-V equivalent.
+
+        /// Emit appropriate SPIR-V decorations for the given IR `irInst`.
+        ///
+        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
+        /// and should correspond to `irInst`.
+        ///
+    void emitDecorations(IRInst* irInst, SpvWord dstID)
+    {
+        for( auto decoration : irInst->getDecorations() )
+        {
+            emitDecoration(dstID, decoration);
+        }
+    }
+
+        /// Emit an appropriate SPIR-V decoration for the given IR `decoration`, if necessary and possible.
+        ///
+        /// The given `dstID` should be the `<id>` of the SPIR-V instruction being decorated,
+        /// and should correspond to the parent of `decoration` in the Slang IR.
+        ///
+    void emitDecoration(SpvWord dstID, IRDecoration* decoration)
+    {
         // Unlike in the Slang IR, decorations in SPIR-V are not children
         // of the instruction they decorate, and instead are free-standing
         // instructions at global scope, which reference their target
@@ -1113,21 +3128,48 @@ struct SPIRVEmitContext
             {
                 auto section = getSection(SpvLogicalSectionID::EntryPoints);
 
-                // TODO: The `OpEntryPoint` is required to list an varying
-                // input or output parameters (by `<id>`) used by the entry point,
-                // although these are encoded as global variables in the IR.
+                // The interface lists the global variables used by the entry
+                // point. Those are emitted as they are referenced, and the
+                // decorations of a function are emitted after its body (and
+                // so after the bodies of any functions it calls), which means
+                // they have all been emitted by now.
                 //
-                // Currently we have a pass that moves entry-point varying
-                // parameters to global scope for the benefit of GLSL output,
-                // but we do not maintain a connection between those parameters
-                // and the original entry point. That pass should be updated
-                // to attach a decoration linking the original entry point
-                // to the new globals, which would be used in the SPIR-V emit case.
+                // We don't track which entry point uses each variable, so
+                // when there are several entry points the interface of an entry
+                // point may also list variables used by those emitted before it.
 
                 auto entryPointDecor = cast<IREntryPointDecoration>(decoration);
-                auto spvStage = mapStageToExecutionModel(entryPointDecor->getProfile().getStage());
+                auto stage = entryPointDecor->getProfile().getStage();
+                auto spvStage = mapStageToExecutionModel(stage);
                 auto name = entryPointDecor->getName()->getStringSlice();
-                emitInst(section, decoration, SpvOpEntryPoint, spvStage, dstID, name);
+                {
+                    InstConstructScope scopeInst(this, SpvOpEntryPoint, decoration);
+                    SpvInst* spvInst = scopeInst;
+                    emitOperand(spvStage);
+                    emitOperand(dstID);
+                    emitOperand(name);
+                    for( auto spvVar : m_interfaceVars )
+                    {
+                        emitOperand(spvVar);
+                    }
+                    section->addInst(spvInst);
+                }
+
+                // [3.6. Execution Mode]
+                //
+                // The Vulkan spec requires fragment shaders to use the
+                // `OriginUpperLeft` execution mode, and a fragment shader
+                // that writes `FragDepth` must declare it does so.
+                //
+                if( stage == Stage::Fragment )
+                {
+                    auto executionModes = getSection(SpvLogicalSectionID::ExecutionModes);
+                    emitInst(executionModes, nullptr, SpvOpExecutionMode, dstID, SpvExecutionModeOriginUpperLeft);
+                    if( m_usesFragDepth )
+                    {
+                        emitInst(executionModes, nullptr, SpvOpExecutionMode, dstID, SpvExecutionModeDepthReplacing);
+                    }
+                }
             }
             break;
 
@@ -1155,6 +3197,31 @@ struct SPIRVEmitContext
             }
             break;
 
+        // [3.20. Decoration]: Flat, NoPerspective, Centroid, Sample
+        case kIROp_InterpolationModeDecoration:
+            {
+                auto section = getSection(SpvLogicalSectionID::Annotations);
+                switch( cast<IRInterpolationModeDecoration>(decoration)->getMode() )
+                {
+                default:
+                    break;
+                case IRInterpolationMode::NoInterpolation:
+                    emitInst(section, nullptr, SpvOpDecorate, dstID, SpvDecorationFlat);
+                    break;
+                case IRInterpolationMode::NoPerspective:
+                    emitInst(section, nullptr, SpvOpDecorate, dstID, SpvDecorationNoPerspective);
+                    break;
+                case IRInterpolationMode::Centroid:
+                    emitInst(section, nullptr, SpvOpDecorate, dstID, SpvDecorationCentroid);
+                    break;
+                case IRInterpolationMode::Sample:
+                    requireCapability(SpvCapabilitySampleRateShading);
+                    emitInst(section, nullptr, SpvOpDecorate, dstID, SpvDecorationSample);
+                    break;
+                }
+            }
+            break;
+
         // ...
         }
     }
@@ -1184,10 +3251,28 @@ struct SPIRVEmitContext
         }
     }
 
-    SPIRVEmitContext(IRModule* module) :
+    // We need to create IR constants for some of the operands we
+    // emit (e.g., the indices of an `OpAccessChain`), and the IR
+    // types of a module aren't guaranteed to be unique, while we
+    // need them to be (SPIR-V doesn't allow duplicate non-aggregate
+    // type declarations), so the context holds an IR builder for the
+    // module, and deduplicates the module up front.
+
+    SharedIRBuilder m_sharedBuilder;
+    IRBuilder m_builder;
+
+        /// Where to report code that can't be emitted as SPIR-V
+    DiagnosticSink* m_sink;
+
+    SPIRVEmitContext(IRModule* module, DiagnosticSink* sink) :
         m_irModule(module),
-        m_memoryArena(2048)
+        m_memoryArena(2048),
+        m_sharedBuilder(module),
+        m_builder(&m_sharedBuilder),
+        m_sink(sink)
     {
+        m_sharedBuilder.deduplicateAndRebuildGlobalNumberingMap();
+        m_builder.setInsertInto(module->getModuleInst());
     }
 };
 
@@ -1197,17 +3282,22 @@ SlangResult emitSPIRVFromIR(
     const List<IRFunc*>&    irEntryPoints,
     List<uint8_t>&          spirvOut)
 {
-    SLANG_UNUSED(compileRequest);
-    
+    auto sink = compileRequest->getSink();
+    const Index errorCount = sink->getErrorCount();
+
     spirvOut.clear();
 
-    SPIRVEmitContext context(irModule);
+    SPIRVEmitContext context(irModule, sink);
 
     context.emitFrontMatter();
     for (auto irEntryPoint : irEntryPoints)
     {
         context.ensureInst(irEntryPoint);
     }
+    if( sink->getErrorCount() != errorCount )
+    {
+        return SLANG_FAIL;
+    }
     context.emitPhysicalLayout();
 
     spirvOut.addRange(
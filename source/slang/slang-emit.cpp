@@ -3,29 +3,38 @@
 
 #include "../core/slang-writer.h"
 #include "../core/slang-type-text-util.h"
+#include "../core/slang-string-util.h"
 
 #include "../compiler-core/slang-name.h"
 
 #include "slang-ir-bind-existentials.h"
+#include "slang-ir-bounds-check.h"
 #include "slang-ir-byte-address-legalize.h"
 #include "slang-ir-collect-global-uniforms.h"
+#include "slang-ir-compact.h"
+#include "slang-ir-cse.h"
 #include "slang-ir-dce.h"
+#include "slang-ir-dse.h"
 #include "slang-ir-entry-point-uniforms.h"
 #include "slang-ir-entry-point-raw-ptr-params.h"
 #include "slang-ir-explicit-global-context.h"
 #include "slang-ir-explicit-global-init.h"
 #include "slang-ir-glsl-legalize.h"
+#include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-legalize-varying-params.h"
 #include "slang-ir-link.h"
 #include "slang-ir-lower-generics.h"
 #include "slang-ir-lower-tuple-types.h"
 #include "slang-ir-lower-bit-cast.h"
+#include "slang-ir-loop-opt.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
+#include "slang-ir-sccp.h"
 #include "slang-ir-specialize.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-resources.h"
+#include "slang-ir-sroa.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-strip-witness-tables.h"
 #include "slang-ir-synthesize-active-mask.h"
@@ -149,6 +158,101 @@ static void dumpIRIfEnabled(
     }
 }
 
+template <typename T>
+static void _remapAfterCompaction(IRCompactionRemap const& remap, T*& ioInst)
+{
+    IRInst* newInst = nullptr;
+    if (ioInst && remap.TryGetValue(ioInst, newInst))
+    {
+        ioInst = static_cast<T*>(newInst);
+    }
+}
+
+    /// Compact the linked IR module if enough of its memory is held by dead instructions
+    /// (or always, if the request asks for it with `-compact-ir`).
+    ///
+    /// Compaction moves every instruction, so `ioLinkedIR` and `ioEntryPoints` are
+    /// updated to point at the moved instructions.
+static void _compactLinkedIRIfWorthwhile(
+    BackEndCompileRequest*  compileRequest,
+    LinkedIR&               ioLinkedIR,
+    List<IRFunc*>&          ioEntryPoints)
+{
+    // The memory held just before compacting is as much as the module will ever hold
+    compileRequest->getLinkage()->noteBackEndIRMemoryUsed(ioLinkedIR.module->memoryArena.calcTotalMemoryUsed());
+
+    IRCompactionRemap remap;
+    if (compileRequest->getLinkage()->m_shouldAlwaysCompactIR)
+    {
+        compactIRModule(ioLinkedIR.module, remap);
+    }
+    else if (!compactIRModuleIfWorthwhile(ioLinkedIR.module, IRCompactionOptions(), remap))
+    {
+        return;
+    }
+
+    _remapAfterCompaction(remap, ioLinkedIR.globalScopeVarLayout);
+    for (auto& entryPoint : ioLinkedIR.entryPoints)
+    {
+        _remapAfterCompaction(remap, entryPoint);
+    }
+    for (auto& entryPoint : ioEntryPoints)
+    {
+        _remapAfterCompaction(remap, entryPoint);
+    }
+}
+
+    /// Get the limits for cost model driven inlining for `target` at the optimization `level`.
+    ///
+    /// Downstream compilers for GPU targets inline aggressively themselves, so inlining is
+    /// currently only enabled for the CPU and CUDA targets, where the generated source is
+    /// compiled as ordinary C++ and smaller kernels tend to optimize better.
+    ///
+    /// Inlining changes the structure of the output, so it is only enabled by default from
+    /// `-O2`. At lower levels `shouldInlineFunctions` (`-inline-functions`) enables it with
+    /// the default limits.
+static InliningOptions _getInliningOptions(CodeGenTarget target, OptimizationLevel level, bool shouldInlineFunctions)
+{
+    InliningOptions options;
+    switch (target)
+    {
+        case CodeGenTarget::CPPSource:
+        case CodeGenTarget::Executable:
+        case CodeGenTarget::SharedLibrary:
+        case CodeGenTarget::HostCallable:
+        case CodeGenTarget::CUDASource:
+        case CodeGenTarget::PTX:
+            break;
+        default:
+            return options;
+    }
+
+    switch (level)
+    {
+        case OptimizationLevel::None:
+        case OptimizationLevel::Default:
+            if (!shouldInlineFunctions)
+            {
+                break;
+            }
+            options.maxCalleeInstCount = 16;
+            options.maxSingleCallSiteCalleeInstCount = 64;
+            options.maxCallerInstCount = 1024;
+            break;
+        case OptimizationLevel::High:
+            options.maxCalleeInstCount = 32;
+            options.maxSingleCallSiteCalleeInstCount = 256;
+            options.maxCallerInstCount = 4096;
+            break;
+        case OptimizationLevel::Maximal:
+            options.maxCalleeInstCount = 64;
+            options.maxSingleCallSiteCalleeInstCount = 1024;
+            options.maxCallerInstCount = 16384;
+            break;
+    }
+    return options;
+}
+
 struct LinkingAndOptimizationOptions
 {
     bool shouldLegalizeExistentialAndResourceTypes = true;
@@ -350,6 +454,12 @@ Result linkAndOptimizeIR(
     // apply at this point?
     //
     eliminateDeadCode(irModule);
+
+    // Instructions removed by DCE are never freed from the module's
+    // arena, so after the passes that leave the most dead code behind
+    // we reclaim that memory if enough of it has built up.
+    //
+    _compactLinkedIRIfWorthwhile(compileRequest, outLinkedIR, irEntryPoints);
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
 #endif
@@ -409,6 +519,7 @@ Result linkAndOptimizeIR(
             irModule,
             sink);
         eliminateDeadCode(irModule);
+        _compactLinkedIRIfWorthwhile(compileRequest, outLinkedIR, irEntryPoints);
 
         //  Debugging output of legalization
     #if 0
@@ -417,13 +528,71 @@ Result linkAndOptimizeIR(
         validateIRModuleIfEnabled(compileRequest, irModule);
     }
 
+    // With types legalized, we can inline calls to small functions (and functions
+    // with a single call site), as decided by a cost model that depends on the
+    // target and optimization level.
+    //
+    const Index inlinedCallCount = performCostModelInlining(irModule,
+        _getInliningOptions(target, compileRequest->getLinkage()->optimizationLevel, compileRequest->getLinkage()->m_shouldInlineFunctions));
+#if 0
+    dumpIRIfEnabled(compileRequest, irModule, "AFTER INLINING");
+#endif
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
     // to see if we can clean up any temporaries created by legalization.
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
+    //
+    // Local variables of aggregate type that are only accessed a field
+    // or element at a time are split up first, so that the individual
+    // fields can be promoted as well.
+    //
+    performScalarReplacementOfAggregates(irModule);
     constructSSA(irModule);
 
+    // Inlining exposes arguments that are constants to the inlined
+    // bodies, and leaves the callees dead when it inlines their only
+    // call site, so we fold constants and clean up afterwards.
+    //
+    if (inlinedCallCount)
+    {
+        applySparseConditionalConstantPropagation(irModule);
+        eliminateDeadCode(irModule);
+    }
+
+    // Loops marked `[unroll]` with a constant trip count are unrolled, after
+    // which constant propagation folds the induction variable into each
+    // iteration. An inner loop whose bounds depended on an outer loop's
+    // counter may only have a constant trip count after that folding, so
+    // we repeat until nothing more is unrolled. Array indices that become
+    // constant allow the arrays to be split and promoted like any other
+    // local variable.
+    //
+    if (unrollLoops(irModule))
+    {
+        do
+        {
+            applySparseConditionalConstantPropagation(irModule);
+        }
+        while (unrollLoops(irModule));
+
+        performScalarReplacementOfAggregates(irModule);
+        constructSSA(irModule);
+    }
+
+    // Computations in loops that don't depend on the loop are moved out
+    // of them, so they are done once rather than on every iteration.
+    //
+    hoistLoopInvariantInsts(irModule);
+
+    // Legalization and specialization leave behind redundant computations
+    // (such as repeated address calculations and loads), which we can remove
+    // now that the code is in SSA form.
+    //
+    eliminateCommonSubexpressions(irModule);
+
 #if 0
     dumpIRIfEnabled(compileRequest, irModule, "AFTER SSA");
 #endif
@@ -467,6 +636,31 @@ Result linkAndOptimizeIR(
 
     validateIRModuleIfEnabled(compileRequest, irModule);
 
+    // Local variables that couldn't be promoted to SSA form (for example
+    // because their address is passed to a call for an `out` parameter)
+    // can still have stores that are never read, and loads of values
+    // that were just stored, which we clean up now that specialization
+    // has settled which calls remain.
+    //
+    eliminateDeadStoresAndRedundantLoads(irModule);
+
+    // If buffer and array accesses are bounds checked, we mark the
+    // accesses that are proven to be in bounds, so that the check
+    // can be skipped for them.
+    //
+    if (compileRequest->getLinkage()->boundsCheckMode != BoundsCheckMode::Default)
+    {
+        switch (target)
+        {
+        case CodeGenTarget::CPPSource:
+            markInBoundsAccesses(irModule);
+            break;
+
+        default:
+            break;
+        }
+    }
+
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
     // that they instead use an intermediate `struct`.
@@ -508,6 +702,7 @@ Result linkAndOptimizeIR(
             break;
 
         case CodeGenTarget::GLSL:
+        case CodeGenTarget::SPIRV:
             // For GLSL targets, we want to translate the vector load/store
             // operations into scalar ops. This is in part as a simplification,
             // but it also ensures that our generated code respects the lax
@@ -606,6 +801,10 @@ Result linkAndOptimizeIR(
     // For GLSL only, we will need to perform "legalization" of
     // the entry point and any entry-point parameters.
     //
+    // When emitting SPIR-V directly we use the same legalization,
+    // so that varying parameters become global parameters that
+    // can be emitted as `Input`/`Output` variables.
+    //
     // TODO: We should consider moving this legalization work
     // as late as possible, so that it doesn't affect how other
     // optimization passes need to work.
@@ -613,8 +812,14 @@ Result linkAndOptimizeIR(
     switch (target)
     {
     case CodeGenTarget::GLSL:
+    case CodeGenTarget::SPIRV:
     {
-        auto glslExtensionTracker = as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker());
+        // There is no source emitter when emitting SPIR-V directly, so
+        // any requirements found are tracked here (and not used).
+        GLSLExtensionTracker spirvExtensionTracker;
+        auto glslExtensionTracker = options.sourceEmitter ?
+            as<GLSLExtensionTracker>(options.sourceEmitter->getExtensionTracker()) :
+            &spirvExtensionTracker;
 
         legalizeEntryPointsForGLSL(
             session,
@@ -698,6 +903,7 @@ Result linkAndOptimizeIR(
     // bit_cast on basic types.
     lowerBitCast(targetRequest, irModule);
     eliminateDeadCode(irModule);
+    _compactLinkedIRIfWorthwhile(compileRequest, outLinkedIR, irEntryPoints);
 
 
     // We include one final step to (optionally) dump the IR and validate
@@ -709,6 +915,10 @@ Result linkAndOptimizeIR(
 #endif
     validateIRModuleIfEnabled(compileRequest, irModule);
 
+    // Compaction may have been skipped, and passes after it can still allocate,
+    // so the module as it is handed to emit is sampled too.
+    compileRequest->getLinkage()->noteBackEndIRMemoryUsed(irModule->memoryArena.calcTotalMemoryUsed());
+
     return SLANG_OK;
 }
 
@@ -722,9 +932,9 @@ SlangResult emitEntryPointsSourceFromIR(
     CodeGenTarget           target,
     TargetRequest*          targetRequest,
     ExtensionTracker*       extensionTracker, 
-    String&                 outSource)
+    StringRope&             outSource)
 {
-    outSource = String();
+    outSource.clear();
 
     auto sink = compileRequest->getSink();
     auto program = compileRequest->getProgram();
@@ -762,6 +972,8 @@ SlangResult emitEntryPointsSourceFromIR(
     desc.targetCaps = targetRequest->getTargetCaps();
     desc.sourceWriter = &sourceWriter;
     desc.extensionTracker = extensionTracker;
+    desc.boundsCheckMode = compileRequest->getLinkage()->boundsCheckMode;
+    desc.emitThreadCount = compileRequest->getLinkage()->m_emitThreadCount;
 
     // Define here, because must be in scope longer than the sourceEmitter, as sourceEmitter might reference
     // items in the linkedIR module
@@ -842,8 +1054,8 @@ SlangResult emitEntryPointsSourceFromIR(
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    StringRope code;
+    sourceWriter.takeContent(code);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -879,15 +1091,10 @@ SlangResult emitEntryPointsSourceFromIR(
 
     sourceEmitter->emitLayoutDirectives(targetRequest);
 
-    String prefix = sourceWriter.getContent();
-    
-    StringBuilder finalResultBuilder;
-    finalResultBuilder << prefix;
-
-    finalResultBuilder << code;
-
-    // Write out the result
-    outSource = finalResultBuilder.ProduceString();
+    // The result is the prefix followed by the code. Neither is copied, the
+    // chunks holding the code are just added after those of the prefix.
+    sourceWriter.takeContent(outSource);
+    outSource.appendRope(code);
     return SLANG_OK;
 }
 
@@ -897,6 +1104,42 @@ SlangResult emitSPIRVFromIR(
     const List<IRFunc*>&    irEntryPoints,
     List<uint8_t>&          spirvOut);
 
+static SlangResult _validateSPIRV(
+    BackEndCompileRequest*  compileRequest,
+    const List<uint8_t>&    spirv)
+{
+    auto sink = compileRequest->getSink();
+
+    // Validation is done with the SPIR-V tools that are part of slang-glslang
+    DownstreamCompiler* compiler = compileRequest->getSession()->getOrLoadDownstreamCompiler(PassThroughMode::Glslang, sink);
+    if (!compiler)
+    {
+        auto compilerName = TypeTextUtil::getPassThroughAsHumanText(SLANG_PASS_THROUGH_GLSLANG);
+        sink->diagnose(SourceLoc(), Diagnostics::passThroughCompilerNotFound, compilerName);
+        return SLANG_FAIL;
+    }
+
+    ComPtr<ISlangBlob> diagnosticsBlob;
+    const SlangResult res = compiler->validate(SLANG_SPIRV, spirv.getBuffer(), size_t(spirv.getCount()), diagnosticsBlob.writeRef());
+    if (res == SLANG_E_NOT_AVAILABLE)
+    {
+        auto compilerName = TypeTextUtil::getPassThroughAsHumanText(SLANG_PASS_THROUGH_GLSLANG);
+        sink->diagnose(SourceLoc(), Diagnostics::passThroughCompilerNotFound, compilerName);
+        return SLANG_FAIL;
+    }
+    if (SLANG_FAILED(res))
+    {
+        String messages;
+        if (diagnosticsBlob)
+        {
+            messages = StringUtil::getString(diagnosticsBlob);
+        }
+        sink->diagnose(SourceLoc(), Diagnostics::spirvValidationFailed, messages);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
 SlangResult emitSPIRVForEntryPointsDirectly(
     BackEndCompileRequest*  compileRequest,
     const List<Int>&        entryPointIndices,
@@ -924,11 +1167,16 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     auto irModule = linkedIR.module;
     auto irEntryPoints = linkedIR.entryPoints;
 
-    emitSPIRVFromIR(
+    SLANG_RETURN_ON_FAIL(emitSPIRVFromIR(
         compileRequest,
         irModule,
         irEntryPoints,
-        spirvOut);
+        spirvOut));
+
+    if (compileRequest->shouldValidateSPIRV)
+    {
+        SLANG_RETURN_ON_FAIL(_validateSPIRV(compileRequest, spirvOut));
+    }
 
     return SLANG_OK;
 }
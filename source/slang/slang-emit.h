@@ -42,6 +42,6 @@ namespace Slang
         CodeGenTarget           target,
         TargetRequest*          targetRequest,
         ExtensionTracker*       extensionTracker, 
-        String&                 outSource);
+        StringRope&             outSource);
 }
 #endif
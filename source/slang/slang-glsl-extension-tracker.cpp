@@ -21,6 +21,17 @@ void GLSLExtensionTracker::requireSPIRVVersion(const SemanticVersion& version)
     }
 }
 
+void GLSLExtensionTracker::addRequirements(const GLSLExtensionTracker& other)
+{
+    for (const auto& extension : other.getExtensions())
+    {
+        requireExtension(extension);
+    }
+    requireVersion(other.m_profileVersion);
+    requireSPIRVVersion(other.m_spirvVersion);
+    m_hasBaseTypeFlags |= other.m_hasBaseTypeFlags;
+}
+
 void GLSLExtensionTracker::requireVersion(ProfileVersion version)
 {
     // Check if this profile is newer
@@ -23,6 +23,8 @@ public:
     void requireVersion(ProfileVersion version);
     void requireBaseTypeExtension(BaseType baseType);
     void requireSPIRVVersion(const SemanticVersion& version);
+        /// Require everything that other requires. Extensions are added in the order other requested them.
+    void addRequirements(const GLSLExtensionTracker& other);
     
     ProfileVersion getRequiredProfileVersion() const { return m_profileVersion; }
     void appendExtensionRequireLines(StringBuilder& builder) const;
@@ -0,0 +1,582 @@
+// slang-ir-bounds-check.cpp
+#include "slang-ir-bounds-check.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+// This file implements an analysis that proves buffer and array accesses
+// are in bounds, such that targets that check accesses (currently the
+// C/C++ targets, with `-bounds-check-mode`) can skip the check.
+//
+// The facts used come from the conditional branches that dominate an
+// access. For example in
+//
+//      buffer.GetDimensions(count, stride);
+//      for (uint i = start; i < count; i += step)
+//      {
+//          buffer[i] = 0;
+//      }
+//
+// the loop body is only entered on the `true` edge of `i < count`, and
+// `count` is the element count of `buffer`, so `buffer[i]` is in bounds.
+//
+// Values are compared structurally (rather than only by identity), because
+// each access to a global resource typically loads it again, and CSE doesn't
+// merge loads.
+
+struct BoundsCheckContext
+{
+        /// Limits the depth of recursive comparisons and proofs
+    static const int kMaxDepth = 8;
+
+        /// What an index needs to be less than to be in bounds
+    struct Bound
+    {
+            /// The buffer being accessed, or nullptr for an array
+        IRInst* buffer = nullptr;
+            /// The element count of an array
+        IRIntegerValue size = 0;
+    };
+
+        /// A fact that holds on entry to a block: `lhs < rhs`, or `lhs <= rhs` if not `isStrict`
+    struct Fact
+    {
+        IRInst* lhs = nullptr;
+        IRInst* rhs = nullptr;
+        bool isStrict = true;
+    };
+
+    IRGlobalValueWithCode* m_code = nullptr;
+    RefPtr<IRDominatorTree> m_dominatorTree;
+    SharedIRBuilder* m_sharedBuilder = nullptr;
+
+    static bool _getIntegerTypeInfo(IRType* type, bool& outIsSigned, int& outBitCount)
+    {
+        auto basicType = as<IRBasicType>(type);
+        if (!basicType)
+            return false;
+
+        switch (basicType->getBaseType())
+        {
+            case BaseType::Int8:    outIsSigned = true;     outBitCount = 8;    return true;
+            case BaseType::Int16:   outIsSigned = true;     outBitCount = 16;   return true;
+            case BaseType::Int:     outIsSigned = true;     outBitCount = 32;   return true;
+            case BaseType::Int64:   outIsSigned = true;     outBitCount = 64;   return true;
+            case BaseType::UInt8:   outIsSigned = false;    outBitCount = 8;    return true;
+            case BaseType::UInt16:  outIsSigned = false;    outBitCount = 16;   return true;
+            case BaseType::UInt:    outIsSigned = false;    outBitCount = 32;   return true;
+            case BaseType::UInt64:  outIsSigned = false;    outBitCount = 64;   return true;
+            default:                return false;
+        }
+    }
+
+    static bool _isUnsignedIntegerType(IRType* type)
+    {
+        bool isSigned;
+        int bitCount;
+        return _getIntegerTypeInfo(type, isSigned, bitCount) && !isSigned;
+    }
+
+    static bool _getNonNegativeLiteral(IRInst* inst, IRIntegerValue& outValue)
+    {
+        auto lit = as<IRIntLit>(inst);
+        if (!lit || lit->getValue() < 0)
+            return false;
+        outValue = lit->getValue();
+        return true;
+    }
+
+        /// Returns true if `inst` is a conversion between integer types, that preserves the value of a
+        /// non-negative operand
+    static bool _isValuePreservingConversion(IRInst* inst)
+    {
+        if (inst->getOp() != kIROp_Construct || inst->getOperandCount() != 1)
+            return false;
+
+        bool toSigned, fromSigned;
+        int toBitCount, fromBitCount;
+        if (!_getIntegerTypeInfo(inst->getDataType(), toSigned, toBitCount) ||
+            !_getIntegerTypeInfo(inst->getOperand(0)->getDataType(), fromSigned, fromBitCount))
+        {
+            return false;
+        }
+        // A non-negative value of the source type fits in the result type, unless
+        // the result is signed and the same size as an unsigned source
+        return toBitCount > fromBitCount || (toBitCount == fromBitCount && (!toSigned || fromSigned));
+    }
+
+    static bool _hasIntrinsicDefinition(IRInst* callee, UnownedStringSlice const& definition)
+    {
+        auto func = getResolvedInstForDecorations(callee);
+        for (auto decoration : func->getDecorations())
+        {
+            auto intrinsic = as<IRTargetIntrinsicDecoration>(decoration);
+            if (intrinsic && intrinsic->getDefinition() == definition)
+                return true;
+        }
+        return false;
+    }
+
+        /// Returns true if `addr` is the address of memory that the kernel can't write to
+    static bool _isImmutableAddress(IRInst* addr)
+    {
+        for (;;)
+        {
+            switch (addr->getOp())
+            {
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    addr = addr->getOperand(0);
+                    break;
+                case kIROp_GlobalParam:
+                    return true;
+                case kIROp_Param:
+                    return as<IRUniformParameterGroupType>(addr->getDataType()) != nullptr;
+                default:
+                    return false;
+            }
+        }
+    }
+
+        /// Returns true if `a` and `b` are known to always be the same value
+    static bool _isSameValue(IRInst* a, IRInst* b, int depth = 0)
+    {
+        if (a == b)
+            return true;
+        if (depth >= kMaxDepth || a->getOp() != b->getOp() || a->getFullType() != b->getFullType())
+            return false;
+
+        switch (a->getOp())
+        {
+            case kIROp_IntLit:
+                return as<IRIntLit>(a)->getValue() == as<IRIntLit>(b)->getValue();
+
+            case kIROp_Load:
+                // A load only produces the same value every time from memory that isn't written to
+                if (!_isImmutableAddress(a->getOperand(0)))
+                    return false;
+                break;
+
+            case kIROp_swizzle:
+            case kIROp_Construct:
+            case kIROp_FieldExtract:
+            case kIROp_FieldAddress:
+            case kIROp_getElement:
+            case kIROp_getElementPtr:
+            case kIROp_Add:
+            case kIROp_Sub:
+            case kIROp_Mul:
+            case kIROp_BitAnd:
+            case kIROp_BitOr:
+            case kIROp_BitXor:
+            case kIROp_Lsh:
+            case kIROp_Rsh:
+                break;
+
+            default:
+                return false;
+        }
+
+        const UInt operandCount = a->getOperandCount();
+        if (operandCount != b->getOperandCount())
+            return false;
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (!_isSameValue(a->getOperand(i), b->getOperand(i), depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+        /// Returns true if `a` is executed before `b` on every path to `b`
+    bool _dominates(IRInst* a, IRInst* b)
+    {
+        auto blockA = as<IRBlock>(a->getParent());
+        auto blockB = as<IRBlock>(b->getParent());
+        if (!blockA || !blockB)
+            return false;
+        if (blockA != blockB)
+            return m_dominatorTree->dominates(blockA, blockB);
+
+        for (auto inst = a->getNextInst(); inst; inst = inst->getNextInst())
+        {
+            if (inst == b)
+                return true;
+        }
+        return false;
+    }
+
+        /// Returns true if `value` is the element count returned by `GetDimensions` on `buffer`
+    bool _isElementCountOf(IRInst* value, IRInst* buffer)
+    {
+        // A conversion of the (unsigned) count either preserves it, or in the case of a
+        // same size signed type may make it negative, which is only compared as signed.
+        if (value->getOp() == kIROp_Construct && value->getOperandCount() == 1 &&
+            _isUnsignedIntegerType(value->getOperand(0)->getDataType()))
+        {
+            bool isSigned;
+            int bitCount;
+            if (!_getIntegerTypeInfo(value->getDataType(), isSigned, bitCount))
+                return false;
+            value = value->getOperand(0);
+        }
+
+        auto load = as<IRLoad>(value);
+        auto var = load ? as<IRVar>(load->getOperand(0)) : nullptr;
+        if (!var)
+            return false;
+
+        // The variable must only be written as the count output of a single `GetDimensions`
+        IRCall* getDimensionsCall = nullptr;
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (user->getOp() == kIROp_Load)
+                continue;
+
+            auto call = as<IRCall>(user);
+            if (!call || getDimensionsCall || call->getArgCount() < 2 || use != call->getArgs() + 1 ||
+                !_hasIntrinsicDefinition(call->getCallee(), UnownedStringSlice::fromLiteral(".GetDimensions")))
+            {
+                return false;
+            }
+            getDimensionsCall = call;
+        }
+
+        return getDimensionsCall &&
+            _isSameValue(getDimensionsCall->getArg(0), buffer) &&
+            _dominates(getDimensionsCall, load);
+    }
+
+        /// Adds the facts implied by `cond` having the value `isTrue`
+    static void _addConditionFacts(IRInst* cond, bool isTrue, List<Fact>& outFacts, int depth = 0)
+    {
+        if (depth >= kMaxDepth)
+            return;
+
+        switch (cond->getOp())
+        {
+            case kIROp_Not:
+                _addConditionFacts(cond->getOperand(0), !isTrue, outFacts, depth + 1);
+                return;
+            case kIROp_And:
+            case kIROp_Or:
+                // Both operands are known if an `and` is true, or an `or` is false
+                if (isTrue == (cond->getOp() == kIROp_And))
+                {
+                    _addConditionFacts(cond->getOperand(0), isTrue, outFacts, depth + 1);
+                    _addConditionFacts(cond->getOperand(1), isTrue, outFacts, depth + 1);
+                }
+                return;
+            default:
+                break;
+        }
+
+        // Comparisons are normalized to `lhs < rhs` or `lhs <= rhs`
+        Fact fact;
+        bool swap = false;
+        switch (cond->getOp())
+        {
+            case kIROp_Less:    swap = !isTrue;     fact.isStrict = isTrue;     break;
+            case kIROp_Leq:     swap = !isTrue;     fact.isStrict = !isTrue;    break;
+            case kIROp_Greater: swap = isTrue;      fact.isStrict = isTrue;     break;
+            case kIROp_Geq:     swap = isTrue;      fact.isStrict = !isTrue;    break;
+            default:            return;
+        }
+        fact.lhs = cond->getOperand(swap ? 1 : 0);
+        fact.rhs = cond->getOperand(swap ? 0 : 1);
+        outFacts.add(fact);
+    }
+
+        /// Get the facts that hold on entry to `block` and all the blocks it dominates,
+        /// from the conditional branches that dominate it.
+    void _getDominatingFacts(IRBlock* block, List<Fact>& outFacts)
+    {
+        for (; block; block = m_dominatorTree->getImmediateDominator(block))
+        {
+            // If the only way into the block is one side of a conditional branch,
+            // the condition is known in the block.
+            auto predecessors = block->getPredecessors();
+            if (predecessors.getCount() != 1)
+                continue;
+
+            auto predecessor = *predecessors.begin();
+            auto branch = as<IRConditionalBranch>(predecessor->getTerminator());
+            if (!branch || branch->getTrueBlock() == branch->getFalseBlock())
+                continue;
+
+            _addConditionFacts(branch->getCondition(), branch->getTrueBlock() == block, outFacts);
+        }
+    }
+
+        /// Returns true if `inst` is known to be non-negative
+    bool _isNonNegative(IRInst* inst, int depth = 0)
+    {
+        if (_isUnsignedIntegerType(inst->getDataType()))
+            return true;
+
+        IRIntegerValue value;
+        if (_getNonNegativeLiteral(inst, value))
+            return true;
+
+        if (depth >= kMaxDepth)
+            return false;
+
+        switch (inst->getOp())
+        {
+            case kIROp_BitAnd:
+                return _getNonNegativeLiteral(inst->getOperand(0), value) || _getNonNegativeLiteral(inst->getOperand(1), value);
+            case kIROp_Construct:
+                return _isValuePreservingConversion(inst) && _isNonNegative(inst->getOperand(0), depth + 1);
+            case kIROp_Param:
+                return _isNonNegativeInductionVariable(as<IRParam>(inst), depth);
+            default:
+                return false;
+        }
+    }
+
+        /// Returns true if `param` is a block parameter that starts non-negative and is only incremented
+    bool _isNonNegativeInductionVariable(IRParam* param, int depth)
+    {
+        auto block = as<IRBlock>(param->getParent());
+        if (!block)
+            return false;
+
+        Index paramIndex = 0;
+        for (auto p = block->getFirstParam(); p != param; p = p->getNextParam())
+            paramIndex++;
+
+        for (auto predecessor : block->getPredecessors())
+        {
+            auto branch = as<IRUnconditionalBranch>(predecessor->getTerminator());
+            if (!branch || UInt(paramIndex) >= branch->getArgCount())
+                return false;
+
+            auto arg = branch->getArg(UInt(paramIndex));
+            if (arg->getOp() == kIROp_Add)
+            {
+                // An increment by a non-negative amount, which can't overflow, because it only
+                // happens when the parameter is known to be less than some (small) constant
+                IRIntegerValue step;
+                IRInst* base = arg->getOperand(0);
+                if (!_getNonNegativeLiteral(arg->getOperand(1), step))
+                {
+                    base = arg->getOperand(1);
+                    if (!_getNonNegativeLiteral(arg->getOperand(0), step))
+                        return false;
+                }
+                if (base == param && _isBelowConstant(param, as<IRBlock>(arg->getParent()), 0x10000))
+                    continue;
+            }
+            if (!_isNonNegative(arg, depth + 1))
+                return false;
+        }
+        return true;
+    }
+
+        /// Returns true if `value` is known to be less than `limit` in `block`
+    bool _isBelowConstant(IRInst* value, IRBlock* block, IRIntegerValue limit)
+    {
+        if (!block)
+            return false;
+
+        List<Fact> facts;
+        _getDominatingFacts(block, facts);
+        for (auto const& fact : facts)
+        {
+            IRIntegerValue rhs;
+            if (fact.lhs == value && _getNonNegativeLiteral(fact.rhs, rhs) &&
+                (fact.isStrict ? rhs : rhs + 1) <= limit)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+        /// Returns true if `fact` implies that `index` is within `bound`
+    bool _isInBounds(Fact const& fact, IRInst* index, Bound const& bound)
+    {
+        IRInst* lhs = fact.lhs;
+        if (!_isSameValue(index, lhs) &&
+            !(_isValuePreservingConversion(index) && _isSameValue(index->getOperand(0), lhs)))
+        {
+            return false;
+        }
+
+        // For a signed comparison, the index could be negative
+        if (!_isNonNegative(lhs))
+            return false;
+
+        if (bound.buffer)
+        {
+            return fact.isStrict && _isElementCountOf(fact.rhs, bound.buffer);
+        }
+
+        IRIntegerValue rhs;
+        return _getNonNegativeLiteral(fact.rhs, rhs) && (fact.isStrict ? rhs : rhs + 1) <= bound.size;
+    }
+
+        /// Returns true if `index` is known to be less than `limit` from the value itself
+    static bool _isConstantBelow(IRInst* index, IRIntegerValue limit)
+    {
+        IRIntegerValue value;
+        if (_getNonNegativeLiteral(index, value))
+            return value < limit;
+
+        switch (index->getOp())
+        {
+            case kIROp_BitAnd:
+                // Masking with a non-negative value gives a result no larger than the mask
+                return (_getNonNegativeLiteral(index->getOperand(0), value) || _getNonNegativeLiteral(index->getOperand(1), value)) &&
+                    value < limit;
+            case kIROp_IRem:
+                // The remainder of an unsigned division is less than the divisor
+                return _isUnsignedIntegerType(index->getDataType()) &&
+                    _getNonNegativeLiteral(index->getOperand(1), value) &&
+                    value > 0 && value <= limit;
+            default:
+                return false;
+        }
+    }
+
+        /// If `inst` is a buffer or array access, get its index and what it must be less than
+    static bool _getAccess(IRInst* inst, IRInst*& outIndex, Bound& outBound)
+    {
+        switch (inst->getOp())
+        {
+            case kIROp_Call:
+            {
+                auto call = static_cast<IRCall*>(inst);
+                if (call->getArgCount() < 2)
+                    return false;
+
+                auto bufferType = call->getArg(0)->getDataType();
+                auto textureType = as<IRTextureTypeBase>(bufferType);
+                if (!as<IRHLSLStructuredBufferTypeBase>(bufferType) &&
+                    !(textureType && textureType->GetBaseShape() == TextureFlavor::Shape::ShapeBuffer))
+                {
+                    return false;
+                }
+                if (!_hasIntrinsicDefinition(call->getCallee(), UnownedStringSlice::fromLiteral(".operator[]")))
+                    return false;
+
+                outIndex = call->getArg(1);
+                outBound.buffer = call->getArg(0);
+                return true;
+            }
+            case kIROp_getElement:
+            case kIROp_getElementPtr:
+            {
+                IRType* baseType = inst->getOperand(0)->getDataType();
+                if (inst->getOp() == kIROp_getElementPtr)
+                {
+                    auto ptrType = as<IRPtrTypeBase>(baseType);
+                    baseType = ptrType ? ptrType->getValueType() : nullptr;
+                }
+                auto arrayType = as<IRArrayType>(baseType);
+                if (!arrayType)
+                    return false;
+
+                auto elementCount = as<IRIntLit>(arrayType->getElementCount());
+                if (!elementCount)
+                    return false;
+
+                outIndex = inst->getOperand(1);
+                outBound.size = elementCount->getValue();
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool processCode(IRGlobalValueWithCode* code)
+    {
+        m_code = code;
+        m_dominatorTree = nullptr;
+
+        IRBuilder builder;
+        builder.sharedBuilder = m_sharedBuilder;
+
+        bool changed = false;
+        for (auto block : code->getBlocks())
+        {
+            List<Fact> facts;
+            bool hasFacts = false;
+
+            for (auto inst : block->getChildren())
+            {
+                IRInst* index = nullptr;
+                Bound bound;
+                if (!_getAccess(inst, index, bound) || inst->findDecoration<IRInBoundsDecoration>())
+                    continue;
+
+                bool isInBounds = !bound.buffer && _isConstantBelow(index, bound.size);
+                if (!isInBounds)
+                {
+                    if (!m_dominatorTree)
+                        m_dominatorTree = computeDominatorTree(code);
+                    if (!hasFacts)
+                    {
+                        _getDominatingFacts(block, facts);
+                        hasFacts = true;
+                    }
+                    for (auto const& fact : facts)
+                    {
+                        if (_isInBounds(fact, index, bound))
+                        {
+                            isInBounds = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (isInBounds)
+                {
+                    builder.addSimpleDecoration<IRInBoundsDecoration>(inst);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+};
+
+bool markInBoundsAccesses(IRGlobalValueWithCode* code)
+{
+    SharedIRBuilder sharedBuilder(code->getModule());
+
+    BoundsCheckContext context;
+    context.m_sharedBuilder = &sharedBuilder;
+    return context.processCode(code);
+}
+
+bool markInBoundsAccesses(IRModule* module)
+{
+    SharedIRBuilder sharedBuilder(module);
+
+    BoundsCheckContext context;
+    context.m_sharedBuilder = &sharedBuilder;
+
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        // As with SSA construction we only look at code at the global scope,
+        // and not inside generics.
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            changed |= context.processCode(code);
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,29 @@
+// slang-ir-bounds-check.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+    struct IRGlobalValueWithCode;
+
+        /// Mark buffer and array accesses in `module` whose index is proven to be in bounds.
+        ///
+        /// The accesses considered are subscripts of structured and typed buffers, and
+        /// `getElement`/`getElementPtr` of fixed size arrays. An index is in bounds if
+        ///
+        /// * it is a constant, or is masked (`&`) or reduced (unsigned `%`) by a constant,
+        ///   less than the size of an array, or
+        /// * the access is dominated by a branch on `index < bound`, where `bound` is
+        ///   at most the size of an array, or is the element count returned by
+        ///   `GetDimensions` on the same buffer. For signed comparisons the index must
+        ///   also be known to be non-negative.
+        ///
+        /// Accesses that are proven to be in bounds are given an `IRInBoundsDecoration`,
+        /// such that code generation can skip checking them.
+        ///
+        /// Returns true if any access was marked.
+    bool markInBoundsAccesses(IRModule* module);
+
+        /// Mark buffer and array accesses in `code` whose index is proven to be in bounds.
+    bool markInBoundsAccesses(IRGlobalValueWithCode* code);
+}
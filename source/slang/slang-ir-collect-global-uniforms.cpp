@@ -238,7 +238,7 @@ struct CollectGlobalUniformParametersContext
             }
             for( auto use : uses )
             {
-                auto user = use->user;
+                auto user = use->getUser();
 
                 // There is an annoying gotcha here, in that we are using
                 // global shader parameters themselves (the `IRGlobalParam`s)
@@ -0,0 +1,269 @@
+// slang-ir-compact.cpp
+#include "slang-ir-compact.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+    /// Returns the number of bytes that were allocated for `inst` in its module's arena.
+    ///
+    /// This must match the sizes used when instructions are created in `slang-ir.cpp`
+    /// (and when they are deserialized). Almost all instructions are just an `IRInst` followed
+    /// by their operands, the exceptions being the module instruction and constants, whose
+    /// payload depends on their type.
+static size_t _calcInstAllocSize(IRInst* inst)
+{
+    const size_t constantPrefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+    switch (inst->getOp())
+    {
+        case kIROp_Module:
+            return sizeof(IRModuleInst);
+
+        case kIROp_BoolLit:
+        case kIROp_IntLit:
+            return constantPrefixSize + sizeof(IRIntegerValue);
+        case kIROp_FloatLit:
+            return constantPrefixSize + sizeof(IRFloatingPointValue);
+        case kIROp_PtrLit:
+            return constantPrefixSize + sizeof(void*);
+        case kIROp_StringLit:
+        {
+            // Transitory strings only ever live on the stack, so the chars must be held after the inst.
+            auto constant = static_cast<IRConstant*>(inst);
+            return constantPrefixSize + offsetof(IRConstant::StringValue, chars) + constant->value.stringVal.numChars;
+        }
+
+        default:
+            return sizeof(IRInst) + inst->getOperandCount() * sizeof(IRUse);
+    }
+}
+
+struct IRCompactionContext
+{
+    IRModule* module;
+
+    // All of the live instructions, in the order they will be laid out in the new arena.
+    List<IRInst*> liveInsts;
+    // Maps each live instruction to its replacement. Before the move takes place, the
+    // replacement is null, so this doubles as the set of live instructions.
+    IRCompactionRemap* remap;
+
+    void addLive(IRInst* inst)
+    {
+        if (remap->ContainsKey(inst))
+            return;
+        remap->Add(inst, nullptr);
+        liveInsts.add(inst);
+    }
+
+    void addLiveDescendants(IRInst* inst)
+    {
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            addLive(child);
+            addLiveDescendants(child);
+        }
+    }
+
+    void collectLiveInsts()
+    {
+        auto moduleInst = module->getModuleInst();
+        addLive(moduleInst);
+
+        // All the globals come first, so that the instructions most often
+        // referenced (types, constants, ...) are close together...
+        for (auto globalInst : moduleInst->getDecorationsAndChildren())
+        {
+            addLive(globalInst);
+        }
+        // ... followed by the contents of each global in turn, such that (say)
+        // all the blocks and instructions of a function are contiguous.
+        for (auto globalInst : moduleInst->getDecorationsAndChildren())
+        {
+            addLiveDescendants(globalInst);
+        }
+
+        // Instructions that have been removed from the module but are still
+        // referenced by live instructions must be kept alive too. Note that
+        // `liveInsts` can grow as we go.
+        for (Index i = 0; i < liveInsts.getCount(); ++i)
+        {
+            IRInst* inst = liveInsts[i];
+            _addLiveOperand(inst->getFullType());
+
+            const UInt operandCount = inst->getOperandCount();
+            for (UInt j = 0; j < operandCount; ++j)
+            {
+                _addLiveOperand(inst->getOperand(j));
+            }
+        }
+    }
+
+    void _addLiveOperand(IRInst* operand)
+    {
+        if (operand && !remap->ContainsKey(operand))
+        {
+            addLive(operand);
+            addLiveDescendants(operand);
+        }
+    }
+
+    size_t calcLiveMemory()
+    {
+        size_t total = 0;
+        for (auto inst : liveInsts)
+        {
+            total += (_calcInstAllocSize(inst) + MemoryArena::kMinAlignment - 1) & ~(MemoryArena::kMinAlignment - 1);
+        }
+        return total;
+    }
+
+    IRInst* getNew(IRInst* oldInst)
+    {
+        // Anything not live (such as the parent of a removed instruction) is dropped
+        IRInst* newInst = nullptr;
+        if (oldInst)
+        {
+            remap->TryGetValue(oldInst, newInst);
+        }
+        return newInst;
+    }
+
+    static IRUse* _getNewUse(IRUse* oldUse, IRInst* oldUser, IRInst* newUser)
+    {
+        // A use is always held within the memory of its user, at the same offset after the move
+        const ptrdiff_t offset = (const char*)oldUse - (const char*)oldUser;
+        return (IRUse*)((char*)newUser + offset);
+    }
+
+    void compact()
+    {
+        MemoryArena newArena(IRModule::kMemoryArenaBlockSize);
+
+        // Copy all of the live instructions over as is
+        for (auto oldInst : liveInsts)
+        {
+            const size_t size = _calcInstAllocSize(oldInst);
+            IRInst* newInst = (IRInst*)newArena.allocate(size);
+            ::memcpy(newInst, oldInst, size);
+            (*remap)[oldInst] = newInst;
+        }
+
+        // Fix up all of the pointers between instructions
+        for (auto oldInst : liveInsts)
+        {
+            IRInst* newInst = getNew(oldInst);
+
+            newInst->parent = getNew(oldInst->parent);
+            newInst->prev = getNew(oldInst->prev);
+            newInst->next = getNew(oldInst->next);
+            newInst->m_decorationsAndChildren.first = getNew(oldInst->m_decorationsAndChildren.first);
+            newInst->m_decorationsAndChildren.last = getNew(oldInst->m_decorationsAndChildren.last);
+
+            newInst->firstUse = nullptr;
+            _initUse(newInst->typeUse);
+
+            const UInt operandCount = newInst->getOperandCount();
+            IRUse* operands = newInst->getOperands();
+            for (UInt i = 0; i < operandCount; ++i)
+            {
+                _initUse(operands[i]);
+            }
+        }
+
+        // Rebuild the use lists in the same order as they were, dropping any
+        // uses by instructions that are no longer live.
+        for (auto oldInst : liveInsts)
+        {
+            IRInst* newInst = getNew(oldInst);
+
+            IRUse** link = &newInst->firstUse;
+            for (IRUse* oldUse = oldInst->firstUse; oldUse; oldUse = oldUse->nextUse)
+            {
+                IRInst* oldUser = oldUse->getUser();
+                IRInst* newUser = getNew(oldUser);
+                if (!newUser)
+                    continue;
+
+                IRUse* newUse = _getNewUse(oldUse, oldUser, newUser);
+                SLANG_ASSERT(newUse->get() == newInst);
+
+                newUse->prevLink = link;
+                *link = newUse;
+                link = &newUse->nextUse;
+            }
+        }
+
+        module->moduleInst = static_cast<IRModuleInst*>(getNew(module->moduleInst));
+
+        // The old arena, and with it all the dead instructions, is freed when `newArena` goes out of scope
+        module->memoryArena.swapWith(newArena);
+    }
+
+    void _initUse(IRUse& use)
+    {
+        // The position of the use within its user is unchanged, so this
+        // only needs to replace the used value.
+        use.setUnlinked(getNew(use.get()));
+        use.nextUse = nullptr;
+        use.prevLink = nullptr;
+    }
+};
+
+size_t calcLiveIRModuleMemory(IRModule* module)
+{
+    IRCompactionRemap remap;
+
+    IRCompactionContext context;
+    context.module = module;
+    context.remap = &remap;
+    context.collectLiveInsts();
+
+    return context.calcLiveMemory();
+}
+
+void compactIRModule(IRModule* module, IRCompactionRemap& outRemap)
+{
+    outRemap.Clear();
+
+    IRCompactionContext context;
+    context.module = module;
+    context.remap = &outRemap;
+    context.collectLiveInsts();
+    context.compact();
+}
+
+bool compactIRModuleIfWorthwhile(
+    IRModule*                   module,
+    IRCompactionOptions const&  options,
+    IRCompactionRemap&          outRemap)
+{
+    outRemap.Clear();
+
+    const size_t usedBytes = module->memoryArena.calcTotalMemoryUsed();
+    if (usedBytes < options.minUsedBytes)
+    {
+        return false;
+    }
+
+    IRCompactionContext context;
+    context.module = module;
+    context.remap = &outRemap;
+    context.collectLiveInsts();
+
+    const size_t liveBytes = context.calcLiveMemory();
+    const size_t deadBytes = usedBytes > liveBytes ? usedBytes - liveBytes : 0;
+    if (double(deadBytes) < double(liveBytes) * options.deadToLiveRatio)
+    {
+        outRemap.Clear();
+        return false;
+    }
+
+    context.compact();
+    return true;
+}
+
+}
@@ -0,0 +1,50 @@
+// slang-ir-compact.h
+#pragma once
+
+#include "../core/slang-dictionary.h"
+
+namespace Slang
+{
+    struct IRInst;
+    struct IRModule;
+
+        /// Maps instructions from before a compaction to the instructions that replaced them.
+    typedef Dictionary<IRInst*, IRInst*> IRCompactionRemap;
+
+    struct IRCompactionOptions
+    {
+            /// Compact when the memory held by dead instructions is at least
+            /// this multiple of the memory held by live instructions.
+        float deadToLiveRatio = 1.0f;
+            /// Modules whose arena has less than this many bytes in use are never compacted.
+        size_t minUsedBytes = 64 * 1024;
+    };
+
+        /// Returns the number of bytes of the module's arena that are held by live instructions.
+        ///
+        /// An instruction is live if it is reachable from the module instruction through
+        /// children and decorations, or is referenced (as an operand or type) by a live
+        /// instruction.
+    size_t calcLiveIRModuleMemory(IRModule* module);
+
+        /// Move all the live instructions of `module` into a fresh memory arena, and free the old one.
+        ///
+        /// Instructions removed from the module are never deallocated from the arena, so over
+        /// a sequence of passes most of a module's memory can end up held by dead instructions.
+        /// Compaction reclaims that memory, and lays out the live instructions so that all the
+        /// global instructions come first, followed by the contents of each global (such as
+        /// the blocks of a function) in order.
+        ///
+        /// Every live instruction moves, so any `IRInst*` held outside of the module must be
+        /// replaced with its entry in `outRemap`. The order of children, decorations and uses
+        /// is preserved.
+    void compactIRModule(IRModule* module, IRCompactionRemap& outRemap);
+
+        /// Compact `module` if dead instructions hold enough of its memory, as determined by `options`.
+        ///
+        /// Returns true if the module was compacted, in which case `outRemap` holds the mapping.
+    bool compactIRModuleIfWorthwhile(
+        IRModule*                   module,
+        IRCompactionOptions const&  options,
+        IRCompactionRemap&          outRemap);
+}
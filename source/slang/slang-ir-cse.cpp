@@ -0,0 +1,295 @@
+// slang-ir-cse.cpp
+#include "slang-ir-cse.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+// This file implements common subexpression elimination (CSE) for
+// the bodies of functions, in the form of a dominator-based global
+// value numbering.
+//
+// The IR is in SSA form, so two instructions with the same opcode,
+// type and operands compute the same value, as long as neither of
+// them depends on (or changes) the state of memory. If one such
+// instruction dominates the other, then the dominated one is redundant
+// and all of its uses can be replaced with the dominating instruction.
+//
+// Walking the dominator tree in pre-order, and keeping a table of
+// the instructions seen so far along the path from the root, means
+// that any match found in the table dominates the instruction being
+// looked at.
+
+    /// Returns true if `addr` points into a constant buffer, texture buffer or parameter block
+static bool _isImmutableAddress(IRInst* addr)
+{
+    for (;;)
+    {
+        switch (addr->getOp())
+        {
+            case kIROp_FieldAddress:
+            case kIROp_getElementPtr:
+                addr = addr->getOperand(0);
+                continue;
+
+            case kIROp_GlobalParam:
+                switch (addr->getDataType()->getOp())
+                {
+                    case kIROp_ConstantBufferType:
+                    case kIROp_TextureBufferType:
+                    case kIROp_ParameterBlockType:
+                        return true;
+                    default:
+                        return false;
+                }
+
+            default:
+                return false;
+        }
+    }
+}
+
+    /// Returns true if `inst` is a swizzle, extraction or conversion of a single value.
+    ///
+    /// Emitters fold these into each of their uses, so sharing one only replaces that
+    /// expression with a temporary, and downstream compilers will share them anyway.
+static bool _isTrivialToRecompute(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+        case kIROp_swizzle:
+        case kIROp_FieldExtract:
+        case kIROp_getElement:
+            return true;
+
+        // A construct from a single value is a conversion
+        case kIROp_Construct:
+            return inst->getOperandCount() == 1;
+
+        default:
+            return false;
+    }
+}
+
+    /// Returns true if `inst` computes its value purely from its operands.
+    ///
+    /// If `allowTrapping` is set, then operations that might trap (division) are allowed.
+static bool _isComputation(IRInst* inst, bool allowTrapping)
+{
+    switch (inst->getOp())
+    {
+        // Each of these produces a distinct value every time it is executed,
+        // or (for loads) depends on the state of memory.
+        case kIROp_Param:
+        case kIROp_Var:
+        case kIROp_undefined:
+        case kIROp_Nop:
+            return false;
+
+        // Memory that can't be written by the shader always holds the same
+        // value, so loads from it can be treated like any other computation.
+        case kIROp_Load:
+            if (!_isImmutableAddress(inst->getOperand(0)))
+                return false;
+            break;
+
+        // Division can trap, which is why it is considered to have side effects.
+        case kIROp_Div:
+        case kIROp_IRem:
+        case kIROp_FRem:
+            if (!allowTrapping)
+                return false;
+            break;
+
+        default:
+            if (inst->mightHaveSideEffects())
+                return false;
+            break;
+    }
+
+    if (as<IRTerminatorInst>(inst) || as<IRType>(inst))
+        return false;
+
+    // Decorations (such as `precise`) can change the meaning of an instruction,
+    // so only the name hint, which doesn't, is allowed.
+    for (auto decoration : inst->getDecorations())
+    {
+        if (!as<IRNameHintDecoration>(decoration))
+            return false;
+    }
+
+    // An instruction with children isn't an ordinary computation.
+    if (inst->getFirstChild())
+        return false;
+
+    return true;
+}
+
+bool isPureComputation(IRInst* inst)
+{
+    return _isComputation(inst, false);
+}
+
+struct CSEContext
+{
+        /// The instructions available at the current point of the dominator tree walk
+    Dictionary<IRInstKey, IRInst*> m_availableInsts;
+
+        /// Keys added to `m_availableInsts`, in order, so they can be removed when leaving a subtree
+    List<IRInstKey> m_addedKeys;
+
+        /// Loads available in the current block, keyed by the load itself (so by type and address)
+    Dictionary<IRInstKey, IRInst*> m_availableLoads;
+
+    bool m_changed = false;
+
+    void _replace(IRInst* inst, IRInst* existing)
+    {
+        // Keep the name of the replaced value if the one replacing it doesn't have one,
+        // so the emitted code still uses the name from the source.
+        if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
+        {
+            if (!existing->findDecoration<IRNameHintDecoration>())
+            {
+                nameHint->removeFromParent();
+                nameHint->insertAtStart(existing);
+            }
+        }
+
+        inst->replaceUsesWith(existing);
+        inst->removeAndDeallocate();
+        m_changed = true;
+    }
+
+    void _processBlock(IRBlock* block)
+    {
+        // Loads are only reused within a block, so the set starts out empty.
+        m_availableLoads.Clear();
+
+        IRInst* next = nullptr;
+        for (auto inst = block->getFirstChild(); inst; inst = next)
+        {
+            next = inst->getNextInst();
+
+            if (inst->getOp() == kIROp_Load && !_isImmutableAddress(inst->getOperand(0)))
+            {
+                IRInstKey key = { inst };
+                IRInst* existing = nullptr;
+                if (m_availableLoads.TryGetValue(key, existing))
+                {
+                    _replace(inst, existing);
+                }
+                else
+                {
+                    m_availableLoads.Add(key, inst);
+                }
+                continue;
+            }
+
+            // As the instruction being replaced is dominated by the one replacing
+            // it, a division that could trap would already have trapped, and
+            // so can be replaced too.
+            if (_isComputation(inst, true) && !_isTrivialToRecompute(inst))
+            {
+                IRInstKey key = { inst };
+                IRInst* existing = nullptr;
+                if (m_availableInsts.TryGetValue(key, existing))
+                {
+                    _replace(inst, existing);
+                }
+                else
+                {
+                    m_availableInsts.Add(key, inst);
+                    m_addedKeys.add(key);
+                }
+                continue;
+            }
+
+            // Anything else that might have side effects might write
+            // to memory, so no earlier load can be relied on after it.
+            if (inst->mightHaveSideEffects())
+            {
+                m_availableLoads.Clear();
+            }
+        }
+    }
+
+    void processCode(IRGlobalValueWithCode* code)
+    {
+        auto firstBlock = code->getFirstBlock();
+        if (!firstBlock)
+            return;
+
+        auto dominatorTree = computeDominatorTree(code);
+
+        // The dominator tree can be deep (for example after loop unrolling),
+        // so it is walked with an explicit stack rather than recursion.
+        struct Entry
+        {
+            IRBlock* block;
+                /// The size of `m_addedKeys` when the block was entered, or -1 if the block hasn't been entered yet
+            Index addedKeyCount;
+        };
+
+        List<Entry> stack;
+        stack.add(Entry{ firstBlock, -1 });
+
+        while (stack.getCount())
+        {
+            Entry entry = stack.getLast();
+            stack.removeLast();
+
+            if (entry.addedKeyCount >= 0)
+            {
+                // Leaving the subtree, so the instructions from it are no longer available
+                for (Index i = m_addedKeys.getCount() - 1; i >= entry.addedKeyCount; --i)
+                {
+                    m_availableInsts.Remove(m_addedKeys[i]);
+                }
+                m_addedKeys.setCount(entry.addedKeyCount);
+                continue;
+            }
+
+            stack.add(Entry{ entry.block, m_addedKeys.getCount() });
+
+            _processBlock(entry.block);
+
+            for (auto child : dominatorTree->getImmediatelyDominatedBlocks(entry.block))
+            {
+                stack.add(Entry{ child, -1 });
+            }
+        }
+
+        SLANG_ASSERT(m_availableInsts.Count() == 0);
+    }
+};
+
+bool eliminateCommonSubexpressions(IRGlobalValueWithCode* code)
+{
+    CSEContext context;
+    context.processCode(code);
+    return context.m_changed;
+}
+
+bool eliminateCommonSubexpressions(IRModule* module)
+{
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        // Code nested in generics will be handled once specialized, so we only
+        // look at functions (and other values with code) at the global scope.
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            changed |= eliminateCommonSubexpressions(code);
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,32 @@
+// slang-ir-cse.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+    struct IRGlobalValueWithCode;
+    struct IRInst;
+
+        /// Returns true if `inst` computes its value purely from its operands, without
+        /// side effects, such that it can be moved or replaced with an equivalent instruction.
+        ///
+        /// Loads are only included when they are from memory that can't be written
+        /// (constant buffers, texture buffers and parameter blocks).
+    bool isPureComputation(IRInst* inst);
+
+        /// Eliminate common subexpressions in the bodies of functions in `module`.
+        ///
+        /// An instruction without side effects that computes the same operation
+        /// on the same operands as an instruction that dominates it is replaced
+        /// with that instruction (global value numbering over the dominator tree).
+        ///
+        /// Loads from memory that might be written are only replaced with an earlier
+        /// load of the same address in the same block, when no instruction that might
+        /// write memory lies between them.
+        ///
+        /// Returns true if any instruction was eliminated.
+    bool eliminateCommonSubexpressions(IRModule* module);
+
+        /// Eliminate common subexpressions in the body of `code`.
+    bool eliminateCommonSubexpressions(IRGlobalValueWithCode* code);
+}
@@ -0,0 +1,607 @@
+// slang-ir-dse.cpp
+#include "slang-ir-dse.h"
+
+#include "../core/slang-uint-set.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+
+// This file implements dead store elimination (DSE) and redundant load
+// elimination for local variables that are still in memory after SSA
+// construction.
+//
+// Every address derived from a local variable is described by an
+// "access path": the variable, followed by the struct keys and element
+// indices used to get from it to the address:
+//
+//      var v : Ptr(S);                         // v
+//      let a = fieldAddress(v, S.arr);         // v.arr
+//      let b = getElementPtr(a, 2);            // v.arr[2]
+//      let c = getElementPtr(a, %i);           // v.arr[%i]
+//
+// Two paths with the same variable can only refer to overlapping memory
+// if one is a prefix of the other, ignoring positions where either uses
+// a dynamic index (so `v.arr[2]` might alias `v.arr[%i]`, but not `v.arr[3]`).
+//
+// As long as every use of a variable's addresses is a load, a store, or an
+// argument to a call, access paths describe everything that can read or
+// write the variable, and we can run two data flow analyses over the CFG:
+//
+// * Forwards, the value known to be held at each path. A load of a path
+//   with a known value is replaced with that value.
+//
+// * Backwards, the paths that overlap memory that might be read before
+//   being overwritten. A store to a path that isn't in that set is dead.
+
+struct DSEContext
+{
+        /// Functions with more access paths than this are skipped, as the alias sets are quadratic in size
+    static const Index kMaxPathCount = 2048;
+
+        /// An address derived from a local variable
+    struct AccessPath
+    {
+        IRVar* root;
+            /// The struct keys and element indices applied to `root`
+        List<IRInst*> selectors;
+    };
+
+    IRGlobalValueWithCode* m_code = nullptr;
+
+    List<AccessPath> m_paths;
+        /// The index of the path for each address derived from a tracked variable
+    Dictionary<IRInst*, Index> m_mapAddrToPath;
+
+        /// For each path, the paths that might refer to overlapping memory (including itself)
+    List<UIntSet> m_mayAlias;
+        /// For each path, the paths that refer to memory entirely within it (including itself).
+        ///
+        /// This is left empty for paths with a dynamic index. The index might be a
+        /// different value on another loop iteration, so the same path doesn't always
+        /// refer to the same memory.
+    List<UIntSet> m_covers;
+
+        /// The reachable blocks, in reverse post-order
+    List<IRBlock*> m_blocks;
+    Dictionary<IRBlock*, Index> m_mapBlockToIndex;
+
+    bool m_changed = false;
+
+        /// Returns true if selectors `a` and `b` always select the same field/element
+    static bool _isSameSelector(IRInst* a, IRInst* b)
+    {
+        if (a == b)
+            return true;
+        auto litA = as<IRIntLit>(a);
+        auto litB = as<IRIntLit>(b);
+        return litA && litB && litA->getValue() == litB->getValue();
+    }
+
+        /// Returns true if selectors `a` and `b` might select the same field/element
+    static bool _mightBeSameSelector(IRInst* a, IRInst* b)
+    {
+        if (_isSameSelector(a, b))
+            return true;
+
+        // Different struct keys, or different constant indices, can't overlap.
+        // Anything else involves a dynamic index.
+        if (as<IRStructKey>(a) || as<IRStructKey>(b))
+            return false;
+        return !(as<IRIntLit>(a) && as<IRIntLit>(b));
+    }
+
+        /// Returns true if every use of `addr` (and addresses derived from it) is understood
+    static bool _hasOnlyKnownUses(IRInst* addr)
+    {
+        for (auto use = addr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+                case kIROp_Load:
+                    break;
+
+                case kIROp_Store:
+                    // Storing the address itself somewhere would let it be
+                    // accessed in ways we can't see.
+                    if (use != user->getOperands())
+                        return false;
+                    break;
+
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    if (use != user->getOperands() || !_hasOnlyKnownUses(user))
+                        return false;
+                    break;
+
+                case kIROp_Call:
+                    // Passing the address as an argument is fine (the callee
+                    // can only access it during the call), but calling it isn't.
+                    if (use == user->getOperands())
+                        return false;
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    Index _findOrAddPath(IRVar* root, List<IRInst*> const& selectors)
+    {
+        for (Index i = 0; i < m_paths.getCount(); ++i)
+        {
+            auto const& path = m_paths[i];
+            if (path.root != root || path.selectors.getCount() != selectors.getCount())
+                continue;
+
+            bool isSame = true;
+            for (Index j = 0; j < selectors.getCount(); ++j)
+            {
+                if (!_isSameSelector(path.selectors[j], selectors[j]))
+                {
+                    isSame = false;
+                    break;
+                }
+            }
+            if (isSame)
+                return i;
+        }
+
+        AccessPath path;
+        path.root = root;
+        path.selectors = selectors;
+        m_paths.add(path);
+        return m_paths.getCount() - 1;
+    }
+
+    void _addAddressPaths(IRVar* root, IRInst* addr, List<IRInst*>& selectors)
+    {
+        m_mapAddrToPath.Add(addr, _findOrAddPath(root, selectors));
+
+        for (auto use = addr->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->getOp())
+            {
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    selectors.add(user->getOperand(1));
+                    _addAddressPaths(root, user, selectors);
+                    selectors.removeLast();
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+        /// Get the path for `addr`, or -1 if it isn't an address of a tracked variable
+    Index _getPath(IRInst* addr)
+    {
+        Index path = -1;
+        m_mapAddrToPath.TryGetValue(addr, path);
+        return path;
+    }
+
+        /// Returns true if `path` only uses struct keys and constant indices
+    static bool _isConstantPath(AccessPath const& path)
+    {
+        for (auto selector : path.selectors)
+        {
+            if (!as<IRStructKey>(selector) && !as<IRIntLit>(selector))
+                return false;
+        }
+        return true;
+    }
+
+    void _computeAliasSets()
+    {
+        const Index count = m_paths.getCount();
+        m_mayAlias.setCount(count);
+        m_covers.setCount(count);
+        for (Index i = 0; i < count; ++i)
+        {
+            m_mayAlias[i].resizeAndClear(UInt(count));
+            m_covers[i].resizeAndClear(UInt(count));
+        }
+
+        for (Index i = 0; i < count; ++i)
+        {
+            auto const& a = m_paths[i];
+            for (Index j = i; j < count; ++j)
+            {
+                auto const& b = m_paths[j];
+                if (a.root != b.root)
+                    continue;
+
+                const Index commonCount = Math::Min(a.selectors.getCount(), b.selectors.getCount());
+                bool mayAlias = true;
+                bool isPrefix = true;
+                for (Index k = 0; k < commonCount && mayAlias; ++k)
+                {
+                    if (!_isSameSelector(a.selectors[k], b.selectors[k]))
+                    {
+                        isPrefix = false;
+                        mayAlias = _mightBeSameSelector(a.selectors[k], b.selectors[k]);
+                    }
+                }
+                if (!mayAlias)
+                    continue;
+
+                m_mayAlias[i].add(UInt(j));
+                m_mayAlias[j].add(UInt(i));
+
+                // The shorter path covers the longer one if it is a prefix of it
+                if (isPrefix)
+                {
+                    if (a.selectors.getCount() <= b.selectors.getCount() && _isConstantPath(a))
+                        m_covers[i].add(UInt(j));
+                    if (b.selectors.getCount() <= a.selectors.getCount() && _isConstantPath(b))
+                        m_covers[j].add(UInt(i));
+                }
+            }
+        }
+    }
+
+    void _computeBlockOrder()
+    {
+        // Reverse post-order of the blocks reachable from the entry block,
+        // computed with an explicit stack.
+        struct Entry
+        {
+            IRBlock* block;
+            bool isLeaving;
+        };
+
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> postOrder;
+        List<Entry> stack;
+        stack.add(Entry{ m_code->getFirstBlock(), false });
+        while (stack.getCount())
+        {
+            Entry entry = stack.getLast();
+            stack.removeLast();
+
+            if (entry.isLeaving)
+            {
+                postOrder.add(entry.block);
+                continue;
+            }
+            if (visited.Contains(entry.block))
+                continue;
+            visited.Add(entry.block);
+
+            stack.add(Entry{ entry.block, true });
+            for (auto succ : entry.block->getSuccessors())
+            {
+                if (!visited.Contains(succ))
+                    stack.add(Entry{ succ, false });
+            }
+        }
+
+        m_blocks.clear();
+        m_mapBlockToIndex.Clear();
+        for (Index i = postOrder.getCount() - 1; i >= 0; --i)
+        {
+            m_mapBlockToIndex.Add(postOrder[i], m_blocks.getCount());
+            m_blocks.add(postOrder[i]);
+        }
+    }
+
+        /// The value known to be held at each path (or null if not known)
+    typedef List<IRInst*> AvailableValues;
+
+        /// Apply the effect of `block` on the values available at each path.
+        ///
+        /// If `dominatorTree` is set, loads with a known value are replaced.
+    void _forwardBlock(IRBlock* block, AvailableValues& values, IRDominatorTree* dominatorTree)
+    {
+        IRInst* next = nullptr;
+        for (auto inst = block->getFirstChild(); inst; inst = next)
+        {
+            next = inst->getNextInst();
+
+            switch (inst->getOp())
+            {
+                case kIROp_Load:
+                {
+                    const Index path = _getPath(inst->getOperand(0));
+                    if (path < 0)
+                        break;
+
+                    auto value = values[path];
+                    if (!value)
+                    {
+                        values[path] = inst;
+                        break;
+                    }
+                    if (!dominatorTree || value->getDataType() != inst->getDataType())
+                        break;
+
+                    // The value is available along every path to the load, so it
+                    // must dominate it. This is checked anyway, to be safe.
+                    auto valueBlock = as<IRBlock>(value->getParent());
+                    if (valueBlock && valueBlock != block && !dominatorTree->dominates(valueBlock, block))
+                        break;
+
+                    inst->replaceUsesWith(value);
+                    inst->removeAndDeallocate();
+                    m_changed = true;
+                    break;
+                }
+                case kIROp_Store:
+                {
+                    const Index path = _getPath(inst->getOperand(0));
+                    if (path < 0)
+                        break;
+
+                    _killAliases(values, path);
+                    values[path] = inst->getOperand(1);
+                    break;
+                }
+                case kIROp_Call:
+                {
+                    // The callee might write through any address passed to it.
+                    for (UInt i = 1; i < inst->getOperandCount(); ++i)
+                    {
+                        const Index path = _getPath(inst->getOperand(i));
+                        if (path >= 0)
+                            _killAliases(values, path);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    void _killAliases(AvailableValues& values, Index path)
+    {
+        for (Index i = 0; i < values.getCount(); ++i)
+        {
+            if (m_mayAlias[path].contains(UInt(i)))
+                values[i] = nullptr;
+        }
+    }
+
+    void _forwardLoads()
+    {
+        const Index pathCount = m_paths.getCount();
+        const Index blockCount = m_blocks.getCount();
+
+        // The values available at the end of each block. A block whose
+        // output hasn't been computed yet doesn't constrain its successors.
+        List<AvailableValues> outValues;
+        List<bool> hasOutValues;
+        outValues.setCount(blockCount);
+        hasOutValues.setCount(blockCount);
+        for (Index i = 0; i < blockCount; ++i)
+            hasOutValues[i] = false;
+
+        AvailableValues values;
+        auto computeInValues = [&](Index blockIndex)
+        {
+            values.setCount(pathCount);
+            for (Index i = 0; i < pathCount; ++i)
+                values[i] = nullptr;
+
+            if (blockIndex == 0)
+                return;
+
+            bool isFirst = true;
+            for (auto pred : m_blocks[blockIndex]->getPredecessors())
+            {
+                Index predIndex = -1;
+                if (!m_mapBlockToIndex.TryGetValue(pred, predIndex) || !hasOutValues[predIndex])
+                    continue;
+
+                auto const& predValues = outValues[predIndex];
+                if (isFirst)
+                {
+                    for (Index i = 0; i < pathCount; ++i)
+                        values[i] = predValues[i];
+                    isFirst = false;
+                }
+                else
+                {
+                    for (Index i = 0; i < pathCount; ++i)
+                    {
+                        if (values[i] != predValues[i])
+                            values[i] = nullptr;
+                    }
+                }
+            }
+        };
+
+        for (bool changed = true; changed; )
+        {
+            changed = false;
+            for (Index b = 0; b < blockCount; ++b)
+            {
+                computeInValues(b);
+                _forwardBlock(m_blocks[b], values, nullptr);
+
+                if (!hasOutValues[b] || !(outValues[b] == values))
+                {
+                    outValues[b] = values;
+                    hasOutValues[b] = true;
+                    changed = true;
+                }
+            }
+        }
+
+        auto dominatorTree = computeDominatorTree(m_code);
+        for (Index b = 0; b < blockCount; ++b)
+        {
+            computeInValues(b);
+            _forwardBlock(m_blocks[b], values, dominatorTree.Ptr());
+        }
+    }
+
+        /// Apply the effect of `block` (backwards) on the set of paths that might be read.
+        ///
+        /// If `removeDeadStores` is set, stores that can't be read are removed.
+    void _liveBlock(IRBlock* block, UIntSet& live, bool removeDeadStores)
+    {
+        IRInst* prev = nullptr;
+        for (auto inst = block->getLastChild(); inst; inst = prev)
+        {
+            prev = inst->getPrevInst();
+
+            switch (inst->getOp())
+            {
+                case kIROp_Load:
+                {
+                    const Index path = _getPath(inst->getOperand(0));
+                    if (path >= 0)
+                        live.unionWith(m_mayAlias[path]);
+                    break;
+                }
+                case kIROp_Store:
+                {
+                    const Index path = _getPath(inst->getOperand(0));
+                    if (path < 0)
+                        break;
+
+                    if (removeDeadStores && !live.contains(UInt(path)))
+                    {
+                        inst->removeAndDeallocate();
+                        m_changed = true;
+                        break;
+                    }
+
+                    // Anything the store completely overwrites can't be read
+                    // by earlier code.
+                    UIntSet::calcSubtract(live, live, m_covers[path]);
+                    break;
+                }
+                case kIROp_Call:
+                {
+                    // The callee might read through any address passed to it.
+                    for (UInt i = 1; i < inst->getOperandCount(); ++i)
+                    {
+                        const Index path = _getPath(inst->getOperand(i));
+                        if (path >= 0)
+                            live.unionWith(m_mayAlias[path]);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    void _removeDeadStores()
+    {
+        const Index pathCount = m_paths.getCount();
+        const Index blockCount = m_blocks.getCount();
+
+        // The paths that might be read after the start of each block. Local
+        // variables can't be read once the function returns, so a block
+        // without successors starts with nothing live.
+        List<UIntSet> inLive;
+        inLive.setCount(blockCount);
+        for (Index i = 0; i < blockCount; ++i)
+            inLive[i].resizeAndClear(UInt(pathCount));
+
+        UIntSet live;
+        auto computeOutLive = [&](Index blockIndex)
+        {
+            live.resizeAndClear(UInt(pathCount));
+            for (auto succ : m_blocks[blockIndex]->getSuccessors())
+            {
+                Index succIndex = -1;
+                if (m_mapBlockToIndex.TryGetValue(succ, succIndex))
+                    live.unionWith(inLive[succIndex]);
+            }
+        };
+
+        for (bool changed = true; changed; )
+        {
+            changed = false;
+            for (Index b = blockCount - 1; b >= 0; --b)
+            {
+                computeOutLive(b);
+                _liveBlock(m_blocks[b], live, false);
+                if (live != inLive[b])
+                {
+                    inLive[b] = live;
+                    changed = true;
+                }
+            }
+        }
+
+        for (Index b = blockCount - 1; b >= 0; --b)
+        {
+            computeOutLive(b);
+            _liveBlock(m_blocks[b], live, true);
+        }
+    }
+
+    void processCode(IRGlobalValueWithCode* code)
+    {
+        m_code = code;
+        if (!code->getFirstBlock())
+            return;
+
+        for (auto block : code->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto var = as<IRVar>(inst);
+                if (!var || !_hasOnlyKnownUses(var))
+                    continue;
+
+                List<IRInst*> selectors;
+                _addAddressPaths(var, var, selectors);
+
+                if (m_paths.getCount() > kMaxPathCount)
+                    return;
+            }
+        }
+
+        if (m_paths.getCount() == 0)
+            return;
+
+        _computeAliasSets();
+        _computeBlockOrder();
+
+        _forwardLoads();
+        _removeDeadStores();
+    }
+};
+
+bool eliminateDeadStoresAndRedundantLoads(IRGlobalValueWithCode* code)
+{
+    DSEContext context;
+    context.processCode(code);
+    return context.m_changed;
+}
+
+bool eliminateDeadStoresAndRedundantLoads(IRModule* module)
+{
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        // As with SSA construction we only look at code at the global scope,
+        // and not inside generics.
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            changed |= eliminateDeadStoresAndRedundantLoads(code);
+        }
+    }
+    return changed;
+}
+
+}
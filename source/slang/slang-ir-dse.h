@@ -0,0 +1,26 @@
+// slang-ir-dse.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+    struct IRGlobalValueWithCode;
+
+        /// Eliminate dead stores and redundant loads of local variables in `module`.
+        ///
+        /// This handles local variables that `constructSSA` couldn't promote, such as
+        /// variables whose address (or the address of one of their fields/elements)
+        /// is passed as an argument to a call. Variables whose address is used in any
+        /// other way (so might be accessed through another pointer) are left alone.
+        ///
+        /// A load is replaced with the value last stored to (or loaded from) the same
+        /// address, if that value is the same along every path to the load. A store
+        /// is removed if no path from it reaches a load (or call) that might read
+        /// the address before it is overwritten or the function returns.
+        ///
+        /// Returns true if any load or store was removed.
+    bool eliminateDeadStoresAndRedundantLoads(IRModule* module);
+
+        /// Eliminate dead stores and redundant loads of local variables in `code`.
+    bool eliminateDeadStoresAndRedundantLoads(IRGlobalValueWithCode* code);
+}
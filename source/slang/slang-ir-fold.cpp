@@ -0,0 +1,221 @@
+// slang-ir-fold.cpp
+#include "slang-ir-fold.h"
+
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+// Integer constant folding works on 64-bit values, which are then
+// truncated (and sign or zero extended) to the width of the result type.
+//
+static bool _getIntegerTypeInfo(IRType* type, int& outBitWidth, bool& outIsSigned)
+{
+    switch( type->getOp() )
+    {
+    case kIROp_Int8Type:    outBitWidth = 8;    outIsSigned = true;     return true;
+    case kIROp_Int16Type:   outBitWidth = 16;   outIsSigned = true;     return true;
+    case kIROp_IntType:     outBitWidth = 32;   outIsSigned = true;     return true;
+    case kIROp_Int64Type:   outBitWidth = 64;   outIsSigned = true;     return true;
+    case kIROp_UInt8Type:   outBitWidth = 8;    outIsSigned = false;    return true;
+    case kIROp_UInt16Type:  outBitWidth = 16;   outIsSigned = false;    return true;
+    case kIROp_UIntType:    outBitWidth = 32;   outIsSigned = false;    return true;
+    case kIROp_UInt64Type:  outBitWidth = 64;   outIsSigned = false;    return true;
+    default:
+        return false;
+    }
+}
+
+static IRIntegerValue _truncateIntegerValue(IRIntegerValue value, int bitWidth, bool isSigned)
+{
+    if( bitWidth >= 64 )
+        return value;
+
+    const uint64_t mask = (uint64_t(1) << bitWidth) - 1;
+    uint64_t bits = uint64_t(value) & mask;
+    if( isSigned && (bits >> (bitWidth - 1)) )
+        bits |= ~mask;
+    return IRIntegerValue(bits);
+}
+
+namespace { // anonymous
+
+// The value of an integer constant, as the type of the constant interprets it
+struct IntegerOperand
+{
+    bool init(IRIntLit* intLit)
+    {
+        if( !_getIntegerTypeInfo(intLit->getDataType(), bitWidth, isSigned) )
+            return false;
+        value = _truncateIntegerValue(intLit->getValue(), bitWidth, isSigned);
+        return true;
+    }
+
+    IRIntegerValue value = 0;
+    int bitWidth = 0;
+    bool isSigned = false;
+};
+
+} // anonymous
+
+template<typename T>
+static bool _compareValues(IROp op, T left, T right)
+{
+    switch( op )
+    {
+    case kIROp_Eql:     return left == right;
+    case kIROp_Neq:     return left != right;
+    case kIROp_Less:    return left < right;
+    case kIROp_Leq:     return left <= right;
+    case kIROp_Greater: return left > right;
+    case kIROp_Geq:     return left >= right;
+    default:
+        SLANG_UNEXPECTED("unhandled comparison");
+        UNREACHABLE_RETURN(false);
+    }
+}
+
+IRInst* tryFoldIntegerOp(
+    IRBuilder*          builder,
+    IROp                op,
+    IRType*             resultType,
+    IRIntLit* const*    operands,
+    Index               operandCount)
+{
+    IntegerOperand values[2];
+    if( operandCount < 1 || operandCount > 2 )
+        return nullptr;
+    for( Index i = 0; i < operandCount; ++i )
+    {
+        if( !values[i].init(operands[i]) )
+            return nullptr;
+    }
+
+    // A conversion between integer types.
+    //
+    if( op == kIROp_Construct )
+    {
+        int bitWidth = 0;
+        bool isSigned = false;
+        if( operandCount != 1 || !_getIntegerTypeInfo(resultType, bitWidth, isSigned) )
+            return nullptr;
+        return builder->getIntValue(resultType, _truncateIntegerValue(values[0].value, bitWidth, isSigned));
+    }
+
+    if( operandCount != 2 )
+        return nullptr;
+
+    const IntegerOperand& left = values[0];
+    const IntegerOperand& right = values[1];
+
+    // Comparisons are only folded when both sides agree on signedness,
+    // as otherwise the conversion applied by the target is needed.
+    //
+    switch( op )
+    {
+    case kIROp_Eql:
+    case kIROp_Neq:
+    case kIROp_Less:
+    case kIROp_Leq:
+    case kIROp_Greater:
+    case kIROp_Geq:
+        {
+            if( left.isSigned != right.isSigned || resultType->getOp() != kIROp_BoolType )
+                return nullptr;
+
+            const bool result = left.isSigned ?
+                _compareValues(op, left.value, right.value) :
+                _compareValues(op, uint64_t(left.value), uint64_t(right.value));
+            return builder->getBoolValue(result);
+        }
+    default:
+        break;
+    }
+
+    int bitWidth = 0;
+    bool isSigned = false;
+    if( !_getIntegerTypeInfo(resultType, bitWidth, isSigned) )
+        return nullptr;
+
+    // The arithmetic is done on unsigned values so that overflow wraps.
+    //
+    const uint64_t a = uint64_t(left.value);
+    const uint64_t b = uint64_t(right.value);
+    uint64_t result = 0;
+    switch( op )
+    {
+    case kIROp_Add:     result = a + b; break;
+    case kIROp_Sub:     result = a - b; break;
+    case kIROp_Mul:     result = a * b; break;
+    case kIROp_BitAnd:  result = a & b; break;
+    case kIROp_BitOr:   result = a | b; break;
+    case kIROp_BitXor:  result = a ^ b; break;
+
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+        {
+            // How a shift by a negative amount, or by at least the width of
+            // the type, behaves differs between targets (and is undefined in C++).
+            //
+            if( (right.isSigned && right.value < 0) || uint64_t(right.value) >= uint64_t(bitWidth) )
+                return nullptr;
+
+            const int shift = int(right.value);
+            if( op == kIROp_Lsh )
+            {
+                result = a << shift;
+            }
+            else
+            {
+                // The sign of the shifted value determines if the shift is arithmetic
+                if( left.isSigned != isSigned )
+                    return nullptr;
+
+                if( isSigned )
+                {
+                    // Shift the complement of negative values, so only unsigned values are shifted
+                    result = (left.value < 0) ? ~(~a >> shift) : (a >> shift);
+                }
+                else
+                {
+                    result = a >> shift;
+                }
+            }
+            break;
+        }
+
+    case kIROp_Div:
+    case kIROp_IRem:
+        {
+            if( left.isSigned != isSigned || right.isSigned != isSigned )
+                return nullptr;
+
+            // Division by zero, and the one signed division that overflows,
+            // are left for the target to handle.
+            //
+            if( right.value == 0 )
+                return nullptr;
+
+            if( isSigned )
+            {
+                const IRIntegerValue minValue = IRIntegerValue(~uint64_t(0) << (bitWidth - 1));
+                if( left.value == minValue && right.value == -1 )
+                    return nullptr;
+
+                // C++ rounds towards zero, as the targets do
+                result = uint64_t((op == kIROp_Div) ? (left.value / right.value) : (left.value % right.value));
+            }
+            else
+            {
+                result = (op == kIROp_Div) ? (a / b) : (a % b);
+            }
+            break;
+        }
+
+    default:
+        return nullptr;
+    }
+    return builder->getIntValue(resultType, _truncateIntegerValue(IRIntegerValue(result), bitWidth, isSigned));
+}
+
+} // namespace Slang
@@ -0,0 +1,25 @@
+// slang-ir-fold.h
+#pragma once
+
+#include "slang-ir.h"
+
+namespace Slang
+{
+    struct IRBuilder;
+
+        /// Try to evaluate the integer operation `op` on constant `operands`, giving a value of `resultType`.
+        ///
+        /// Handles conversions between integer types, arithmetic, shifts, bitwise operations and
+        /// comparisons. Arithmetic wraps around on overflow (for signed types too), as it does on
+        /// the GPU targets.
+        ///
+        /// Returns the resulting constant, or nullptr if the operation isn't handled, or doesn't have
+        /// a result that is the same on every target (a division by zero, a signed division that
+        /// overflows, or a shift by a negative amount or by at least the bit width).
+    IRInst* tryFoldIntegerOp(
+        IRBuilder*          builder,
+        IROp                op,
+        IRType*             resultType,
+        IRIntLit* const*    operands,
+        Index               operandCount);
+}
@@ -26,6 +26,9 @@ struct InliningPassBase
         /// The module that we are optimizing/transforming
     IRModule* m_module = nullptr;
 
+        /// If set, inlined instructions take the source location of the call site in preference to their own.
+    bool m_preferCallSiteSourceLoc = true;
+
         /// Initialize an inlining pass to operate on the given `module`
     InliningPassBase(IRModule* module)
         : m_module(module)
@@ -323,9 +326,18 @@ struct InliningPassBase
         {
             inlineTrivialFuncBody(callSite, &env, &builder);
         }
+        else if( isSingleReturnFunc(callee) )
+        {
+            // A callee with more than one block can still be inlined
+            // without disturbing the structured control flow of the
+            // caller, as long as every path through it ends at
+            // the same `return`.
+            //
+            inlineSingleReturnFuncBody(callSite, &env, &builder);
+        }
         else
         {
-            // Running into any non-trivial function to be inlined
+            // Running into any other function to be inlined
             // is currently an internal compiler error.
             //
             SLANG_UNIMPLEMENTED_X("general case of inlining");
@@ -355,6 +367,48 @@ struct InliningPassBase
         return true;
     }
 
+        /// Check if every path through the body of `func` ends at a single `return`
+    bool isSingleReturnFunc(IRFunc* func)
+    {
+        // The caller is going to be left with a branch from the
+        // (clone of the) one `return` to the code after the call site.
+        // That branch is only structured if control can't leave the
+        // callee any other way, so any block that ends in something
+        // other than an ordinary branch or the one `return` rules
+        // the function out.
+        //
+        // Note that this also rules out a `return` nested inside
+        // of a loop, since the `break` block of such a loop would
+        // have to end in something like `unreachable`.
+        //
+        Index returnCount = 0;
+        for( auto block : func->getBlocks() )
+        {
+            auto terminator = block->getTerminator();
+            if( !terminator )
+                return false;
+
+            switch( terminator->getOp() )
+            {
+            case kIROp_ReturnVal:
+            case kIROp_ReturnVoid:
+                returnCount++;
+                break;
+
+            case kIROp_unconditionalBranch:
+            case kIROp_loop:
+            case kIROp_conditionalBranch:
+            case kIROp_ifElse:
+            case kIROp_Switch:
+                break;
+
+            default:
+                return false;
+            }
+        }
+        return returnCount == 1;
+    }
+
         // When instructions are cloned, with cloneInst no sourceLoc information is copied over by default.
         // Here we attempt some policy about copying sourceLocs when inlining.
         //
@@ -377,7 +431,10 @@ struct InliningPassBase
         // serialization.
         // 
         // For now this punts on this, and just assumes [__unsafeForceInlineEarly] is not in user code.
-    static IRInst* _cloneInstWithSourceLoc(CallSiteInfo const& callSite,
+        //
+        // Passes that inline user code (where diagnostics from downstream compilers should point
+        // into the callee) can clear `m_preferCallSiteSourceLoc` to prefer the loc of the original instruction.
+    IRInst* _cloneInstWithSourceLoc(CallSiteInfo const& callSite,
         IRCloneEnv*     env,
         IRBuilder*      builder,
         IRInst*         inst)
@@ -386,7 +443,11 @@ struct InliningPassBase
 
         SourceLoc sourceLoc;
 
-        if (callSite.call->sourceLoc.isValid())
+        if (!m_preferCallSiteSourceLoc && inst->sourceLoc.isValid())
+        {
+            sourceLoc = inst->sourceLoc;
+        }
+        else if (callSite.call->sourceLoc.isValid())
         {
             // Default to using the source loc at the call site
             sourceLoc = callSite.call->sourceLoc;
@@ -469,6 +530,136 @@ struct InliningPassBase
         //
         call->removeAndDeallocate();
     }
+
+        /// Inline the body of the callee for `callSite`, where the callee passes `isSingleReturnFunc`
+    void inlineSingleReturnFuncBody(CallSiteInfo const& callSite, IRCloneEnv* env, IRBuilder* builder)
+    {
+        auto call = callSite.call;
+        auto callee = callSite.callee;
+        auto callBlock = as<IRBlock>(call->getParent());
+        SLANG_ASSERT(callBlock);
+
+        // We start by splitting the block that contains the call,
+        // so that everything after the `call` (including the
+        // terminator) moves to a new block that the inlined
+        // body will branch to when it is done.
+        //
+        auto afterBlock = builder->createBlock();
+        afterBlock->insertAfter(callBlock);
+
+        // If the callee returns a value, it gets passed along to
+        // the new block as an argument to the branch, so that
+        // it can replace the `call`.
+        //
+        builder->setInsertInto(afterBlock);
+        IRParam* resultParam = nullptr;
+        if( !as<IRVoidType>(call->getDataType()) )
+        {
+            resultParam = builder->emitParam(call->getFullType());
+        }
+
+        {
+            IRInst* next = nullptr;
+            for( auto inst = call->getNextInst(); inst; inst = next )
+            {
+                next = inst->getNextInst();
+                inst->insertAtEnd(afterBlock);
+            }
+        }
+
+        // Next we create all of the blocks for the cloned body up
+        // front, so that branches can refer to blocks that come
+        // later in the function. The blocks are placed in order
+        // between the call block and the continuation.
+        //
+        auto entryBlock = callee->getFirstBlock();
+        IRInst* prevBlock = callBlock;
+        List<IRBlock*> newBlocks;
+        for( auto block : callee->getBlocks() )
+        {
+            auto newBlock = builder->createBlock();
+            newBlock->insertAfter(prevBlock);
+            prevBlock = newBlock;
+
+            env->mapOldValToNew.Add(block, newBlock);
+            newBlocks.add(newBlock);
+        }
+
+        // Now we can clone the instructions into each block. The
+        // parameters of the entry block are the parameters of the
+        // callee, which have already been mapped to the arguments,
+        // while the one `return` turns into a branch to `afterBlock`.
+        //
+        List<IRInst*> clonedInsts;
+        Index blockIndex = 0;
+        for( auto block : callee->getBlocks() )
+        {
+            builder->setInsertInto(newBlocks[blockIndex++]);
+
+            for( auto inst : block->getChildren() )
+            {
+                switch( inst->getOp() )
+                {
+                case kIROp_Param:
+                    if( block != entryBlock )
+                    {
+                        clonedInsts.add(_cloneInstWithSourceLoc(callSite, env, builder, inst));
+                    }
+                    break;
+
+                case kIROp_ReturnVoid:
+                    builder->emitBranch(afterBlock);
+                    break;
+
+                case kIROp_ReturnVal:
+                    {
+                        IRInst* args[] = { afterBlock, findCloneForOperand(env, inst->getOperand(0)) };
+                        clonedInsts.add(builder->emitIntrinsicInst(
+                            builder->getVoidType(),
+                            kIROp_unconditionalBranch,
+                            SLANG_COUNT_OF(args),
+                            args));
+                    }
+                    break;
+
+                default:
+                    clonedInsts.add(_cloneInstWithSourceLoc(callSite, env, builder, inst));
+                    break;
+                }
+            }
+        }
+
+        // The order of blocks isn't required to follow dominance, so an
+        // instruction may have been cloned before (the clone of) one of
+        // its operands. Any such operand is fixed up now that everything
+        // has been cloned.
+        //
+        for( auto inst : clonedInsts )
+        {
+            const UInt operandCount = inst->getOperandCount();
+            for( UInt i = 0; i < operandCount; ++i )
+            {
+                auto operand = inst->getOperand(i);
+                if( auto newOperand = lookUp(env, operand) )
+                {
+                    inst->setOperand(i, newOperand);
+                }
+            }
+        }
+
+        if( resultParam )
+        {
+            call->replaceUsesWith(resultParam);
+        }
+
+        // Finally the call site itself is replaced with a branch
+        // into the inlined body.
+        //
+        builder->setInsertBefore(call);
+        builder->emitBranch(newBlocks[0]);
+
+        call->removeAndDeallocate();
+    }
 };
 
     /// An inlining pass that inlines calls to `[unsafeForceInlineEarly]` functions
@@ -495,4 +686,233 @@ void performMandatoryEarlyInlining(IRModule* module)
     pass.considerAllCallSites();
 }
 
+    /// An inlining pass that inlines small functions, and functions with a single call site,
+    /// based on the limits in an `InliningOptions`
+struct CostModelInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    InliningOptions m_options;
+
+        /// The function that contains the call sites currently being considered
+    IRFunc* m_caller = nullptr;
+
+        /// The number of instructions in the body of `m_caller`, updated as calls are inlined
+    Index m_callerInstCount = 0;
+
+        /// Cached instruction counts for functions that have already been processed
+    Dictionary<IRFunc*, Index> m_instCounts;
+
+        /// The number of call sites inlined so far
+    Index m_inlinedCount = 0;
+
+    CostModelInliningPass(IRModule* module, InliningOptions const& options)
+        : Super(module)
+        , m_options(options)
+    {
+        // Unlike `[__unsafeForceInlineEarly]` functions, the callees here are
+        // typically user code, so the inlined code keeps its own locations.
+        m_preferCallSiteSourceLoc = false;
+    }
+
+    static Index _countInsts(IRFunc* func)
+    {
+        Index count = 0;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                SLANG_UNUSED(inst);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    Index _getInstCount(IRFunc* func)
+    {
+        Index count = 0;
+        if( !m_instCounts.TryGetValue(func, count) )
+        {
+            count = _countInsts(func);
+            m_instCounts.Add(func, count);
+        }
+        return count;
+    }
+
+        /// Returns true if the only uses of `func` are as the callee of a single `call`
+    static bool _hasSingleCallSite(IRFunc* func)
+    {
+        auto use = func->firstUse;
+        if( !use || use->nextUse )
+            return false;
+
+        auto call = as<IRCall>(use->getUser());
+        return call && call->getCallee() == func;
+    }
+
+        /// Returns true if `func` has a decoration that inlining would lose, or that asks for it not to be inlined
+    static bool _hasBlockingDecoration(IRFunc* func)
+    {
+        for( auto decoration : func->getDecorations() )
+        {
+            switch( decoration->getOp() )
+            {
+            case kIROp_NoInlineDecoration:
+            case kIROp_EntryPointDecoration:
+            case kIROp_RequireSPIRVVersionDecoration:
+            case kIROp_RequireGLSLVersionDecoration:
+            case kIROp_RequireGLSLExtensionDecoration:
+            case kIROp_RequireCUDASMVersionDecoration:
+            case kIROp_RequiresNVAPIDecoration:
+            case kIROp_RequiresQuadDecoration:
+                return true;
+
+            default:
+                if( as<IRTargetSpecificDecoration>(decoration) )
+                    return true;
+                break;
+            }
+        }
+        return false;
+    }
+
+    bool shouldInline(CallSiteInfo const& callSite)
+    {
+        auto callee = callSite.callee;
+
+        // Recursive calls are never inlined, as doing so would never terminate
+        // (calls that only become recursive once something else is inlined are
+        // safe, because cloned call sites aren't reconsidered).
+        //
+        if( callee == m_caller )
+            return false;
+
+        if( _hasBlockingDecoration(callee) )
+            return false;
+
+        // We only handle callees that can be inlined without disturbing the
+        // structured control flow of the caller.
+        //
+        if( !isTrivialFunc(callee) && !isSingleReturnFunc(callee) )
+            return false;
+
+        const Index calleeInstCount = _getInstCount(callee);
+
+        // Inlining a function that is only called once doesn't grow the
+        // code as a whole, so a larger limit applies.
+        //
+        Index maxInstCount = m_options.maxCalleeInstCount;
+        if( !callSite.specialize && _hasSingleCallSite(callee) )
+        {
+            maxInstCount = Math::Max(maxInstCount, m_options.maxSingleCallSiteCalleeInstCount);
+        }
+        if( calleeInstCount > maxInstCount )
+            return false;
+
+        if( m_callerInstCount + calleeInstCount > m_options.maxCallerInstCount )
+            return false;
+
+        return true;
+    }
+
+        /// Visit `func`, and any functions it calls, such that callees are processed before their callers
+    void _addFuncsInCallOrderRec(IRFunc* func, HashSet<IRFunc*>& ioVisited, List<IRFunc*>& ioOrder)
+    {
+        if( !ioVisited.Add(func) )
+            return;
+
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                auto call = as<IRCall>(inst);
+                if( !call )
+                    continue;
+
+                CallSiteInfo callSite;
+                if( canInline(call, callSite) )
+                {
+                    _addFuncsInCallOrderRec(callSite.callee, ioVisited, ioOrder);
+                }
+            }
+        }
+
+        ioOrder.add(func);
+    }
+
+    void _considerCallSitesInFunc(IRFunc* func)
+    {
+        m_caller = func;
+        m_callerInstCount = _countInsts(func);
+
+        // The call sites are gathered first, because inlining splits
+        // blocks and so changes the instructions we would be iterating.
+        //
+        List<IRCall*> calls;
+        for( auto block : func->getBlocks() )
+        {
+            for( auto inst : block->getChildren() )
+            {
+                if( auto call = as<IRCall>(inst) )
+                    calls.add(call);
+            }
+        }
+
+        for( auto call : calls )
+        {
+            CallSiteInfo callSite;
+            if( !canInline(call, callSite) || !shouldInline(callSite) )
+                continue;
+
+            const Index calleeInstCount = _getInstCount(callSite.callee);
+            inlineCallSite(callSite);
+
+            m_callerInstCount += calleeInstCount;
+            m_inlinedCount++;
+        }
+
+        // The body has changed, so any cached count is stale.
+        //
+        m_instCounts[func] = m_callerInstCount;
+        m_caller = nullptr;
+    }
+
+        /// Consider all call sites in the module, working bottom up through the call graph
+    void considerAllCallSitesBottomUp()
+    {
+        HashSet<IRFunc*> visited;
+        List<IRFunc*> order;
+        for( auto inst : m_module->getGlobalInsts() )
+        {
+            auto func = as<IRFunc>(inst);
+            if( !func )
+            {
+                // Functions nested in generics are reached through
+                // their call sites, and are otherwise of no interest
+                // as they will be specialized away.
+                //
+                continue;
+            }
+            if( func->getFirstBlock() )
+                _addFuncsInCallOrderRec(func, visited, order);
+        }
+
+        for( auto func : order )
+        {
+            _considerCallSitesInFunc(func);
+        }
+    }
+};
+
+Index performCostModelInlining(IRModule* module, InliningOptions const& options)
+{
+    if( !options.isEnabled() )
+        return 0;
+
+    CostModelInliningPass pass(module, options);
+    pass.considerAllCallSitesBottomUp();
+    return pass.m_inlinedCount;
+}
+
 } // namespace Slang
@@ -1,10 +1,37 @@
 // slang-ir-inline.h
 #pragma once
 
+#include "../core/slang-basic.h"
+
 namespace Slang
 {
     struct IRModule;
 
+        /// Limits used by `performCostModelInlining` to decide which call sites to inline.
+        ///
+        /// Sizes are measured in IR instructions in the body of a function.
+    struct InliningOptions
+    {
+            /// Callees at most this size are inlined at every call site
+        Index maxCalleeInstCount = 0;
+            /// Callees that are only called from one place are inlined if at most this size
+        Index maxSingleCallSiteCalleeInstCount = 0;
+            /// No more calls are inlined into a caller once it grows past this size
+        Index maxCallerInstCount = 0;
+
+        bool isEnabled() const { return maxCallerInstCount > 0 && (maxCalleeInstCount > 0 || maxSingleCallSiteCalleeInstCount > 0); }
+    };
+
         /// Inline any call sites to functions marked `[unsafeForceInlineEarly]`
     void performMandatoryEarlyInlining(IRModule* module);
+
+        /// Inline call sites chosen by a cost model based on the size of the callee
+        /// and its number of call sites, using the limits in `options`.
+        ///
+        /// Callees are processed before their callers, so that the size of a callee
+        /// reflects any inlining into it. Only callees whose control flow can be
+        /// inlined while keeping the caller structured are considered.
+        ///
+        /// Returns the number of call sites inlined.
+    Index performCostModelInlining(IRModule* module, InliningOptions const& options);
 }
@@ -602,6 +602,9 @@ INST(HighLevelDeclDecoration,               highLevelDecl,          1, 0)
         /// The decorated instruction requires NVAPI to be included via prelude when compiling for D3D.
     INST(RequiresNVAPIDecoration, requiresNVAPI, 0, 0)
 
+        /// The decorated instruction needs quad execution when compiling for CPU.
+    INST(RequiresQuadDecoration, requiresQuad, 0, 0)
+
         /// The decorated instruction is part of the NVAPI "magic" and should always use its original name
     INST(NVAPIMagicDecoration, nvapiMagic, 1, 0)
 
@@ -609,6 +612,9 @@ INST(HighLevelDeclDecoration,               highLevelDecl,          1, 0)
         /// that the NVAPI shader parameter intends to use.
     INST(NVAPISlotDecoration, nvapiSlot, 2, 0)
 
+        /// The decorated buffer or array access has an index that is proven to be in bounds, so doesn't need to be checked.
+    INST(InBoundsDecoration, inBounds, 0, 0)
+
         /// Applie to an IR function and signals that inlining should not be performed unless unavoidable.
     INST(NoInlineDecoration, noInline, 0, 0)
 
@@ -666,7 +672,8 @@ INST(GetEquivalentStructuredBuffer,     getEquivalentStructuredBuffer, 1, 0)
     /* TypeLayout */
         INST(TypeLayoutBase, typeLayout, 0, 0)
         INST(ParameterGroupTypeLayout, parameterGroupTypeLayout, 2, 0)
-        INST(ArrayTypeLayout, arrayTypeLayout, 1, 0)
+        INST(ArrayTypeLayout, arrayTypeLayout, 2, 0)
+        INST(StructuredBufferTypeLayout, structuredBufferTypeLayout, 2, 0)
         INST(StreamOutputTypeLayout, streamOutputTypeLayout, 1, 0)
         INST(MatrixTypeLayout, matrixTypeLayout, 1, 0)
         INST(TaggedUnionTypeLayout, taggedUnionTypeLayout, 0, 0)
@@ -268,6 +268,8 @@ IR_SIMPLE_DECORATION(PreciseDecoration)
 IR_SIMPLE_DECORATION(PublicDecoration)
 IR_SIMPLE_DECORATION(KeepAliveDecoration)
 IR_SIMPLE_DECORATION(RequiresNVAPIDecoration)
+IR_SIMPLE_DECORATION(RequiresQuadDecoration)
+IR_SIMPLE_DECORATION(InBoundsDecoration)
 IR_SIMPLE_DECORATION(NoInlineDecoration)
 
 struct IRNVAPIMagicDecoration : IRDecoration
@@ -866,6 +868,12 @@ struct IRArrayTypeLayout : IRTypeLayout
         return cast<IRTypeLayout>(getOperand(0));
     }
 
+        /// Get the distance in bytes between the starts of consecutive elements in uniform storage
+    IRIntegerValue getUniformStride()
+    {
+        return getIntVal(getOperand(1));
+    }
+
     struct Builder : Super::Builder
     {
         Builder(IRBuilder* irBuilder, IRTypeLayout* elementTypeLayout)
@@ -873,6 +881,12 @@ struct IRArrayTypeLayout : IRTypeLayout
             , m_elementTypeLayout(elementTypeLayout)
         {}
 
+            /// Set the uniform stride, for arrays that hold uniform data
+        void setUniformStride(IRIntegerValue stride)
+        {
+            m_uniformStride = stride;
+        }
+
         IRArrayTypeLayout* build()
         {
             return cast<IRArrayTypeLayout>(Super::Builder::build());
@@ -883,6 +897,48 @@ struct IRArrayTypeLayout : IRTypeLayout
         void addOperandsImpl(List<IRInst*>& ioOperands) SLANG_OVERRIDE;
 
         IRTypeLayout* m_elementTypeLayout;
+        IRIntegerValue m_uniformStride = 0;
+    };
+};
+
+    /// Specialized layout information for structured buffer types
+struct IRStructuredBufferTypeLayout : IRTypeLayout
+{
+    typedef IRTypeLayout Super;
+
+    IR_LEAF_ISA(StructuredBufferTypeLayout)
+
+        /// Get the layout of the elements of the buffer
+    IRTypeLayout* getElementTypeLayout()
+    {
+        return cast<IRTypeLayout>(getOperand(0));
+    }
+
+        /// Get the distance in bytes between the starts of consecutive elements of the buffer
+    IRIntegerValue getElementStride()
+    {
+        return getIntVal(getOperand(1));
+    }
+
+    struct Builder : Super::Builder
+    {
+        Builder(IRBuilder* irBuilder, IRTypeLayout* elementTypeLayout, IRIntegerValue elementStride)
+            : Super::Builder(irBuilder)
+            , m_elementTypeLayout(elementTypeLayout)
+            , m_elementStride(elementStride)
+        {}
+
+        IRStructuredBufferTypeLayout* build()
+        {
+            return cast<IRStructuredBufferTypeLayout>(Super::Builder::build());
+        }
+
+    protected:
+        IROp getOp() SLANG_OVERRIDE { return kIROp_StructuredBufferTypeLayout; }
+        void addOperandsImpl(List<IRInst*>& ioOperands) SLANG_OVERRIDE;
+
+        IRTypeLayout* m_elementTypeLayout;
+        IRIntegerValue m_elementStride;
     };
 };
 
@@ -0,0 +1,701 @@
+// slang-ir-loop-opt.cpp
+#include "slang-ir-loop-opt.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-cse.h"
+
+namespace Slang
+{
+
+// This file implements optimizations on the loops in function bodies.
+//
+// After SSA construction a `for` loop such as:
+//
+//      for (int i = 0; i < 4; i++) { ... }
+//
+// has the form:
+//
+//      preheader:
+//          loop(header, break, continue, 0)
+//      header(param i : Int):
+//          let c = cmpLT(i, 4)
+//          ifElse(c, body, break, body)
+//      body:
+//          ...
+//          unconditionalBranch(continue)
+//      continue:
+//          let next = add(i, 1)
+//          unconditionalBranch(header, next)
+//      break:
+//          ...
+//
+// The blocks of the loop are those that can be reached from the
+// header without going through the break block.
+
+    /// Returns `inst` as a loop if it is a `loop` instruction, else nullptr
+    ///
+    /// `IRLoop` shares the type test of `IRUnconditionalBranch`, so `as<IRLoop>`
+    /// can't be used to tell the two apart.
+static IRLoop* _asLoop(IRInst* inst)
+{
+    return (inst && inst->getOp() == kIROp_loop) ? static_cast<IRLoop*>(inst) : nullptr;
+}
+
+    /// Gather the blocks of the loop started by `loopInst`, in the order they appear in the function
+static void _collectLoopBlocks(IRLoop* loopInst, List<IRBlock*>& outBlocks, HashSet<IRBlock*>& outBlockSet)
+{
+    outBlocks.clear();
+    outBlockSet.Clear();
+
+    auto breakBlock = loopInst->getBreakBlock();
+
+    // Every block referenced by a terminator is followed (and not just the
+    // successors), so that blocks only referenced as (say) the break block of
+    // a nested loop that never exits are included.
+    List<IRBlock*> workList;
+    workList.add(loopInst->getTargetBlock());
+    outBlockSet.Add(loopInst->getTargetBlock());
+    while (workList.getCount())
+    {
+        auto block = workList.getLast();
+        workList.removeLast();
+
+        auto terminator = block->getTerminator();
+        if (!terminator)
+            continue;
+
+        for (UInt i = 0; i < terminator->getOperandCount(); ++i)
+        {
+            auto target = as<IRBlock>(terminator->getOperand(i));
+            if (!target || target == breakBlock || outBlockSet.Contains(target))
+                continue;
+            outBlockSet.Add(target);
+            workList.add(target);
+        }
+    }
+
+    auto func = loopInst->getParent()->getParent();
+    for (auto child : func->getChildren())
+    {
+        auto block = as<IRBlock>(child);
+        if (block && outBlockSet.Contains(block))
+            outBlocks.add(block);
+    }
+}
+
+    /// Gather all of the `loop` instructions in `code`, with inner loops before the loops containing them
+static void _collectLoops(IRGlobalValueWithCode* code, List<IRLoop*>& outLoops)
+{
+    // A nested loop appears after the loop that contains it, so
+    // going through the blocks backwards visits inner loops first.
+    outLoops.clear();
+    for (auto block = code->getLastBlock(); block; block = block->getPrevBlock())
+    {
+        if (auto loopInst = _asLoop(block->getTerminator()))
+            outLoops.add(loopInst);
+    }
+}
+
+    /// Returns true if every use of `block` is from `loopInst`, or from the terminators of blocks in `blockSet`
+static bool _isOnlyUsedInLoop(IRBlock* block, IRLoop* loopInst, HashSet<IRBlock*> const& blockSet)
+{
+    for (auto use = block->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        if (user == loopInst)
+            continue;
+        auto userBlock = as<IRBlock>(user->getParent());
+        if (!userBlock || !blockSet.Contains(userBlock))
+            return false;
+    }
+    return true;
+}
+
+    /// Count the number of uses of `block` by the terminators of blocks in `blockSet`
+static Index _countUsesInLoop(IRBlock* block, HashSet<IRBlock*> const& blockSet)
+{
+    Index count = 0;
+    for (auto use = block->firstUse; use; use = use->nextUse)
+    {
+        auto userBlock = as<IRBlock>(use->getUser()->getParent());
+        if (userBlock && blockSet.Contains(userBlock))
+            ++count;
+    }
+    return count;
+}
+
+struct LoopUnrollContext
+{
+        /// Loops that would need more iterations than this aren't unrolled
+    static const Index kMaxTripCount = 64;
+
+        /// Loops that would need more instructions than this when unrolled aren't unrolled
+    static const Index kMaxUnrolledInstCount = 2048;
+
+    SharedIRBuilder* m_sharedBuilder = nullptr;
+
+        /// Information about a loop that can be unrolled
+    struct LoopInfo
+    {
+        IRLoop* loopInst = nullptr;
+        IRBlock* headerBlock = nullptr;
+        IRBlock* continueBlock = nullptr;
+        IRBlock* breakBlock = nullptr;
+
+            /// The first block of the loop body (the target of the header when the condition holds)
+        IRBlock* bodyBlock = nullptr;
+
+            /// The blocks of the loop, in function order
+        List<IRBlock*> blocks;
+        HashSet<IRBlock*> blockSet;
+
+            /// The number of times the body is executed
+        Index tripCount = 0;
+    };
+
+        /// Get the value of `inst` if it is an integer constant (possibly wrapped in a `construct`)
+    static bool _getConstantValue(IRInst* inst, IRIntegerValue& outValue)
+    {
+        if (inst->getOp() == kIROp_Construct && inst->getOperandCount() == 1)
+            inst = inst->getOperand(0);
+
+        if (auto intLit = as<IRIntLit>(inst))
+        {
+            outValue = intLit->getValue();
+            return true;
+        }
+        return false;
+    }
+
+        /// Evaluate comparison `op` on `left` and `right`
+    static bool _evalCompare(IROp op, IRIntegerValue left, IRIntegerValue right, bool& outResult)
+    {
+        switch (op)
+        {
+            case kIROp_Less:    outResult = left < right; return true;
+            case kIROp_Leq:     outResult = left <= right; return true;
+            case kIROp_Greater: outResult = left > right; return true;
+            case kIROp_Geq:     outResult = left >= right; return true;
+            case kIROp_Neq:     outResult = left != right; return true;
+            case kIROp_Eql:     outResult = left == right; return true;
+            default:            return false;
+        }
+    }
+
+        /// Work out how many times the loop in `info` runs, returning false if it isn't a known constant
+    static bool _computeTripCount(LoopInfo& info, IRInst* condition, bool continueOnTrue)
+    {
+        if (condition->getParent() != info.headerBlock || condition->getOperandCount() != 2)
+            return false;
+
+        // One side of the comparison must be a parameter of the header,
+        // and the other a constant.
+        auto param = as<IRParam>(condition->getOperand(0));
+        auto limitInst = condition->getOperand(1);
+        bool paramOnLeft = true;
+        if (!param || param->getParent() != info.headerBlock)
+        {
+            param = as<IRParam>(condition->getOperand(1));
+            limitInst = condition->getOperand(0);
+            paramOnLeft = false;
+            if (!param || param->getParent() != info.headerBlock)
+                return false;
+        }
+
+        IRIntegerValue limit = 0;
+        if (!_getConstantValue(limitInst, limit))
+            return false;
+
+        // Only 32-bit integers are handled, and the simulation is done with
+        // 64-bit values so that overflow (which would mean the loop
+        // depends on wrap-around) can be detected.
+        IRIntegerValue minValue = 0;
+        IRIntegerValue maxValue = 0;
+        switch (param->getDataType()->getOp())
+        {
+            case kIROp_IntType:
+                minValue = IRIntegerValue(INT32_MIN);
+                maxValue = IRIntegerValue(INT32_MAX);
+                break;
+            case kIROp_UIntType:
+                minValue = 0;
+                maxValue = IRIntegerValue(UINT32_MAX);
+                break;
+            default:
+                return false;
+        }
+
+        // Find the index of the parameter, to find its initial value and its
+        // value on the next iteration.
+        UInt paramIndex = 0;
+        for (auto p : info.headerBlock->getParams())
+        {
+            if (p == param)
+                break;
+            ++paramIndex;
+        }
+
+        auto backEdge = as<IRUnconditionalBranch>(info.continueBlock->getTerminator());
+        if (paramIndex >= info.loopInst->getArgCount() || paramIndex >= backEdge->getArgCount())
+            return false;
+
+        IRIntegerValue value = 0;
+        if (!_getConstantValue(info.loopInst->getArg(paramIndex), value))
+            return false;
+
+        auto stepInst = backEdge->getArg(paramIndex);
+        if (stepInst->getOperandCount() != 2)
+            return false;
+
+        IRIntegerValue step = 0;
+        switch (stepInst->getOp())
+        {
+            case kIROp_Add:
+                if (stepInst->getOperand(0) == param && _getConstantValue(stepInst->getOperand(1), step))
+                    break;
+                if (stepInst->getOperand(1) == param && _getConstantValue(stepInst->getOperand(0), step))
+                    break;
+                return false;
+            case kIROp_Sub:
+                if (stepInst->getOperand(0) == param && _getConstantValue(stepInst->getOperand(1), step))
+                {
+                    step = -step;
+                    break;
+                }
+                return false;
+            default:
+                return false;
+        }
+
+        Index tripCount = 0;
+        for (;;)
+        {
+            if (value < minValue || value > maxValue)
+                return false;
+
+            bool result = false;
+            if (!_evalCompare(condition->getOp(), paramOnLeft ? value : limit, paramOnLeft ? limit : value, result))
+                return false;
+            if (result != continueOnTrue)
+                break;
+
+            if (++tripCount > kMaxTripCount)
+                return false;
+            value += step;
+        }
+
+        info.tripCount = tripCount;
+        return true;
+    }
+
+        /// Returns true if the loop started by `loopInst` can be unrolled, filling in `outInfo`
+    static bool _canUnroll(IRLoop* loopInst, LoopInfo& outInfo)
+    {
+        auto loopControl = loopInst->findDecoration<IRLoopControlDecoration>();
+        if (!loopControl || loopControl->getMode() != kIRLoopControl_Unroll)
+            return false;
+
+        outInfo.loopInst = loopInst;
+        outInfo.headerBlock = loopInst->getTargetBlock();
+        outInfo.continueBlock = loopInst->getContinueBlock();
+        outInfo.breakBlock = loopInst->getBreakBlock();
+
+        auto headerBlock = outInfo.headerBlock;
+        auto continueBlock = outInfo.continueBlock;
+        auto breakBlock = outInfo.breakBlock;
+        if (continueBlock == headerBlock || breakBlock == headerBlock)
+            return false;
+
+        // The header tests the condition, and exits to the break block when it fails
+        auto headerBranch = as<IRConditionalBranch>(headerBlock->getTerminator());
+        if (!headerBranch)
+            return false;
+
+        bool continueOnTrue = true;
+        if (headerBranch->getFalseBlock() == breakBlock && headerBranch->getTrueBlock() != breakBlock)
+        {
+            outInfo.bodyBlock = headerBranch->getTrueBlock();
+        }
+        else if (headerBranch->getTrueBlock() == breakBlock && headerBranch->getFalseBlock() != breakBlock)
+        {
+            outInfo.bodyBlock = headerBranch->getFalseBlock();
+            continueOnTrue = false;
+        }
+        else
+        {
+            return false;
+        }
+        if (auto ifElse = as<IRIfElse>(headerBranch))
+        {
+            if (ifElse->getAfterBlock() != outInfo.bodyBlock)
+                return false;
+        }
+
+        // The continue block goes straight back to the header
+        auto backEdge = as<IRUnconditionalBranch>(continueBlock->getTerminator());
+        if (!backEdge || _asLoop(backEdge) || backEdge->getTargetBlock() != headerBlock)
+            return false;
+
+        _collectLoopBlocks(loopInst, outInfo.blocks, outInfo.blockSet);
+        if (!outInfo.blockSet.Contains(continueBlock))
+            return false;
+
+        // A `break` would branch to the break block from inside the loop, and
+        // a `continue` would add another branch to the continue block. Neither
+        // is supported, so the break block must only be reached from the header,
+        // and the continue block only along the normal path through the body.
+        for (auto use = breakBlock->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (user != loopInst && user != headerBranch)
+                return false;
+        }
+        if (_countUsesInLoop(continueBlock, outInfo.blockSet) != 1)
+            return false;
+        for (auto use = headerBlock->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (user != loopInst && user != backEdge)
+                return false;
+        }
+
+        // Nothing outside of the loop can branch into it
+        for (auto block : outInfo.blocks)
+        {
+            if (!_isOnlyUsedInLoop(block, loopInst, outInfo.blockSet))
+                return false;
+            for (auto decoration : block->getDecorations())
+            {
+                SLANG_UNUSED(decoration);
+                return false;
+            }
+        }
+
+        // Values computed in the loop body can only be used inside the loop,
+        // but values computed in the header are also available after it.
+        for (auto block : outInfo.blocks)
+        {
+            if (block == headerBlock)
+                continue;
+            for (auto inst : block->getChildren())
+            {
+                for (auto use = inst->firstUse; use; use = use->nextUse)
+                {
+                    auto userBlock = as<IRBlock>(use->getUser()->getParent());
+                    if (!userBlock || !outInfo.blockSet.Contains(userBlock))
+                        return false;
+                }
+            }
+        }
+
+        if (!_computeTripCount(outInfo, headerBranch->getCondition(), continueOnTrue))
+            return false;
+
+        Index instCount = 0;
+        for (auto block : outInfo.blocks)
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                ++instCount;
+            }
+        }
+        if (instCount * (outInfo.tripCount + 1) > kMaxUnrolledInstCount)
+            return false;
+
+        return true;
+    }
+
+        /// Clone `inst`, keeping its source location
+    static IRInst* _cloneInst(IRCloneEnv* env, IRBuilder* builder, IRInst* inst)
+    {
+        auto clonedInst = cloneInst(env, builder, inst);
+        clonedInst->sourceLoc = inst->sourceLoc;
+        return clonedInst;
+    }
+
+        /// Clone the non-parameter, non-terminator instructions of `block` into the block `builder` is inserting into
+    static void _cloneOrdinaryInsts(IRCloneEnv* env, IRBuilder* builder, IRBlock* block)
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (as<IRParam>(inst) || as<IRTerminatorInst>(inst))
+                continue;
+            _cloneInst(env, builder, inst);
+        }
+    }
+
+    void _unroll(LoopInfo& info)
+    {
+        IRBuilder builder;
+        builder.sharedBuilder = m_sharedBuilder;
+
+        auto preheaderBlock = as<IRBlock>(info.loopInst->getParent());
+        auto headerBlock = info.headerBlock;
+
+        // The values of the header parameters for the current iteration
+        List<IRInst*> paramValues;
+        for (UInt i = 0; i < info.loopInst->getArgCount(); ++i)
+            paramValues.add(info.loopInst->getArg(i));
+
+        // Each iteration begins with a copy of the header, with the
+        // parameters replaced by the values for that iteration.
+        auto iterHeaderBlock = builder.createBlock();
+        iterHeaderBlock->insertAfter(preheaderBlock);
+        IRBlock* lastBlock = iterHeaderBlock;
+
+        builder.setInsertBefore(info.loopInst);
+        builder.emitBranch(iterHeaderBlock);
+        info.loopInst->removeAndDeallocate();
+        info.loopInst = nullptr;
+
+        for (Index iter = 0; iter <= info.tripCount; ++iter)
+        {
+            IRCloneEnv env;
+
+            Index paramIndex = 0;
+            for (auto param : headerBlock->getParams())
+                env.mapOldValToNew.Add(param, paramValues[paramIndex++]);
+
+            builder.setInsertInto(iterHeaderBlock);
+            _cloneOrdinaryInsts(&env, &builder, headerBlock);
+
+            if (iter == info.tripCount)
+            {
+                // The condition fails on the last copy of the header, and so
+                // the loop exits. Anything after the loop that used a value
+                // computed in the header uses the value from this last copy.
+                builder.emitBranch(info.breakBlock);
+
+                for (auto inst : headerBlock->getChildren())
+                {
+                    IRInst* newInst = nullptr;
+                    if (env.mapOldValToNew.TryGetValue(inst, newInst))
+                        inst->replaceUsesWith(newInst);
+                }
+                break;
+            }
+
+            // Blocks are created up front, as branches can refer to blocks
+            // that come later in the loop.
+            List<IRBlock*> newBlocks;
+            for (auto block : info.blocks)
+            {
+                if (block == headerBlock)
+                {
+                    newBlocks.add(nullptr);
+                    continue;
+                }
+                auto newBlock = builder.createBlock();
+                newBlock->insertAfter(lastBlock);
+                lastBlock = newBlock;
+                env.mapOldValToNew.Add(block, newBlock);
+                newBlocks.add(newBlock);
+            }
+
+            builder.setInsertInto(iterHeaderBlock);
+            builder.emitBranch(as<IRBlock>(lookUp(&env, info.bodyBlock)));
+
+            auto nextHeaderBlock = builder.createBlock();
+            nextHeaderBlock->insertAfter(lastBlock);
+            lastBlock = nextHeaderBlock;
+
+            List<IRInst*> clonedInsts;
+            for (Index i = 0; i < info.blocks.getCount(); ++i)
+            {
+                auto block = info.blocks[i];
+                if (block == headerBlock)
+                    continue;
+
+                builder.setInsertInto(newBlocks[i]);
+                for (auto inst : block->getChildren())
+                {
+                    if (block == info.continueBlock && inst == block->getTerminator())
+                    {
+                        // The back edge goes to the next iteration instead, which
+                        // takes its parameter values from the arguments.
+                        auto backEdge = as<IRUnconditionalBranch>(inst);
+                        for (UInt a = 0; a < backEdge->getArgCount(); ++a)
+                            paramValues[a] = backEdge->getArg(a);
+                        builder.emitBranch(nextHeaderBlock);
+                        continue;
+                    }
+                    clonedInsts.add(_cloneInst(&env, &builder, inst));
+                }
+            }
+
+            // Operands that referred to instructions later in the loop can
+            // now be mapped to the clones.
+            for (auto clonedInst : clonedInsts)
+            {
+                for (UInt i = 0; i < clonedInst->getOperandCount(); ++i)
+                {
+                    if (auto newOperand = lookUp(&env, clonedInst->getOperand(i)))
+                        clonedInst->setOperand(i, newOperand);
+                }
+            }
+            for (auto& value : paramValues)
+            {
+                if (auto newValue = lookUp(&env, value))
+                    value = newValue;
+            }
+
+            iterHeaderBlock = nextHeaderBlock;
+        }
+
+        // The original loop is no longer used
+        for (auto block : info.blocks)
+            block->removeAndDeallocateAllDecorationsAndChildren();
+        for (auto block : info.blocks)
+            block->removeAndDeallocate();
+    }
+
+    bool processFunc(IRGlobalValueWithCode* code)
+    {
+        bool changed = false;
+
+        // Loops that can't be unrolled are remembered, so that they aren't
+        // looked at again when the loops are gathered again after a change.
+        HashSet<IRLoop*> rejectedLoops;
+        List<IRLoop*> loops;
+        for (;;)
+        {
+            _collectLoops(code, loops);
+
+            bool unrolled = false;
+            for (auto loopInst : loops)
+            {
+                if (rejectedLoops.Contains(loopInst))
+                    continue;
+
+                LoopInfo info;
+                if (!_canUnroll(loopInst, info))
+                {
+                    rejectedLoops.Add(loopInst);
+                    continue;
+                }
+
+                // Unrolling an inner loop makes new blocks (and instructions) in the
+                // loops around it, so the loops are gathered again.
+                _unroll(info);
+                unrolled = true;
+                break;
+            }
+            if (!unrolled)
+                break;
+            changed = true;
+        }
+        return changed;
+    }
+};
+
+bool unrollLoops(IRModule* module)
+{
+    SharedIRBuilder sharedBuilder(module);
+
+    LoopUnrollContext context;
+    context.m_sharedBuilder = &sharedBuilder;
+
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        // As with SSA construction we only look at code at the global scope,
+        // and not inside generics.
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            changed |= context.processFunc(code);
+        }
+    }
+    return changed;
+}
+
+    /// Hoist the loop-invariant instructions of the loop started by `loopInst` to just before it
+static bool _hoistLoopInvariantInsts(IRLoop* loopInst)
+{
+    List<IRBlock*> blocks;
+    HashSet<IRBlock*> blockSet;
+    _collectLoopBlocks(loopInst, blocks, blockSet);
+
+    // A block that isn't only reached through the loop header isn't
+    // really part of the loop.
+    for (auto block : blocks)
+    {
+        if (!_isOnlyUsedInLoop(block, loopInst, blockSet))
+            return false;
+    }
+
+    // The blocks are visited in order, so an instruction that depends on
+    // another hoisted instruction from an earlier block (or earlier in the
+    // same block) will also be hoisted.
+    bool changed = false;
+    for (auto block : blocks)
+    {
+        IRInst* next = nullptr;
+        for (auto inst = block->getFirstChild(); inst; inst = next)
+        {
+            next = inst->getNextInst();
+
+            if (!isPureComputation(inst))
+                continue;
+
+            // An instruction that only depends on constants (such as a conversion
+            // of a literal) costs nothing to leave where it is.
+            bool isInvariant = true;
+            bool isConstant = true;
+            for (UInt i = 0; i < inst->getOperandCount(); ++i)
+            {
+                auto operand = inst->getOperand(i);
+                auto operandBlock = as<IRBlock>(operand->getParent());
+                if (operandBlock && blockSet.Contains(operandBlock))
+                {
+                    isInvariant = false;
+                    break;
+                }
+                if (!as<IRConstant>(operand))
+                    isConstant = false;
+            }
+            if (!isInvariant || isConstant)
+                continue;
+
+            auto type = inst->getFullType();
+            if (type)
+            {
+                auto typeBlock = as<IRBlock>(type->getParent());
+                if (typeBlock && blockSet.Contains(typeBlock))
+                    continue;
+            }
+
+            inst->insertBefore(loopInst);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool hoistLoopInvariantInsts(IRModule* module)
+{
+    bool changed = false;
+    List<IRLoop*> loops;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            _collectLoops(code, loops);
+            for (auto loopInst : loops)
+            {
+                changed |= _hoistLoopInvariantInsts(loopInst);
+            }
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,31 @@
+// slang-ir-loop-opt.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Fully unroll loops marked `[unroll]` that have a constant trip count.
+        ///
+        /// Only loops in the simple counted form that `for` loops lower to are handled:
+        /// the loop header tests an induction variable against a constant, and the
+        /// `continue` block steps it by a constant. Loops that contain a `break` or
+        /// `continue` (other than the normal path to the next iteration) are left alone,
+        /// as are loops that would grow too large when unrolled.
+        ///
+        /// The unrolled iterations are left for SCCP to fold, so that (for example) array
+        /// indices that depended on the induction variable become constants.
+        ///
+        /// Returns true if any loop was unrolled.
+    bool unrollLoops(IRModule* module);
+
+        /// Hoist loop-invariant instructions out of loops.
+        ///
+        /// An instruction is moved to just before the loop if it is a pure computation
+        /// (see `isPureComputation`) and none of its operands are defined in the loop.
+        /// Inner loops are processed first, so an instruction can be hoisted out of
+        /// several loops.
+        ///
+        /// Returns true if any instruction was hoisted.
+    bool hoistLoopInvariantInsts(IRModule* module);
+}
@@ -2,6 +2,7 @@
 #include "slang-ir-sccp.h"
 
 #include "slang-ir.h"
+#include "slang-ir-fold.h"
 #include "slang-ir-insts.h"
 
 namespace Slang {
@@ -14,8 +15,7 @@ namespace Slang {
 //
 struct SharedSCCPContext
 {
-    IRModule*       module;
-    SharedIRBuilder sharedBuilder;
+    SharedIRBuilder* sharedBuilder;
 };
 //
 // Next we have a context struct that will be applied for each function (or other
@@ -228,6 +228,30 @@ struct SCCPContext
     IRBuilder builderStorage;
     IRBuilder* getBuilder() { return &builderStorage; }
 
+    // Try to evaluate `inst` when it is an integer operation on constant operands,
+    // returning the resulting constant (or null if it can't be folded).
+    //
+    IRInst* tryFoldIntegerInst(IRInst* inst)
+    {
+        auto resultType = inst->getDataType();
+        const Index operandCount = Index(inst->getOperandCount());
+        if( !resultType || operandCount < 1 || operandCount > 2 )
+            return nullptr;
+
+        IRIntLit* operands[2] = {};
+        for( Index i = 0; i < operandCount; ++i )
+        {
+            LatticeVal val = getLatticeVal(inst->getOperand(UInt(i)));
+            if( val.flavor != LatticeVal::Flavor::Constant )
+                return nullptr;
+
+            operands[i] = as<IRIntLit>(val.value);
+            if( !operands[i] )
+                return nullptr;
+        }
+        return tryFoldIntegerOp(getBuilder(), inst->getOp(), resultType, operands, operandCount);
+    }
+
     // In order to perform constant folding, we need to be able to
     // interpret an instruction over the lattice values.
     //
@@ -254,14 +278,12 @@ struct SCCPContext
             break;
         }
 
-        // TODO: We should now look up the lattice values for
-        // the operands of the instruction.
+        // We look up the lattice values for the operands of the instruction.
         //
         // If all of the operands have `Constant` lattice values,
         // then we can potential execute the operation directly
         // on those constant values, create a fresh `IRConstant`,
-        // and return a `Constant` lattice value for it. This
-        // would allow us to achieve true constant folding here.
+        // and return a `Constant` lattice value for it.
         //
         // Textbook discussions of SCCP often point out that it
         // is also possible to perform certain algebraic simplifications
@@ -288,14 +310,14 @@ struct SCCPContext
         // `None` inputs as producing `Any` to make sure we don't
         // optimize the code based on non-obvious assumptions.
         //
-        // For now we aren't implementing *any* folding logic here,
-        // for simplicity. This is the right place to add folding
-        // optimizations if/when we need them.
+        // For now we only fold integer arithmetic, shifts, comparisons
+        // and conversions (see `tryFoldIntegerOp`). This is enough for
+        // code where a loop counter has been replaced with constants
+        // (such as an unrolled loop) to end up indexing with constants.
         //
+        if( auto folded = tryFoldIntegerInst(inst) )
+            return LatticeVal::getConstant(folded);
 
-        // A safe default is to assume that every instruction not
-        // handled by one of the cases above could produce *any*
-        // value whatsoever.
         return LatticeVal::getAny();
     }
 
@@ -573,7 +595,7 @@ struct SCCPContext
     {
         // We start with the busy-work of setting up our IR builder.
         //
-        builderStorage.sharedBuilder = &shared->sharedBuilder;
+        builderStorage.sharedBuilder = shared->sharedBuilder;
 
         // We expect the caller to have filtered out functions with
         // no bodies, so there should always be at least one basic block.
@@ -937,14 +959,19 @@ static void applySparseConditionalConstantPropagationRec(
 
 void applySparseConditionalConstantPropagation(
     IRModule*       module)
+{
+    SharedIRBuilder sharedBuilder(module);
+    applySparseConditionalConstantPropagation(&sharedBuilder, module->getModuleInst());
+}
+
+void applySparseConditionalConstantPropagation(
+    SharedIRBuilder*    sharedBuilder,
+    IRInst*             inst)
 {
     SharedSCCPContext shared;
-    shared.module = module;
-    shared.sharedBuilder.module = module;
-    shared.sharedBuilder.session = module->getSession();
+    shared.sharedBuilder = sharedBuilder;
 
-    applySparseConditionalConstantPropagationRec(&shared, module->getModuleInst());
+    applySparseConditionalConstantPropagationRec(&shared, inst);
 }
 
 }
-
@@ -3,7 +3,9 @@
 
 namespace Slang
 {
+    struct IRInst;
     struct IRModule;
+    struct SharedIRBuilder;
 
         /// Apply Sparse Conditional Constant Propagation (SCCP) to a module.
         ///
@@ -14,5 +16,11 @@ namespace Slang
         /// becoming dead code)
     void applySparseConditionalConstantPropagation(
         IRModule*       module);
+
+        /// Apply SCCP to the code of `inst` (and any code nested within it), using
+        /// `sharedBuilder` for any values created.
+    void applySparseConditionalConstantPropagation(
+        SharedIRBuilder*    sharedBuilder,
+        IRInst*             inst);
 }
 
@@ -6,6 +6,13 @@
 
 namespace Slang
 {
+static IRIntegerValue _getSequentialID(IRWitnessTable* witnessTable)
+{
+    auto seqIdDecoration = witnessTable->findDecoration<IRSequentialIDDecoration>();
+    SLANG_ASSERT(seqIdDecoration);
+    return seqIdDecoration->getSequentialID();
+}
+
 IRFunc* specializeDispatchFunction(SharedGenericsLoweringContext* sharedContext, IRFunc* dispatchFunc)
 {
     auto witnessTableType = cast<IRFuncType>(dispatchFunc->getDataType())->getParamType(0);
@@ -87,33 +94,64 @@ IRFunc* specializeDispatchFunction(SharedGenericsLoweringContext* sharedContext,
     auto witnessTableSequentialID =
         builder->emitSwizzle(builder->getUIntType(), witnessTableParam, 1, &elemIdx);
 
-    // Generate case blocks for each possible witness table.
+    // Sort the witness tables by their sequential IDs, so that the case values of the
+    // `switch` we generate form a dense range that downstream compilers can lower into
+    // a jump table instead of a chain of comparisons.
+    witnessTables.sort(
+        [](IRWitnessTable* a, IRWitnessTable* b)
+        {
+            return _getSequentialID(a) < _getSequentialID(b);
+        });
+
+    // Witness tables that map the requirement to the same function (e.g. through a
+    // shared base implementation) are grouped into a single case block that is
+    // labeled with each of their IDs.
+    List<IRInst*> callees;
+    List<List<IRWitnessTable*>> witnessTableGroups;
+    Dictionary<IRInst*, Index> mapCalleeToGroupIndex;
+    Index groupIndex = -1;
+    for (auto witnessTable : witnessTables)
+    {
+        auto callee = sharedContext->findWitnessTableEntry(witnessTable, requirementKey);
+        SLANG_ASSERT(callee);
+        if (!mapCalleeToGroupIndex.TryGetValue(callee, groupIndex))
+        {
+            groupIndex = callees.getCount();
+            mapCalleeToGroupIndex[callee] = groupIndex;
+            callees.add(callee);
+            witnessTableGroups.add(List<IRWitnessTable*>());
+        }
+        witnessTableGroups[groupIndex].add(witnessTable);
+    }
+
+    // The group containing the last witness table is used as the `default` case.
+    Index defaultGroupIndex = groupIndex;
+
+    // Generate case blocks for each possible callee.
     List<IRInst*> caseBlocks;
-    for (Index i = 0; i < witnessTables.getCount(); i++)
+    for (Index i = 0; i < callees.getCount(); i++)
     {
-        auto witnessTable = witnessTables[i];
-        auto seqIdDecoration = witnessTable->findDecoration<IRSequentialIDDecoration>();
-        SLANG_ASSERT(seqIdDecoration);
-        
-        if (i != witnessTables.getCount() - 1)
+        builder->setInsertInto(newDispatchFunc);
+        auto caseBlock = builder->emitBlock();
+        if (i == defaultGroupIndex)
         {
-            // Create a case block if we are not the last case.
-            caseBlocks.add(seqIdDecoration->getSequentialIDOperand());
-            builder->setInsertInto(newDispatchFunc);
-            auto caseBlock = builder->emitBlock();
-            caseBlocks.add(caseBlock);
+            // Generate code for the last possible value in the `default` block.
+            defaultBlock = caseBlock;
         }
         else
         {
-            // Generate code for the last possible value in the `default` block.
-            builder->setInsertInto(newDispatchFunc);
-            defaultBlock = builder->emitBlock();
-            builder->setInsertInto(defaultBlock);
+            // Create a case for every witness table sharing this callee.
+            for (auto witnessTable : witnessTableGroups[i])
+            {
+                caseBlocks.add(
+                    witnessTable->findDecoration<IRSequentialIDDecoration>()
+                        ->getSequentialIDOperand());
+                caseBlocks.add(caseBlock);
+            }
         }
 
-        auto callee = sharedContext->findWitnessTableEntry(witnessTable, requirementKey);
-        SLANG_ASSERT(callee);
-        auto specializedCallInst = builder->emitCallInst(callInst->getFullType(), callee, params);
+        builder->setInsertInto(caseBlock);
+        auto specializedCallInst = builder->emitCallInst(callInst->getFullType(), callees[i], params);
         if (callInst->getDataType()->getOp() == kIROp_VoidType)
             builder->emitReturn();
         else
@@ -124,10 +162,9 @@ IRFunc* specializeDispatchFunction(SharedGenericsLoweringContext* sharedContext,
     // the witness table sequential ID passed in.
     builder->setInsertInto(newDispatchFunc);
 
-    
-    if (witnessTables.getCount() == 1)
+    if (callees.getCount() == 1)
     {
-        // If there is only 1 case, no switch statement is necessary.
+        // If there is only 1 possible callee, no switch statement is necessary.
         builder->setInsertInto(newBlock);
         builder->emitBranch(defaultBlock);
     }
@@ -217,6 +254,76 @@ void ensureWitnessTableSequentialIDs(SharedGenericsLoweringContext* sharedContex
     }
 }
 
+// Returns the witness table that `witnessTableArg` is known to refer to at compile time,
+// or nullptr if it can only be determined at runtime.
+static IRWitnessTable* _findConcreteWitnessTable(IRInst* witnessTableArg)
+{
+    for (;;)
+    {
+        switch (witnessTableArg->getOp())
+        {
+        case kIROp_WitnessTable:
+            return cast<IRWitnessTable>(witnessTableArg);
+        case kIROp_GetTupleElement:
+            {
+                // An existential value is lowered into a tuple of (RTTI, witness table, value),
+                // so look through to the tuple's operand if it is constructed locally.
+                auto getElement = cast<IRGetTupleElement>(witnessTableArg);
+                auto tuple = as<IRMakeTuple>(getElement->getTuple());
+                auto elementIndex = as<IRIntLit>(getElement->getElementIndex());
+                if (!tuple || !elementIndex || elementIndex->getValue() < 0 ||
+                    UInt(elementIndex->getValue()) >= tuple->getOperandCount())
+                    return nullptr;
+                witnessTableArg = tuple->getOperand(UInt(elementIndex->getValue()));
+                break;
+            }
+        default:
+            return nullptr;
+        }
+    }
+}
+
+// Replaces calls to `dispatchFunc` with direct calls to the concrete implementation
+// of `requirementKey` wherever the witness table argument can only be one table: either
+// because it is known at the call site, or because `witnessTables` has a single entry.
+void devirtualizeDispatchFuncCalls(
+    SharedGenericsLoweringContext* sharedContext,
+    IRFunc* dispatchFunc,
+    IRInst* requirementKey,
+    List<IRWitnessTable*> const& witnessTables)
+{
+    List<IRCall*> calls;
+    for (auto use = dispatchFunc->firstUse; use; use = use->nextUse)
+    {
+        auto call = as<IRCall>(use->getUser());
+        if (call && call->getCallee() == dispatchFunc && call->getArgCount() != 0)
+            calls.add(call);
+    }
+    for (auto call : calls)
+    {
+        auto witnessTable = _findConcreteWitnessTable(call->getArg(0));
+        if (!witnessTable && witnessTables.getCount() == 1)
+            witnessTable = witnessTables[0];
+        if (!witnessTable)
+            continue;
+        auto callee = sharedContext->findWitnessTableEntry(witnessTable, requirementKey);
+        if (!callee)
+            continue;
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedContext->sharedBuilderStorage;
+        builder.setInsertBefore(call);
+        List<IRInst*> args;
+        for (UInt i = 1; i < call->getArgCount(); i++)
+        {
+            args.add(call->getArg(i));
+        }
+        auto newCall = builder.emitCallInst(call->getFullType(), callee, args);
+        call->replaceUsesWith(newCall);
+        call->removeAndDeallocate();
+    }
+}
+
 // Fixes up call sites of a dispatch function, so that the witness table argument is replaced with
 // its sequential ID.
 void fixupDispatchFuncCall(SharedGenericsLoweringContext* sharedContext, IRFunc* newDispatchFunc)
@@ -263,6 +370,16 @@ void specializeDispatchFunctions(SharedGenericsLoweringContext* sharedContext)
     {
         auto dispatchFunc = kv.Value;
 
+        // Call directly into the implementation at call sites where the witness table
+        // can be determined statically.
+        auto conformanceType = cast<IRWitnessTableTypeBase>(
+            cast<IRFuncType>(dispatchFunc->getDataType())->getParamType(0))->getConformanceType();
+        devirtualizeDispatchFuncCalls(
+            sharedContext,
+            dispatchFunc,
+            kv.Key,
+            sharedContext->getWitnessTablesFromInterfaceType(conformanceType));
+
         // Generate a specialized `switch` statement based dispatch func,
         // from the witness tables present in the module.
         auto newDispatchFunc = specializeDispatchFunction(sharedContext, dispatchFunc);
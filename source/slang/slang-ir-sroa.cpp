@@ -0,0 +1,330 @@
+// slang-ir-sroa.cpp
+#include "slang-ir-sroa.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+// Scalar replacement of aggregates (SROA) takes a local variable with
+// aggregate type like:
+//
+//      var p : Ptr(Pair);
+//      let a = fieldAddress(p, Pair.a);
+//      store(a, 1);
+//      let b = fieldAddress(p, Pair.b);
+//      ...
+//
+// and replaces it with a variable per field:
+//
+//      var p_a : Ptr(Int);
+//      var p_b : Ptr(Int);
+//      store(p_a, 1);
+//      ...
+//
+// SSA construction only promotes variables that are accessed with plain
+// loads and stores, so this makes it possible for each field to become
+// an SSA value. Loads and stores of the whole aggregate are rewritten to
+// load and store each field in turn.
+
+struct SROAContext
+{
+        /// Arrays with more elements than this are left alone, as splitting them
+        /// would produce a large number of variables (and loads/stores of the
+        /// whole array would become very large).
+    static const IRIntegerValue kMaxElementCount = 16;
+
+    SharedIRBuilder* m_sharedBuilder = nullptr;
+
+        /// Variables that have been created by splitting, and may be split further
+    List<IRVar*> m_workList;
+
+    bool m_changed = false;
+
+        /// A field or element of an aggregate variable
+    struct Part
+    {
+            /// The struct key or element index
+        IRInst* key;
+        IRType* type;
+    };
+
+        /// Get the parts of `type` if variables of `type` could be split, else returns false
+    bool _getParts(IRBuilder* builder, IRType* type, List<Part>& outParts)
+    {
+        outParts.clear();
+
+        // Types that map onto a type provided by the target can't be taken apart.
+        if (type->findDecoration<IRTargetIntrinsicDecoration>())
+            return false;
+
+        if (auto structType = as<IRStructType>(type))
+        {
+            for (auto field : structType->getFields())
+            {
+                outParts.add(Part{ field->getKey(), field->getFieldType() });
+            }
+            return outParts.getCount() > 0;
+        }
+        else if (auto arrayType = as<IRArrayType>(type))
+        {
+            auto countLit = as<IRIntLit>(arrayType->getElementCount());
+            if (!countLit)
+                return false;
+
+            const IRIntegerValue count = countLit->getValue();
+            if (count <= 0 || count > kMaxElementCount)
+                return false;
+
+            auto elementType = arrayType->getElementType();
+            for (IRIntegerValue i = 0; i < count; ++i)
+            {
+                outParts.add(Part{ builder->getIntValue(builder->getIntType(), i), elementType });
+            }
+            return true;
+        }
+        return false;
+    }
+
+        /// Find the index of the part accessed by `user` (a field/element address or extract), or -1 if not a known part
+    static Index _findPartIndex(IRInst* user, List<Part> const& parts)
+    {
+        switch (user->getOp())
+        {
+            case kIROp_FieldAddress:
+            case kIROp_FieldExtract:
+            {
+                auto key = user->getOperand(1);
+                for (Index i = 0; i < parts.getCount(); ++i)
+                {
+                    if (parts[i].key == key)
+                        return i;
+                }
+                return -1;
+            }
+            case kIROp_getElementPtr:
+            case kIROp_getElement:
+            {
+                auto indexLit = as<IRIntLit>(user->getOperand(1));
+                if (!indexLit)
+                    return -1;
+                const IRIntegerValue index = indexLit->getValue();
+                return (index >= 0 && index < parts.getCount()) ? Index(index) : -1;
+            }
+            default:
+                return -1;
+        }
+    }
+
+        /// Returns true if every use of `var` can be rewritten in terms of its parts
+    static bool _canSplit(IRVar* var, List<Part> const& parts)
+    {
+        for (auto decoration : var->getDecorations())
+        {
+            if (!as<IRNameHintDecoration>(decoration))
+                return false;
+        }
+
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+
+            // The variable must be the address being accessed, not (say) a
+            // value being stored or an argument to a call.
+            if (use != user->getOperands())
+                return false;
+
+            switch (user->getOp())
+            {
+                case kIROp_Load:
+                case kIROp_Store:
+                    break;
+
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    if (_findPartIndex(user, parts) < 0)
+                        return false;
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+        /// Get the value of part `index` of `val`, which has the aggregate type being split
+    static IRInst* _extractPart(IRBuilder* builder, IRInst* val, Part const& part, Index index)
+    {
+        // Aggregates are often stored straight after they are made, in which
+        // case we can use the value directly.
+        switch (val->getOp())
+        {
+            case kIROp_makeStruct:
+            case kIROp_makeArray:
+                if (Index(val->getOperandCount()) > index)
+                    return val->getOperand(index);
+                break;
+            default:
+                break;
+        }
+
+        if (as<IRStructKey>(part.key))
+            return builder->emitFieldExtract(part.type, val, part.key);
+        return builder->emitElementExtract(part.type, val, part.key);
+    }
+
+        /// Make a name hint for a part of `var`, if `var` has a name
+    static void _addNameHint(IRBuilder* builder, IRVar* var, IRVar* partVar, Part const& part)
+    {
+        auto nameHint = var->findDecoration<IRNameHintDecoration>();
+        if (!nameHint)
+            return;
+
+        StringBuilder name;
+        name << nameHint->getName();
+        if (auto keyNameHint = part.key->findDecoration<IRNameHintDecoration>())
+        {
+            name << "_" << keyNameHint->getName();
+        }
+        else if (auto indexLit = as<IRIntLit>(part.key))
+        {
+            name << "_" << indexLit->getValue();
+        }
+        builder->addNameHintDecoration(partVar, name.getUnownedSlice());
+    }
+
+    void _trySplit(IRVar* var)
+    {
+        IRBuilder builder;
+        builder.sharedBuilder = m_sharedBuilder;
+        builder.setInsertBefore(var);
+
+        auto type = var->getDataType()->getValueType();
+
+        List<Part> parts;
+        if (!_getParts(&builder, type, parts) || !_canSplit(var, parts))
+            return;
+
+        // Create a variable for each part, next to the original variable
+        List<IRVar*> partVars;
+        for (Index i = 0; i < parts.getCount(); ++i)
+        {
+            auto partVar = builder.emitVar(parts[i].type);
+            _addNameHint(&builder, var, partVar, parts[i]);
+            partVars.add(partVar);
+        }
+
+        // Rewrite each use in terms of the parts. The uses are gathered first,
+        // as rewriting removes them.
+        List<IRInst*> users;
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            users.add(use->getUser());
+        }
+
+        for (auto user : users)
+        {
+            builder.setInsertBefore(user);
+
+            switch (user->getOp())
+            {
+                case kIROp_Load:
+                {
+                    List<IRInst*> args;
+                    for (auto partVar : partVars)
+                    {
+                        args.add(builder.emitLoad(partVar));
+                    }
+
+                    // Anything that extracts a single part from the loaded value
+                    // can use the load of that part instead.
+                    List<IRInst*> extracts;
+                    for (auto loadUse = user->firstUse; loadUse; loadUse = loadUse->nextUse)
+                    {
+                        auto loadUser = loadUse->getUser();
+                        if (loadUse == loadUser->getOperands() && _findPartIndex(loadUser, parts) >= 0)
+                            extracts.add(loadUser);
+                    }
+                    for (auto extract : extracts)
+                    {
+                        extract->replaceUsesWith(args[_findPartIndex(extract, parts)]);
+                        extract->removeAndDeallocate();
+                    }
+
+                    auto newVal = as<IRStructType>(type)
+                        ? builder.emitMakeStruct(type, args)
+                        : builder.emitMakeArray(type, UInt(args.getCount()), args.getBuffer());
+                    user->replaceUsesWith(newVal);
+                    break;
+                }
+                case kIROp_Store:
+                {
+                    auto val = user->getOperand(1);
+                    for (Index i = 0; i < parts.getCount(); ++i)
+                    {
+                        builder.emitStore(partVars[i], _extractPart(&builder, val, parts[i], i));
+                    }
+                    break;
+                }
+                default:
+                {
+                    const Index partIndex = _findPartIndex(user, parts);
+                    SLANG_ASSERT(partIndex >= 0);
+                    user->replaceUsesWith(partVars[partIndex]);
+                    break;
+                }
+            }
+            user->removeAndDeallocate();
+        }
+
+        var->removeAndDeallocate();
+        m_changed = true;
+
+        m_workList.addRange(partVars);
+    }
+
+    void processFunc(IRGlobalValueWithCode* code)
+    {
+        for (auto block : code->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (auto var = as<IRVar>(inst))
+                    m_workList.add(var);
+            }
+        }
+
+        while (m_workList.getCount())
+        {
+            auto var = m_workList.getLast();
+            m_workList.removeLast();
+            _trySplit(var);
+        }
+    }
+};
+
+bool performScalarReplacementOfAggregates(IRModule* module)
+{
+    SharedIRBuilder sharedBuilder(module);
+
+    SROAContext context;
+    context.m_sharedBuilder = &sharedBuilder;
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        // As with SSA construction we only look at code at the global scope,
+        // and not inside generics.
+        if (as<IRGeneric>(inst))
+            continue;
+
+        if (auto code = as<IRGlobalValueWithCode>(inst))
+        {
+            context.processFunc(code);
+        }
+    }
+    return context.m_changed;
+}
+
+}
@@ -0,0 +1,20 @@
+// slang-ir-sroa.h
+#pragma once
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Apply scalar replacement of aggregates (SROA) to local variables in `module`.
+        ///
+        /// A local variable of `struct` or (small) fixed-size array type, that is only
+        /// accessed through field/element addresses with known fields and constant indices,
+        /// or by loading or storing the whole value, is split into one variable per
+        /// field/element. The new variables are split again if possible.
+        ///
+        /// This is intended to be run before `constructSSA`, which can then promote the
+        /// individual fields/elements to SSA values.
+        ///
+        /// Returns true if any variable was split.
+    bool performScalarReplacementOfAggregates(IRModule* module);
+}
@@ -18,16 +18,18 @@ struct PhiInfo : RefObject
     // The original variable that this phi will be replacing.
     IRVar* var;
 
-    // The operands to the phi will be stored as uses here,
-    // because our IR parameters don't have operands.
+    // The operands to the phi will be stored as the operands
+    // of this instruction, because our IR parameters don't have
+    // operands. It is never inserted into the IR, and only serves
+    // to keep the operands registered as uses of their values.
     //
     // Once we've collected all the values we plan to use,
     // we will turn this into argument in predecessor blocks
     // that branch to this one.
     //
-    // The order of elements in this list must match the
+    // The order of the operands must match the
     // order in which the predecessor blocks get enumerated.
-    List<IRUse> operands;
+    IRInst* operands = nullptr;
 
     // If this phi ended up being removed as trivial, then
     // this will be the value that we replaced it with.
@@ -83,7 +85,7 @@ struct ConstructSSAContext
     Dictionary<IRBlock*, RefPtr<SSABlockInfo>> blockInfos;
 
     // IR building state to use during the operation
-    SharedIRBuilder sharedBuilder;
+    SharedIRBuilder* sharedBuilder = nullptr;
 
     // Instructions to remove during cleanup
     List<IRInst*> instsToRemove;
@@ -100,6 +102,16 @@ struct ConstructSSAContext
             return *found;
         return nullptr;
     }
+
+    // Maps the instruction holding the operands of a phi back to the phi
+    Dictionary<IRInst*, PhiInfo*> phiInfoForOperands;
+
+    PhiInfo* getPhiInfoForOperands(IRInst* operands)
+    {
+        if(auto found = phiInfoForOperands.TryGetValue(operands))
+            return *found;
+        return nullptr;
+    }
 };
 
 /// Do all uses of this instruction lead to a `load`?
@@ -318,10 +330,12 @@ IRInst* applyAccessChain(
             auto fieldKey = accessChain->getOperand(1);
             auto type = cast<IRPtrTypeBase>(accessChain->getDataType())->getValueType();
             auto baseValue = applyAccessChain(context, builder, baseChain, leafVarValue);
-            return builder->emitFieldExtract(
+            auto fieldExtract = builder->emitFieldExtract(
                 type,
                 baseValue,
                 fieldKey);
+            fieldExtract->sourceLoc = accessChain->sourceLoc;
+            return fieldExtract;
         }
 
     case kIROp_getElementPtr:
@@ -332,10 +346,12 @@ IRInst* applyAccessChain(
             auto index = accessChain->getOperand(1);
             auto type = cast<IRPtrTypeBase>(accessChain->getDataType())->getValueType();
             auto baseValue = applyAccessChain(context, builder, baseChain, leafVarValue);
-            return builder->emitElementExtract(
+            auto elementExtract = builder->emitElementExtract(
                 type,
                 baseValue,
                 index);
+            elementExtract->sourceLoc = accessChain->sourceLoc;
+            return elementExtract;
         }
     }
 }
@@ -423,9 +439,10 @@ IRInst* tryRemoveTrivialPhi(
     // to the phi itself.
 
     IRInst* same = nullptr;
-    for (auto u : phiInfo->operands)
+    const UInt operandCount = phiInfo->operands->getOperandCount();
+    for (UInt ii = 0; ii < operandCount; ++ii)
     {
-        auto usedVal = u.get();
+        auto usedVal = phiInfo->operands->getOperand(ii);
         SLANG_ASSERT(usedVal);
 
         if (usedVal == same || usedVal == phi)
@@ -472,17 +489,11 @@ IRInst* tryRemoveTrivialPhi(
     List<PhiInfo*> otherPhis;
     for( auto u = phi->firstUse; u; u = u->nextUse )
     {
-        auto user = u->user;
-        if(!user) continue;
-        if(user == phi) continue;
-
-        if( user->getOp() == kIROp_Param )
+        if( auto otherPhiInfo = context->getPhiInfoForOperands(u->getUser()) )
         {
-            auto maybeOtherPhi = (IRParam*) user;
-            if( auto otherPhiInfo = context->getPhiInfo(maybeOtherPhi) )
-            {
-                otherPhis.add(otherPhiInfo);
-            }
+            if(otherPhiInfo == phiInfo) continue;
+
+            otherPhis.add(otherPhiInfo);
         }
     }
 
@@ -492,9 +503,9 @@ IRInst* tryRemoveTrivialPhi(
 
     // Clear out the operands to the phi, since they won't
     // actually get used in the program any more.
-    for( auto& u : phiInfo->operands )
+    for (UInt ii = 0; ii < operandCount; ++ii)
     {
-        u.clear();
+        phiInfo->operands->getOperands()[ii].clear();
     }
 
     // We will record the value that was used to replace this
@@ -546,17 +557,16 @@ IRInst* addPhiOperands(
         operandValues.add(phiOperand);
     }
 
-    // The `IRUse`  type needs to stay at a stable location
-    // since they get threaded into lists. We allocate the
-    // list with its final size so that we can preserve the
-    // required invariant.
+    // The operands are held in an instruction, because an `IRUse`
+    // needs to stay at a stable location (since uses get threaded
+    // into lists), and can only be stored inside an instruction.
 
-    UInt operandCount = operandValues.getCount();
-    phiInfo->operands.setCount(operandCount);
-    for(UInt ii = 0; ii < operandCount; ++ii)
-    {
-        phiInfo->operands[ii].init(phiInfo->phi, operandValues[ii]);
-    }
+    phiInfo->operands = context->getBuilder()->createIntrinsicInst(
+        nullptr,
+        kIROp_Nop,
+        operandValues.getCount(),
+        operandValues.getBuffer());
+    context->phiInfoForOperands.Add(phiInfo->operands, phiInfo);
 
     return tryRemoveTrivialPhi(context, phiInfo);
 }
@@ -1035,7 +1045,7 @@ static void breakCriticalEdges(
 
     for (auto edge : criticalEdges)
     {
-        context->sharedBuilder.insertBlockAlongEdge(edge);
+        context->sharedBuilder->insertBlockAlongEdge(edge);
     }
 }
 
@@ -1065,7 +1075,7 @@ void constructSSA(ConstructSSAContext* context)
         auto blockInfo = new SSABlockInfo();
         blockInfo->block = bb;
 
-        blockInfo->builder.sharedBuilder = &context->sharedBuilder;
+        blockInfo->builder.sharedBuilder = context->sharedBuilder;
         blockInfo->builder.setInsertBefore(bb->getLastInst());
 
         context->blockInfos.Add(bb, blockInfo);
@@ -1100,9 +1110,9 @@ void constructSSA(ConstructSSAContext* context)
                 UInt predIndex = predCounter++;
                 auto predInfo = *context->blockInfos.TryGetValue(pp);
 
-                IRInst* operandVal = phiInfo->operands[predIndex].get();
+                IRInst* operandVal = phiInfo->operands->getOperand(predIndex);
 
-                phiInfo->operands[predIndex].clear();
+                phiInfo->operands->getOperands()[predIndex].clear();
 
                 predInfo->successorArgs.add(operandVal);
             }
@@ -1191,27 +1201,26 @@ void constructSSA(ConstructSSAContext* context)
 }
 
 // Construct SSA form for a global value with code
-void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
+void constructSSA(SharedIRBuilder* sharedBuilder, IRGlobalValueWithCode* globalVal)
 {
     ConstructSSAContext context;
     context.globalVal = globalVal;
 
-    context.sharedBuilder.module = module;
-    context.sharedBuilder.session = module->session;
+    context.sharedBuilder = sharedBuilder;
 
-    context.builder.sharedBuilder = &context.sharedBuilder;
-    context.builder.setInsertInto(module->moduleInst);
+    context.builder.sharedBuilder = sharedBuilder;
+    context.builder.setInsertInto(sharedBuilder->module->moduleInst);
 
     constructSSA(&context);
 }
 
-void constructSSA(IRModule* module, IRInst* globalVal)
+void constructSSA(SharedIRBuilder* sharedBuilder, IRInst* globalVal)
 {
     switch (globalVal->getOp())
     {
     case kIROp_Func:
     case kIROp_GlobalVar:
-        constructSSA(module, (IRGlobalValueWithCode*)globalVal);
+        constructSSA(sharedBuilder, (IRGlobalValueWithCode*)globalVal);
 
     default:
         break;
@@ -1220,9 +1229,10 @@ void constructSSA(IRModule* module, IRInst* globalVal)
 
 void constructSSA(IRModule* module)
 {
+    SharedIRBuilder sharedBuilder(module);
     for(auto ii : module->getGlobalInsts())
     {
-        constructSSA(module, ii);
+        constructSSA(&sharedBuilder, ii);
     }
 }
 
@@ -3,7 +3,15 @@
 
 namespace Slang
 {
+    struct IRInst;
     struct IRModule;
+    struct SharedIRBuilder;
 
+        /// Promote local variables to SSA temporaries where possible, in all functions (and
+        /// global variables with initializer code) at the global scope of `module`.
     void constructSSA(IRModule* module);
+
+        /// Construct SSA form for the single global value `globalVal`, if it's a function or
+        /// global variable with code, using `sharedBuilder` for any values created.
+    void constructSSA(SharedIRBuilder* sharedBuilder, IRInst* globalVal);
 }
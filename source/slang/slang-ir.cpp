@@ -90,7 +90,7 @@ namespace Slang
     void IRUse::debugValidate()
     {
 #ifdef _DEBUG
-        auto uv = this->usedValue;
+        auto uv = get();
         if(!uv)
         {
             assert(!nextUse);
@@ -109,12 +109,38 @@ namespace Slang
 #endif
     }
 
+    void IRUse::initPosition(Index operandIndex)
+    {
+        SLANG_ASSERT(get() == nullptr);
+
+        // Find the largest power of 4 step back that doesn't pass the `typeUse`
+        const Index distance = operandIndex + 1;
+        uintptr_t stepCode = 0;
+        if (distance > 0)
+        {
+            stepCode = 1;
+            while (stepCode < kMaxStepCode && (Index(1) << (stepCode * kStepCodeShift)) <= distance)
+            {
+                stepCode++;
+            }
+        }
+        m_usedValueAndStep = stepCode;
+    }
+
     void IRUse::init(IRInst* u, IRInst* v)
+    {
+        // The user is implied by where this use is stored
+        SLANG_UNUSED(u);
+        SLANG_ASSERT(getUser() == u);
+
+        set(v);
+    }
+
+    void IRUse::set(IRInst* v)
     {
         clear();
 
-        user = u;
-        usedValue = v;
+        setUnlinked(v);
         if(v)
         {
             nextUse = v->firstUse;
@@ -131,11 +157,6 @@ namespace Slang
         debugValidate();
     }
 
-    void IRUse::set(IRInst* uv)
-    {
-        init(user, uv);
-    }
-
     void IRUse::clear()
     {
         // This `IRUse` is part of the linked list
@@ -143,18 +164,15 @@ namespace Slang
 
         debugValidate();
 
-        if (usedValue)
+        if (auto uv = get())
         {
-            auto uv = usedValue;
-
             *prevLink = nextUse;
             if(nextUse)
             {
                 nextUse->prevLink = prevLink;
             }
 
-            user        = nullptr;
-            usedValue   = nullptr;
+            setUnlinked(nullptr);
             nextUse     = nullptr;
             prevLink    = nullptr;
 
@@ -649,7 +667,7 @@ namespace Slang
 
     IRInst* IRUnconditionalBranch::getArg(UInt index)
     {
-        return getArgs()[index].usedValue;
+        return getArgs()[index].get();
     }
 
     IRParam* IRGlobalValueWithParams::getFirstParam()
@@ -902,7 +920,20 @@ namespace Slang
 
     void IRArrayTypeLayout::Builder::addOperandsImpl(List<IRInst*>& ioOperands)
     {
+        auto irBuilder = getIRBuilder();
         ioOperands.add(m_elementTypeLayout);
+        ioOperands.add(irBuilder->getIntValue(irBuilder->getIntType(), m_uniformStride));
+    }
+
+    //
+    // IRStructuredBufferTypeLayout
+    //
+
+    void IRStructuredBufferTypeLayout::Builder::addOperandsImpl(List<IRInst*>& ioOperands)
+    {
+        auto irBuilder = getIRBuilder();
+        ioOperands.add(m_elementTypeLayout);
+        ioOperands.add(irBuilder->getIntValue(irBuilder->getIntType(), m_elementStride));
     }
 
     //
@@ -1313,6 +1344,18 @@ namespace Slang
         return parent;
     }
 
+        /// Record the position of each of the uses of `inst`, so that `IRUse::getUser` works.
+        /// Must be called once the operand count is set, and before any of the uses are initialized.
+    static void _initUsePositions(IRInst* inst)
+    {
+        const Index operandCount = Index(inst->getOperandCount());
+        IRUse* operands = inst->getOperands();
+        for (Index i = 0; i < operandCount; ++i)
+        {
+            operands[i].initPosition(i);
+        }
+    }
+
     IRInst* createEmptyInst(
         IRModule*   module,
         IROp        op,
@@ -1325,6 +1368,7 @@ namespace Slang
 
         inst->operandCount = uint32_t(totalArgCount);
         inst->m_op = op;
+        _initUsePositions(inst);
 
         return inst;
     }
@@ -1646,6 +1690,7 @@ namespace Slang
 #endif
 
         inst->operandCount = (uint32_t)(fixedArgCount + varArgCount);
+        _initUsePositions(inst);
 
         inst->m_op = op;
 
@@ -2124,7 +2169,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_BoolLit;
-        keyInst.typeUse.usedValue = getBoolType();
+        keyInst.typeUse.setUnlinked(getBoolType());
         keyInst.value.intVal = IRIntegerValue(inValue);
         return findOrEmitConstant(this, keyInst);
     }
@@ -2134,7 +2179,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_IntLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.setUnlinked(type);
         keyInst.value.intVal = inValue;
         return findOrEmitConstant(this, keyInst);
     }
@@ -2144,7 +2189,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_FloatLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.setUnlinked(type);
         keyInst.value.floatVal = inValue;
         return findOrEmitConstant(this, keyInst);
     }
@@ -2161,7 +2206,7 @@ namespace Slang
         stackDecoration.insertAtEnd(&keyInst);
             
         keyInst.m_op = kIROp_StringLit;
-        keyInst.typeUse.usedValue = getStringType();
+        keyInst.typeUse.setUnlinked(getStringType());
         
         IRConstant::StringSliceValue& dstSlice = keyInst.value.transitoryStringVal;
         dstSlice.chars = const_cast<char*>(inSlice.begin());
@@ -2177,7 +2222,7 @@ namespace Slang
         IRConstant keyInst;
         memset(&keyInst, 0, sizeof(keyInst));
         keyInst.m_op = kIROp_PtrLit;
-        keyInst.typeUse.usedValue = type;
+        keyInst.typeUse.setUnlinked(type);
         keyInst.value.ptrVal = value;
         return (IRPtrLit*) findOrEmitConstant(this, keyInst);
     }
@@ -2244,8 +2289,9 @@ namespace Slang
         inst->_debugUID = _debugGetAndIncreaseInstCounter();
 #endif
         inst->m_op = op;
-        inst->typeUse.usedValue = type;
+        inst->typeUse.setUnlinked(type);
         inst->operandCount = (uint32_t) operandCount;
+        _initUsePositions(inst);
 
         // Don't link up as we may free (if we already have this key)
         {
@@ -2255,7 +2301,7 @@ namespace Slang
                 UInt listOperandCount = listOperandCounts[ii];
                 for (UInt jj = 0; jj < listOperandCount; ++jj)
                 {
-                    operand->usedValue = listOperands[ii][jj];
+                    operand->setUnlinked(listOperands[ii][jj]);
                     operand++;
                 }
             }
@@ -2281,7 +2327,7 @@ namespace Slang
         {
             if (type)
             {
-                inst->typeUse.usedValue = nullptr;
+                inst->typeUse.setUnlinked(nullptr);
                 inst->typeUse.init(inst, type);
             }
 
@@ -2291,9 +2337,9 @@ namespace Slang
             for (UInt i = 0; i < operandCount; ++i)
             {
                 IRUse& operand = operands[i];
-                auto value = operand.usedValue;
+                auto value = operand.get();
 
-                operand.usedValue = nullptr;
+                operand.setUnlinked(nullptr);
                 operand.init(inst, value);
             }
         }
@@ -2334,8 +2380,9 @@ namespace Slang
         inst->_debugUID = _debugGetAndIncreaseInstCounter();
 #endif
         inst->m_op = op;
-        inst->typeUse.usedValue = type;
+        inst->typeUse.setUnlinked(type);
         inst->operandCount = (uint32_t)operandCount;
+        _initUsePositions(inst);
 
         // Don't link up as we may free (if we already have this key)
         {
@@ -2345,7 +2392,7 @@ namespace Slang
                 UInt listOperandCount = listOperandCounts[ii];
                 for (UInt jj = 0; jj < listOperandCount; ++jj)
                 {
-                    operand->usedValue = listOperands[ii][jj];
+                    operand->setUnlinked(listOperands[ii][jj]);
                     operand++;
                 }
             }
@@ -2371,7 +2418,7 @@ namespace Slang
         {
             if (type)
             {
-                inst->typeUse.usedValue = nullptr;
+                inst->typeUse.setUnlinked(nullptr);
                 inst->typeUse.init(inst, type);
             }
 
@@ -2381,9 +2428,9 @@ namespace Slang
             for (UInt i = 0; i < operandCount; ++i)
             {
                 IRUse& operand = operands[i];
-                auto value = operand.usedValue;
+                auto value = operand.get();
 
-                operand.usedValue = nullptr;
+                operand.setUnlinked(nullptr);
                 operand.init(inst, value);
             }
         }
@@ -5441,7 +5488,7 @@ namespace Slang
             SLANG_ASSERT(uu->get() == this);
 
             // Swap this use over to use the other value.
-            uu->usedValue = other;
+            uu->setUnlinked(other);
 
             // Try to move to the next use, but bail
             // out if we are at the last one.
@@ -96,20 +96,45 @@ struct IROpInfo
 IROpInfo getIROpInfo(IROp op);
 
 // A use of another value/inst within an IR operation
+//
+// Every `IRUse` is stored inside the instruction that is doing the
+// using: either as its `typeUse`, or as one of the operands that
+// directly follow it in memory. Rather than store a pointer to the
+// user in every use, the low bits of the used value (which are always
+// zero because of alignment) hold how many uses back the `typeUse`
+// is, so that the user can be found from the position of the use.
 struct IRUse
 {
-    IRInst* get() const { return usedValue; }
-    IRInst* getUser() const { return user; }
+    enum : uintptr_t
+    {
+        kStepMask = sizeof(void*) - 1,              ///< The low bits of the used value that hold the step code
+        kMaxStepCode = kStepMask,
+        kStepCodeShift = 2,                         ///< A step code `c` > 0 means a step back of 4^(c - 1) uses
+    };
+
+    IRInst* get() const { return (IRInst*)(m_usedValueAndStep & ~uintptr_t(kStepMask)); }
+    IRInst* getUser() const;
 
     void init(IRInst* user, IRInst* usedValue);
     void set(IRInst* usedValue);
     void clear();
 
-    // The instruction that is being used
-    IRInst* usedValue = nullptr;
+        /// Set the used value, without linking this use into the list of uses of the value.
+        ///
+        /// Only for use when the use is not currently linked, such as for instructions that
+        /// are only used as keys for lookups.
+    void setUnlinked(IRInst* usedValue) { m_usedValueAndStep = uintptr_t(usedValue) | (m_usedValueAndStep & kStepMask); }
+
+        /// Record the position of this use within its user, where -1 is the `typeUse`
+        /// and other indices are operand indices. Must be set before the use is initialized.
+    void initPosition(Index operandIndex);
 
-    // The instruction that is doing the using.
-    IRInst* user = nullptr;
+    // The instruction that is being used, with a step back (in `IRUse`s) towards
+    // the `typeUse` of the user encoded in the low bits. A step code of 0 means this
+    // is the `typeUse`. Each use holds the largest power of 4 step that doesn't pass
+    // the `typeUse`, so the user of operand `n` is found in O(log n) steps. (Past
+    // 4^(kMaxStepCode - 1) operands the largest step is repeated.)
+    uintptr_t m_usedValueAndStep = 0;
 
     // The next use of the same value
     IRUse*  nextUse = nullptr;
@@ -441,6 +466,9 @@ struct IRInst
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
+    //
+    // This must be the last member, so that the operands
+    // directly follow it in memory (see `IRUse::getUser`).
     IRUse typeUse;
 
     IRType* getFullType() { return (IRType*) typeUse.get(); }
@@ -464,7 +492,7 @@ struct IRInst
 
     void setOperand(UInt index, IRInst* value)
     {
-        SLANG_ASSERT(getOperands()[index].user != nullptr);
+        SLANG_ASSERT(index < getOperandCount());
         getOperands()[index].set(value);
     }
 
@@ -535,6 +563,16 @@ struct IRInst
     void _insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent);
 };
 
+SLANG_FORCE_INLINE IRInst* IRUse::getUser() const
+{
+    const IRUse* use = this;
+    while (const uintptr_t stepCode = (use->m_usedValueAndStep & kStepMask))
+    {
+        use -= uintptr_t(1) << ((stepCode - 1) * kStepCodeShift);
+    }
+    return (IRInst*)((const char*)use - SLANG_OFFSET_OF(IRInst, typeUse));
+}
+
 template<typename T>
 T* dynamicCast(IRInst* inst)
 {
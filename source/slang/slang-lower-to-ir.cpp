@@ -7336,6 +7336,11 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
             getBuilder()->addSimpleDecoration<IRRequiresNVAPIDecoration>(irFunc);
         }
 
+        if(decl->findModifier<RequiresQuadAttribute>())
+        {
+            getBuilder()->addSimpleDecoration<IRRequiresQuadDecoration>(irFunc);
+        }
+
         if(decl->findModifier<NoInlineAttribute>())
         {
             getBuilder()->addSimpleDecoration<IRNoInlineDecoration>(irFunc);
@@ -7998,8 +8003,20 @@ IRModule* generateIRForTranslationUnit(
     //
     // Next, ensure that all other global declarations have
     // been emitted.
+    //
+    // If function bodies are checked lazily, any function that
+    // was never referenced from checked code has not been checked,
+    // and is not needed, so is skipped.
+    //
+    const bool skipUncheckedFuncs = (compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING) != 0;
     for (auto decl : translationUnit->getModuleDecl()->members)
     {
+        if (skipUncheckedFuncs && !decl->isChecked(DeclCheckState::Checked))
+        {
+            auto genericDecl = as<GenericDecl>(decl);
+            if (as<FuncDecl>(genericDecl ? genericDecl->inner : decl))
+                continue;
+        }
         ensureAllDeclsRec(context, decl);
     }
 
@@ -8056,13 +8073,26 @@ IRModule* generateIRForTranslationUnit(
     performMandatoryEarlyInlining(module);
 
     // Next, attempt to promote local variables to SSA
-    // temporaries whenever possible.
-    constructSSA(module);
-
-    // Do basic constant folding and dead code elimination
-    // using Sparse Conditional Constant Propagation (SCCP)
+    // temporaries whenever possible, and then do basic
+    // constant folding and dead code elimination using
+    // Sparse Conditional Constant Propagation (SCCP).
+    //
+    // Both passes only look at the code of one function at
+    // a time, so rather than making a pass over the whole
+    // module for each, we apply both to each global value
+    // in turn. The code of a function is then likely still
+    // in cache when SCCP runs over it, and one builder (and
+    // so one set of deduplicated global values) is used
+    // for the whole module.
     //
-    applySparseConditionalConstantPropagation(module);
+    {
+        SharedIRBuilder sharedBuilder(module);
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            constructSSA(&sharedBuilder, globalInst);
+            applySparseConditionalConstantPropagation(&sharedBuilder, globalInst);
+        }
+    }
 
     // Propagate `constexpr`-ness through the dataflow graph (and the
     // call graph) based on constraints imposed by different instructions.
@@ -8421,8 +8451,26 @@ IRTypeLayout* lowerTypeLayout(
     {
         auto irElementTypeLayout = lowerTypeLayout(context, arrayTypeLayout->elementTypeLayout);
         IRArrayTypeLayout::Builder builder(context->irBuilder, irElementTypeLayout);
+        builder.setUniformStride(IRIntegerValue(arrayTypeLayout->uniformStride));
         return _lowerTypeLayoutCommon(context, &builder, arrayTypeLayout);
     }
+    else if( auto structuredBufferTypeLayout = as<StructuredBufferTypeLayout>(typeLayout) )
+    {
+        // Elements are placed at multiples of their size rounded up to their alignment
+        auto elementTypeLayout = structuredBufferTypeLayout->elementTypeLayout;
+        IRIntegerValue elementStride = 0;
+        auto uniformInfo = elementTypeLayout->FindResourceInfo(LayoutResourceKind::Uniform);
+        if( uniformInfo && uniformInfo->count.isFinite() )
+        {
+            const IRIntegerValue alignment = IRIntegerValue(elementTypeLayout->uniformAlignment);
+            const IRIntegerValue size = IRIntegerValue(uniformInfo->count.getFiniteValue());
+            elementStride = (size + alignment - 1) / alignment * alignment;
+        }
+
+        auto irElementTypeLayout = lowerTypeLayout(context, elementTypeLayout);
+        IRStructuredBufferTypeLayout::Builder builder(context->irBuilder, irElementTypeLayout, elementStride);
+        return _lowerTypeLayoutCommon(context, &builder, structuredBufferTypeLayout);
+    }
     else if( auto taggedUnionTypeLayout = as<TaggedUnionTypeLayout>(typeLayout) )
     {
         IRTaggedUnionTypeLayout::Builder builder(context->irBuilder, taggedUnionTypeLayout->tagOffset);
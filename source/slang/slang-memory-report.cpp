@@ -0,0 +1,241 @@
+// slang-memory-report.cpp
+#include "slang-memory-report.h"
+
+#include "slang-compiler.h"
+#include "slang-ir.h"
+#include "slang-type-layout.h"
+
+#include "../core/slang-type-text-util.h"
+
+namespace Slang
+{
+
+Index MemoryReport::add(Index depth, const String& name, size_t bytes)
+{
+    Entry entry;
+    entry.depth = depth;
+    entry.name = name;
+    entry.bytes = bytes;
+
+    const Index index = entries.getCount();
+    entries.add(entry);
+    return index;
+}
+
+bool MemoryReport::markCounted(const void* object)
+{
+    return object && countedObjects.Add(object);
+}
+
+void MemoryReport::appendAsText(StringBuilder& out) const
+{
+    const Index nameColumnWidth = 48;
+
+    for (const auto& entry : entries)
+    {
+        const Index startLength = out.getLength();
+
+        for (Index i = 0; i < entry.depth; ++i)
+        {
+            out << "  ";
+        }
+        out << entry.name;
+
+        const Index nameLength = out.getLength() - startLength;
+        for (Index i = nameLength; i < nameColumnWidth; ++i)
+        {
+            out << " ";
+        }
+        out << " " << UInt64(entry.bytes) << "\n";
+    }
+}
+
+static size_t _getArenaMemoryUsed(MemoryReport& ioReport, MemoryArena* arena)
+{
+    return ioReport.markCounted(arena) ? arena->calcTotalMemoryUsed() : 0;
+}
+
+static size_t _addASTBuilder(ASTBuilder* astBuilder, const char* name, Index depth, MemoryReport& ioReport)
+{
+    if (!astBuilder)
+    {
+        return 0;
+    }
+    const size_t bytes = _getArenaMemoryUsed(ioReport, &astBuilder->getMemoryArena());
+    if (bytes)
+    {
+        ioReport.add(depth, name, bytes);
+    }
+    return bytes;
+}
+
+static String _getModuleName(Module* module)
+{
+    if (auto moduleDecl = module->getModuleDecl())
+    {
+        if (auto name = moduleDecl->getName())
+        {
+            return "module '" + getText(name) + "'";
+        }
+    }
+    return "module";
+}
+
+size_t addModuleToMemoryReport(Module* module, Index depth, MemoryReport& ioReport)
+{
+    if (!ioReport.markCounted(module))
+    {
+        return 0;
+    }
+
+    const Index entryIndex = ioReport.add(depth, _getModuleName(module), 0);
+
+    size_t total = _addASTBuilder(module->getASTBuilder(), "AST", depth + 1, ioReport);
+
+    if (auto irModule = module->getIRModule())
+    {
+        const size_t bytes = _getArenaMemoryUsed(ioReport, &irModule->memoryArena);
+        if (bytes)
+        {
+            ioReport.add(depth + 1, "IR", bytes);
+            total += bytes;
+        }
+    }
+
+    ioReport.entries[entryIndex].bytes = total;
+    return total;
+}
+
+size_t addLinkageToMemoryReport(Linkage* linkage, Index depth, MemoryReport& ioReport)
+{
+    if (!ioReport.markCounted(linkage))
+    {
+        return 0;
+    }
+
+    const Index entryIndex = ioReport.add(depth, "linkage", 0);
+
+    size_t total = _addASTBuilder(linkage->getASTBuilder(), "AST", depth + 1, ioReport);
+
+    {
+        auto sourceManager = linkage->getSourceManager();
+        if (ioReport.markCounted(sourceManager))
+        {
+            const size_t bytes = sourceManager->calcTotalMemoryUsed();
+            ioReport.add(depth + 1, "source files", bytes);
+            total += bytes;
+        }
+    }
+
+    for (auto target : linkage->targets)
+    {
+        // Layouts are held in individually allocated objects, so this is a lower bound
+        const Index layoutCount = target->getTypeLayouts().Count();
+        if (layoutCount)
+        {
+            const size_t bytes = size_t(layoutCount) * sizeof(TypeLayout);
+            StringBuilder name;
+            name << "type layouts (" << TypeTextUtil::getCompileTargetName(SlangCompileTarget(target->getTarget())) << ", " << layoutCount << ")";
+            ioReport.add(depth + 1, name, bytes);
+            total += bytes;
+        }
+    }
+
+    if (linkage->loadedModulesList.getCount())
+    {
+        const Index modulesIndex = ioReport.add(depth + 1, "loaded modules", 0);
+        size_t modulesTotal = 0;
+        for (auto module : linkage->loadedModulesList)
+        {
+            modulesTotal += addModuleToMemoryReport(module, depth + 2, ioReport);
+        }
+        ioReport.entries[modulesIndex].bytes = modulesTotal;
+        total += modulesTotal;
+    }
+
+    ioReport.entries[entryIndex].bytes = total;
+    return total;
+}
+
+size_t addSessionToMemoryReport(Session* session, Index depth, MemoryReport& ioReport)
+{
+    if (!ioReport.markCounted(session))
+    {
+        return 0;
+    }
+
+    const Index entryIndex = ioReport.add(depth, "session", 0);
+
+    size_t total = _addASTBuilder(session->getGlobalASTBuilder(), "AST", depth + 1, ioReport);
+
+    // When the stdlib is shared, so are the names it created, and they are held by the session it came from
+    {
+        const size_t bytes = session->getRootNamePool()->calcTotalMemoryUsed(!session->isStdLibShared());
+        ioReport.add(depth + 1, "names", bytes);
+        total += bytes;
+    }
+
+    if (session->isStdLibShared())
+    {
+        ioReport.add(depth + 1, "stdlib (shared with another session)", 0);
+    }
+    else
+    {
+        {
+            const size_t bytes = session->getBuiltinSourceManager()->calcTotalMemoryUsed();
+            ioReport.add(depth + 1, "stdlib source files", bytes);
+            total += bytes;
+        }
+
+        if (auto builtinLinkage = session->getBuiltinLinkage())
+        {
+            if (ioReport.markCounted(builtinLinkage))
+            {
+                total += _addASTBuilder(builtinLinkage->getASTBuilder(), "stdlib AST", depth + 1, ioReport);
+            }
+        }
+
+        const Index stdlibIndex = ioReport.add(depth + 1, "stdlib modules", 0);
+        size_t stdlibTotal = 0;
+        for (auto module : session->stdlibModules)
+        {
+            stdlibTotal += addModuleToMemoryReport(module, depth + 2, ioReport);
+        }
+        ioReport.entries[stdlibIndex].bytes = stdlibTotal;
+        total += stdlibTotal;
+    }
+
+    ioReport.entries[entryIndex].bytes = total;
+    return total;
+}
+
+size_t addCompileRequestToMemoryReport(EndToEndCompileRequest* request, MemoryReport& ioReport)
+{
+    auto linkage = request->getLinkage();
+
+    size_t total = addSessionToMemoryReport(request->getSession(), 0, ioReport);
+    total += addLinkageToMemoryReport(linkage, 0, ioReport);
+
+    if (auto frontEndReq = request->getFrontEndReq())
+    {
+        const Index unitsIndex = ioReport.add(0, "translation units", 0);
+        size_t unitsTotal = 0;
+        for (auto translationUnit : frontEndReq->translationUnits)
+        {
+            if (auto module = translationUnit->getModule())
+            {
+                unitsTotal += addModuleToMemoryReport(module, 1, ioReport);
+            }
+        }
+        ioReport.entries[unitsIndex].bytes = unitsTotal;
+        total += unitsTotal;
+    }
+
+    ioReport.add(0, "total", total);
+
+    // Not held any more, so not part of the total
+    ioReport.add(0, "peak back-end IR", linkage->getPeakBackEndIRMemoryUsed());
+    return total;
+}
+
+}
@@ -0,0 +1,54 @@
+// slang-memory-report.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    class EndToEndCompileRequest;
+    class Linkage;
+    class Module;
+    class Session;
+
+        /// A breakdown of the memory held by the compiler, by subsystem and by module.
+        ///
+        /// Sizes are in bytes. Memory held in arenas (AST, IR, ...) is measured from the
+        /// arena blocks in use, while memory held in containers (names, layouts, ...) is
+        /// estimated from their contents. Anything reachable from more than one place (such
+        /// as an AST builder shared between modules) is only counted the first time it is seen.
+    struct MemoryReport
+    {
+        struct Entry
+        {
+            Index depth;                ///< Nesting level of the entry (entries at depth N+1 following it are its parts)
+            String name;
+            size_t bytes;
+        };
+
+            /// Add an entry, returning its index
+        Index add(Index depth, const String& name, size_t bytes);
+
+            /// Returns true the first time it is called with `object`, such that it is only counted once
+        bool markCounted(const void* object);
+
+            /// Append the report as human readable text to `out`
+        void appendAsText(StringBuilder& out) const;
+
+        List<Entry> entries;
+        HashSet<const void*> countedObjects;
+    };
+
+        /// Add the memory held by `module` to the report. Returns the total in bytes.
+    size_t addModuleToMemoryReport(Module* module, Index depth, MemoryReport& ioReport);
+
+        /// Add the memory held by `linkage` (and the modules loaded into it) to the report.
+        /// Returns the total in bytes.
+    size_t addLinkageToMemoryReport(Linkage* linkage, Index depth, MemoryReport& ioReport);
+
+        /// Add the memory held by `session` (including the stdlib) to the report. Returns the total in bytes.
+    size_t addSessionToMemoryReport(Session* session, Index depth, MemoryReport& ioReport);
+
+        /// Add everything held by `request`, its linkage and its session to the report.
+        /// Returns the total in bytes.
+    size_t addCompileRequestToMemoryReport(EndToEndCompileRequest* request, MemoryReport& ioReport);
+}
@@ -532,6 +532,10 @@ struct OptionsParser
                 {
                     flags |= SLANG_COMPILE_FLAG_NO_CODEGEN;
                 }
+                else if (argValue == "-lazy-function-checking")
+                {
+                    flags |= SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING;
+                }
                 else if (argValue == "-dump-intermediates")
                 {
                     compileRequest->setDumpIntermediates(true);
@@ -578,6 +582,10 @@ struct OptionsParser
                 {
                     requestImpl->m_dumpReproOnError = true;
                 }
+                else if (argValue == "-report-memory")
+                {
+                    requestImpl->m_reportMemory = true;
+                }
                 else if (argValue == "-extract-repro")
                 {
                     CommandLineArg reproName;
@@ -673,6 +681,27 @@ struct OptionsParser
                 {
                     requestImpl->getFrontEndReq()->verifyDebugSerialization = true;
                 }
+                else if (argValue == "-compact-ir")
+                {
+                    requestImpl->getLinkage()->m_shouldAlwaysCompactIR = true;
+                }
+                else if (argValue == "-inline-functions")
+                {
+                    requestImpl->getLinkage()->m_shouldInlineFunctions = true;
+                }
+                else if (argValue == "-emit-threads")
+                {
+                    CommandLineArg count;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(count));
+
+                    Int threadCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(count.value.getUnownedSlice(), threadCount)) || threadCount < 0)
+                    {
+                        sink->diagnose(count.loc, Diagnostics::invalidEmitThreadCount, count.value);
+                        return SLANG_FAIL;
+                    }
+                    requestImpl->getLinkage()->m_emitThreadCount = threadCount;
+                }
                 else if(argValue == "-validate-ir" )
                 {
                     requestImpl->getFrontEndReq()->shouldValidateIR = true;
@@ -975,6 +1004,32 @@ struct OptionsParser
 
                     setFloatingPointMode(getCurrentTarget(), mode);
                 }
+                else if( argValue == "-bounds-check-mode" )
+                {
+                    CommandLineArg name;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(name));
+
+                    BoundsCheckMode mode = BoundsCheckMode::Default;
+                    if(name.value == "default")
+                    {
+                        mode = BoundsCheckMode::Default;
+                    }
+                    else if(name.value == "clamp")
+                    {
+                        mode = BoundsCheckMode::Clamp;
+                    }
+                    else if(name.value == "trap")
+                    {
+                        mode = BoundsCheckMode::Trap;
+                    }
+                    else
+                    {
+                        sink->diagnose(name.loc, Diagnostics::unknownBoundsCheckMode, name.value);
+                        return SLANG_FAIL;
+                    }
+
+                    requestImpl->getLinkage()->boundsCheckMode = mode;
+                }
                 else if( argValue.getLength() >= 2 && argValue[1] == 'O' )
                 {
                     UnownedStringSlice levelSlice = argValue.getUnownedSlice().tail(2);
@@ -1070,6 +1125,10 @@ struct OptionsParser
                 {
                     requestImpl->getBackEndReq()->shouldEmitSPIRVDirectly = true;
                 }
+                else if( argValue == "-validate-spirv" )
+                {
+                    requestImpl->getBackEndReq()->shouldValidateSPIRV = true;
+                }
                 else if (argValue == "-default-downstream-compiler")
                 {
                     CommandLineArg sourceLanguageArg, compilerArg;
@@ -1095,6 +1154,28 @@ struct OptionsParser
                         sink->diagnose(arg.loc, Diagnostics::unableToSetDefaultDownstreamCompiler, compilerArg.value, sourceLanguageArg.value);
                         return SLANG_FAIL;
                     }
+                }
+                else if (argValue == "-downstream-staging")
+                {
+                    CommandLineArg name;
+                    SLANG_RETURN_ON_FAIL(reader.expectArg(name));
+
+                    SlangDownstreamStaging staging = SLANG_DOWNSTREAM_STAGING_DEFAULT;
+                    if (name.value == "default")
+                    {
+                        staging = SLANG_DOWNSTREAM_STAGING_DEFAULT;
+                    }
+                    else if (name.value == "memory")
+                    {
+                        staging = SLANG_DOWNSTREAM_STAGING_MEMORY;
+                    }
+                    else
+                    {
+                        sink->diagnose(name.loc, Diagnostics::unknownDownstreamStaging, name.value);
+                        return SLANG_FAIL;
+                    }
+
+                    session->setDownstreamCompilerStaging(staging);
                 }       
                 else if (argValue == "--")
                 {
@@ -903,13 +903,7 @@ SLANG_API SlangInt spReflectionTypeLayout_findFieldIndexByName(SlangReflectionTy
 
     if(auto structTypeLayout = as<StructTypeLayout>(typeLayout))
     {
-        Index fieldCount = structTypeLayout->fields.getCount();
-        for(Index f = 0; f < fieldCount; ++f)
-        {
-            auto field = structTypeLayout->fields[f];
-            if(getReflectionName(field->varDecl)->text.getUnownedSlice() == name)
-                return f;
-        }
+        return structTypeLayout->findFieldIndexByName(name);
     }
 
     return -1;
@@ -4345,6 +4345,31 @@ RefPtr<TypeLayout> TypeLayout::unwrapArray()
 }
 
 
+Index StructTypeLayout::findFieldIndexByName(const UnownedStringSlice& name)
+{
+    // Bring the map up to date with any fields that have been added
+    // since the last lookup.
+    //
+    const Index fieldCount = fields.getCount();
+    for (; m_nameMappedFieldCount < fieldCount; ++m_nameMappedFieldCount)
+    {
+        auto field = fields[m_nameMappedFieldCount];
+        Name* fieldName = field->varDecl ? getReflectionName(field->varDecl) : nullptr;
+        if (!fieldName)
+            continue;
+
+        // `TryGetValueOrAdd` leaves an existing entry alone, so the first
+        // field with a given name is the one that is found.
+        m_mapNameToFieldIndex.TryGetValueOrAdd(fieldName->text.getUnownedSlice(), m_nameMappedFieldCount);
+    }
+
+    if (Index* indexPtr = m_mapNameToFieldIndex.TryGetValue(name))
+    {
+        return *indexPtr;
+    }
+    return -1;
+}
+
 GlobalGenericParamDecl* GenericParamTypeLayout::getGlobalGenericParamDecl()
 {
     auto declRefType = as<DeclRefType>(type);
@@ -658,6 +658,26 @@ public:
     // in the array above, rather than to the actual pointer,
     // so that we 
     Dictionary<VarDeclBase*, RefPtr<VarLayout>> mapVarToLayout;
+
+        /// Find the index of the field (in `fields`) with the given reflection `name`.
+        ///
+        /// Returns -1 if there is no such field. If multiple fields share
+        /// a name, the index of the first one is returned.
+        ///
+        /// Lookups go through a name->index map that is built lazily
+        /// (and extended if more `fields` have been added since the
+        /// last lookup), so repeated queries are O(1) rather than a
+        /// linear scan over the fields.
+    Index findFieldIndexByName(const UnownedStringSlice& name);
+
+protected:
+        /// Maps reflection names to indices in `fields`
+        ///
+        /// The slices reference the text of `Name`s, which are owned by the
+        /// session's name pool, and so outlive the layout.
+    Dictionary<UnownedStringSlice, Index> m_mapNameToFieldIndex;
+        /// The number of entries at the start of `fields` that have been added to `m_mapNameToFieldIndex`
+    Index m_nameMappedFieldCount = 0;
 };
 
 class GenericParamTypeLayout : public TypeLayout
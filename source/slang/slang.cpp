@@ -34,6 +34,7 @@
 #include "slang-doc-markdown-writer.h"
 
 #include "slang-check-impl.h"
+#include "slang-memory-report.h"
 
 #include "../../slang-tag-version.h"
 
@@ -191,10 +192,89 @@ void Session::init()
     m_languagePreludes[Index(SourceLanguage::HLSL)] = get_slang_hlsl_prelude();
 }
 
+void Session::initSharingStdLib(Session* source)
+{
+    // If the source itself shares its stdlib, share from where it gets it from
+    Session* stdLibSession = source->m_stdLibSession ? source->m_stdLibSession.Ptr() : source;
+
+    // From now on the stdlib can't be changed
+    source->m_isStdLibShared = true;
+    stdLibSession->m_isStdLibShared = true;
+    m_isStdLibShared = true;
+
+    m_stdLibSession = stdLibSession;
+
+    // The downstream compilers are per session, and found/loaded on demand
+    ::memcpy(m_downstreamCompilerLocators, source->m_downstreamCompilerLocators, sizeof(m_downstreamCompilerLocators));
+    m_downstreamCompilerSet = new DownstreamCompilerSet;
+
+    // Names created so far (including all those used by the stdlib) are frozen and shared.
+    // Names created from here on are only seen by the session creating them.
+    source->rootNamePool.shareWith(rootNamePool);
+    getNamePool()->setRootNamePool(getRootNamePool());
+
+    m_sharedLibraryLoader = source->m_sharedLibraryLoader;
+
+    m_sharedASTBuilder = new SharedASTBuilder;
+    m_sharedASTBuilder->initSharing(this, stdLibSession->m_sharedASTBuilder);
+
+    globalAstBuilder = new ASTBuilder(m_sharedASTBuilder, "globalAstBuilder");
+
+    // The stdlib source is found via the parent
+    builtinSourceManager.initialize(&stdLibSession->builtinSourceManager, nullptr);
+
+    // The stdlib modules and their scopes are shared as is
+    m_builtinLinkage = stdLibSession->m_builtinLinkage;
+
+    baseLanguageScope = stdLibSession->baseLanguageScope;
+    coreLanguageScope = stdLibSession->coreLanguageScope;
+    hlslLanguageScope = stdLibSession->hlslLanguageScope;
+    slangLanguageScope = stdLibSession->slangLanguageScope;
+
+    baseModuleDecl = stdLibSession->baseModuleDecl;
+    stdlibModules = stdLibSession->stdlibModules;
+
+    // Settings start off the same as the source
+    for (Index i = 0; i < Index(PassThroughMode::CountOf); ++i)
+    {
+        m_downstreamCompilerPaths[i] = source->m_downstreamCompilerPaths[i];
+    }
+    for (Index i = 0; i < Index(SourceLanguage::CountOf); ++i)
+    {
+        m_languagePreludes[i] = source->m_languagePreludes[i];
+        m_defaultDownstreamCompilers[i] = source->m_defaultDownstreamCompilers[i];
+    }
+    m_downstreamStaging = source->m_downstreamStaging;
+}
+
+SlangResult Session::createGlobalSessionSharingStdLib(slang::IGlobalSession** outGlobalSession)
+{
+    if (m_builtinLinkage->mapNameToLoadedModules.Count() == 0)
+    {
+        // There is no stdlib to share
+        return SLANG_FAIL;
+    }
+
+    Session* globalSession = new Session();
+    ComPtr<slang::IGlobalSession> result(globalSession);
+
+    globalSession->initSharingStdLib(this);
+
+    *outGlobalSession = result.detach();
+    return SLANG_OK;
+}
+
 void Session::addBuiltins(
     char const*     sourcePath,
     char const*     sourceString)
 {
+    if (m_isStdLibShared)
+    {
+        // Other sessions are using the stdlib scopes, so they can't be added to
+        SLANG_ASSERT(!"Cannot add builtins to a stdlib that is shared");
+        return;
+    }
+
     // TODO(tfoley): Add ability to directly new builtins to the appropriate scope
     addBuiltinSource(
         coreLanguageScope,
@@ -1052,6 +1132,23 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getMemoryReport(
+    ISlangBlob** outReport)
+{
+    if (!outReport) return SLANG_E_INVALID_ARG;
+
+    MemoryReport report;
+    size_t total = addSessionToMemoryReport(getSessionImpl(), 0, report);
+    total += addLinkageToMemoryReport(this, 0, report);
+    report.add(0, "total", total);
+    report.add(0, "peak back-end IR", getPeakBackEndIRMemoryUsed());
+
+    StringBuilder buf;
+    report.appendAsText(buf);
+    *outReport = StringUtil::createStringBlob(buf).detach();
+    return SLANG_OK;
+}
+
 SlangResult Linkage::addSearchPath(
     char const* path)
 {
@@ -2118,6 +2215,14 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         }
     }
 
+    // If the module is being written out as a container, everything in it
+    // is needed, so function bodies can't be checked lazily.
+    //
+    if (m_containerFormat != ContainerFormat::None)
+    {
+        getFrontEndReq()->compileFlags &= ~SlangCompileFlags(SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING);
+    }
+
     // We only do parsing and semantic checking if we *aren't* doing
     // a pass-through compilation.
     //
@@ -2562,7 +2667,20 @@ RefPtr<Module> Linkage::findOrImportModule(
 
     // Maybe this was loaded previously at a different relative name?
     if (mapPathToLoadedModule.TryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
+    {
+        if (isBeingImported(loadedModule))
+        {
+            sink->diagnose(loc, Diagnostics::recursiveModuleImport, name);
+            return nullptr;
+        }
+
+        // Remember the module under this name too, so that subsequent imports
+        // using the name don't need to search for the file again. This is only
+        // done once the module has been imported, so that the name can't refer
+        // to a module that is part way through being imported.
+        mapNameToLoadedModules[name] = loadedModule;
         return loadedModule;
+    }
 
     // Try to load it
     ComPtr<ISlangBlob> fileContents;
@@ -2822,6 +2940,10 @@ ISlangUnknown* ComponentType::getInterface(Guid const& guid)
     {
         return static_cast<slang::IComponentType*>(this);
     }
+    if(guid == slang::IComponentType2::getTypeGuid())
+    {
+        return static_cast<slang::IComponentType2*>(this);
+    }
 
     return nullptr;
 }
@@ -2900,6 +3022,57 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
     return SLANG_OK;
 }
 
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetCode(
+    SlangInt        targetIndex,
+    slang::IBlob**  outCode,
+    slang::IBlob**  outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if(targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    auto target = linkage->targets[targetIndex];
+
+    auto targetProgram = getTargetProgram(target);
+
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    auto& wholeProgramResult = targetProgram->getOrCreateWholeProgramResult(&sink);
+    sink.getBlobIfNeeded(outDiagnostics);
+
+    if(wholeProgramResult.format == ResultFormat::None )
+        return SLANG_FAIL;
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(wholeProgramResult.getBlob(blob));
+    *outCode = blob.detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetHostCallable(
+    int                     targetIndex,
+    ISlangSharedLibrary**   outSharedLibrary,
+    slang::IBlob**          outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if(targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    auto target = linkage->targets[targetIndex];
+
+    auto targetProgram = getTargetProgram(target);
+
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    auto& wholeProgramResult = targetProgram->getOrCreateWholeProgramResult(&sink);
+    sink.getBlobIfNeeded(outDiagnostics);
+
+    if(wholeProgramResult.format == ResultFormat::None )
+        return SLANG_FAIL;
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    SLANG_RETURN_ON_FAIL(wholeProgramResult.getSharedLibrary(sharedLibrary));
+
+    *outSharedLibrary = sharedLibrary.detach();
+    return SLANG_OK;
+}
+
 RefPtr<ComponentType> ComponentType::specialize(
     SpecializationArg const*    inSpecializationArgs,
     SlangInt                    specializationArgCount,
@@ -3941,6 +4114,19 @@ void EndToEndCompileRequest::setTargetLineDirectiveMode(
     getLinkage()->targets[targetIndex]->setLineDirectiveMode(LineDirectiveMode(mode));
 }
 
+SlangResult EndToEndCompileRequest::getMemoryReport(ISlangBlob** outReport)
+{
+    if (!outReport) return SLANG_E_INVALID_ARG;
+
+    MemoryReport report;
+    addCompileRequestToMemoryReport(this, report);
+
+    StringBuilder buf;
+    report.appendAsText(buf);
+    *outReport = StringUtil::createStringBlob(buf).detach();
+    return SLANG_OK;
+}
+
 SlangResult EndToEndCompileRequest::addTargetCapability(SlangInt targetIndex, SlangCapabilityID capability)
 {
     auto& targets = getLinkage()->targets;
@@ -4275,6 +4461,17 @@ SlangResult EndToEndCompileRequest::EndToEndCompileRequest::compile()
         }
     }
 
+    if (m_reportMemory)
+    {
+        MemoryReport report;
+        addCompileRequestToMemoryReport(this, report);
+
+        StringBuilder buf;
+        buf << "memory report (bytes):\n";
+        report.appendAsText(buf);
+        getWriter(WriterChannel::StdError)->write(buf.getBuffer(), buf.getLength());
+    }
+
     return res;
 }
 
@@ -0,0 +1,44 @@
+//TEST:CPP_COMPILER_EXECUTE:
+
+// Tests the prelude's handling of out of bounds accesses in trap mode, as selected with
+// `-bounds-check-mode trap`. The failure handler is replaced so that execution continues,
+// with the access then handled as in clamp mode.
+
+#include <stdio.h>
+
+static int g_failureCount = 0;
+
+#define SLANG_PRELUDE_BOUND_CHECK_MODE SLANG_PRELUDE_BOUND_CHECK_MODE_TRAP
+#define SLANG_PRELUDE_BOUND_CHECK_FAILED(LOCATION, INDEX, COUNT) \
+    do { g_failureCount++; printf("%s: %d of %d\n", (LOCATION), int(INDEX), int(COUNT)); } while (0)
+
+#include "../../prelude/slang-cpp-prelude.h"
+
+int main(int argc, char** argv)
+{
+    int32_t data[4] = { 1, 2, 3, 4 };
+    uint32_t words[2] = { 16, 32 };
+
+    RWStructuredBuffer<int32_t> buffer = { data, 4 };
+    StructuredBuffer<int32_t> emptyBuffer = { nullptr, 0 };
+    FixedArray<int32_t, 3> array = { { 10, 20, 30 } };
+    RWByteAddressBuffer byteBuffer = { words, 8 };
+
+    // In bounds, so doesn't fail
+    printf("%d\n", buffer.at(3, "test.slang(1)"));
+    // Clamped to the last element
+    printf("%d\n", buffer.at(4, "test.slang(2)"));
+    buffer.at(100, "test.slang(3)") = 5;
+    printf("%d\n", data[3]);
+    printf("%d\n", array.at(3, "test.slang(4)"));
+    // Nothing to clamp to, so reads as zero
+    printf("%d\n", emptyBuffer.at(0, "test.slang(5)"));
+    // Out of bounds byte address loads are zero, and stores are discarded
+    printf("%d\n", int(byteBuffer.Load(4)));
+    printf("%d\n", int(byteBuffer.Load(8)));
+    byteBuffer.Store2(4, uint2{ 1, 2 });
+    printf("%d %d\n", int(words[0]), int(words[1]));
+
+    printf("failures: %d\n", g_failureCount);
+    return 0;
+}
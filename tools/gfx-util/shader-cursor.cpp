@@ -319,4 +319,71 @@ Result ShaderCursor::followPath(const char* path, ShaderCursor& ioCursor)
     return SLANG_OK;
 }
 
+Result ShaderCursorPath::compile(const ShaderCursor& cursor, const char* path, ShaderCursorPath& outPath)
+{
+    if (!cursor.isValid() || cursor.m_containerType != ShaderObjectContainerType::None)
+        return SLANG_E_INVALID_ARG;
+
+    // Rather than duplicate the logic of `getField`/`getElement` we follow the
+    // path from cursors with known offsets, and work out how the offsets were
+    // transformed.
+    //
+    // The uniform offset and binding range index are only ever added to along a
+    // path. The binding array index is scaled by the element count of each array
+    // passed through and then has the element index added, so overall it is
+    // `base * scale + index`. Following from a base array index of 0 gives `index`,
+    // and following from 1 gives `scale + index`.
+    //
+    ShaderCursor base = cursor;
+    base.m_offset = ShaderOffset();
+
+    ShaderCursor atZero = base;
+    SLANG_RETURN_ON_FAIL(ShaderCursor::followPath(path, atZero));
+
+    ShaderCursor atOne = base;
+    atOne.m_offset.bindingArrayIndex = 1;
+    SLANG_RETURN_ON_FAIL(ShaderCursor::followPath(path, atOne));
+
+    // The path must lead somewhere, and stay within the same object. If it
+    // moved into another object the offsets are relative to that object, which
+    // may not be the same for other objects the path is applied to.
+    //
+    if (!atZero.isValid() || atZero.m_baseObject != cursor.m_baseObject ||
+        atZero.m_containerType != ShaderObjectContainerType::None)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ShaderCursorPath compiledPath;
+    compiledPath.m_baseTypeLayout = cursor.m_typeLayout;
+    compiledPath.m_typeLayout = atZero.m_typeLayout;
+    compiledPath.m_uniformOffset = atZero.m_offset.uniformOffset;
+    compiledPath.m_bindingRangeIndex = atZero.m_offset.bindingRangeIndex;
+    compiledPath.m_bindingArrayIndex = atZero.m_offset.bindingArrayIndex;
+    compiledPath.m_bindingArrayScale = atOne.m_offset.bindingArrayIndex - atZero.m_offset.bindingArrayIndex;
+
+    outPath = compiledPath;
+    return SLANG_OK;
+}
+
+Result ShaderCursorPath::apply(const ShaderCursor& cursor, ShaderCursor& outCursor) const
+{
+    if (!isValid() || !cursor.isValid() || cursor.m_typeLayout != m_baseTypeLayout ||
+        cursor.m_containerType != ShaderObjectContainerType::None)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ShaderCursor result;
+    result.m_baseObject = cursor.m_baseObject;
+    result.m_typeLayout = m_typeLayout;
+    result.m_offset.uniformOffset = cursor.m_offset.uniformOffset + m_uniformOffset;
+    result.m_offset.bindingRangeIndex = cursor.m_offset.bindingRangeIndex + m_bindingRangeIndex;
+    result.m_offset.bindingArrayIndex =
+        cursor.m_offset.bindingArrayIndex * m_bindingArrayScale + m_bindingArrayIndex;
+
+    outCursor = result;
+    return SLANG_OK;
+}
+
 } // namespace gfx
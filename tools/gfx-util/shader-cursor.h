@@ -5,6 +5,8 @@
 namespace gfx
 {
 
+struct ShaderCursorPath;
+
 /// Represents a "pointer" to the storage for a shader parameter of a (dynamically) known type.
 ///
 /// A `ShaderCursor` serves as a pointer-like type for things stored inside a `ShaderObject`.
@@ -74,6 +76,12 @@ struct ShaderCursor
         return result;
     }
 
+    /// Form the cursor that a previously compiled `path` leads to from this cursor.
+    ///
+    /// Produces the same result as `getPath` with the path's original text, without
+    /// parsing the text or looking up fields by name.
+    ShaderCursor getPath(const ShaderCursorPath& path) const;
+
     ShaderCursor() {}
 
     ShaderCursor(IShaderObject* object)
@@ -132,4 +140,57 @@ struct ShaderCursor
     ShaderCursor operator[](int8_t index) const { return getElement((SlangInt)index); }
     ShaderCursor operator[](uint8_t index) const { return getElement((SlangInt)index); }
 };
+
+/// A path (as accepted by `ShaderCursor::getPath`) that has been resolved ahead of time.
+///
+/// Following a path by name requires parsing it and looking up each field, which is
+/// wasteful when the same parameter is written over and over (for example, every frame).
+/// A `ShaderCursorPath` is compiled once against a cursor, and records the type layout
+/// the path leads to along with how it transforms the cursor's `ShaderOffset`. It can then
+/// be applied to any cursor with the same type layout (typically the same parameter on
+/// another shader object of the same type) in constant time.
+///
+/// Only paths that stay within a single shader object can be compiled. A path that
+/// dereferences a `ConstantBuffer` or `ParameterBlock`, or finds a parameter via an entry
+/// point, moves to another object; such a path should instead be compiled relative to a
+/// cursor for the sub-object it leads into.
+///
+struct ShaderCursorPath
+{
+    /// The type layout of cursors this path can be applied to
+    slang::TypeLayoutReflection* m_baseTypeLayout = nullptr;
+    /// The type layout of the value the path leads to
+    slang::TypeLayoutReflection* m_typeLayout = nullptr;
+
+    /// Added to the base cursor's uniform offset
+    SlangInt m_uniformOffset = 0;
+    /// Added to the base cursor's binding range index
+    SlangInt m_bindingRangeIndex = 0;
+    /// The resulting binding array index is `base * m_bindingArrayScale + m_bindingArrayIndex`
+    SlangInt m_bindingArrayScale = 1;
+    SlangInt m_bindingArrayIndex = 0;
+
+    /// Is this a successfully compiled path?
+    bool isValid() const { return m_typeLayout != nullptr; }
+
+    /// Compile `path` relative to `cursor`.
+    ///
+    /// Fails if the path is malformed, doesn't lead anywhere, or leaves the shader object
+    /// `cursor` points into. Cursors for elements of container objects (such as a
+    /// `StructuredBuffer` shader object) are not supported as a base.
+    static Result compile(const ShaderCursor& cursor, const char* path, ShaderCursorPath& outPath);
+
+    /// Apply the path to `cursor`, writing the resulting cursor to `outCursor`.
+    ///
+    /// Fails if `cursor` does not have the type layout the path was compiled against.
+    Result apply(const ShaderCursor& cursor, ShaderCursor& outCursor) const;
+};
+
+inline ShaderCursor ShaderCursor::getPath(const ShaderCursorPath& path) const
+{
+    ShaderCursor result;
+    path.apply(*this, result);
+    return result;
+}
+
 }
@@ -15,6 +15,10 @@
 #define SLANG_PRELUDE_NAMESPACE slang_prelude
 #include "prelude/slang-cpp-types.h"
 
+#if SLANG_PROCESSOR_X86_64
+#   include <emmintrin.h>
+#endif
+
 namespace gfx
 {
 using namespace Slang;
@@ -80,9 +84,13 @@ static CPUTextureBaseShapeInfo const* _getBaseShapeInfo(ITextureResource::Type b
 
 typedef void (*CPUTextureUnpackFunc)(void const* texelData, void* outData, size_t outSize);
 
+    /// Computes the weighted sum of `count` texels, writing the result as 4 floats to `outTexel`.
+typedef void (*CPUTextureFilterFunc)(void const* const* texels, float const* weights, int count, float* outTexel);
+
 struct CPUTextureFormatInfo
 {
     CPUTextureUnpackFunc unpackFunc;
+    CPUTextureFilterFunc filterFunc;        ///< nullptr if the format can't be filtered (e.g. integer formats)
 };
 
 template<int N>
@@ -163,33 +171,113 @@ void _unpackUInt32Texel(void const* texelData, void* outData, size_t outSize)
     memcpy(outData, temp, outSize);
 }
 
+template<CPUTextureUnpackFunc UNPACK>
+void _filterTexels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < count; ++i)
+    {
+        float texel[4];
+        UNPACK(texels[i], texel, sizeof(texel));
+        for (int j = 0; j < 4; ++j)
+            sum[j] += texel[j] * weights[i];
+    }
+    memcpy(outTexel, sum, sizeof(sum));
+}
+
+#if SLANG_PROCESSOR_X86_64
+
+// SSE2 versions for the most common formats, which unpack and weight all 4 channels at once.
+
+void _filterFloat4Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    __m128 sum = _mm_setzero_ps();
+    for (int i = 0; i < count; ++i)
+    {
+        __m128 texel = _mm_loadu_ps((float const*)texels[i]);
+        sum = _mm_add_ps(sum, _mm_mul_ps(texel, _mm_set1_ps(weights[i])));
+    }
+    _mm_storeu_ps(outTexel, sum);
+}
+
+static SLANG_FORCE_INLINE __m128 _sumUnorm8x4Texels(void const* const* texels, float const* weights, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128 sum = _mm_setzero_ps();
+    for (int i = 0; i < count; ++i)
+    {
+        int32_t packed;
+        memcpy(&packed, texels[i], sizeof(packed));
+
+        // Widen the 4 bytes to 4 x int32
+        __m128i texel = _mm_cvtsi32_si128(packed);
+        texel = _mm_unpacklo_epi8(texel, zero);
+        texel = _mm_unpacklo_epi16(texel, zero);
+
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(texel), _mm_set1_ps(weights[i])));
+    }
+    // Divide (rather than multiply by the reciprocal) so that 255 maps exactly to 1.0
+    return _mm_div_ps(sum, _mm_set1_ps(255.0f));
+}
+
+void _filterUnorm8x4Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    _mm_storeu_ps(outTexel, _sumUnorm8x4Texels(texels, weights, count));
+}
+
+void _filterUnormBGRA8Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    __m128 sum = _sumUnorm8x4Texels(texels, weights, count);
+    _mm_storeu_ps(outTexel, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 0, 1, 2)));
+}
+
+#else
+
+void _filterFloat4Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    _filterTexels<&_unpackFloatTexel<4>>(texels, weights, count, outTexel);
+}
+
+void _filterUnorm8x4Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    _filterTexels<&_unpackUnorm8Texel<4>>(texels, weights, count, outTexel);
+}
+
+void _filterUnormBGRA8Texels(void const* const* texels, float const* weights, int count, float* outTexel)
+{
+    _filterTexels<&_unpackUnormBGRA8Texel>(texels, weights, count, outTexel);
+}
+
+#endif
+
 struct CPUFormatInfoMap
 {
     CPUFormatInfoMap()
     {
         memset(m_infos, 0, sizeof(m_infos));
 
-        set(Format::RGBA_Float32, &_unpackFloatTexel<4>);
-        set(Format::RGB_Float32, &_unpackFloatTexel<3>);
+        set(Format::RGBA_Float32, &_unpackFloatTexel<4>, &_filterFloat4Texels);
+        set(Format::RGB_Float32, &_unpackFloatTexel<3>, &_filterTexels<&_unpackFloatTexel<3>>);
 
-        set(Format::RG_Float32, &_unpackFloatTexel<2>);
-        set(Format::R_Float32, &_unpackFloatTexel<1>);
+        set(Format::RG_Float32, &_unpackFloatTexel<2>, &_filterTexels<&_unpackFloatTexel<2>>);
+        set(Format::R_Float32, &_unpackFloatTexel<1>, &_filterTexels<&_unpackFloatTexel<1>>);
 
-        set(Format::RGBA_Float16, &_unpackFloat16Texel<4>);
-        set(Format::RG_Float16, &_unpackFloat16Texel<2>);
-        set(Format::R_Float16, &_unpackFloat16Texel<1>);
+        set(Format::RGBA_Float16, &_unpackFloat16Texel<4>, &_filterTexels<&_unpackFloat16Texel<4>>);
+        set(Format::RG_Float16, &_unpackFloat16Texel<2>, &_filterTexels<&_unpackFloat16Texel<2>>);
+        set(Format::R_Float16, &_unpackFloat16Texel<1>, &_filterTexels<&_unpackFloat16Texel<1>>);
 
-        set(Format::RGBA_Unorm_UInt8, &_unpackUnorm8Texel<4>);
-        set(Format::BGRA_Unorm_UInt8, &_unpackUnormBGRA8Texel);
-        set(Format::R_UInt16, &_unpackUInt16Texel<1>);
-        set(Format::R_UInt32, &_unpackUInt32Texel<1>);
-        set(Format::D_Float32, &_unpackFloatTexel<1>);
+        set(Format::RGBA_Unorm_UInt8, &_unpackUnorm8Texel<4>, &_filterUnorm8x4Texels);
+        set(Format::BGRA_Unorm_UInt8, &_unpackUnormBGRA8Texel, &_filterUnormBGRA8Texels);
+        set(Format::R_UInt16, &_unpackUInt16Texel<1>, nullptr);
+        set(Format::R_UInt32, &_unpackUInt32Texel<1>, nullptr);
+        set(Format::D_Float32, &_unpackFloatTexel<1>, &_filterTexels<&_unpackFloatTexel<1>>);
     }
 
-    void set(Format format, CPUTextureUnpackFunc func)
+    void set(Format format, CPUTextureUnpackFunc unpackFunc, CPUTextureFilterFunc filterFunc)
     {
         auto& info = m_infos[Index(format)];
-        info.unpackFunc = func;
+        info.unpackFunc = unpackFunc;
+        info.filterFunc = filterFunc;
     }
     SLANG_FORCE_INLINE const CPUTextureFormatInfo& get(Format format) const { return m_infos[Index(format)]; }
 
@@ -365,6 +453,31 @@ public:
     void*           m_data = nullptr;
 };
 
+class CPUSamplerState : public ISamplerState, public ComObject
+{
+public:
+    SLANG_COM_OBJECT_IUNKNOWN_ALL
+    ISamplerState* getInterface(const Guid& guid)
+    {
+        if (guid == GfxGUID::IID_ISlangUnknown || guid == GfxGUID::IID_ISamplerState)
+            return static_cast<ISamplerState*>(this);
+        return nullptr;
+    }
+
+    CPUSamplerState(Desc const& desc)
+        : m_desc(desc)
+    {}
+
+        /// Get the sampler referenced by a `SamplerState` value passed to kernel code.
+        /// The prelude `ISamplerState` type is opaque, and the shader object stores a `CPUSamplerState` pointer in it.
+    static CPUSamplerState* fromPrelude(slang_prelude::SamplerState samplerState)
+    {
+        return reinterpret_cast<CPUSamplerState*>(samplerState.state);
+    }
+
+    Desc m_desc;
+};
+
 class CPUResourceView : public ResourceViewBase
 {
 public:
@@ -452,52 +565,96 @@ public:
 
     void SampleLevel(slang_prelude::SamplerState samplerState, const float* coords, float level, void* outData, size_t dataSize) SLANG_OVERRIDE
     {
+        static const ISamplerState::Desc kDefaultSamplerDesc = ISamplerState::Desc();
+
         CPUTextureResource* texture = m_texture;
         auto baseShape = texture->m_baseShape;
         auto& desc = texture->_getDesc();
-        int32_t rank = baseShape->rank;
-        int32_t baseCoordCount = baseShape->baseCoordCount;
+        auto formatInfo = texture->m_formatInfo;
 
-        int32_t integerMipLevel = int32_t(level + 0.5f);
-        if(integerMipLevel >= desc.numMipLevels) integerMipLevel = desc.numMipLevels-1;
-        if(integerMipLevel < 0) integerMipLevel = 0;
+        CPUSamplerState* sampler = CPUSamplerState::fromPrelude(samplerState);
+        auto& samplerDesc = sampler ? sampler->m_desc : kDefaultSamplerDesc;
 
-        auto& mipLevelInfo = texture->m_mipLevels[integerMipLevel];
-
-        bool isArray = (desc.arraySize != 0) || (desc.type == ITextureResource::Type::TextureCube);
-        int32_t effectiveArrayElementCount = texture->m_effectiveArrayElementCount;
-        int32_t coordIndex = baseCoordCount;
+        // Work out the normalized location within a single (2D/3D) image, and which array element/cube face it is in.
+        float location[kMaxRank] = { 0.0f, 0.0f, 0.0f };
+        TextureAddressingMode addressModes[kMaxRank] = { samplerDesc.addressU, samplerDesc.addressV, samplerDesc.addressW };
+        int32_t coordIndex = baseShape->baseCoordCount;
         int32_t elementIndex = 0;
-        if( isArray )
+        if (desc.type == ITextureResource::Type::TextureCube)
         {
-            elementIndex = int32_t(coords[coordIndex++] + 0.5f);
+            elementIndex = _calcCubeFaceLocation(coords, location);
+            // Filtering doesn't cross cube faces, so the best we can do is to clamp at the edges
+            addressModes[0] = addressModes[1] = TextureAddressingMode::ClampToEdge;
         }
-        if(elementIndex >= effectiveArrayElementCount) elementIndex = effectiveArrayElementCount-1;
-        if(elementIndex < 0) elementIndex = 0;
-
-        // Note: for now we are just going to do nearest-neighbor sampling
-        //
-        int64_t texelOffset = mipLevelInfo.offset;
-        texelOffset += elementIndex * mipLevelInfo.strides[3];
-        for(int32_t axis = 0; axis < rank; ++axis)
+        else
+        {
+            for (int32_t axis = 0; axis < baseShape->rank; ++axis)
+                location[axis] = coords[axis];
+        }
+        if (desc.arraySize != 0)
         {
-            int32_t extent = mipLevelInfo.extents[axis];
+            int32_t arrayIndex = int32_t(coords[coordIndex++] + 0.5f);
+            elementIndex += arrayIndex * baseShape->implicitArrayElementCount;
+        }
+        if(elementIndex >= texture->m_effectiveArrayElementCount) elementIndex = texture->m_effectiveArrayElementCount-1;
+        if(elementIndex < 0) elementIndex = 0;
 
-            float coord = coords[axis];
+        // Work out the level of detail, and the filtering needed within and between mip levels.
+        float lod = level + samplerDesc.mipLODBias;
+        if (lod < samplerDesc.minLOD) lod = samplerDesc.minLOD;
+        if (lod > samplerDesc.maxLOD) lod = samplerDesc.maxLOD;
 
-            // TODO: deal with wrap/clamp/repeat if `coord < 0` or `coord > 1`
+        TextureFilteringMode filter = (lod <= 0.0f) ? samplerDesc.magFilter : samplerDesc.minFilter;
+        TextureFilteringMode mipFilter = samplerDesc.mipFilter;
+        if (!formatInfo->filterFunc)
+        {
+            filter = TextureFilteringMode::Point;
+            mipFilter = TextureFilteringMode::Point;
+        }
 
-            int32_t integerCoord = int32_t(coord*(extent-1) + 0.5f);
+        const int32_t levelCount = int32_t(texture->m_mipLevels.getCount());
+        const float maxLevel = float(levelCount - 1);
+        if (lod < 0.0f) lod = 0.0f;
+        if (lod > maxLevel) lod = maxLevel;
 
-            if(integerCoord >= extent) integerCoord = extent-1;
-            if(integerCoord < 0) integerCoord = 0;
+        TexelFootprint footprint;
+        if (mipFilter == TextureFilteringMode::Linear)
+        {
+            const int32_t baseLevel = int32_t(lod);
+            const float fraction = lod - float(baseLevel);
 
-            texelOffset += integerCoord * mipLevelInfo.strides[axis];
+            _addFootprint(baseLevel, elementIndex, location, filter, addressModes, 1.0f - fraction, footprint);
+            if (fraction > 0.0f)
+            {
+                _addFootprint(baseLevel + 1, elementIndex, location, filter, addressModes, fraction, footprint);
+            }
+        }
+        else
+        {
+            _addFootprint(int32_t(lod + 0.5f), elementIndex, location, filter, addressModes, 1.0f, footprint);
         }
 
-        auto texelPtr = (char const*)texture->m_data + texelOffset;
-
-        m_texture->m_formatInfo->unpackFunc(texelPtr, outData, dataSize);
+        if (formatInfo->filterFunc)
+        {
+            float result[4];
+            formatInfo->filterFunc(footprint.texels, footprint.weights, footprint.count, result);
+            if (footprint.borderWeight > 0.0f)
+            {
+                for (int i = 0; i < 4; ++i)
+                    result[i] += samplerDesc.borderColor[i] * footprint.borderWeight;
+            }
+            memcpy(outData, result, dataSize);
+        }
+        else if (footprint.count)
+        {
+            // Point sampled, so there is just the one texel
+            formatInfo->unpackFunc(footprint.texels[0], outData, dataSize);
+        }
+        else
+        {
+            // Integer formats just read as zero from the border
+            memset(outData, 0, dataSize);
+        }
     }
 
     //
@@ -510,6 +667,175 @@ public:
     }
 
 private:
+    enum { kMaxRank = 3 };
+
+        /// The texels (and their weights) that contribute to a filtered sample.
+        /// At most 2 mip levels of a 2x2x2 neighborhood.
+    struct TexelFootprint
+    {
+        enum { kMaxTexelCount = 16 };
+
+        void const* texels[kMaxTexelCount];
+        float weights[kMaxTexelCount];
+        int count = 0;
+        float borderWeight = 0.0f;      ///< The total weight of locations that fall on the border
+    };
+
+        /// Map the texel `coord` onto the range [0, extent) according to `mode`.
+        /// Returns -1 if the texel is on the border.
+    static int32_t _applyAddressMode(int32_t coord, int32_t extent, TextureAddressingMode mode)
+    {
+        if (coord >= 0 && coord < extent)
+            return coord;
+
+        switch (mode)
+        {
+        default:
+        case TextureAddressingMode::Wrap:
+            coord %= extent;
+            return coord < 0 ? coord + extent : coord;
+        case TextureAddressingMode::ClampToEdge:
+            return coord < 0 ? 0 : extent - 1;
+        case TextureAddressingMode::ClampToBorder:
+            return -1;
+        case TextureAddressingMode::MirrorRepeat:
+        {
+            const int32_t period = extent * 2;
+            coord %= period;
+            coord = coord < 0 ? coord + period : coord;
+            return coord < extent ? coord : period - 1 - coord;
+        }
+        case TextureAddressingMode::MirrorOnce:
+            coord = coord < 0 ? -coord - 1 : coord;
+            return coord < extent ? coord : extent - 1;
+        }
+    }
+
+        /// Select the cube face for `direction`, and write the location on that face to `outLocation`.
+        /// Returns the face index.
+    static int32_t _calcCubeFaceLocation(const float* direction, float* outLocation)
+    {
+        const float x = direction[0], y = direction[1], z = direction[2];
+        const float ax = fabsf(x), ay = fabsf(y), az = fabsf(z);
+
+        int32_t face;
+        float majorAxis, s, t;
+        if (ax >= ay && ax >= az)
+        {
+            face = x >= 0.0f ? 0 : 1;
+            majorAxis = ax;
+            s = x >= 0.0f ? -z : z;
+            t = -y;
+        }
+        else if (ay >= az)
+        {
+            face = y >= 0.0f ? 2 : 3;
+            majorAxis = ay;
+            s = x;
+            t = y >= 0.0f ? z : -z;
+        }
+        else
+        {
+            face = z >= 0.0f ? 4 : 5;
+            majorAxis = az;
+            s = z >= 0.0f ? x : -x;
+            t = -y;
+        }
+
+        const float scale = majorAxis > 0.0f ? 0.5f / majorAxis : 0.0f;
+        outLocation[0] = s * scale + 0.5f;
+        outLocation[1] = t * scale + 0.5f;
+        outLocation[2] = 0.0f;
+        return face;
+    }
+
+        /// Add the texels of mip level `levelIndex` that contribute to a sample at the normalized `location`
+        /// to `ioFootprint`, with their weights scaled by `levelWeight`.
+    void _addFootprint(
+        int32_t levelIndex,
+        int32_t elementIndex,
+        const float* location,
+        TextureFilteringMode filter,
+        const TextureAddressingMode* addressModes,
+        float levelWeight,
+        TexelFootprint& ioFootprint)
+    {
+        CPUTextureResource* texture = m_texture;
+        const int32_t rank = texture->getRank();
+        auto& mipLevelInfo = texture->m_mipLevels[levelIndex];
+
+        // The (up to) 2 texels along each axis and their weights. Texel offsets of -1 mark the border.
+        int64_t axisOffsets[kMaxRank][2];
+        float axisWeights[kMaxRank][2];
+        int32_t axisCounts[kMaxRank];
+
+        for (int32_t axis = 0; axis < kMaxRank; ++axis)
+        {
+            if (axis >= rank)
+            {
+                axisOffsets[axis][0] = 0;
+                axisWeights[axis][0] = 1.0f;
+                axisCounts[axis] = 1;
+                continue;
+            }
+
+            const int32_t extent = mipLevelInfo.extents[axis];
+            const int64_t stride = mipLevelInfo.strides[axis];
+            const TextureAddressingMode mode = addressModes[axis];
+
+            int32_t coords[2];
+            if (filter == TextureFilteringMode::Linear)
+            {
+                // Texel centers are at half integer locations
+                const float texelLocation = location[axis] * extent - 0.5f;
+                const float base = floorf(texelLocation);
+                const float fraction = texelLocation - base;
+
+                coords[0] = int32_t(base);
+                coords[1] = coords[0] + 1;
+                axisWeights[axis][0] = 1.0f - fraction;
+                axisWeights[axis][1] = fraction;
+                axisCounts[axis] = fraction > 0.0f ? 2 : 1;
+            }
+            else
+            {
+                coords[0] = int32_t(floorf(location[axis] * extent));
+                axisWeights[axis][0] = 1.0f;
+                axisCounts[axis] = 1;
+            }
+
+            for (int32_t i = 0; i < axisCounts[axis]; ++i)
+            {
+                const int32_t coord = _applyAddressMode(coords[i], extent, mode);
+                axisOffsets[axis][i] = coord < 0 ? -1 : coord * stride;
+            }
+        }
+
+        const int64_t baseOffset = mipLevelInfo.offset + elementIndex * mipLevelInfo.strides[3];
+        char const* data = (char const*)texture->m_data;
+
+        for (int32_t k = 0; k < axisCounts[2]; ++k)
+        {
+            for (int32_t j = 0; j < axisCounts[1]; ++j)
+            {
+                for (int32_t i = 0; i < axisCounts[0]; ++i)
+                {
+                    const float weight = levelWeight * axisWeights[0][i] * axisWeights[1][j] * axisWeights[2][k];
+                    if (axisOffsets[0][i] < 0 || axisOffsets[1][j] < 0 || axisOffsets[2][k] < 0)
+                    {
+                        ioFootprint.borderWeight += weight;
+                        continue;
+                    }
+
+                    SLANG_ASSERT(ioFootprint.count < TexelFootprint::kMaxTexelCount);
+                    const Index index = ioFootprint.count++;
+                    ioFootprint.texels[index] = data + baseOffset + axisOffsets[0][i] + axisOffsets[1][j] + axisOffsets[2][k];
+                    ioFootprint.weights[index] = weight;
+                }
+            }
+        }
+    }
+
     RefPtr<CPUTextureResource> m_texture;
 
     void* _getTexelPtr(int32_t const* texelCoords)
@@ -831,6 +1157,7 @@ class CPUShaderObject
 
 public:
     List<RefPtr<CPUResourceView>> m_resources;
+    List<RefPtr<CPUSamplerState>> m_samplers;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
         init(IDevice* device, CPUShaderObjectLayout* typeLayout);
@@ -927,9 +1254,22 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
         setSampler(ShaderOffset const& offset, ISamplerState* sampler) override
     {
-        SLANG_UNUSED(sampler);
-        SLANG_UNUSED(offset);
-        return SLANG_OK;
+        auto layout = getLayout();
+
+        auto bindingRangeIndex = offset.bindingRangeIndex;
+        SLANG_ASSERT(bindingRangeIndex >= 0);
+        SLANG_ASSERT(bindingRangeIndex < layout->m_bindingRanges.getCount());
+
+        auto& bindingRange = layout->m_bindingRanges[bindingRangeIndex];
+        auto samplerIndex = bindingRange.baseIndex + offset.bindingArrayIndex;
+
+        auto samplerImpl = static_cast<CPUSamplerState*>(sampler);
+        m_samplers[samplerIndex] = samplerImpl;
+
+        // See `CPUSamplerState::fromPrelude`
+        slang_prelude::SamplerState samplerObj;
+        samplerObj.state = reinterpret_cast<slang_prelude::ISamplerState*>(samplerImpl);
+        return setData(offset, &samplerObj, sizeof(samplerObj));
     }
     virtual SLANG_NO_THROW Result SLANG_MCALL setCombinedTextureSampler(
         ShaderOffset const& offset, IResourceView* textureView, ISamplerState* sampler) override
@@ -1287,8 +1627,8 @@ public:
     virtual SLANG_NO_THROW Result SLANG_MCALL
         createSamplerState(ISamplerState::Desc const& desc, ISamplerState** outSampler) override
     {
-        SLANG_UNUSED(desc);
-        *outSampler = nullptr;
+        RefPtr<CPUSamplerState> sampler = new CPUSamplerState(desc);
+        returnComPtr(outSampler, sampler);
         return SLANG_OK;
     }
 
@@ -1332,6 +1672,7 @@ SlangResult CPUShaderObject::init(IDevice* device, CPUShaderObjectLayout* typeLa
     // and not just the number of resource/sub-object ranges.
     //
     m_resources.setCount(typeLayout->getResourceCount());
+    m_samplers.setCount(typeLayout->getResourceCount());
     m_objects.setCount(typeLayout->getSubObjectCount());
 
     for (auto subObjectRange : getLayout()->subObjectRanges)
@@ -172,6 +172,22 @@ struct AssignValsFromLayoutContext
         }
     }
 
+        /// Get the cursor for the named `path` from `cursor`.
+        ///
+        /// The path is compiled into a `ShaderCursorPath` and then applied, as an application
+        /// setting the same parameter repeatedly would, so that compiled paths are exercised by
+        /// any test with named inputs. Paths that can't be compiled (because they leave the
+        /// object `cursor` points into) are followed by name.
+    static ShaderCursor getPath(ShaderCursor const& cursor, const char* path)
+    {
+        ShaderCursorPath compiledPath;
+        if (SLANG_SUCCEEDED(ShaderCursorPath::compile(cursor, path, compiledPath)))
+        {
+            return cursor.getPath(compiledPath);
+        }
+        return cursor.getPath(path);
+    }
+
     SlangResult assignData(ShaderCursor const& dstCursor, ShaderInputLayout::DataVal* srcVal)
     {
         const size_t bufferSize = srcVal->bufferData.getCount() * sizeof(uint32_t);
@@ -297,7 +313,7 @@ struct AssignValsFromLayoutContext
             }
             else
             {
-                auto fieldCursor = dstCursor.getPath(field.name.getBuffer());
+                auto fieldCursor = getPath(dstCursor, field.name.getBuffer());
                 if(!fieldCursor.isValid())
                 {
                     StdWriters::getError().print("error: could not find shader parameter matching '%s'\n", field.name.begin());
@@ -139,6 +139,34 @@ namespace renderer_test
             {
                 val->samplerDesc.isCompareSampler = true;
             }
+            else if (word == "filteringMode")
+            {
+                parser.Read("=");
+                auto modeWord = parser.ReadWord();
+                if (modeWord == "point")
+                    val->samplerDesc.filteringMode = TextureFilteringMode::Point;
+                else if (modeWord == "linear")
+                    val->samplerDesc.filteringMode = TextureFilteringMode::Linear;
+                else
+                    return SLANG_FAIL;
+            }
+            else if (word == "addressingMode")
+            {
+                parser.Read("=");
+                auto modeWord = parser.ReadWord();
+                if (modeWord == "wrap")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::Wrap;
+                else if (modeWord == "clamp")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::ClampToEdge;
+                else if (modeWord == "border")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::ClampToBorder;
+                else if (modeWord == "mirror")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::MirrorRepeat;
+                else if (modeWord == "mirrorOnce")
+                    val->samplerDesc.addressingMode = TextureAddressingMode::MirrorOnce;
+                else
+                    return SLANG_FAIL;
+            }
             else
             {
                 return SLANG_FAIL;
@@ -63,6 +63,8 @@ struct InputBufferDesc
 struct InputSamplerDesc
 {
     bool isCompareSampler = false;
+    TextureFilteringMode filteringMode = TextureFilteringMode::Linear;
+    TextureAddressingMode addressingMode = TextureAddressingMode::Wrap;
 };
 
 struct TextureData
@@ -136,6 +136,12 @@ static ISamplerState::Desc _calcSamplerDesc(const InputSamplerDesc& srcDesc)
         dstDesc.reductionOp = TextureReductionOp::Comparison;
         dstDesc.comparisonFunc = ComparisonFunc::Less;
     }
+    dstDesc.minFilter = srcDesc.filteringMode;
+    dstDesc.magFilter = srcDesc.filteringMode;
+    dstDesc.mipFilter = srcDesc.filteringMode;
+    dstDesc.addressU = srcDesc.addressingMode;
+    dstDesc.addressV = srcDesc.addressingMode;
+    dstDesc.addressW = srcDesc.addressingMode;
     return dstDesc;
 }
 
@@ -80,6 +80,16 @@ void ShaderCompilerUtil::Output::reset()
     out.m_requestForKernels = slangRequest;
     out.session = session->getGlobalSession();
 
+    // Set up flags before parsing the extra args, so that any flags they set are added to these
+    if (input.passThrough != SLANG_PASS_THROUGH_NONE)
+    {
+        spSetPassThrough(slangRequest, input.passThrough);
+    }
+    else
+    {
+        spSetCompileFlags(slangRequest, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    }
+
     // Parse all the extra args
     {
         List<const char*> args;
@@ -127,15 +137,6 @@ void ShaderCompilerUtil::Output::reset()
         break;
     }
 
-    if (input.passThrough != SLANG_PASS_THROUGH_NONE)
-    {
-        spSetPassThrough(slangRequest, input.passThrough);
-    }
-    else
-    {
-        spSetCompileFlags(slangRequest, SLANG_COMPILE_FLAG_NO_CODEGEN);
-    }
-
     
     const auto sourceLanguage = input.sourceLanguage;
 
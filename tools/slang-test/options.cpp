@@ -208,6 +208,34 @@ static bool _isSubCommand(const char* arg)
         {
             optionsOut->outputMode = TestOutputMode::TeamCity;
         }
+        else if (strcmp(arg, "-j") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            const char* jobCountText = *argCursor++;
+            optionsOut->jobCount = StringToInt(jobCountText);
+            if (optionsOut->jobCount < 1)
+            {
+                stdError.print("error: expected a job count of at least 1 for '%s', found '%s'\n", arg, jobCountText);
+                return SLANG_FAIL;
+            }
+        }
+        else if (strcmp(arg, "-persistent-workers") == 0)
+        {
+            optionsOut->usePersistentWorkers = true;
+        }
+        else if (strcmp(arg, "-test-worker") == 0)
+        {
+            optionsOut->isTestWorker = true;
+            optionsOut->outputMode = TestOutputMode::Worker;
+        }
+        else if (strcmp(arg, "-timings") == 0)
+        {
+            optionsOut->showTimings = true;
+        }
         else if (strcmp(arg, "-category") == 0)
         {
             if (argCursor == argEnd)
@@ -72,6 +72,18 @@ struct Options
     // kind of output to generate
     TestOutputMode outputMode = TestOutputMode::Default;
 
+    // The maximum amount of test files that are run concurrently. If > 1 test files are run in worker processes.
+    int jobCount = 1;
+
+    // If set workers are kept alive and each runs a share of the test files (rather than a new process per test file)
+    bool usePersistentWorkers = false;
+
+    // If set this slang-test is a worker - test files to run are read from stdin, and results are output for a parent slang-test
+    bool isTestWorker = false;
+
+    // If set the time taken for each test is output, and the slowest tests are listed in the summary
+    bool showTimings = false;
+
     // Only run tests that match one of the given categories
     Slang::Dictionary<TestCategory*, TestCategory*> includeCategories;
 
@@ -1334,6 +1334,154 @@ static SlangResult _readExpected(const UnownedStringSlice& stem, String& out)
     return _readText(buf.getUnownedSlice(), out);
 }
 
+// A pattern from a `CHECK:` or `CHECK-NOT:` line of a FILECHECK test
+struct FileCheckPattern
+{
+    bool isNot;
+    UnownedStringSlice text;
+};
+
+static void _findFileCheckPatterns(const UnownedStringSlice& source, List<FileCheckPattern>& outPatterns)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(source, lines);
+
+    for (const auto& line : lines)
+    {
+        static const UnownedStringSlice checkNot = UnownedStringSlice::fromLiteral("CHECK-NOT:");
+        static const UnownedStringSlice check = UnownedStringSlice::fromLiteral("CHECK:");
+
+        const UnownedStringSlice trimmedLine = line.trim();
+        if (!trimmedLine.startsWith(UnownedStringSlice::fromLiteral("//")))
+        {
+            continue;
+        }
+        const UnownedStringSlice comment = UnownedStringSlice(trimmedLine.begin() + 2, trimmedLine.end()).trim();
+
+        FileCheckPattern pattern;
+        if (comment.startsWith(checkNot))
+        {
+            pattern.isNot = true;
+            pattern.text = UnownedStringSlice(comment.begin() + checkNot.getLength(), comment.end()).trim();
+        }
+        else if (comment.startsWith(check))
+        {
+            pattern.isNot = false;
+            pattern.text = UnownedStringSlice(comment.begin() + check.getLength(), comment.end()).trim();
+        }
+        else
+        {
+            continue;
+        }
+        outPatterns.add(pattern);
+    }
+}
+
+static Index _indexOf(const UnownedStringSlice& text, Index startIndex, const UnownedStringSlice& pattern)
+{
+    const Index index = UnownedStringSlice(text.begin() + startIndex, text.end()).indexOf(pattern);
+    return index < 0 ? index : index + startIndex;
+}
+
+    /// Check `output` contains the `CHECK:` patterns in order, and that a `CHECK-NOT:` pattern doesn't
+    /// appear between the matches of the patterns around it. Patterns are plain text. 
+static SlangResult _checkFileCheckPatterns(const List<FileCheckPattern>& patterns, const UnownedStringSlice& output, StringBuilder& outMessage)
+{
+    Index searchIndex = 0;
+    List<UnownedStringSlice> notPatterns;
+
+    auto checkNotPatterns = [&](Index endIndex) -> SlangResult
+    {
+        const UnownedStringSlice range(output.begin() + searchIndex, output.begin() + endIndex);
+        for (const auto& notPattern : notPatterns)
+        {
+            if (range.indexOf(notPattern) >= 0)
+            {
+                outMessage << "CHECK-NOT: '" << notPattern << "' was found\n";
+                return SLANG_FAIL;
+            }
+        }
+        notPatterns.clear();
+        return SLANG_OK;
+    };
+
+    for (const auto& pattern : patterns)
+    {
+        if (pattern.isNot)
+        {
+            notPatterns.add(pattern.text);
+            continue;
+        }
+
+        const Index index = _indexOf(output, searchIndex, pattern.text);
+        if (index < 0)
+        {
+            outMessage << "CHECK: '" << pattern.text << "' was not found\n";
+            return SLANG_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(checkNotPatterns(index));
+        searchIndex = index + pattern.text.getLength();
+    }
+    return checkNotPatterns(output.getLength());
+}
+
+TestResult runFileCheckTest(TestContext* context, TestInput& input)
+{
+    // Compiles with the stand-alone Slang compiler, and checks the output against the `CHECK:`
+    // and `CHECK-NOT:` lines in the test file
+    auto outputStem = input.outputStem;
+
+    CommandLine cmdLine;
+    _initSlangCompiler(context, cmdLine);
+
+    cmdLine.addArg(input.filePath);
+    for (auto arg : input.testOptions->args)
+    {
+        cmdLine.addArg(arg);
+    }
+
+    ExecuteResult exeRes;
+    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
+
+    if (context->isCollectingRequirements())
+    {
+        return TestResult::Pass;
+    }
+
+    String source;
+    if (SLANG_FAILED(_readText(input.filePath.getUnownedSlice(), source)))
+    {
+        return TestResult::Fail;
+    }
+
+    List<FileCheckPattern> patterns;
+    _findFileCheckPatterns(source.getUnownedSlice(), patterns);
+
+    StringBuilder message;
+    if (patterns.getCount() == 0)
+    {
+        message << "No CHECK: patterns found\n";
+    }
+    else if (exeRes.resultCode == 0)
+    {
+        _checkFileCheckPatterns(patterns, exeRes.standardOutput.getUnownedSlice(), message);
+    }
+
+    if (exeRes.resultCode == 0 && message.getLength() == 0)
+    {
+        return TestResult::Pass;
+    }
+
+    // Write out the output and the reason for failure, so the problem can be diagnosed
+    StringBuilder actualOutput;
+    actualOutput << message << getOutput(exeRes);
+
+    String actualOutputPath = outputStem + ".actual";
+    Slang::File::writeAllText(actualOutputPath, actualOutput);
+    context->reporter->message(TestMessageType::TestFailure, message);
+    return TestResult::Fail;
+}
+
 TestResult runSimpleLineTest(TestContext* context, TestInput& input)
 {
     // need to execute the stand-alone Slang compiler on the file, and compare its output to what we expect
@@ -2871,6 +3019,7 @@ static const TestCommandInfo s_testCommandInfos[] =
     { "SIMPLE",                                 &runSimpleTest,                             0 },
     { "SIMPLE_EX",                              &runSimpleTest,                             0 },
     { "SIMPLE_LINE",                            &runSimpleLineTest,                         0 },
+    { "FILECHECK",                              &runFileCheckTest,                          0 },
     { "REFLECTION",                             &runReflectionTest,                         0 },
     { "CPU_REFLECTION",                         &runReflectionTest,                         0 },
     { "COMMAND_LINE_SIMPLE",                    &runSimpleCompareCommandLineTest,           0 },
@@ -3333,9 +3482,30 @@ static bool shouldRunTest(
     return true;
 }
 
-void runTestsInDirectory(
-    TestContext*		context,
-    String				directoryPath)
+static void _runTestFile(
+    TestContext*    context,
+    const String&   file)
+{
+    if (SLANG_FAILED(_runTestsOnFile(context, file)))
+    {
+        auto reporter = context->reporter;
+
+        {
+            TestReporter::TestScope scope(reporter, file);
+            reporter->message(TestMessageType::RunError, "slang-test: unable to parse test");
+
+            reporter->addResult(TestResult::Fail);
+        }
+
+        // Output there was some kind of error trying to run the tests on this file
+        // fprintf(stderr, "slang-test: unable to parse test '%s'\n", file.getBuffer());
+    }
+}
+
+static void _findTestFilesInDirectory(
+    TestContext*    context,
+    String          directoryPath,
+    List<String>&   ioFiles)
 {
     {
         List<String> files;
@@ -3345,32 +3515,401 @@ void runTestsInDirectory(
             if( shouldRunTest(context, file) )
             {
     //            fprintf(stderr, "slang-test: found '%s'\n", file.getBuffer());
-                if (SLANG_FAILED(_runTestsOnFile(context, file)))
-                {
-                    auto reporter = context->reporter;
+                ioFiles.add(file);
+            }
+        }
+    }
 
-                    {
-                        TestReporter::TestScope scope(reporter, file);
-                        reporter->message(TestMessageType::RunError, "slang-test: unable to parse test");
+    {
+        List<String> subDirs;
+        DirectoryUtil::findDirectories(directoryPath, subDirs);
+        for (auto subDir : subDirs)
+        {
+            _findTestFilesInDirectory(context, subDir, ioFiles);
+        }
+    }
+}
+
+/* Holds the state of running test files in worker slang-test processes. Results are held until all the
+files before them have been reported, so the output is in the same order as a serial run. */
+struct TestWorkerState
+{
+    typedef TestReporter::TestInfo TestInfo;
 
-                        reporter->addResult(TestResult::Fail);
+        /// A worker that runs test files sent to it on stdin, until its stdin is closed
+    struct PersistentWorker
+    {
+        RefPtr<Process> process;
+        Index fileIndex = -1;               ///< The file the worker is running, or -1 if none
+        Index outputOffset = 0;             ///< The offset of the standard output that hasn't been parsed yet
+    };
+
+    void reportCompleted()
+    {
+        auto reporter = context->reporter;
+        while (nextFileToReport < files.getCount() && isFileCompleted[nextFileToReport])
+        {
+            for (const auto& info : fileResults[nextFileToReport])
+            {
+                reporter->addTest(info);
+            }
+            // No longer needed
+            fileResults[nextFileToReport] = List<TestInfo>();
+            nextFileToReport++;
+        }
+    }
+
+    void completeFile(Index fileIndex, const List<TestInfo>& results)
+    {
+        fileResults[fileIndex] = results;
+        isFileCompleted[fileIndex] = true;
+    }
+
+        /// Complete the file as a failure, as the worker running it didn't complete it
+    void failFile(Index fileIndex, SlangResult res, const ExecuteResult& exeRes)
+    {
+        StringBuilder message;
+        if (SLANG_FAILED(res))
+        {
+            message << "slang-test: unable to run test worker";
+        }
+        else
+        {
+            message << "slang-test: test worker failed (result code = " << exeRes.resultCode << ")";
+            if (exeRes.standardError.getLength())
+            {
+                message << "\n" << exeRes.standardError;
+            }
+        }
+
+        TestInfo info;
+        info.name = files[fileIndex];
+        info.testResult = TestResult::Fail;
+        info.message = message;
+
+        fileResults[fileIndex].add(info);
+        isFileCompleted[fileIndex] = true;
+    }
+
+    static void onWorkerCompleted(ProcessQueue::Handle handle, SlangResult res, const ExecuteResult& exeRes, void* userData)
+    {
+        TestWorkerState* state = (TestWorkerState*)userData;
+
+        const Index* fileIndexPtr = state->workerFileIndices.TryGetValue(handle);
+        SLANG_ASSERT(fileIndexPtr);
+        const Index fileIndex = *fileIndexPtr;
+
+        List<List<TestInfo>> results;
+        if (SLANG_SUCCEEDED(res))
+        {
+            TestReporter::parseWorkerOutput(exeRes.standardOutput.getUnownedSlice(), results);
+        }
+
+        if (results.getCount())
+        {
+            state->completeFile(fileIndex, results[0]);
+        }
+        else
+        {
+            state->failFile(fileIndex, res, exeRes);
+        }
+
+        state->reportCompleted();
+    }
+
+        /// Send the next file to the worker to run, or if there are none left close its input so it exits
+    void sendNextFile(PersistentWorker& worker)
+    {
+        if (nextFileToSend < files.getCount())
+        {
+            worker.fileIndex = nextFileToSend++;
+
+            // The files to run are passed on stdin, one per line
+            StringBuilder line;
+            line << files[worker.fileIndex] << "\n";
+            worker.process->writeStdIn(line);
+        }
+        else
+        {
+            worker.fileIndex = -1;
+            worker.process->closeStdIn();
+        }
+    }
+
+        /// Start the worker, and send it the first file to run. If the worker can't be started, the files
+        /// are reported as failed, until either a worker starts or there are no files left.
+    void startPersistentWorker(const CommandLine& workerCmdLine, PersistentWorker& worker)
+    {
+        worker = PersistentWorker();
+        while (nextFileToSend < files.getCount())
+        {
+            if (context->options.shouldBeVerbose)
+            {
+                String commandLine = ProcessUtil::getCommandLineString(workerCmdLine);
+                context->reporter->messageFormat(TestMessageType::Info, "%s\n", commandLine.getBuffer());
+            }
+
+            const SlangResult res = ProcessUtil::createProcess(workerCmdLine, String(), Process::Flag::KeepStdInOpen, worker.process);
+            if (SLANG_SUCCEEDED(res))
+            {
+                sendNextFile(worker);
+                return;
+            }
+
+            failFile(nextFileToSend++, res, ExecuteResult());
+        }
+    }
+
+        /// Handle the output of the worker, completing files it has finished and sending it more to do.
+        /// Once the worker has terminated, a file it didn't complete is failed, and a new worker started if there are more files.
+    void updatePersistentWorker(const CommandLine& workerCmdLine, PersistentWorker& worker)
+    {
+        const ExecuteResult& exeRes = worker.process->getResult();
+        for (;;)
+        {
+            const UnownedStringSlice output = exeRes.standardOutput.getUnownedSlice().tail(worker.outputOffset);
+            const Index endFileOffset = TestReporter::findWorkerEndFile(output);
+            if (endFileOffset < 0 || worker.fileIndex < 0)
+            {
+                break;
+            }
+
+            List<List<TestInfo>> results;
+            TestReporter::parseWorkerOutput(output.head(endFileOffset), results);
+            completeFile(worker.fileIndex, results.getCount() ? results[0] : List<TestInfo>());
+
+            worker.outputOffset += endFileOffset;
+            sendNextFile(worker);
+        }
+
+        if (worker.process->isTerminated())
+        {
+            if (worker.fileIndex >= 0)
+            {
+                // The worker stopped part way through a file (for example it crashed)
+                failFile(worker.fileIndex, SLANG_OK, exeRes);
+                startPersistentWorker(workerCmdLine, worker);
+            }
+            else
+            {
+                worker.process.setNull();
+            }
+        }
+    }
+
+    TestContext* context = nullptr;
+    List<String> files;
+    List<List<TestInfo>> fileResults;
+    List<bool> isFileCompleted;
+    Index nextFileToReport = 0;
+        /// The index of the file run by each worker (when not using persistent workers)
+    Dictionary<ProcessQueue::Handle, Index> workerFileIndices;
+        /// The index of the next file to send to a persistent worker
+    Index nextFileToSend = 0;
+};
+
+    /// Run the files with as many persistent workers as jobs. Each worker runs one file at a time, and when done takes
+    /// the next from the files that haven't been run yet, so the workers are kept busy until all of the files have been sent.
+static void _runTestFilesInPersistentWorkers(TestWorkerState& state, const CommandLine& workerCmdLine)
+{
+    List<TestWorkerState::PersistentWorker> workers;
+    workers.setCount(Math::Min(Index(state.context->options.jobCount), state.files.getCount()));
+    for (auto& worker : workers)
+    {
+        state.startPersistentWorker(workerCmdLine, worker);
+    }
+    state.reportCompleted();
+
+    List<Process*> processes;
+    for (;;)
+    {
+        processes.clear();
+        for (const auto& worker : workers)
+        {
+            if (worker.process)
+            {
+                processes.add(worker.process);
+            }
+        }
+        if (processes.getCount() == 0)
+        {
+            break;
+        }
+
+        // Output may be spread over multiple reads, so it's only handled once the end file marker has been read
+        if (SLANG_FAILED(ProcessUtil::waitForOutput(processes.getBuffer(), processes.getCount(), -1)))
+        {
+            // Can't make progress, so fail whatever is left
+            for (auto& worker : workers)
+            {
+                if (worker.process)
+                {
+                    worker.process->kill();
+                    if (worker.fileIndex >= 0)
+                    {
+                        state.failFile(worker.fileIndex, SLANG_FAIL, ExecuteResult());
                     }
+                    worker.process.setNull();
+                }
+            }
+            while (state.nextFileToSend < state.files.getCount())
+            {
+                state.failFile(state.nextFileToSend++, SLANG_FAIL, ExecuteResult());
+            }
+        }
 
-                    // Output there was some kind of error trying to run the tests on this file
-                    // fprintf(stderr, "slang-test: unable to parse test '%s'\n", file.getBuffer());
+        for (auto& worker : workers)
+        {
+            if (worker.process)
+            {
+                state.updatePersistentWorker(workerCmdLine, worker);
+            }
+        }
+        state.reportCompleted();
+    }
+}
+
+static void _runTestFilesInWorkers(
+    TestContext*        context,
+    const CommandLine&  workerCmdLine,
+    const List<String>& files)
+{
+    const auto& options = context->options;
+
+    TestWorkerState state;
+    state.context = context;
+    state.files = files;
+    state.fileResults.setCount(files.getCount());
+    state.isFileCompleted.setCount(files.getCount());
+    for (auto& isCompleted : state.isFileCompleted)
+    {
+        isCompleted = false;
+    }
+
+    if (options.usePersistentWorkers)
+    {
+        _runTestFilesInPersistentWorkers(state, workerCmdLine);
+        SLANG_ASSERT(state.nextFileToReport == files.getCount());
+        return;
+    }
+
+    // Otherwise each file has a worker of its own
+    ProcessQueue queue;
+    queue.setMaxRunningCount(options.jobCount);
+
+    for (Index i = 0; i < files.getCount(); ++i)
+    {
+        StringBuilder stdinContents;
+        stdinContents << files[i] << "\n";
+
+        if (options.shouldBeVerbose)
+        {
+            String commandLine = ProcessUtil::getCommandLineString(workerCmdLine);
+            context->reporter->messageFormat(TestMessageType::Info, "%s < %s", commandLine.getBuffer(), stdinContents.getBuffer());
+        }
+
+        const auto handle = queue.add(workerCmdLine, stdinContents, &TestWorkerState::onWorkerCompleted, &state);
+        state.workerFileIndices.Add(handle, i);
+    }
+
+    queue.waitAll();
+    SLANG_ASSERT(state.nextFileToReport == files.getCount());
+}
+
+void runTestsInDirectory(
+    TestContext*		context,
+    const CommandLine&  workerCmdLine,
+    String				directoryPath)
+{
+    List<String> files;
+    _findTestFilesInDirectory(context, directoryPath, files);
+
+    if (context->options.jobCount > 1)
+    {
+        _runTestFilesInWorkers(context, workerCmdLine, files);
+        return;
+    }
+
+    for (const auto& file : files)
+    {
+        _runTestFile(context, file);
+    }
+}
+
+    /// Run the test files listed (one per line) on stdin, outputting results for a parent slang-test. Each file is run
+    /// as soon as its line has been read, as the parent may only send the next file once the previous one is done.
+static SlangResult _runTestWorker(TestContext* context)
+{
+    for (;;)
+    {
+        // Read a line of stdin
+        StringBuilder buf;
+        {
+            char chunk[1024];
+            while (fgets(chunk, sizeof(chunk), stdin))
+            {
+                buf << chunk;
+                if (buf.getLength() && buf[buf.getLength() - 1] == '\n')
+                {
+                    break;
                 }
             }
         }
+        if (buf.getLength() == 0)
+        {
+            // End of input
+            break;
+        }
+
+        for (auto line : LineParser(buf.getUnownedSlice()))
+        {
+            const UnownedStringSlice file = line.trim();
+            if (file.getLength() == 0)
+            {
+                continue;
+            }
+
+            _runTestFile(context, String(file));
+
+            // Mark the end of the results for the file
+            StringBuilder endFile;
+            TestReporter::appendWorkerEndFile(endFile);
+            fputs(endFile.getBuffer(), stdout);
+            fflush(stdout);
+        }
     }
 
+    return SLANG_OK;
+}
+
+    /// Calculate the command line to start a worker slang-test. It is the same as the command line used to run this
+    /// slang-test, without the options that control workers, such that the workers run tests the same way.
+static void _calcTestWorkerCommandLine(int argc, char** argv, CommandLine& outCmdLine)
+{
+    String exePath = Path::getExecutablePath();
+    if (exePath.getLength() == 0)
     {
-        List<String> subDirs;
-        DirectoryUtil::findDirectories(directoryPath, subDirs);
-        for (auto subDir : subDirs)
+        exePath = argv[0];
+    }
+    outCmdLine.setExecutablePath(exePath);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-j") == 0)
+        {
+            // Skip the operand too
+            i++;
+            continue;
+        }
+        if (strcmp(arg, "-persistent-workers") == 0 || strcmp(arg, "-test-worker") == 0)
         {
-            runTestsInDirectory(context, subDir);
+            continue;
         }
+        outCmdLine.addArg(arg);
     }
+
+    outCmdLine.addArg("-test-worker");
 }
 
 static void _disableCPPBackends(TestContext* context)
@@ -3551,13 +4090,23 @@ SlangResult innerMain(int argc, char** argv)
         reporter.m_dumpOutputOnFailure = options.dumpOutputOnFailure;
         reporter.m_isVerbose = options.shouldBeVerbose;
         reporter.m_hideIgnored = options.hideIgnored;
+        reporter.m_showTimings = options.showTimings;
 
+        if (options.isTestWorker)
         {
+            TestReporter::SuiteScope suiteScope(&reporter, "tests");
+            return _runTestWorker(&context);
+        }
+
+        {
+            CommandLine workerCmdLine;
+            _calcTestWorkerCommandLine(argc, argv, workerCmdLine);
+
             TestReporter::SuiteScope suiteScope(&reporter, "tests");
             // Enumerate test files according to policy
             // TODO: add more directories to this list
             // TODO: allow for a command-line argument to select a particular directory
-            runTestsInDirectory(&context, "tests/");
+            runTestsInDirectory(&context, workerCmdLine, "tests/");
         }
 
         // Run the unit tests (these are internal C++ tests - not specified via files in a directory) 
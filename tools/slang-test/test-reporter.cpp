@@ -2,6 +2,7 @@
 #include "test-reporter.h"
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-string-escape-util.h"
 #include "../../source/core/slang-process-util.h"
 
 #include <stdio.h>
@@ -91,6 +92,7 @@ Result TestReporter::init(TestOutputMode outputMode)
 
 TestReporter::~TestReporter()
 {
+    m_processQueue.waitAll();
 }
 
 bool TestReporter::canWriteStdError() const
@@ -99,6 +101,7 @@ bool TestReporter::canWriteStdError() const
     {
         case TestOutputMode::XUnit:
         case TestOutputMode::XUnit2:
+        case TestOutputMode::Worker:
         {
             return false;
         }
@@ -120,6 +123,11 @@ void TestReporter::startTest(const String& testName)
     m_currentInfo = TestInfo();
     m_currentInfo.name = testName;
     m_currentMessage.Clear();
+
+    if (m_showTimings)
+    {
+        m_currentStartTick = ProcessUtil::getClockTick();
+    }
 }
 
 void TestReporter::endTest()
@@ -129,6 +137,13 @@ void TestReporter::endTest()
 
     m_currentInfo.message = m_currentMessage;
 
+    // If the test didn't record its own time, use the time between start and end
+    if (m_showTimings && m_currentInfo.executionTime <= 0.0)
+    {
+        const uint64_t ticks = ProcessUtil::getClockTick() - m_currentStartTick;
+        m_currentInfo.executionTime = double(ticks) / double(ProcessUtil::getClockFrequency());
+    }
+
     _addResult(m_currentInfo);
 
     m_inTest = false;
@@ -423,6 +438,14 @@ void TestReporter::_addResult(const TestInfo& info)
             // Don't output anything -> we'll output all in one go at the end
             break;
         }
+        case TestOutputMode::Worker:
+        {
+            StringBuilder buf;
+            appendWorkerResult(info, buf);
+            fputs(buf.getBuffer(), stdout);
+            fflush(stdout);
+            break;
+        }
         case TestOutputMode::AppVeyor:
         {
             char const* resultString = "None";
@@ -459,27 +482,33 @@ void TestReporter::_addResult(const TestInfo& info)
                 cmdLine.addArg(builder);
             }
 
-            ExecuteResult exeRes;
-            SlangResult res = ProcessUtil::execute(cmdLine, exeRes);
-            
-            if (SLANG_FAILED(res))
-            {
-                messageFormat(TestMessageType::Info, "failed to add appveyor test results for '%S'\n", info.name.toWString().begin());
-
-#if 0
-                String cmdLineString = ProcessUtil::getCommandLineString(cmdLine);
-                fprintf(stderr, "[%d] TEST RESULT: %s {%d} {%s} {%s}\n", err, cmdLineString.getBuffer(),
-                    exeRes.resultCode,
-                    exeRes.standardOutput.begin(),
-                    exeRes.standardError.begin());
-#endif
-            }
+            // Adding the result doesn't need to hold up testing, so it is run asynchronously 
+            const auto handle = m_processQueue.add(cmdLine, String(), &_appVeyorAddTestCompleted, this);
+            m_pendingTestNames.Add(handle, info.name);
+            m_processQueue.update();
+
             defaultOutputFunc(info);
             break;
         }
     }
 }
 
+/* static */void TestReporter::_appVeyorAddTestCompleted(ProcessQueue::Handle handle, SlangResult res, const ExecuteResult& exeResult, void* userData)
+{
+    SLANG_UNUSED(exeResult);
+
+    TestReporter* reporter = (TestReporter*)userData;
+
+    String testName;
+    reporter->m_pendingTestNames.TryGetValue(handle, testName);
+    reporter->m_pendingTestNames.Remove(handle);
+
+    if (SLANG_FAILED(res))
+    {
+        reporter->messageFormat(TestMessageType::Info, "failed to add appveyor test results for '%S'\n", testName.toWString().begin());
+    }
+}
+
 void TestReporter::addTest(const String& testName, TestResult testResult)
 {
     // Can't add this way if in test
@@ -491,6 +520,128 @@ void TestReporter::addTest(const String& testName, TestResult testResult)
     _addResult(info);
 }
 
+void TestReporter::addTest(const TestInfo& info)
+{
+    assert(!m_inTest);
+
+    if (info.testResult == TestResult::Fail && info.message.getLength() && canWriteStdError())
+    {
+        fprintf(stderr, "error: ");
+        fputs(info.message.getBuffer(), stderr);
+        fprintf(stderr, "\n");
+    }
+
+    _addResult(info);
+}
+
+static const char s_workerResultPrefix[] = "slang-test-worker: result ";
+static const char s_workerEndFileLine[] = "slang-test-worker: end-file";
+
+/* static */void TestReporter::appendWorkerResult(const TestInfo& info, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::Cpp);
+
+    out << s_workerResultPrefix << int(info.testResult) << " ";
+    StringUtil::appendFormat(out, "%.9g", info.executionTime);
+    out << " ";
+    StringEscapeUtil::appendQuoted(handler, info.name.getUnownedSlice(), out);
+    out << " ";
+    StringEscapeUtil::appendQuoted(handler, info.message.getUnownedSlice(), out);
+    out << "\n";
+}
+
+/* static */void TestReporter::appendWorkerEndFile(StringBuilder& out)
+{
+    out << s_workerEndFileLine << "\n";
+}
+
+static SlangResult _parseWorkerQuoted(StringEscapeHandler* handler, const char*& ioCursor, String& out)
+{
+    const char* start = ioCursor;
+    SLANG_RETURN_ON_FAIL(handler->lexQuoted(start, &ioCursor));
+
+    StringBuilder buf;
+    SLANG_RETURN_ON_FAIL(StringEscapeUtil::appendUnquoted(handler, UnownedStringSlice(start, ioCursor), buf));
+    out = buf.ProduceString();
+    return SLANG_OK;
+}
+
+static SlangResult _parseWorkerResult(const UnownedStringSlice& line, TestReporter::TestInfo& outInfo)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::Cpp);
+
+    // The result and time are space delimited, followed by the quoted name and message.
+    // The quoted parts are lexed from the line - the line is within a zero terminated string, and the
+    // quoted text can't contain new lines, so lexing can't go past the end of the line.
+    UnownedStringSlice slices[2];
+    UnownedStringSlice rest(line.begin() + SLANG_COUNT_OF(s_workerResultPrefix) - 1, line.end());
+    if (StringUtil::split(rest, ' ', 2, slices) != 2)
+    {
+        return SLANG_FAIL;
+    }
+
+    const int result = StringToInt(String(slices[0]));
+    if (result < int(TestResult::Ignored) || result > int(TestResult::Fail))
+    {
+        return SLANG_FAIL;
+    }
+    outInfo.testResult = TestResult(result);
+    outInfo.executionTime = StringToDouble(String(slices[1]));
+
+    const char* cursor = slices[1].end();
+    if (*cursor++ != ' ')
+    {
+        return SLANG_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(_parseWorkerQuoted(handler, cursor, outInfo.name));
+    if (*cursor++ != ' ')
+    {
+        return SLANG_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(_parseWorkerQuoted(handler, cursor, outInfo.message));
+
+    return cursor == line.end() ? SLANG_OK : SLANG_FAIL;
+}
+
+/* static */SlangResult TestReporter::parseWorkerOutput(const UnownedStringSlice& text, List<List<TestInfo>>& outFileResults)
+{
+    List<TestInfo> fileResults;
+    for (auto line : LineParser(text))
+    {
+        if (line.startsWith(UnownedStringSlice::fromLiteral(s_workerResultPrefix)))
+        {
+            TestInfo info;
+            SLANG_RETURN_ON_FAIL(_parseWorkerResult(line, info));
+            fileResults.add(info);
+        }
+        else if (line == UnownedStringSlice::fromLiteral(s_workerEndFileLine))
+        {
+            outFileResults.add(fileResults);
+            fileResults.clear();
+        }
+    }
+
+    // Results without an end marker mean the worker stopped part way through a file (for example it crashed).
+    // They are dropped, such that the file can be reported as a whole.
+    return SLANG_OK;
+}
+
+/* static */Index TestReporter::findWorkerEndFile(const UnownedStringSlice& text)
+{
+    for (auto line : LineParser(text))
+    {
+        // The marker line only counts once it's complete, ie it's followed by the end of line
+        if (line == UnownedStringSlice::fromLiteral(s_workerEndFileLine) && line.end() < text.end())
+        {
+            const char* cur = line.end();
+            // Skip the end of line (which may be \r\n)
+            cur += (cur[0] == '\r' && cur + 1 < text.end() && cur[1] == '\n') ? 2 : 1;
+            return Index(cur - text.begin());
+        }
+    }
+    return -1;
+}
+
 void TestReporter::message(TestMessageType type, const String& message)
 {
     if (type == TestMessageType::Info)
@@ -544,6 +695,9 @@ bool TestReporter::didAllSucceed() const
 
 void TestReporter::outputSummary()
 {
+    // Make sure all results have been reported
+    m_processQueue.waitAll();
+
     auto passCount = m_passedTestCount;
     auto rawTotal = m_totalTestCount;
     auto ignoredCount = m_ignoredTestCount;
@@ -586,9 +740,18 @@ void TestReporter::outputSummary()
                 }
                 printf("---\n");
             }
+
+            if (m_showTimings)
+            {
+                _outputSlowestTests();
+            }
+            break;
+        }
+        case TestOutputMode::Worker:
+        {
+            // The parent slang-test outputs the summary
             break;
         }
-        
         case TestOutputMode::XUnit:
         {
             // xUnit 1.0 format  
@@ -651,6 +814,37 @@ void TestReporter::outputSummary()
     }
 }
 
+void TestReporter::_outputSlowestTests()
+{
+    const Index maxCount = 20;
+
+    List<const TestInfo*> infos;
+    for (const auto& testInfo : m_testInfos)
+    {
+        if (testInfo.executionTime > 0.0)
+        {
+            infos.add(&testInfo);
+        }
+    }
+    if (infos.getCount() == 0)
+    {
+        return;
+    }
+
+    infos.sort([](const TestInfo* a, const TestInfo* b) -> bool { return a->executionTime > b->executionTime; });
+
+    printf("slowest tests:\n");
+    printf("---\n");
+    const Index count = Math::Min(maxCount, infos.getCount());
+    for (Index i = 0; i < count; ++i)
+    {
+        StringBuilder buf;
+        _appendTime(infos[i]->executionTime, buf);
+        printf("%s %s\n", buf.getBuffer(), infos[i]->name.getBuffer());
+    }
+    printf("---\n");
+}
+
 void TestReporter::startSuite(const String& name)
 {
     m_suiteStack.add(name);
@@ -7,6 +7,7 @@
 #include "../../source/core/slang-platform.h"
 #include "../../source/core/slang-std-writers.h"
 #include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-process-util.h"
 
 
 #define SLANG_CHECK(x) TestReporter::get()->addResultWithLocation((x), #x, __FILE__, __LINE__);
@@ -46,6 +47,7 @@ enum class TestOutputMode
     XUnit,         ///< xUnit original format  https://nose.readthedocs.io/en/latest/plugins/xunit.html
     XUnit2,        ///< https://xunit.github.io/docs/format-xml-v2
     TeamCity,      ///< Output suitable for teamcity
+    Worker,        ///< Results are written such that they can be read back by a parent slang-test (see -j)
 };
 
 enum class TestResult
@@ -124,6 +126,9 @@ class TestReporter
     TestResult addTest(const Slang::String& testName, bool isPass);
         /// Effectively runs start/endTest (so cannot be called inside start/endTest). 
     void addTest(const Slang::String& testName, TestResult testResult);
+        /// Add a complete test result, such as one read back from a worker. Any failure message is output
+        /// as if it had been reported whilst the test was running.
+    void addTest(const TestInfo& info);
 
         // Called for an error in the test-runner (not for an error involving a test itself).
     void message(TestMessageType type, const Slang::String& errorText);
@@ -149,6 +154,17 @@ class TestReporter
 
     static TestResult combine(TestResult a, TestResult b) { return (a > b) ? a : b; }
 
+        /// Append info as a single line in the form output in TestOutputMode::Worker
+    static void appendWorkerResult(const TestInfo& info, Slang::StringBuilder& out);
+        /// Append the line marking the end of the results for a test file in TestOutputMode::Worker
+    static void appendWorkerEndFile(Slang::StringBuilder& out);
+        /// Parse the output of a worker. The results for each test file (as delimited by the end file marker) are added
+        /// to outFileResults. Lines that aren't part of the worker output are ignored.
+    static SlangResult parseWorkerOutput(const Slang::UnownedStringSlice& text, Slang::List<Slang::List<TestInfo>>& outFileResults);
+        /// Find the end of the results of the first test file in the output of a worker. Returns the offset just past
+        /// the end file marker line, or -1 if the marker line hasn't been output yet.
+    static Slang::Index findWorkerEndFile(const Slang::UnownedStringSlice& text);
+
     static TestReporter* get() { return s_reporter; }
     static void set(TestReporter* reporter) { s_reporter = reporter; }
 
@@ -167,15 +183,26 @@ class TestReporter
     bool m_dumpOutputOnFailure;
     bool m_isVerbose = false;
     bool m_hideIgnored = false;
+    bool m_showTimings = false;                 ///< If set, the time taken by each test is measured (if the test doesn't set it itself) and the slowest are listed in the summary
 
 protected:
     
     void _addResult(const TestInfo& info);
+        /// Output the tests that took the longest (used when m_showTimings is set)
+    void _outputSlowestTests();
+
+    static void _appVeyorAddTestCompleted(Slang::ProcessQueue::Handle handle, SlangResult res, const Slang::ExecuteResult& exeResult, void* userData);
+
+        /// Used to run external processes reporting results (such as for AppVeyor) without blocking testing
+    Slang::ProcessQueue m_processQueue;
+        /// Maps a handle in the process queue to the name of the test being reported
+    Slang::Dictionary<Slang::ProcessQueue::Handle, Slang::String> m_pendingTestNames;
     
     Slang::StringBuilder m_currentMessage;
     TestInfo m_currentInfo;
     int m_numCurrentResults;
     int m_numFailResults;
+    uint64_t m_currentStartTick = 0;
 
     bool m_inTest;
 
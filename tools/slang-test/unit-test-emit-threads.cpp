@@ -0,0 +1,109 @@
+// unit-test-emit-threads.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangResult _compile(slang::IGlobalSession* session, SlangCompileTarget target, const char* source, int threadCount, String& outCode)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, target);
+
+    StringBuilder threadCountText;
+    threadCountText << threadCount;
+    const char* args[] = { "-emit-threads", threadCountText.getBuffer() };
+    SlangResult res = spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "emitThreadsFile", source);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = spCompile(request);
+    }
+    if (SLANG_SUCCEEDED(res))
+    {
+        outCode = spGetEntryPointSource(request, 0);
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void emitThreadsTest()
+{
+    // Enough functions that threads are working on them at the same time, using locals,
+    // structs, control flow and intrinsics, and each calling the one before it
+    const int kFuncCount = 32;
+
+    StringBuilder source;
+    source << "struct Data { float value; int count; };\n";
+    source << "RWStructuredBuffer<float> outputBuffer;\n";
+    source << "float func0(float x) { return x; }\n";
+    for (int i = 1; i < kFuncCount; ++i)
+    {
+        source << "float func" << i << "(float x)\n";
+        source << "{\n";
+        source << "    Data data;\n";
+        source << "    data.value = x;\n";
+        source << "    data.count = " << i << ";\n";
+        source << "    for (int j = 0; j < data.count; ++j)\n";
+        source << "    {\n";
+        source << "        if (data.value > 100.0f) break;\n";
+        source << "        data.value = sin(data.value) + func" << (i - 1) << "(data.value * 0.5f);\n";
+        source << "    }\n";
+        source << "    return data.value;\n";
+        source << "}\n";
+    }
+    source << "[numthreads(4, 1, 1)]\n";
+    source << "void computeMain(uint3 tid : SV_DispatchThreadID)\n";
+    source << "{\n";
+    source << "    outputBuffer[tid.x] = func" << (kFuncCount - 1) << "(float(tid.x));\n";
+    source << "}\n";
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, session.writeRef())));
+
+    const SlangCompileTarget targets[] = { SLANG_HLSL, SLANG_GLSL };
+    for (auto target : targets)
+    {
+        String serialCode;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, target, source.getBuffer(), 0, serialCode)));
+
+        String code;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, target, source.getBuffer(), 1, code)));
+        for (int i = 0; i < kFuncCount; ++i)
+        {
+            StringBuilder funcName;
+            funcName << "func" << i << "_0(";
+            SLANG_CHECK(serialCode.indexOf(funcName.getUnownedSlice()) >= 0);
+            SLANG_CHECK(code.indexOf(funcName.getUnownedSlice()) >= 0);
+        }
+
+        // The output doesn't depend on the number of threads, or how the work was shared out between them
+        const int threadCounts[] = { 2, 8, 2, 8 };
+        for (auto threadCount : threadCounts)
+        {
+            String threadedCode;
+            SLANG_CHECK(SLANG_SUCCEEDED(_compile(session, target, source.getBuffer(), threadCount, threadedCode)));
+            SLANG_CHECK(threadedCode == code);
+        }
+    }
+
+    // The count must be a number of threads
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(session);
+        const char* args[] = { "-emit-threads", "-1" };
+        SLANG_CHECK(SLANG_FAILED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+        spDestroyCompileRequest(request);
+    }
+}
+
+SLANG_UNIT_TEST("emitThreads", emitThreadsTest);
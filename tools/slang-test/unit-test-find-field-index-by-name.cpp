@@ -0,0 +1,56 @@
+// unit-test-find-field-index-by-name.cpp
+
+#include "../../slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void findFieldIndexByNameTest()
+{
+    const char* testSource =
+        "struct TestStruct {"
+        "   int member0;"
+        "   Texture2D texture1;"
+        "   float4 member2;"
+        "};";
+    auto session = spCreateSession();
+    auto request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_DXBC);
+    int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spCompile(request);
+
+    auto testBody = [&]()
+    {
+        auto reflection = slang::ShaderReflection::get(request);
+        auto testStruct = reflection->findTypeByName("TestStruct");
+        SLANG_CHECK_ABORT(testStruct != nullptr);
+        auto typeLayout = reflection->getTypeLayout(testStruct);
+        SLANG_CHECK_ABORT(typeLayout != nullptr && typeLayout->getFieldCount() == 3);
+
+        // Look up each field more than once, as lookups after the first are via a map
+        for (int i = 0; i < 2; ++i)
+        {
+            SLANG_CHECK(typeLayout->findFieldIndexByName("member0") == 0);
+            SLANG_CHECK(typeLayout->findFieldIndexByName("texture1") == 1);
+            SLANG_CHECK(typeLayout->findFieldIndexByName("member2") == 2);
+            SLANG_CHECK(typeLayout->findFieldIndexByName("notAMember") == -1);
+        }
+
+        // A name can be specified as a range in a larger string
+        const char* path = "member2.x";
+        SLANG_CHECK(typeLayout->findFieldIndexByName(path, path + 7) == 2);
+        SLANG_CHECK(typeLayout->findFieldIndexByName(path, path + 6) == -1);
+    };
+
+    testBody();
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("findFieldIndexByName", findFieldIndexByNameTest);
@@ -0,0 +1,183 @@
+// unit-test-interlocked.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#define SLANG_PRELUDE_NAMESPACE slang_prelude
+#include "../../prelude/slang-cpp-types.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const int kGroupSize = 64;
+static const int kGroupCount = 256;
+static const int kWorkerCount = 8;
+static const int kBinCount = 16;
+
+// Must match the hash used in the kernel
+uint32_t _getBin(uint32_t index) { return (index * 2654435761u) >> 28; }
+
+struct Buffers
+{
+    uint32_t histogram[kBinCount];
+    int32_t stats[3];
+    uint32_t wide[4];
+};
+
+} // anonymous
+
+static void _checkInterlockedConcurrentDispatch(SlangSession* session)
+{
+    // Each thread updates a histogram, a running max/min, a counter incremented via a
+    // compare-exchange loop, and 64-bit and float sums. The results are only correct
+    // if every operation is atomic with respect to the other workers.
+    const char* testSource =
+        "RWStructuredBuffer<uint> histogram;\n"
+        "RWStructuredBuffer<int> stats;\n"
+        "RWByteAddressBuffer wide;\n"
+        "[numthreads(64, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    uint originalValue;\n"
+        "    InterlockedAdd(histogram[(tid.x * 2654435761u) >> 28], 1, originalValue);\n"
+        "    InterlockedMax(stats[0], int(tid.x));\n"
+        "    InterlockedMin(stats[1], -int(tid.x));\n"
+        "    int expected = 0;\n"
+        "    for (;;)\n"
+        "    {\n"
+        "        int prev;\n"
+        "        InterlockedCompareExchange(stats[2], expected, expected + 1, prev);\n"
+        "        if (prev == expected) break;\n"
+        "        expected = prev;\n"
+        "    }\n"
+        "    wide.InterlockedAddI64(0, int64_t(tid.x) << 20);\n"
+        "    wide.InterlockedAddF32(8, 1.0f);\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HOST_CALLABLE);
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", testSource);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompileRequest_getProgramWithEntryPoints(request, program.writeRef())));
+
+    ComPtr<slang::IComponentType2> program2;
+    SLANG_CHECK(program && SLANG_SUCCEEDED(program->queryInterface(slang::IComponentType2::getTypeGuid(), (void**)program2.writeRef())));
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    ComPtr<slang::IBlob> diagnostics;
+    SLANG_CHECK(program2 && SLANG_SUCCEEDED(program2->getTargetHostCallable(0, sharedLibrary.writeRef(), diagnostics.writeRef())));
+
+    slang::ProgramLayout* layout = program ? program->getLayout(0) : nullptr;
+    SLANG_CHECK(layout && layout->getParameterCount() == 3);
+
+    auto func = sharedLibrary ? (slang_prelude::ComputeFunc)sharedLibrary->findFuncByName("computeMain") : nullptr;
+    SLANG_CHECK(func != nullptr);
+
+    if (func && layout && layout->getParameterCount() == 3)
+    {
+        Buffers buffers;
+        memset(&buffers, 0, sizeof(buffers));
+        buffers.stats[0] = -1;
+
+        // Set up the global parameters, at the offsets given by reflection
+        size_t uniformSize = layout->getGlobalParamsTypeLayout()->getSize();
+        List<uint8_t> uniformState;
+        uniformState.setCount(Index(uniformSize));
+        ::memset(uniformState.getBuffer(), 0, uniformSize);
+
+        auto setParam = [&](int index, void* data, size_t count)
+        {
+            const size_t offset = layout->getParameterByIndex(index)->getOffset(SLANG_PARAMETER_CATEGORY_UNIFORM);
+            slang_prelude::RWStructuredBuffer<uint32_t> buffer;
+            buffer.data = (uint32_t*)data;
+            buffer.count = count;
+            ::memcpy(uniformState.getBuffer() + offset, &buffer, sizeof(buffer));
+        };
+        setParam(0, buffers.histogram, kBinCount);
+        setParam(1, buffers.stats, SLANG_COUNT_OF(buffers.stats));
+        // For a byte address buffer the size is in bytes
+        setParam(2, buffers.wide, sizeof(buffers.wide));
+
+        // Each worker dispatches every kWorkerCount-th group, so that all workers are
+        // contending on the same addresses for the duration of the test.
+        std::thread workers[kWorkerCount];
+        for (int i = 0; i < kWorkerCount; ++i)
+        {
+            workers[i] = std::thread([&, i]()
+            {
+                for (uint32_t groupID = i; groupID < kGroupCount; groupID += kWorkerCount)
+                {
+                    slang_prelude::ComputeVaryingInput varyingInput;
+                    varyingInput.startGroupID = { groupID, 0, 0 };
+                    varyingInput.endGroupID = { groupID + 1, 1, 1 };
+                    func(&varyingInput, nullptr, uniformState.getBuffer());
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        const uint32_t threadCount = kGroupSize * kGroupCount;
+
+        uint32_t expectedHistogram[kBinCount] = {};
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            expectedHistogram[_getBin(i)]++;
+        }
+        SLANG_CHECK(::memcmp(expectedHistogram, buffers.histogram, sizeof(expectedHistogram)) == 0);
+
+        SLANG_CHECK(buffers.stats[0] == int32_t(threadCount - 1));
+        SLANG_CHECK(buffers.stats[1] == -int32_t(threadCount - 1));
+        SLANG_CHECK(buffers.stats[2] == int32_t(threadCount));
+
+        int64_t sum;
+        ::memcpy(&sum, &buffers.wide[0], sizeof(sum));
+        SLANG_CHECK(sum == (int64_t(threadCount) * (threadCount - 1) / 2) << 20);
+
+        float floatSum;
+        ::memcpy(&floatSum, &buffers.wide[2], sizeof(floatSum));
+        SLANG_CHECK(floatSum == float(threadCount));
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+static void interlockedUnitTest()
+{
+    SlangSession* session = spCreateSession();
+
+    // If we can't compile host callable code, there is nothing to test
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(session, SLANG_HOST_CALLABLE)))
+    {
+        spDestroySession(session);
+        return;
+    }
+
+    TestToolUtil::setSessionDefaultPreludeFromExePath(Path::getExecutablePath().getBuffer(), session);
+
+    _checkInterlockedConcurrentDispatch(session);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("Interlocked", interlockedUnitTest);
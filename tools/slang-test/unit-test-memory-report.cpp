@@ -0,0 +1,192 @@
+// unit-test-memory-report.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-string-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct ReportEntry
+{
+    Index depth;
+    String name;
+    Int bytes;
+};
+
+} // anonymous
+
+static SlangResult _parseReport(ISlangBlob* blob, List<ReportEntry>& outEntries)
+{
+    const UnownedStringSlice text((const char*)blob->getBufferPointer());
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    for (auto line : lines)
+    {
+        if (line.getLength() == 0)
+        {
+            continue;
+        }
+
+        // Lines are an indented name, followed by the number of bytes
+        Index indent = 0;
+        while (indent < line.getLength() && line[indent] == ' ')
+        {
+            indent++;
+        }
+        const Index bytesStart = line.lastIndexOf(' ');
+        if ((indent % 2) != 0 || bytesStart <= indent)
+        {
+            return SLANG_FAIL;
+        }
+
+        ReportEntry entry;
+        entry.depth = indent / 2;
+        entry.name = UnownedStringSlice(line.begin() + indent, line.begin() + bytesStart).trim();
+        SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(line.begin() + bytesStart + 1, line.end()), entry.bytes));
+        outEntries.add(entry);
+    }
+    return SLANG_OK;
+}
+
+static Int _findBytes(const List<ReportEntry>& entries, const char* name)
+{
+    for (const auto& entry : entries)
+    {
+        if (entry.name == name)
+        {
+            return entry.bytes;
+        }
+    }
+    return -1;
+}
+
+static SlangResult _getReport(SlangCompileRequest* request, List<ReportEntry>& outEntries)
+{
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(spGetMemoryReport(request, blob.writeRef()));
+    return _parseReport(blob, outEntries);
+}
+
+static void _checkTotals(const List<ReportEntry>& entries)
+{
+    // Each entry with parts holds the sum of them
+    for (Index i = 0; i < entries.getCount(); ++i)
+    {
+        Int partsTotal = 0;
+        bool hasParts = false;
+        for (Index j = i + 1; j < entries.getCount() && entries[j].depth > entries[i].depth; ++j)
+        {
+            if (entries[j].depth == entries[i].depth + 1)
+            {
+                partsTotal += entries[j].bytes;
+                hasParts = true;
+            }
+        }
+        SLANG_CHECK(!hasParts || partsTotal == entries[i].bytes);
+    }
+
+    // The total is of everything at the top level before it
+    Int total = 0;
+    for (const auto& entry : entries)
+    {
+        if (entry.name == "total")
+        {
+            SLANG_CHECK(total == entry.bytes);
+            break;
+        }
+        if (entry.depth == 0)
+        {
+            total += entry.bytes;
+        }
+    }
+}
+
+static SlangCompileRequest* _createRequest(slang::IGlobalSession* session, const char* source)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "memoryReportFile", source);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+static String _getSource(int funcCount)
+{
+    // Each function calls the one before it, so all of them are used by the entry point
+    StringBuilder source;
+    source << "RWStructuredBuffer<float> outputBuffer;\n";
+    source << "float func0(float x) { return sin(x); }\n";
+    for (int i = 1; i < funcCount; ++i)
+    {
+        source << "float func" << i << "(float x) { return cos(func" << (i - 1) << "(x * 0.5f)) + " << i << ".0f; }\n";
+    }
+    source << "[numthreads(4, 1, 1)]\n";
+    source << "void computeMain(uint3 tid : SV_DispatchThreadID)\n";
+    source << "{\n";
+    source << "    outputBuffer[tid.x] = func" << (funcCount - 1) << "(float(tid.x));\n";
+    source << "}\n";
+    return source;
+}
+
+static void memoryReportTest()
+{
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, session.writeRef())));
+
+    // A small module, and then larger ones
+    const int funcCounts[] = { 1, 8, 32 };
+    Int previousUnitsBytes = 0;
+    Int previousPeakBytes = 0;
+    for (auto funcCount : funcCounts)
+    {
+        SlangCompileRequest* request = _createRequest(session, _getSource(funcCount).getBuffer());
+
+        // Before compiling, only the session and the linkage hold anything
+        List<ReportEntry> beforeEntries;
+        SLANG_CHECK(SLANG_SUCCEEDED(_getReport(request, beforeEntries)));
+        _checkTotals(beforeEntries);
+        SLANG_CHECK(_findBytes(beforeEntries, "session") > 0);
+        SLANG_CHECK(_findBytes(beforeEntries, "peak back-end IR") == 0);
+
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+        List<ReportEntry> entries;
+        SLANG_CHECK(SLANG_SUCCEEDED(_getReport(request, entries)));
+        _checkTotals(entries);
+
+        const char* names[] = { "session", "linkage", "translation units", "total", "peak back-end IR" };
+        for (auto name : names)
+        {
+            SLANG_CHECK(_findBytes(entries, name) > 0);
+        }
+
+        // Compiling only adds to what is held
+        SLANG_CHECK(_findBytes(entries, "session") >= _findBytes(beforeEntries, "session"));
+        SLANG_CHECK(_findBytes(entries, "linkage") >= _findBytes(beforeEntries, "linkage"));
+        SLANG_CHECK(_findBytes(entries, "total") > _findBytes(beforeEntries, "total"));
+
+        // A larger module holds more, and needs more IR to generate code for
+        const Int unitsBytes = _findBytes(entries, "translation units");
+        const Int peakBytes = _findBytes(entries, "peak back-end IR");
+        SLANG_CHECK(unitsBytes > previousUnitsBytes);
+        SLANG_CHECK(peakBytes > previousPeakBytes);
+        previousUnitsBytes = unitsBytes;
+        previousPeakBytes = peakBytes;
+
+        spDestroyCompileRequest(request);
+    }
+}
+
+SLANG_UNIT_TEST("memoryReport", memoryReportTest);
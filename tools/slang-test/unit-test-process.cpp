@@ -0,0 +1,238 @@
+// unit-test-process.cpp
+
+#include "../../source/core/slang-process-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompletedCounter
+{
+    static void onCompleted(ProcessQueue::Handle handle, SlangResult res, const ExecuteResult& exeResult, void* userData)
+    {
+        SLANG_UNUSED(handle);
+        SLANG_UNUSED(exeResult);
+
+        CompletedCounter* counter = (CompletedCounter*)userData;
+        counter->count++;
+        counter->failedCount += SLANG_FAILED(res) ? 1 : 0;
+    }
+
+    Index count = 0;
+    Index failedCount = 0;
+};
+
+struct ReentrantChecker
+{
+        /// Checks the results of all completed jobs are available from within the callback, and adds a job
+    static void onCompleted(ProcessQueue::Handle handle, SlangResult res, const ExecuteResult& exeResult, void* userData)
+    {
+        ReentrantChecker* checker = (ReentrantChecker*)userData;
+        ProcessQueue* queue = checker->queue;
+
+        for (ProcessQueue::Handle i = 0; i <= handle; ++i)
+        {
+            ExecuteResult completedResult;
+            if (queue->isCompleted(i) && 
+                (SLANG_FAILED(queue->getResult(i, completedResult)) || completedResult.standardOutput != checker->getExpectedOutput(i)))
+            {
+                checker->errorCount++;
+            }
+        }
+        if (SLANG_FAILED(res) || exeResult.standardOutput != checker->getExpectedOutput(handle))
+        {
+            checker->errorCount++;
+        }
+
+        if (checker->addCount > 0)
+        {
+            checker->addCount--;
+            const ProcessQueue::Handle addedHandle = checker->add();
+
+            // Waiting makes progress on the queue from within the callback
+            if ((handle & 1) == 0)
+            {
+                ExecuteResult addedResult;
+                if (SLANG_FAILED(queue->wait(addedHandle)) ||
+                    SLANG_FAILED(queue->getResult(addedHandle, addedResult)) ||
+                    addedResult.standardOutput != checker->getExpectedOutput(addedHandle))
+                {
+                    checker->errorCount++;
+                }
+            }
+        }
+    }
+
+    String getExpectedOutput(ProcessQueue::Handle handle) const
+    {
+        StringBuilder buf;
+        buf << handle << "\n";
+        return buf;
+    }
+
+    ProcessQueue::Handle add()
+    {
+        // Handles are allocated in order, so the handle is the amount added
+        StringBuilder script;
+        script << "echo " << addedCount++;
+
+        CommandLine cmdLine;
+        cmdLine.setExecutableFilename("sh");
+        cmdLine.addArg("-c");
+        cmdLine.addArg(script);
+
+        return queue->add(cmdLine, String(), &ReentrantChecker::onCompleted, this);
+    }
+
+    ProcessQueue* queue = nullptr;
+    Index addedCount = 0;
+    Index addCount = 0;                     ///< How many more jobs to add from callbacks
+    Index errorCount = 0;
+};
+
+} // anonymous
+
+static void processUnitTest()
+{
+#if SLANG_UNIX_FAMILY
+    // Standard input is written to the process
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableFilename("cat");
+
+        // Make large enough to not fit in a pipe buffer
+        StringBuilder buf;
+        for (Index i = 0; i < 10000; ++i)
+        {
+            buf << "Line " << i << "\n";
+        }
+
+        ExecuteResult exeRes;
+        SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::execute(cmdLine, buf.ProduceString(), exeRes)));
+        SLANG_CHECK(exeRes.resultCode == 0);
+        SLANG_CHECK(exeRes.standardOutput == buf);
+    }
+
+    // Processes are run concurrently, with callbacks on completion
+    {
+        CompletedCounter counter;
+
+        ProcessQueue queue;
+        queue.setMaxRunningCount(2);
+
+        List<ProcessQueue::Handle> handles;
+        for (Index i = 0; i < 5; ++i)
+        {
+            StringBuilder script;
+            script << "echo " << i << "; exit " << i;
+
+            CommandLine cmdLine;
+            cmdLine.setExecutableFilename("sh");
+            cmdLine.addArg("-c");
+            cmdLine.addArg(script);
+
+            handles.add(queue.add(cmdLine, String(), &CompletedCounter::onCompleted, &counter));
+        }
+
+        SLANG_CHECK(queue.getPendingCount() == 5);
+
+        // We can wait on a specific one
+        SLANG_CHECK(SLANG_SUCCEEDED(queue.wait(handles[3])));
+        SLANG_CHECK(queue.isCompleted(handles[3]));
+
+        SLANG_CHECK(SLANG_SUCCEEDED(queue.waitAll()));
+        SLANG_CHECK(queue.getPendingCount() == 0);
+        SLANG_CHECK(counter.count == 5 && counter.failedCount == 0);
+
+        for (Index i = 0; i < handles.getCount(); ++i)
+        {
+            ExecuteResult exeRes;
+            SLANG_CHECK(SLANG_SUCCEEDED(queue.getResult(handles[i], exeRes)));
+            SLANG_CHECK(exeRes.resultCode == int(i));
+
+            StringBuilder expected;
+            expected << i << "\n";
+            SLANG_CHECK(exeRes.standardOutput == expected);
+        }
+    }
+
+    // Callbacks can use the queue, and see the results of all the jobs that have completed
+    {
+        ProcessQueue queue;
+        queue.setMaxRunningCount(3);
+
+        ReentrantChecker checker;
+        checker.queue = &queue;
+        checker.addCount = 4;
+
+        for (Index i = 0; i < 4; ++i)
+        {
+            checker.add();
+        }
+
+        SLANG_CHECK(SLANG_SUCCEEDED(queue.waitAll()));
+        SLANG_CHECK(checker.addedCount == 8);
+        SLANG_CHECK(checker.errorCount == 0);
+    }
+
+    // Standard input can be kept open, with the output read as the process runs, so the process can be
+    // sent more input in response to its output
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableFilename("sh");
+        cmdLine.addArg("-c");
+        cmdLine.addArg("while read line; do echo \"got $line\"; done; exit 3");
+
+        RefPtr<Process> process;
+        SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::createProcess(cmdLine, String("a\n"), Process::Flag::KeepStdInOpen, process)));
+
+        Process* processes[] = { process };
+        const char* expectedOutputs[] = { "got a\n", "got a\ngot b\n", "got a\ngot b\ngot c\n" };
+        const char* nextInputs[] = { "b\n", "c\n" };
+        for (Index i = 0; i < SLANG_COUNT_OF(expectedOutputs); ++i)
+        {
+            const UnownedStringSlice expected(expectedOutputs[i]);
+            while (!process->isTerminated() && process->getResult().standardOutput.getLength() < expected.getLength())
+            {
+                SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::waitForOutput(processes, 1, -1)));
+            }
+            SLANG_CHECK(!process->isTerminated());
+            SLANG_CHECK(process->getResult().standardOutput.getUnownedSlice() == expected);
+
+            if (i < SLANG_COUNT_OF(nextInputs))
+            {
+                process->writeStdIn(nextInputs[i]);
+            }
+        }
+
+        // Closing stdin lets the process complete
+        process->closeStdIn();
+        while (!process->isTerminated())
+        {
+            SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::waitForAny(processes, 1, -1)));
+        }
+        SLANG_CHECK(process->getResult().resultCode == 3);
+    }
+
+    // A running process can be killed
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableFilename("sleep");
+        cmdLine.addArg("60");
+
+        RefPtr<Process> process;
+        SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::createProcess(cmdLine, String(), process)));
+        SLANG_CHECK(!process->isTerminated());
+
+        process->kill();
+        SLANG_CHECK(process->isTerminated());
+        SLANG_CHECK(process->getResult().resultCode != 0);
+    }
+#endif
+
+    SLANG_CHECK(ProcessUtil::getProcessorCount() >= 1);
+}
+
+SLANG_UNIT_TEST("Process", processUnitTest);
@@ -0,0 +1,82 @@
+// unit-test-shared-stdlib.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangResult _compileToHLSL(slang::IGlobalSession* session, const char* source, String& outCode)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+
+    const int tuIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, tuIndex, "internalFile", source);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        outCode = spGetEntryPointSource(request, 0);
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static void sharedStdLibTest()
+{
+    // Uses stdlib types and functions, as well as names that are new to each session
+    const char* testSource =
+        "RWStructuredBuffer<float4> outputBuffer;\n"
+        "struct UniqueToTheTest { float4 value; };\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    UniqueToTheTest t;\n"
+        "    t.value = float4(tid.x, 1.0f, 2.0f, 3.0f);\n"
+        "    outputBuffer[tid.x] = normalize(t.value) + saturate(float(tid.y));\n"
+        "}\n";
+
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(slang_createGlobalSession(SLANG_API_VERSION, session.writeRef())));
+
+    ComPtr<slang::IGlobalSession> sharedSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->createGlobalSessionSharingStdLib(sharedSession.writeRef())));
+
+    // A session sharing from a sharing session
+    ComPtr<slang::IGlobalSession> sharedSharedSession;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(sharedSession->createGlobalSessionSharingStdLib(sharedSharedSession.writeRef())));
+
+    // The stdlib can no longer be replaced
+    SLANG_CHECK(SLANG_FAILED(session->compileStdLib(0)));
+    SLANG_CHECK(SLANG_FAILED(sharedSession->compileStdLib(0)));
+
+    // Settings are copied, but are then separate
+    SLANG_CHECK(sharedSession->getDefaultDownstreamCompiler(SLANG_SOURCE_LANGUAGE_CPP) == session->getDefaultDownstreamCompiler(SLANG_SOURCE_LANGUAGE_CPP));
+    sharedSession->setDownstreamCompilerStaging(SLANG_DOWNSTREAM_STAGING_MEMORY);
+    SLANG_CHECK(session->getDownstreamCompilerStaging() == SLANG_DOWNSTREAM_STAGING_DEFAULT);
+
+    String code;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileToHLSL(session, testSource, code)));
+
+    // Should produce the same output from all the sessions
+    String sharedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileToHLSL(sharedSession, testSource, sharedCode)));
+    SLANG_CHECK(code.getLength() > 0 && code == sharedCode);
+
+    // Releasing the session that holds the stdlib, should not stop the others working
+    session.setNull();
+    sharedSession.setNull();
+
+    String sharedSharedCode;
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileToHLSL(sharedSharedSession, testSource, sharedSharedCode)));
+    SLANG_CHECK(code == sharedSharedCode);
+}
+
+SLANG_UNIT_TEST("sharedStdLib", sharedStdLibTest);
@@ -0,0 +1,113 @@
+// unit-test-string-rope.cpp
+
+#include "../../source/core/slang-string-rope.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-writer.h"
+
+using namespace Slang;
+
+static String _getRopeText(const StringRope& rope)
+{
+    StringBuilder buf;
+    for (const auto& chunk : rope.getChunks())
+    {
+        buf << chunk;
+    }
+    return buf;
+}
+
+static void stringRopeUnitTest()
+{
+    // Build up a rope and a string with the same contents, with appends of random sizes
+    {
+        DefaultRandomGenerator randGen(0x34a4);
+
+        StringRope rope;
+        StringBuilder expected;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const Index count = (i % 100 == 99) ? StringRope::kChunkSize + 10 : randGen.nextInt32UpTo(300);
+
+            StringBuilder text;
+            for (Index j = 0; j < count; ++j)
+            {
+                text.appendChar(char('a' + (i + j) % 26));
+            }
+
+            rope.append(text.getUnownedSlice());
+            expected << text;
+        }
+
+        SLANG_CHECK(rope.getLength() == expected.getLength());
+        SLANG_CHECK(rope.getChunks().getCount() > 1);
+        SLANG_CHECK(_getRopeText(rope) == expected);
+
+        // Writing out doesn't change the chunks
+        {
+            StringBuilder buf;
+            StringWriter writer(&buf, 0);
+            SLANG_CHECK(SLANG_SUCCEEDED(rope.writeTo(&writer)));
+            SLANG_CHECK(buf == expected);
+        }
+
+        const String flattened = rope.flatten();
+        SLANG_CHECK(flattened == expected);
+        SLANG_CHECK(rope.getChunks().getCount() == 1);
+        SLANG_CHECK(rope.getLength() == expected.getLength());
+
+        // Flattening again doesn't copy
+        SLANG_CHECK(rope.flatten().getBuffer() == flattened.getBuffer());
+
+        // Appending to a flattened rope
+        rope.append(UnownedStringSlice::fromLiteral("end"));
+        expected << "end";
+        SLANG_CHECK(rope.flatten() == expected);
+        // The flattened string isn't modified
+        SLANG_CHECK(flattened.getLength() + 3 == expected.getLength());
+    }
+
+    // Joining ropes
+    {
+        StringRope prefix;
+        prefix.append(UnownedStringSlice::fromLiteral("Hello"));
+
+        StringRope rope;
+        rope.append(UnownedStringSlice::fromLiteral(" World"));
+        rope.prependRope(prefix);
+        SLANG_CHECK(_getRopeText(rope) == "Hello World");
+
+        // Appending after prepend uses the tail as usual
+        rope.append(UnownedStringSlice::fromLiteral("!"));
+        SLANG_CHECK(_getRopeText(rope) == "Hello World!");
+
+        // Chunks are shared, so modifying the rope doesn't change the original
+        prefix.append(UnownedStringSlice::fromLiteral("?"));
+        SLANG_CHECK(_getRopeText(prefix) == "Hello?");
+        SLANG_CHECK(_getRopeText(rope) == "Hello World!");
+
+        rope.appendRope(prefix);
+        rope.append(UnownedStringSlice::fromLiteral("."));
+        SLANG_CHECK(_getRopeText(prefix) == "Hello?");
+        SLANG_CHECK(_getRopeText(rope) == "Hello World!Hello?.");
+
+        rope.appendRope(rope);
+        SLANG_CHECK(rope.flatten() == "Hello World!Hello?.Hello World!Hello?.");
+        SLANG_CHECK(rope.getLength() == 38);
+
+        // A string added as a chunk isn't copied
+        String text("Shared");
+        StringRope other;
+        other.appendChunk(text);
+        SLANG_CHECK(other.flatten().getBuffer() == text.getBuffer());
+
+        other.clear();
+        SLANG_CHECK(other.getLength() == 0 && other.getChunks().getCount() == 0);
+        SLANG_CHECK(other.flatten() == "");
+    }
+}
+
+SLANG_UNIT_TEST("StringRope", stringRopeUnitTest);
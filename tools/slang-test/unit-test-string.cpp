@@ -1,6 +1,7 @@
 // unit-test-path.cpp
 
 #include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-string-escape-util.h"
 
 #include "test-context.h"
 
@@ -259,6 +260,42 @@ static void stringUnitTest()
             SLANG_CHECK(value == parsedValue);
         }
     }
+    {
+        // C++ style escaping round trips
+        auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::Cpp);
+
+        const char* texts[] =
+        {
+            "",
+            "Hello",
+            "Line\nAnother line\n",
+            "\"quoted\" \\ back\\slash\\",
+            "tab\there\x01\x7f end",
+            "\xe2\x9c\x93 utf8",
+            "\\\\\n\n\\",
+        };
+
+        for (auto text : texts)
+        {
+            const UnownedStringSlice slice = UnownedTerminatedStringSlice(text);
+
+            StringBuilder quoted;
+            SLANG_CHECK(SLANG_SUCCEEDED(StringEscapeUtil::appendQuoted(handler, slice, quoted)));
+            // Escaped text doesn't contain any new lines
+            SLANG_CHECK(quoted.indexOf('\n') < 0);
+
+            StringBuilder unquoted;
+            SLANG_CHECK(SLANG_SUCCEEDED(StringEscapeUtil::appendUnquoted(handler, quoted.getUnownedSlice(), unquoted)));
+            SLANG_CHECK(unquoted.getUnownedSlice() == slice);
+        }
+
+        // Escapes are decoded in place, and the text either side is retained
+        {
+            StringBuilder buf;
+            SLANG_CHECK(SLANG_SUCCEEDED(handler->appendUnescaped(UnownedStringSlice::fromLiteral("a\\nb\\101c\\x41;"), buf)));
+            SLANG_CHECK(buf.getUnownedSlice() == UnownedStringSlice::fromLiteral("a\nbAcA;"));
+        }
+    }
 }
 
 SLANG_UNIT_TEST("String", stringUnitTest);
@@ -0,0 +1,202 @@
+// unit-test-target-host-callable.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-test-tool-util.h"
+
+#define SLANG_PRELUDE_NAMESPACE slang_prelude
+#include "../../prelude/slang-cpp-types.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangResult _getTargetHostCallable(slang::IComponentType* program, ComPtr<ISlangSharedLibrary>& outSharedLibrary)
+{
+    // The whole program methods are on a separate interface, obtained via queryInterface
+    ComPtr<slang::IComponentType2> program2;
+    SLANG_RETURN_ON_FAIL(program->queryInterface(slang::IComponentType2::getTypeGuid(), (void**)program2.writeRef()));
+
+    ComPtr<slang::IBlob> diagnostics;
+    return program2->getTargetHostCallable(0, outSharedLibrary.writeRef(), diagnostics.writeRef());
+}
+
+static const slang_prelude::ComputeEntryPointInfo* _getEntryPointTable(ISlangSharedLibrary* sharedLibrary, int* outCount)
+{
+    *outCount = 0;
+    auto getTable = (slang_prelude::GetComputeEntryPointTableFunc)sharedLibrary->findFuncByName("slang_getComputeEntryPointTable");
+    SLANG_CHECK(getTable != nullptr);
+    return getTable ? getTable(outCount) : nullptr;
+}
+
+static SlangCompileRequest* _createRequest(SlangSession* session, const char* source, int* outTranslationUnitIndex)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HOST_CALLABLE);
+    // We only want to produce code when asked via the IComponentType2 interface
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+
+    *outTranslationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "tu1");
+    spAddTranslationUnitSourceString(request, *outTranslationUnitIndex, "internalFile", source);
+    return request;
+}
+
+static void _checkTargetHostCallable(SlangSession* session)
+{
+    // Tests that multiple entry points can be compiled into, and accessed from, a single shared library
+    const char* testSource =
+        "RWStructuredBuffer<int> outputBuffer;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeA(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = int(tid.x); }\n"
+        "[numthreads(2, 3, 1)]\n"
+        "void computeB(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = -int(tid.x); }\n";
+
+    int tuIndex = 0;
+    SlangCompileRequest* request = _createRequest(session, testSource, &tuIndex);
+    spAddEntryPoint(request, tuIndex, "computeA", SLANG_STAGE_COMPUTE);
+    spAddEntryPoint(request, tuIndex, "computeB", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompileRequest_getProgramWithEntryPoints(request, program.writeRef())));
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    SLANG_CHECK(program && SLANG_SUCCEEDED(_getTargetHostCallable(program, sharedLibrary)));
+
+    if (sharedLibrary)
+    {
+        int count = 0;
+        const slang_prelude::ComputeEntryPointInfo* infos = _getEntryPointTable(sharedLibrary, &count);
+        SLANG_CHECK(count == 2);
+
+        if (count == 2)
+        {
+            SLANG_CHECK(strcmp(infos[0].name, "computeA") == 0);
+            SLANG_CHECK(strcmp(infos[1].name, "computeB") == 0);
+
+            SLANG_CHECK(infos[0].threadGroupSize[0] == 4 && infos[0].threadGroupSize[1] == 1 && infos[0].threadGroupSize[2] == 1);
+            SLANG_CHECK(infos[1].threadGroupSize[0] == 2 && infos[1].threadGroupSize[1] == 3 && infos[1].threadGroupSize[2] == 1);
+
+            for (int i = 0; i < count; ++i)
+            {
+                const auto& info = infos[i];
+                SLANG_CHECK(info.func == (slang_prelude::ComputeFunc)sharedLibrary->findFuncByName(info.name));
+                SLANG_CHECK(info.groupFunc && info.threadFunc);
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+static void _checkSpecializedEntryPoints(SlangSession* session)
+{
+    // Two specializations of the same generic entry point share a name, so the second
+    // is exported with a numeric suffix. Each must run its own specialization.
+    const char* testSource =
+        "interface IValue { static int get(); }\n"
+        "struct Ten : IValue { static int get() { return 10; } }\n"
+        "struct Twenty : IValue { static int get() { return 20; } }\n"
+        "RWStructuredBuffer<int> outputBuffer;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain<T : IValue>(uint3 tid : SV_DispatchThreadID) { outputBuffer[tid.x] = T.get() + int(tid.x); }\n";
+
+    int tuIndex = 0;
+    SlangCompileRequest* request = _createRequest(session, testSource, &tuIndex);
+
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    spAddEntryPoint(request, tuIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    // With codegen disabled the program holds the unspecialized entry points, each of which
+    // has a single specialization parameter
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompileRequest_getProgramWithEntryPoints(request, program.writeRef())));
+    SLANG_CHECK(program && program->getSpecializationParamCount() == 2);
+
+    ComPtr<slang::IComponentType> specializedProgram;
+    if (program && program->getSpecializationParamCount() == 2)
+    {
+        slang::ProgramLayout* layout = program->getLayout(0);
+        slang::SpecializationArg args[] =
+        {
+            slang::SpecializationArg::fromType(layout->findTypeByName("Ten")),
+            slang::SpecializationArg::fromType(layout->findTypeByName("Twenty")),
+        };
+        ComPtr<slang::IBlob> diagnostics;
+        SLANG_CHECK(SLANG_SUCCEEDED(program->specialize(args, SLANG_COUNT_OF(args), specializedProgram.writeRef(), diagnostics.writeRef())));
+    }
+
+    ComPtr<ISlangSharedLibrary> sharedLibrary;
+    SLANG_CHECK(specializedProgram && SLANG_SUCCEEDED(_getTargetHostCallable(specializedProgram, sharedLibrary)));
+
+    if (sharedLibrary)
+    {
+        int count = 0;
+        const slang_prelude::ComputeEntryPointInfo* infos = _getEntryPointTable(sharedLibrary, &count);
+        SLANG_CHECK(count == 2);
+
+        if (count == 2)
+        {
+            SLANG_CHECK(strcmp(infos[0].name, "computeMain") == 0);
+            SLANG_CHECK(strcmp(infos[1].name, "computeMain_1") == 0);
+
+            const int expectedBase[] = { 10, 20 };
+            for (int i = 0; i < count; ++i)
+            {
+                const auto& info = infos[i];
+                SLANG_CHECK(info.func == (slang_prelude::ComputeFunc)sharedLibrary->findFuncByName(info.name));
+
+                int values[4] = { 0, 0, 0, 0 };
+                slang_prelude::RWStructuredBuffer<int> outputBuffer;
+                outputBuffer.data = values;
+                outputBuffer.count = 4;
+
+                slang_prelude::ComputeVaryingInput varying;
+                varying.startGroupID = { 0, 0, 0 };
+                varying.endGroupID = { 1, 1, 1 };
+
+                info.func(&varying, nullptr, &outputBuffer);
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    SLANG_CHECK(values[j] == expectedBase[i] + j);
+                }
+            }
+        }
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+static void targetHostCallableUnitTest()
+{
+    SlangSession* session = spCreateSession();
+
+    // If we can't compile host callable code, there is nothing to test
+    if (SLANG_FAILED(spSessionCheckCompileTargetSupport(session, SLANG_HOST_CALLABLE)))
+    {
+        spDestroySession(session);
+        return;
+    }
+
+    TestToolUtil::setSessionDefaultPreludeFromExePath(Path::getExecutablePath().getBuffer(), session);
+
+    _checkTargetHostCallable(session);
+    _checkSpecializedEntryPoints(session);
+
+    // Should work identically if temporary files are staged in memory (or falls back if not available)
+    session->setDownstreamCompilerStaging(SLANG_DOWNSTREAM_STAGING_MEMORY);
+    _checkTargetHostCallable(session);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("TargetHostCallable", targetHostCallableUnitTest);